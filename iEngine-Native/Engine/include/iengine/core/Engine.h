@@ -1,20 +1,37 @@
 #pragma once
 
 #include "../renderers/Renderer.h"
+#include "FramePacer.h"
 
 #include <memory>
 #include <string>
 #include <map>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
 
 // 前向声明
 namespace iengine {
     class Scene;
     class Context;
+    class TextureLoader;
+    class JobSystem;
+    class RenderThread;
+    class RenderSnapshot;
+    class RenderSnapshotBuilder;
+    class WindowInterface;
     
     struct EngineOptions {
         RendererType renderer = RendererType::OpenGL;
         bool disableWebGPU = false;
+        size_t textureMemoryBudget = 0;   // 2D 纹理显存预算（字节），0 表示使用 TextureResidencyOptions 的默认值
+        size_t jobWorkerThreads = 0;      // 任务调度器的工作线程数，0 表示硬件线程数减一；纹理解码也在这些线程上执行
+        bool renderThread = false;        // 在专用渲染线程上提交 GL 命令，见 Engine::enqueueRenderCommand
+        FramePacingOptions framePacing;   // 固定步长、帧间隔上限和帧率限制，默认可变步长、不限帧率
+        bool onDemandRendering = false;   // 场景没有变化时 tick() 跳过渲染，见 Engine::needsRedraw
+        bool multipleInstances = false;   // 有意创建多个引擎（如每个工作线程一个离屏引擎并行渲染），不再输出多实例警告
     };
     
     /**
@@ -40,6 +57,18 @@ namespace iengine {
     * iengine::Engine engine2(options);  // WARNING: Multiple instances!
     * @endcode
     * 
+    * 多个引擎并行：引擎不使用进程级的可变状态（帧计时、渲染器缓存、纹理加载器和任务调度器都属于引擎实例，
+    * ShaderLib 和 WindowFactory 为进程共享且线程安全），因此可以在 N 个线程上各用一个上下文运行 N 个引擎，
+    * 例如离屏批量渲染。每个引擎及其场景只能由创建/驱动它的线程访问；此时设置 EngineOptions::multipleInstances。
+    * 
+    * 渲染线程模式（EngineOptions::renderThread）：start() 把 GL 上下文交给渲染线程，
+    * tick() 在主线程更新场景并构建渲染快照，渲染线程渲染上一帧的快照并交换缓冲区，
+    * 主线程至多领先一帧。此模式下应用不再调用 swapBuffers，
+    * 涉及 GL 上下文或网格/纹理数据的操作（纹理加载、回读、修改网格等）需通过 enqueueRenderCommand 提交。
+    * 
+    * 按需渲染（EngineOptions::onDemandRendering）：tick() 照常更新场景，但只有 needsRedraw() 为 true 时才渲染，
+    * 返回是否渲染了一帧。场景静止时宿主可以不交换缓冲区，并阻塞等待输入事件而不是持续轮询。
+    * 
     * @see Scene - 使用多个Scene来组织不同的渲染内容
     */
     class Engine {
@@ -67,8 +96,17 @@ namespace iengine {
         
         void setRenderer(RendererType renderer);
         
-        // 公共渲染方法，供外部调用
-        void tick();
+        // 公共渲染方法，供外部调用；返回本次是否渲染了一帧（按需渲染且无变化时为 false，宿主无需交换缓冲区）
+        bool tick();
+        
+        // 按需渲染
+        void setOnDemandRendering(bool enabled);
+        bool isOnDemandRendering() const noexcept { return onDemandRendering_; }
+        // 下一次 tick() 是否会渲染：场景有变化（见 Scene::needsRedraw）、有动画、请求过重绘、有排队的输入事件，
+        // 或有待完成的渲染命令、主线程任务、纹理加载、分帧上传和回读；未启用按需渲染时总是 true
+        bool needsRedraw() const;
+        // 请求下一次 tick() 渲染，用于引擎无法感知的变化（如直接修改网格数据），可在任意线程调用
+        void requestRedraw() { redrawRequested_ = true; }
         //void render();
         
         // 新增：resize 事件处理（对齐 Web 版本）
@@ -76,12 +114,38 @@ namespace iengine {
 
         bool isReady() const noexcept;
         
+        // 异步纹理加载器，加载结果在 tick() 开始时交给纹理
+        TextureLoader& getTextureLoader() { return *textureLoader_; }
+        // 任务调度器，主线程任务在 tick() 开始时执行（渲染线程模式下在渲染线程上执行）
+        JobSystem& getJobSystem() { return *jobSystem_; }
+        
+        // 帧节奏：帧间隔、固定步长和帧率限制，可在运行时调整选项
+        FramePacer& getFramePacer() { return framePacer_; }
+        // 固定步长时最后一步之后经过的时间占一步的比例（0-1），用于在两步的状态之间插值；可变步长时为 0
+        float getInterpolationAlpha() const { return static_cast<float>(framePacer_.getAlpha()); }
+        
+        // 在持有 GL 上下文的线程上、下一帧渲染前执行；单线程模式下在下一次 tick() 中执行
+        void enqueueRenderCommand(std::function<void()> command);
+        bool isRenderThreadEnabled() const noexcept { return renderThreadEnabled_; }
+        // 渲染线程，仅在渲染线程模式下 start() 之后有效
+        RenderThread* getRenderThread() { return renderThread_.get(); }
+        
     private:
         void initRenderer();
         void setRenderer(RendererType renderer, bool init);
         void update(float deltaTime);
+        // 按帧节奏执行一次或多次（固定步长）update
+        void simulate(float deltaTime);
         void render();
         //void tick();
+        void finishRedraw();
+        // 分发活动场景窗口中排队的输入事件（合并后每帧一批）
+        void dispatchInputEvents();
+        void startRenderThread();
+        void stopRenderThread();
+        // 渲染线程上执行一帧：渲染命令、主线程任务、纹理加载结果，然后渲染快照并呈现
+        void renderSnapshot(RenderSnapshot& snapshot);
+        void runRenderCommands(std::vector<std::function<void()>>& commands);
         
     private:
         // 用于调试时检测多实例（非强制）
@@ -91,10 +155,29 @@ namespace iengine {
         std::unique_ptr<Renderer> openglRenderer_;
         std::unique_ptr<Renderer> webgpuRenderer_;
         
+        // 加载器的解码任务运行在 jobSystem_ 上，需要先于它析构
+        std::unique_ptr<JobSystem> jobSystem_;
+        std::unique_ptr<TextureLoader> textureLoader_;
+        size_t textureMemoryBudget_ = 0;
+        
+        // 渲染线程模式
+        bool renderThreadEnabled_ = false;
+        std::unique_ptr<RenderThread> renderThread_;
+        std::unique_ptr<RenderSnapshotBuilder> snapshotBuilder_;
+        std::shared_ptr<WindowInterface> renderWindow_;
+        uint64_t snapshotFrame_ = 0;
+        std::vector<std::function<void()>> renderCommands_;
+        mutable std::mutex renderCommandsMutex_;
+        
+        // 按需渲染
+        bool onDemandRendering_ = false;
+        std::atomic<bool> redrawRequested_{true};
+        std::atomic<bool> rendererPendingWork_{false};  // 最近一次渲染后渲染器的 hasPendingWork()，渲染线程模式下由渲染线程写入
+        
         std::map<std::string, std::shared_ptr<Scene>> scenes_;
         std::shared_ptr<Scene> activeScene_;
         
         bool running_ = false;
-        float lastTime_ = 0.0f;
+        FramePacer framePacer_;
     };
 }
\ No newline at end of file
@@ -7,4 +7,37 @@ namespace iengine {
         WebGPU
     };
 
+    // 缓冲区数据的更新频率
+    enum class BufferUsage {
+        Static,   // 上传一次，多次绘制
+        Dynamic,  // 偶尔更新，多次绘制
+        Stream    // 每帧重写，写一次绘制一次
+    };
+
+    // 纹理像素格式（GPU 内部格式）
+    // 8 位格式的 CPU 数据为每通道 uint8，浮点格式的 CPU 数据为每通道 float，均紧密排列；
+    // BC 压缩格式的 CPU 数据为按行排列的 4x4 块
+    enum class TextureFormat {
+        R8,
+        RG8,
+        RGB8,
+        RGBA8,
+        SRGB8_ALPHA8,
+        R16F,
+        RGBA16F,
+        RGBA32F,
+        BC1,        // RGB，4 bpp
+        BC1_SRGB,
+        BC3,        // RGBA，8 bpp
+        BC3_SRGB,
+        BC4,        // 单通道，4 bpp
+        BC5,        // 双通道（法线 XY），8 bpp
+        BC7,        // RGBA 高质量，8 bpp
+        BC7_SRGB,
+        // 深度格式，只用于渲染目标的附件
+        DEPTH24,
+        DEPTH24_STENCIL8,
+        DEPTH32F
+    };
+
 } // namespace iengine
\ No newline at end of file
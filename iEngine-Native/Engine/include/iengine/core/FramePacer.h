@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace iengine {
+    struct FramePacingOptions {
+        double fixedTimestep = 0.0;     // 固定模拟步长（秒），如 1/60；0 表示每帧按实际间隔更新一次
+        int maxStepsPerFrame = 8;       // 每帧最多执行的固定步数，超出的积累时间丢弃，避免越追越慢
+        double maxDeltaTime = 0.25;     // 单帧间隔上限（秒），断点、拖动窗口等造成的长间隔按此计算
+        double targetFps = 0.0;         // 帧率上限，0 表示不限制（由垂直同步或宿主的定时器决定）
+        double spinThreshold = 0.001;   // 帧限制的最后这段时间（秒）自旋等待，之前休眠，兼顾精度和 CPU 占用
+        double smoothing = 0.1;         // 帧间隔指数平滑系数（0-1），越小越平稳
+    };
+
+    struct FramePacingStats {
+        uint64_t frames = 0;
+        uint64_t clampedFrames = 0;     // 间隔超过 maxDeltaTime 的帧数
+        double clampedSeconds = 0.0;    // 因此丢弃的时间
+        uint64_t simulationSteps = 0;
+        uint64_t droppedSteps = 0;      // 超出 maxStepsPerFrame 而丢弃的固定步数
+        uint64_t limitedFrames = 0;     // 帧限制器等待过的帧数
+        double sleepMilliseconds = 0.0; // 帧限制器累计休眠时间
+        double spinMilliseconds = 0.0;  // 帧限制器累计自旋时间
+    };
+
+    /**
+     * @brief 帧节奏控制：帧间隔测量、固定步长模拟、帧率限制和帧时间平滑
+     *
+     * 每帧开始调用 beginFrame() 得到钳制后的间隔。固定步长模式下 getFixedSteps() 给出本帧应执行的
+     * 模拟步数，getAlpha() 为剩余积累时间占一步的比例，渲染时可用它在上一步和当前步的状态之间插值。
+     * 帧末调用 limitFrameRate()：先休眠到接近目标时间，再自旋到目标时间，
+     * 目标时间按固定间隔递增，偶尔的慢帧之后会补回平均帧率，落后超过一帧时重新对齐。
+     */
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit FramePacer(const FramePacingOptions& options = FramePacingOptions());
+
+        // 开始新的一帧，返回钳制后的帧间隔（秒），第一帧为 0
+        double beginFrame();
+        // 帧末调用，按 targetFps 等待
+        void limitFrameRate();
+        // 重新开始计时（暂停恢复、重新启动后调用），不清除统计
+        void reset();
+
+        bool isFixedTimestep() const { return options_.fixedTimestep > 0.0; }
+        double getFixedTimestep() const { return options_.fixedTimestep; }
+        int getFixedSteps() const { return fixedSteps_; }
+        double getAlpha() const { return alpha_; }
+
+        double getDeltaTime() const { return deltaTime_; }
+        double getRawDeltaTime() const { return rawDeltaTime_; }
+        double getSmoothedDeltaTime() const { return smoothedDeltaTime_; }
+        double getSmoothedFps() const { return smoothedDeltaTime_ > 0.0 ? 1.0 / smoothedDeltaTime_ : 0.0; }
+        // 累计的（钳制后的）运行时间
+        double getTime() const { return time_; }
+        uint64_t getFrameIndex() const { return frameIndex_; }
+
+        const FramePacingOptions& getOptions() const { return options_; }
+        void setOptions(const FramePacingOptions& options);
+        const FramePacingStats& getStats() const { return stats_; }
+        void printStats() const;
+
+    private:
+        FramePacingOptions options_;
+        FramePacingStats stats_;
+
+        bool started_ = false;
+        Clock::time_point lastFrame_;
+        Clock::time_point deadline_;
+        bool hasDeadline_ = false;
+
+        double rawDeltaTime_ = 0.0;
+        double deltaTime_ = 0.0;
+        double smoothedDeltaTime_ = 0.0;
+        double time_ = 0.0;
+        uint64_t frameIndex_ = 0;
+
+        double accumulator_ = 0.0;
+        int fixedSteps_ = 0;
+        double alpha_ = 0.0;
+    };
+}
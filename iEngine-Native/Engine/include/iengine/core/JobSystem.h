@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iengine {
+    class JobSystem;
+
+    namespace detail {
+        struct JobState;
+        struct ParallelForGroup;
+    }
+
+    /**
+     * @brief 已提交任务的句柄，可用于等待或作为其他任务的依赖
+     */
+    class JobHandle {
+    public:
+        JobHandle() = default;
+
+        bool isValid() const { return state_ != nullptr; }
+        // 空句柄视为已完成
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+        explicit JobHandle(std::shared_ptr<detail::JobState> state) : state_(std::move(state)) {}
+
+        std::shared_ptr<detail::JobState> state_;
+    };
+
+    struct JobSystemOptions {
+        size_t workerCount = 0;      // 工作线程数，0 表示硬件线程数减一（至少一个）
+        int parallelForSplitsPerThread = 8;  // parallelFor 按线程数把区间至少细分到这么多份，供空闲线程窃取
+    };
+
+    // 单个任务的执行记录，交给性能分析器
+    struct JobProfileEvent {
+        const char* name = nullptr;
+        int worker = -1;             // 工作线程序号，-1 为主线程或其他外部线程
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    struct JobWorkerStats {
+        uint64_t jobsExecuted = 0;
+        uint64_t jobsStolen = 0;     // 从其他线程的队列窃取的任务数
+        uint64_t busyMicroseconds = 0;
+    };
+
+    struct JobSystemStats {
+        uint64_t jobsScheduled = 0;
+        uint64_t mainThreadJobs = 0; // 在主线程队列上执行的任务数
+        uint64_t parallelForCalls = 0;
+        uint64_t parallelForChunks = 0;
+        std::vector<JobWorkerStats> workers;  // 最后一项为主线程及其他外部线程
+    };
+
+    /**
+     * @brief 任务窃取式的任务调度器
+     *
+     * 每个工作线程有自己的双端队列：自己从尾部取（后进先出，缓存友好），
+     * 空闲时从其他队列的头部窃取（先进先出，取到的是较早拆出的大块工作）。
+     * 外部线程提交的任务进入单独的注入队列。任务可以声明依赖，全部依赖完成后才进入队列；
+     * wait/parallelFor 的调用线程在等待期间也执行任务，不会空等。
+     * 需要 GL 上下文的工作用 scheduleMainThread 提交，只在主线程调用 runMainThreadJobs 时执行。
+     * 工作线程在构造时启动，析构时执行完剩余任务后退出。
+     */
+    class JobSystem {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using ProfileCallback = std::function<void(const JobProfileEvent&)>;
+
+        explicit JobSystem(const JobSystemOptions& options = JobSystemOptions());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // 任务抛出的异常会输出到 std::cerr 并被吞掉，任务仍视为完成
+        JobHandle schedule(std::function<void()> job, const char* name = nullptr);
+        // 全部依赖完成后才执行
+        JobHandle schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies,
+                           const char* name = nullptr);
+        // 在 dependency 完成后执行的后续任务
+        JobHandle then(const JobHandle& dependency, std::function<void()> job, const char* name = nullptr);
+        // 只在主线程的 runMainThreadJobs 中执行（GL 资源创建、上传等），同样可以声明依赖
+        JobHandle scheduleMainThread(std::function<void()> job, const std::vector<JobHandle>& dependencies = {},
+                                     const char* name = nullptr);
+
+        // 执行已就绪的主线程任务，只能在主线程（默认为创建 JobSystem 的线程）上调用，返回执行的任务数
+        size_t runMainThreadJobs();
+        // 是否有已就绪、等待 runMainThreadJobs 执行的主线程任务
+        bool hasMainThreadJobs() const;
+        // 把主线程队列交给调用线程，用于 GL 上下文随渲染线程迁移的情况
+        void setMainThread() { mainThreadId_ = std::this_thread::get_id(); }
+
+        // 等待任务完成，期间调用线程帮助执行其他任务
+        void wait(const JobHandle& handle);
+        void waitAll(const std::vector<JobHandle>& handles);
+
+        /**
+         * @brief 把 [0, count) 分给所有线程执行，调用线程也参与，全部完成后返回
+         *
+         * 区间按需二分：执行者在自己的队列空闲时把剩余区间的后一半放回队列供其他线程窃取，
+         * 直到区间不大于粒度（minChunk 与 count / (线程数 * parallelForSplitsPerThread) 中的较大者）。
+         * 负载均匀时拆分很少，不均匀时空闲线程会窃取到较大的剩余区间。fn 的签名为 void(int begin, int end)。
+         * fn 抛出异常时尚未开始的区间不再执行，等所有区间结束后在调用线程上重新抛出第一个异常。
+         */
+        void parallelFor(int count, const std::function<void(int, int)>& fn, int minChunk = 1,
+                         const char* name = nullptr);
+
+        size_t getWorkerCount() const { return workers_.size(); }
+        bool isMainThread() const { return std::this_thread::get_id() == mainThreadId_.load(); }
+        // 当前线程的工作线程序号，主线程和其他外部线程返回 -1
+        int getCurrentWorker() const;
+
+        // 性能分析回调：每个任务执行完后在执行线程上调用，应在提交任务前设置
+        void setProfileCallback(ProfileCallback callback);
+
+        JobSystemStats getStats() const;
+        void resetStats();
+        void printStats() const;
+
+    private:
+        using JobPtr = std::shared_ptr<detail::JobState>;
+
+        struct WorkerQueue {
+            std::deque<JobPtr> jobs;
+            std::mutex mutex;
+        };
+
+        struct WorkerCounters {
+            std::atomic<uint64_t> jobsExecuted{0};
+            std::atomic<uint64_t> jobsStolen{0};
+            std::atomic<uint64_t> busyMicroseconds{0};
+        };
+
+        JobHandle submit(std::function<void()> job, const std::vector<JobHandle>& dependencies, const char* name,
+                         bool mainThread);
+        void enqueue(const JobPtr& job);
+        JobPtr popLocal(size_t queue);
+        JobPtr steal(size_t thief);
+        bool runOne(size_t queue);
+        void execute(const JobPtr& job, size_t queue);
+        void complete(const JobPtr& job);
+        void workerLoop(size_t index);
+        void runRange(const std::shared_ptr<detail::ParallelForGroup>& group, int begin, int end);
+        size_t getCurrentQueue() const;
+        size_t getQueueSize(size_t queue);
+
+        JobSystemOptions options_;
+        std::atomic<std::thread::id> mainThreadId_;
+        std::vector<std::thread> workers_;
+        // 每个工作线程一个队列，最后一个是外部线程的注入队列
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::unique_ptr<WorkerCounters>> counters_;
+
+        std::deque<JobPtr> mainThreadJobs_;
+        mutable std::mutex mainThreadMutex_;
+
+        // 工作线程休眠/唤醒
+        std::atomic<int64_t> queuedJobs_{0};
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        std::atomic<bool> stopping_{false};
+
+        ProfileCallback profileCallback_;
+        std::atomic<uint64_t> jobsScheduled_{0};
+        std::atomic<uint64_t> mainThreadJobsRun_{0};
+        std::atomic<uint64_t> parallelForCalls_{0};
+        std::atomic<uint64_t> parallelForChunks_{0};
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <array>
@@ -7,10 +8,10 @@
 #include <map>
 #include "../geometries/Geometry.h"
 #include "../core/Primitive.h"
+#include "../core/Enums.h"
+#include "../renderers/Context.h"
 
 namespace iengine {
-    // 前向声明
-    class Context;
     
     class Mesh {
     public:
@@ -18,6 +19,12 @@ namespace iengine {
         std::shared_ptr<Primitive> primitive;
         bool uploaded = false;
         
+        // 是否从共享缓冲区池中子分配顶点/索引区间（后端不支持时自动回退到独立缓冲区）
+        bool usePooledBuffers = true;
+        
+        // 数据更新频率：Static 走缓冲区池，Dynamic 原地更新独立缓冲区，Stream 每帧写入环形缓冲区
+        BufferUsage usage = BufferUsage::Static;
+        
         std::array<float, 16> transform = {{
             1, 0, 0, 0,
             0, 1, 0, 0,
@@ -26,6 +33,7 @@ namespace iengine {
         }};
         
         Mesh(std::shared_ptr<Geometry> geometry, std::shared_ptr<Primitive> primitive);
+        ~Mesh();
         
         bool hasNormal() const;
         bool hasUV() const;
@@ -40,18 +48,41 @@ namespace iengine {
         
         void upload(std::shared_ptr<Context> context, bool force = false);
         
+        // 释放 GPU 资源（池化区间归还给缓冲区池），之后可以重新 upload
+        void release(std::shared_ptr<Context> context);
+        
+        // 上传到 GPU 的数据量（交错顶点 + 索引），用于上传预算估算
+        size_t getGpuByteSize() const;
+        
+        // 标记几何数据已修改，下次渲染时重新上传
+        void markDirty() { dirty = true; }
+        bool isDirty() const { return dirty; }
+        
+        // LOD 支持（仅三角形列表有效，所有级别共用同一个 VBO 和 IBO）
+        bool hasLods() const;
+        size_t getLodCount() const;
+        
         // 构建交错缓冲区
         std::vector<float> buildInterleavedBuffer(const VertexLayout& layout) const;
         
         // 访问器方法
-        void* getVBO() const { return vbo; }
-        void* getIBO() const { return ibo; }
+        BufferHandle getVBO() const { return vbo; }
+        BufferHandle getIBO() const { return ibo; }
+        uint32_t getBufferAllocation() const { return bufferAllocation; }
+        bool isPooled() const { return bufferAllocation != 0; }
+        const StreamBufferRange& getStreamRange() const { return streamRange; }
         
     private:
         std::vector<std::pair<std::string, std::vector<float>>> vertexAttributeDataMap;
         
         // OpenGL/WebGPU资源
-        void* vbo = nullptr;  // 顶点缓冲区对象
-        void* ibo = nullptr;  // 索引缓冲区对象
+        BufferHandle vbo;  // 顶点缓冲区对象
+        BufferHandle ibo;  // 索引缓冲区对象
+        uint32_t bufferAllocation = 0;  // 缓冲区池中的分配句柄，0 表示使用独立缓冲区
+        StreamBufferRange streamRange;  // 流式数据在环形缓冲区中的位置
+        bool dirty = false;
+        
+        // 上传时使用的上下文，析构时用它释放 GPU 资源
+        std::weak_ptr<Context> uploadContext;
     };
 }
\ No newline at end of file
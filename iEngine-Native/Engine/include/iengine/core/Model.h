@@ -7,8 +7,29 @@
 #include "Mesh.h"
 #include "../materials/Material.h"
 #include "../math/Matrix4.h"
+#include "../math/Vector3.h"
+#include "../scenes/EntityRegistry.h"
 
 namespace iengine {
+    class Camera;
+    class Scene;
+    struct EntityStateComponent;
+    
+    // LOD 选择参数
+    struct LodSelectionOptions {
+        bool enabled = true;
+        float pixelErrorThreshold = 1.0f;  // 允许的屏幕空间几何误差（像素）
+        float bias = 1.0f;                 // 大于1偏向更粗糙的级别，小于1偏向更精细的级别
+        float hysteresis = 0.2f;           // 切换迟滞比例，避免在阈值附近来回跳变（popping）
+    };
+    
+    /**
+     * @brief 模型：场景组件的对象接口
+     *
+     * 加入场景后，变换、显示开关和变化标记存放在场景实体存储的列中，Model 只是按实体句柄访问它们的外观对象；
+     * 移出场景时这些状态复制回 Model。网格和材质仍由 Model 持有，直接给 mesh、material 赋值后
+     * 需要调用 markDirty()（或改用 setMesh/setMaterial），场景才会重新读取它们。
+     */
     class Model {
     public:
         std::string name;
@@ -24,16 +45,64 @@ namespace iengine {
         void setRotation(float x, float y, float z);
         void setScale(float x, float y, float z);
         
-        // 获取变换矩阵
-        const Matrix4& getTransform() const { return transform_; }
+        // 获取变换矩阵；在场景中时矩阵存放在实体的组件列里，列会随实体增删组件搬移，因此按值返回
+        Matrix4 getTransform() const;
+        void setTransform(const Matrix4& transform);
+        
+        void setMesh(std::shared_ptr<Mesh> mesh);
+        void setMaterial(std::shared_ptr<Material> material);
+        
+        // 隐藏的模型不参与剔除和渲染
+        void setVisible(bool visible);
+        bool isVisible() const;
+        
+        // 所在的场景和实体，不在场景中时为空
+        Scene* getScene() const { return scene_; }
+        Entity getEntity() const { return entity_; }
         
         // 动画支持
         using AnimationCallback = std::function<void(Model&, float)>;
         void addAnimation(const AnimationCallback& callback);
         void update(float deltaTime);
+        // 有动画的模型每帧都可能变化，按需渲染时场景持续重绘
+        bool hasAnimations() const { return !animations_.empty(); }
+        
+        // 按需渲染：变换改变后为 true，渲染后由引擎清除
+        bool isDirty() const;
+        void markDirty();
+        void clearDirty();
+        
+        // 世界空间包围球（由几何包围盒和当前变换得到），没有网格时返回 false
+        bool getWorldBoundingSphere(Vector3& center, float& radius) const;
+        
+        // LOD 支持：根据包围盒在屏幕上的投影误差选择本帧使用的 LOD 级别
+        size_t selectLod(Camera& camera, float viewportHeight);
+        size_t getCurrentLod() const;
+        void setLodOptions(const LodSelectionOptions& options) { lodOptions_ = options; }
+        const LodSelectionOptions& getLodOptions() const { return lodOptions_; }
+        // 按投影误差选择级别，pixelsPerUnitError 为包围球直径在屏幕上的像素数，currentLevel 为上次选择的级别
+        static size_t selectLodLevel(const Geometry& geometry, const LodSelectionOptions& options,
+                                     size_t currentLevel, float pixelsPerUnitError);
         
     private:
+        friend class Scene;
+        
+        // 在场景中时返回实体的状态列，否则为空
+        EntityStateComponent* getState() const;
+        // 变换改变：标记重绘，在场景中时还要重新计算包围球
+        void markTransformDirty();
+        
+        // 不在场景中时使用的状态
         Matrix4 transform_;
+        bool visible_ = true;
+        bool dirty_ = true;
+        
         std::vector<AnimationCallback> animations_;
+        
+        LodSelectionOptions lodOptions_;
+        size_t currentLod_ = 0;
+        
+        Scene* scene_ = nullptr;
+        Entity entity_;
     };
 }
\ No newline at end of file
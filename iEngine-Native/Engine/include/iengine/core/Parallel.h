@@ -0,0 +1,26 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "JobSystem.h"
+
+namespace iengine {
+    /**
+     * @brief 把 [0, count) 分块交给任务调度器执行，调用线程也参与，全部完成后返回
+     *
+     * 不创建线程：在纹理解码等任务内部调用时，分出的块由同一组工作线程窃取执行，不会超额占用 CPU。
+     * 每块至少 minItemsPerChunk 项；jobSystem 为空或工作量不超过一块时直接在调用线程执行。
+     * fn 的签名为 void(int begin, int end)。
+     */
+    template <typename Fn>
+    void parallelFor(JobSystem* jobSystem, int count, size_t minItemsPerChunk, Fn&& fn) {
+        if (count <= 0) return;
+        const size_t minChunk = std::max<size_t>(1, minItemsPerChunk);
+        if (!jobSystem || static_cast<size_t>(count) <= minChunk) {
+            fn(0, count);
+            return;
+        }
+        jobSystem->parallelFor(count, [&fn](int begin, int end) { fn(begin, end); },
+                               static_cast<int>(minChunk), "parallelFor");
+    }
+}
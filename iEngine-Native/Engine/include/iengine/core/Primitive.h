@@ -52,6 +52,6 @@ namespace iengine {
         static VertexFormatInfo getVertexFormatInfo(const std::string& format);
         
         // 常用顶点格式信息映射
-        static std::map<std::string, VertexFormatInfo> VertexFormatInfoMap;
+        static const std::map<std::string, VertexFormatInfo> VertexFormatInfoMap;
     };
 }
\ No newline at end of file
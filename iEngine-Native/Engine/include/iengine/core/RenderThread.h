@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../renderers/RenderSnapshot.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace iengine {
+    struct RenderThreadStats {
+        uint64_t framesSubmitted = 0;
+        uint64_t framesRendered = 0;
+        double mainWaitMilliseconds = 0.0;    // 主线程等待空闲快照缓冲的累计时间（渲染跟不上时增长）
+        double renderWaitMilliseconds = 0.0;  // 渲染线程等待新快照的累计时间（主线程跟不上时增长）
+        double renderMilliseconds = 0.0;      // 渲染线程执行渲染的累计时间
+    };
+
+    /**
+     * @brief 专用渲染线程，与主线程通过两个快照缓冲交替交换数据
+     *
+     * 主线程用 beginSnapshot 取得空闲缓冲写入下一帧，submitSnapshot 交给渲染线程；
+     * 渲染线程按提交顺序渲染。两个缓冲都未归还时 beginSnapshot 等待，
+     * 因此主线程至多领先渲染线程一帧，延迟有界。
+     * GL 上下文只在渲染线程上使用：start 的 onStart 在渲染线程上使其成为当前上下文，onStop 释放。
+     */
+    class RenderThread {
+    public:
+        using Callback = std::function<void()>;
+        using RenderFunction = std::function<void(RenderSnapshot&)>;
+
+        RenderThread() = default;
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        bool start(Callback onStart, RenderFunction render, Callback onStop);
+        // 渲染完已提交的快照后退出并等待线程结束
+        void stop();
+        bool isRunning() const { return thread_.joinable(); }
+        bool isRenderThread() const { return std::this_thread::get_id() == threadId_.load(); }
+
+        // 主线程：取得可写入的快照缓冲，必须与 submitSnapshot 成对调用
+        RenderSnapshot& beginSnapshot();
+        void submitSnapshot();
+        // 等待已提交的快照全部渲染完成
+        void waitIdle();
+
+        RenderThreadStats getStats() const;
+        void printStats() const;
+
+    private:
+        enum class BufferState {
+            Free,
+            Writing,
+            Ready,
+            Rendering
+        };
+
+        static constexpr int kBufferCount = 2;
+
+        void loop(Callback onStart, RenderFunction render, Callback onStop);
+
+        RenderSnapshot buffers_[kBufferCount];
+        BufferState states_[kBufferCount] = { BufferState::Free, BufferState::Free };
+        int writing_ = -1;
+        std::deque<int> ready_;  // 按提交顺序等待渲染的缓冲
+
+        std::thread thread_;
+        std::atomic<std::thread::id> threadId_;
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+        bool stopping_ = false;
+        RenderThreadStats stats_;
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace iengine {
+    /**
+     * @brief 带代数计数的槽位表
+     *
+     * 元素删除后槽位会被复用，但代数加一，因此旧句柄（index, generation）再次访问时会失效，
+     * 不会误用到后来分配在同一槽位上的对象。代数 0 保留给空句柄。
+     */
+    template <typename T>
+    class SlotMap {
+    public:
+        struct Key {
+            uint32_t index = 0;
+            uint32_t generation = 0;
+        };
+
+        Key insert(T value) {
+            uint32_t index;
+            if (!freeList_.empty()) {
+                index = freeList_.back();
+                freeList_.pop_back();
+            } else {
+                index = static_cast<uint32_t>(slots_.size());
+                slots_.emplace_back();
+            }
+
+            Slot& slot = slots_[index];
+            slot.value = std::move(value);
+            slot.occupied = true;
+            size_++;
+            return Key{index, slot.generation};
+        }
+
+        T* get(uint32_t index, uint32_t generation) {
+            if (index >= slots_.size() || generation == 0) return nullptr;
+            Slot& slot = slots_[index];
+            return (slot.occupied && slot.generation == generation) ? &slot.value : nullptr;
+        }
+
+        const T* get(uint32_t index, uint32_t generation) const {
+            return const_cast<SlotMap*>(this)->get(index, generation);
+        }
+
+        bool erase(uint32_t index, uint32_t generation) {
+            if (!get(index, generation)) return false;
+
+            Slot& slot = slots_[index];
+            slot.value = T{};
+            slot.occupied = false;
+            if (++slot.generation == 0) {
+                slot.generation = 1;
+            }
+            freeList_.push_back(index);
+            size_--;
+            return true;
+        }
+
+        size_t size() const { return size_; }
+
+        template <typename F>
+        void forEach(F&& func) const {
+            for (const auto& slot : slots_) {
+                if (slot.occupied) func(slot.value);
+            }
+        }
+
+        void clear() {
+            slots_.clear();
+            freeList_.clear();
+            size_ = 0;
+        }
+
+    private:
+        struct Slot {
+            T value{};
+            uint32_t generation = 1;
+            bool occupied = false;
+        };
+
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> freeList_;
+        size_t size_ = 0;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iengine {
+    /**
+     * @brief 固定数量工作线程的简单线程池
+     *
+     * 任务按提交顺序执行，用于纹理解码等不涉及 GPU 的后台工作。
+     * 析构时会等待已提交的任务全部执行完毕。
+     */
+    class ThreadPool {
+    public:
+        // threadCount 为 0 时使用硬件线程数减一（至少一个）
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void enqueue(std::function<void()> task);
+
+        // 阻塞直到队列为空且没有正在执行的任务
+        void waitIdle();
+
+        size_t getThreadCount() const { return workers_.size(); }
+        size_t getPendingCount() const;
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> tasks_;
+        mutable std::mutex mutex_;
+        std::condition_variable taskAvailable_;
+        std::condition_variable idle_;
+        size_t activeCount_ = 0;
+        bool stopping_ = false;
+    };
+}
@@ -25,6 +25,17 @@ namespace iengine {
         size_t vertexCount = 0;
         size_t indexCount = 0;
         
+        // LOD 级别：indexOffset 是在 [indices, lodIndices] 拼接后的索引缓冲区中的偏移
+        struct LodLevel {
+            size_t indexOffset = 0;
+            size_t indexCount = 0;
+            float error = 0.0f;  // 相对于包围盒对角线的几何误差
+        };
+        
+        // 第0级对应原始 indices；更粗糙的级别的索引依次拼接在 lodIndices 中，与第0级共用顶点数据
+        std::vector<LodLevel> lodLevels;
+        std::vector<unsigned int> lodIndices;
+        
         Geometry(const std::vector<float>& vertices,
                  const std::vector<unsigned int>& indices = {});
         
@@ -33,6 +44,10 @@ namespace iengine {
                  const std::vector<float>& texCoords,
                  const std::vector<unsigned int>& indices = {});
         
+        size_t getLodCount() const { return lodLevels.empty() ? 1 : lodLevels.size(); }
+        LodLevel getLodLevel(size_t level) const;
+        float getBoundingDiagonal() const;
+        
     private:
         BoundingBox computeBoundingBox();
     };
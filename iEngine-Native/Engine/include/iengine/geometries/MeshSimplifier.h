@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace iengine {
+    class Geometry;
+
+    // 简化参数
+    struct SimplifyOptions {
+        float targetError = 0.01f;  // 允许的最大误差（相对于包围盒对角线长度）
+        bool lockBorder = true;     // 锁定开放边界上的顶点，避免模型轮廓收缩
+        float normalWeight = 0.5f;  // 法线差异在误差中的权重
+        float uvWeight = 1.0f;      // 纹理坐标差异在误差中的权重
+        float colorWeight = 0.5f;   // 顶点颜色差异在误差中的权重
+    };
+
+    // LOD 链生成参数
+    struct LodChainOptions {
+        size_t maxLevels = 4;          // 最大级数（包含原始的第0级）
+        float reductionRatio = 0.5f;   // 每一级相对上一级保留的三角形比例
+        size_t minTriangles = 16;      // 三角形数低于该值时不再继续简化
+        SimplifyOptions simplify;
+    };
+
+    /**
+     * @brief 基于二次误差度量（QEM）的网格简化器
+     *
+     * 采用半边折叠（把一个顶点折叠到相邻的已有顶点上），因此简化结果只产生新的索引，
+     * 所有 LOD 级别都可以共用同一份顶点数据（同一个 VBO）。
+     * 位置相同但属性不同的接缝顶点、非流形顶点以及（可选）开放边界顶点会被锁定，保证不产生裂缝。
+     */
+    class MeshSimplifier {
+    public:
+        /**
+         * @brief 简化一组三角形索引
+         * @param geometry 提供顶点属性的几何体
+         * @param indices 源三角形索引（必须是 TRIANGLES 列表）
+         * @param targetIndexCount 目标索引数量
+         * @param options 简化参数
+         * @param outError 输出实际产生的最大相对误差（可选）
+         * @return 简化后的索引，引用的仍是 geometry 中的原始顶点
+         */
+        static std::vector<unsigned int> simplify(
+            const Geometry& geometry,
+            const std::vector<unsigned int>& indices,
+            size_t targetIndexCount,
+            const SimplifyOptions& options = SimplifyOptions{},
+            float* outError = nullptr);
+
+        /**
+         * @brief 为几何体生成 LOD 链，结果写入 geometry.lodLevels / geometry.lodIndices
+         * @return 生成后的 LOD 级数（包含第0级）
+         */
+        static size_t generateLodChain(Geometry& geometry, const LodChainOptions& options = LodChainOptions{});
+    };
+}
@@ -8,6 +8,11 @@
 #include "core/Mesh.h"
 #include "core/Model.h"
 #include "core/Primitive.h"
+#include "core/ThreadPool.h"
+#include "core/Parallel.h"
+#include "core/JobSystem.h"
+#include "core/FramePacer.h"
+#include "core/RenderThread.h"
 
 // 数学库
 #include "math/Vector2.h"
@@ -20,9 +25,12 @@
 #include "geometries/Geometry.h"
 #include "geometries/Cube.h"
 #include "geometries/Triangle.h"
+#include "geometries/MeshSimplifier.h"
 
 // 场景
 #include "scenes/Scene.h"
+#include "scenes/EntityRegistry.h"
+#include "scenes/SceneComponents.h"
 
 // 相机
 #include "views/cameras/Camera.h"
@@ -41,9 +49,17 @@
 #include "renderers/opengl/OpenGLShaderProgram.h"
 #include "renderers/opengl/OpenGLUniforms.h"
 #include "renderers/opengl/OpenGLRenderPipeline.h"
+#include "renderers/opengl/OpenGLBufferArena.h"
+#include "renderers/opengl/OpenGLReadback.h"
+#include "renderers/opengl/OpenGLRenderTarget.h"
 
 // 上下文
 #include "renderers/Context.h"
+#include "renderers/BufferRangeAllocator.h"
+#include "renderers/UploadScheduler.h"
+#include "renderers/TextureResidencyManager.h"
+#include "renderers/RenderSnapshot.h"
+#include "renderers/CommandList.h"
 
 // 材质
 #include "materials/Material.h"
@@ -56,9 +72,15 @@
 #include "textures/Texture.h"
 #include "textures/Texture3D.h"
 #include "textures/TextureUtils.h"
+#include "textures/TextureLoader.h"
+#include "textures/MipmapGenerator.h"
+#include "textures/TextureCompressor.h"
+#include "textures/TextureArrayAllocator.h"
+#include "textures/StreamingTexture.h"
 
 // 着色器
 #include "shaders/ShaderLib.h"
+#include "shaders/ShaderVariantCache.h"
 #include "shaders/ShaderPreprocessor.h"
 
 // 光源
@@ -8,5 +8,7 @@ namespace iengine {
     public:
         AmbientLight(const Color& color = Color(1.0f, 1.0f, 1.0f), float intensity = 1.0f);
         virtual ~AmbientLight() = default;
+        
+        std::shared_ptr<Light> clone() const override;
     };
 }
\ No newline at end of file
@@ -11,5 +11,7 @@ namespace iengine {
         DirectionalLight(const Color& color = Color(1.0f, 1.0f, 1.0f), 
                         float intensity = 1.0f,
                         const Vector3& direction = Vector3(0.0f, -1.0f, 0.0f));
+        
+        std::shared_ptr<Light> clone() const override;
     };
 }
\ No newline at end of file
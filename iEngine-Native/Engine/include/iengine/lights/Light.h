@@ -12,5 +12,16 @@ namespace iengine {
         
         Light(const Color& color = Color(1.0f, 1.0f, 1.0f), float intensity = 1.0f);
         virtual ~Light() = default;
+        
+        // 复制灯光当前参数，供渲染线程使用
+        virtual std::shared_ptr<Light> clone() const;
+        
+        // 按需渲染：setter 会自动标记，直接修改 color/intensity 后需调用 markDirty()
+        bool isDirty() const { return dirty_; }
+        void markDirty() { dirty_ = true; }
+        void clearDirty() { dirty_ = false; }
+        
+    protected:
+        bool dirty_ = true;
     };
 }
\ No newline at end of file
@@ -21,5 +21,7 @@ namespace iengine {
         
         void setPosition(const Vector3& position);
         void setRange(float range);
+        
+        std::shared_ptr<Light> clone() const override;
     };
 }
\ No newline at end of file
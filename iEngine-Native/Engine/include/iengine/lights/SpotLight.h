@@ -29,5 +29,7 @@ namespace iengine {
         void setDirection(const Vector3& direction);
         void setAngle(float angle);
         void setRange(float range);
+        
+        std::shared_ptr<Light> clone() const override;
     };
 }
\ No newline at end of file
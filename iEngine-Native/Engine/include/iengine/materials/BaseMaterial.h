@@ -24,9 +24,10 @@ namespace iengine {
         std::map<std::string, class UniformValue> getUniforms(
             std::shared_ptr<Context> context,
             std::shared_ptr<Camera> camera,
-            std::shared_ptr<class Model> model,  // 改为传递 Model
+            const Matrix4& modelMatrix,
             const std::vector<std::shared_ptr<Light>>& lights) override;
         TextureInfo getTextures() override;
+        std::shared_ptr<Material> clone() const override;
         
         // 获取渲染管线状态
         RenderPipelineState getRenderPipelineState() const;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <map>
@@ -14,6 +15,7 @@ namespace iengine {
     class Camera;
     class Mesh;
     class Light;
+    class Matrix4;
     class UniformValue;
     
     struct TextureInfo {
@@ -43,6 +45,8 @@ namespace iengine {
         int depthFunc = 0; // OpenGL的GL_LEQUAL等常量
         bool transparent = true;
         bool doubleSided = true;
+        // 贴图放入渲染器的纹理数组/图集，不同材质的绘制可以共用同一组纹理绑定（需着色器支持 USE_TEXTURE_ARRAYS，目前为 PBR 着色器）
+        bool useTextureArrays = false;
         
         Material(const std::string& name = "default", 
                  const std::string& shaderName = "basic");
@@ -54,8 +58,22 @@ namespace iengine {
         virtual std::map<std::string, UniformValue> getUniforms(
             std::shared_ptr<Context> context,
             std::shared_ptr<Camera> camera,
-            std::shared_ptr<class Model> model,  // 改为传递 Model 而不是 Mesh
+            const Matrix4& modelMatrix,  // 模型的世界变换，渲染快照中的绘制项不再携带 Model 对象
             const std::vector<std::shared_ptr<Light>>& lights) = 0;
         virtual TextureInfo getTextures() = 0;
+        
+        // 复制材质当前参数（贴图共享），供渲染线程使用；返回空表示不支持复制，渲染线程直接使用原材质
+        virtual std::shared_ptr<Material> clone() const { return nullptr; }
+        
+        // 按需渲染：setter 会自动标记，直接修改公有字段后需调用 markDirty()，否则场景静止时不会重绘
+        bool isDirty() const { return dirty_; }
+        void markDirty() { dirty_ = true; ++version_; }
+        void clearDirty() { dirty_ = false; }
+        // 参数版本，每次 markDirty() 加一；渲染快照只为版本变化的材质生成副本
+        uint64_t getVersion() const { return version_; }
+        
+    protected:
+        bool dirty_ = true;
+        uint64_t version_ = 0;
     };
 }
\ No newline at end of file
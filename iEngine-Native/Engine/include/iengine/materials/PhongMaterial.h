@@ -35,9 +35,10 @@ namespace iengine {
         std::map<std::string, UniformValue> getUniforms(
             std::shared_ptr<Context> context,
             std::shared_ptr<Camera> camera,
-            std::shared_ptr<Model> model,
+            const Matrix4& modelMatrix,
             const std::vector<std::shared_ptr<Light>>& lights) override;
         TextureInfo getTextures() override;
+        std::shared_ptr<Material> clone() const override;
         
         // 获取渲染管线状态
         RenderPipelineState getRenderPipelineState() const;
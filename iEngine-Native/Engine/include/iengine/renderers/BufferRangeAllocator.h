@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace iengine {
+    /**
+     * @brief 线性地址空间上的区间分配器（纯 CPU 端簿记，不涉及任何图形 API）
+     *
+     * 空闲块同时按偏移和大小索引：按大小做最佳适配分配，释放时按偏移与相邻空闲块合并。
+     * 单位由调用方决定（字节、顶点或索引个数均可）。
+     */
+    class BufferRangeAllocator {
+    public:
+        static constexpr size_t InvalidOffset = SIZE_MAX;
+
+        explicit BufferRangeAllocator(size_t capacity = 0);
+
+        // 分配 size 个单位，失败返回 InvalidOffset
+        size_t allocate(size_t size);
+        // 释放之前分配的区间，并与相邻空闲块合并
+        void free(size_t offset, size_t size);
+
+        // 重置为 [0, usedPrefix) 已占用、其余空闲的状态（碎片整理后使用）
+        void reset(size_t capacity, size_t usedPrefix = 0);
+
+        size_t getCapacity() const { return capacity_; }
+        size_t getUsed() const { return capacity_ - freeTotal_; }
+        size_t getFree() const { return freeTotal_; }
+        size_t getFreeBlockCount() const { return freeByOffset_.size(); }
+        size_t getLargestFreeBlock() const;
+
+        // 碎片率：1 - 最大空闲块 / 空闲总量，0 表示空闲空间完全连续
+        float getFragmentation() const;
+
+    private:
+        void insertFreeBlock(size_t offset, size_t size);
+        void eraseFreeBlock(std::map<size_t, size_t>::iterator it);
+
+        size_t capacity_ = 0;
+        size_t freeTotal_ = 0;
+        std::map<size_t, size_t> freeByOffset_;       // offset -> size
+        std::multimap<size_t, size_t> freeBySize_;    // size -> offset
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "opengl/OpenGLUniforms.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iengine {
+    class Mesh;
+
+    enum class RenderCommandType : uint8_t {
+        BindPipeline,   // 切换着色器程序、顶点数组和渲染状态，与当前管线相同时跳过
+        SetUniforms,    // 设置 uniforms 中的一段
+        BindTextures,   // 绑定 uniforms 中的一段纹理，本次未设置的采样器绑定占位纹理
+        Draw,
+        DrawInstanced
+    };
+
+    struct RenderCommand {
+        RenderCommandType type = RenderCommandType::Draw;
+        uint32_t index = 0;     // BindPipeline：管线序号；Draw/DrawInstanced：网格序号；SetUniforms/BindTextures：uniform 起始位置
+        uint32_t count = 0;     // SetUniforms/BindTextures：uniform 数；DrawInstanced：实例数
+        uint32_t lod = 0;       // Draw/DrawInstanced：LOD 级别
+    };
+
+    /**
+     * @brief 命令列表引用的管线
+     *
+     * 录制线程只查找后端已有的管线，找到时填入 resolved；找不到时只记录着色器变体和网格，
+     * 由提交线程在执行前创建（需要图形上下文），因此录制过程不修改后端的缓存。
+     */
+    struct RenderPipelineBinding {
+        std::string shaderName;
+        std::map<std::string, bool> defines;
+        std::shared_ptr<Mesh> mesh;
+        std::shared_ptr<void> resolved;  // 后端的管线对象，后端负责解释
+    };
+
+    // 一次绘制对应的一段连续命令，排序以绘制为单位进行
+    struct RenderDrawRecord {
+        uint64_t sortKey = 0;
+        uint32_t firstCommand = 0;
+        uint32_t commandCount = 0;
+    };
+
+    /**
+     * @brief 与图形后端无关的命令列表
+     *
+     * 工作线程各自录制一段（beginDraw/.../endDraw），append 按录制顺序合并到一个列表，
+     * sort 按状态排序键重排绘制，最后由持有图形上下文的线程在一个循环中执行。
+     * 命令只保存序号，资源放在管线、网格和 uniform 表中，便于捕获和回放。
+     */
+    class CommandList {
+    public:
+        using Uniform = std::pair<std::string, UniformValue>;
+
+        uint32_t addPipeline(RenderPipelineBinding binding);
+        uint32_t addMesh(const std::shared_ptr<Mesh>& mesh);
+
+        void beginDraw(uint64_t sortKey);
+        void bindPipeline(uint32_t pipeline);
+        void setUniforms(const std::map<std::string, UniformValue>& uniforms);
+        void bindTextures(const std::map<std::string, UniformValue>& textures);
+        void draw(uint32_t mesh, uint32_t lod);
+        void drawInstanced(uint32_t mesh, uint32_t lod, uint32_t instanceCount);
+        // 取消当前绘制已录制的命令（如管线无效时）
+        void cancelDraw();
+        void endDraw();
+
+        // 把 other 的内容移动到末尾，other 被清空
+        void append(CommandList& other);
+        // 按排序键稳定排序，相同状态的绘制相邻，减少管线切换
+        void sort();
+        // 清空内容，保留容量
+        void clear();
+
+        bool empty() const { return draws_.empty(); }
+        const std::vector<RenderDrawRecord>& getDraws() const { return draws_; }
+        const std::vector<RenderCommand>& getCommands() const { return commands_; }
+        const std::vector<Uniform>& getUniforms() const { return uniforms_; }
+        std::vector<RenderPipelineBinding>& getPipelines() { return pipelines_; }
+        const std::vector<RenderPipelineBinding>& getPipelines() const { return pipelines_; }
+        const std::vector<std::shared_ptr<Mesh>>& getMeshes() const { return meshes_; }
+
+    private:
+        void push(RenderCommandType type, uint32_t index, uint32_t count, uint32_t lod);
+
+        std::vector<RenderDrawRecord> draws_;
+        std::vector<RenderCommand> commands_;
+        std::vector<Uniform> uniforms_;
+        std::vector<RenderPipelineBinding> pipelines_;
+        std::vector<std::shared_ptr<Mesh>> meshes_;
+
+        // 已解析的管线和网格去重，append 时同样适用
+        std::unordered_map<const void*, uint32_t> pipelineIndices_;
+        std::unordered_map<const Mesh*, uint32_t> meshIndices_;
+        bool recording_ = false;
+    };
+}
@@ -1,9 +1,25 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "../core/Enums.h"
+#include "GpuResource.h"
+
 namespace iengine {
+    struct VertexLayout;
+    struct TextureSamplerDesc;
+    
+    // 流式数据在当前帧环形缓冲区中的位置，只在写入的那一帧有效
+    struct StreamBufferRange {
+        bool valid = false;
+        uint64_t frame = 0;
+        size_t baseVertex = 0;
+        size_t firstIndex = 0;
+        size_t indexCount = 0;
+    };
+
     class Context {
     public:
         virtual ~Context() = default;
@@ -12,17 +28,63 @@ namespace iengine {
         virtual void resize(int width, int height) = 0;
         
         // Buffer操作
-        virtual void* createVertexBuffer(size_t size) = 0;
-        virtual void* createIndexBuffer(size_t size) = 0;
-        virtual void deleteBuffer(void* buffer) = 0;
-        virtual void writeBuffer(void* buffer, const void* data, size_t size, size_t offset = 0) = 0;
+        // 删除操作是延迟的：句柄立即失效，底层对象在在途帧结束后才真正销毁
+        virtual BufferHandle createVertexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) = 0;
+        virtual BufferHandle createIndexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) = 0;
+        virtual void deleteBuffer(BufferHandle buffer) = 0;
+        virtual void writeBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset = 0) = 0;
+        
+        // 网格缓冲区子分配：从按顶点布局划分的共享缓冲区池中分配顶点/索引区间并写入数据
+        // 返回分配句柄，0 表示失败或后端不支持（调用方应回退到独立缓冲区）
+        virtual uint32_t allocateMeshBuffers(const VertexLayout& /*layout*/,
+                                             const void* /*vertexData*/, size_t /*vertexCount*/,
+                                             const unsigned int* /*indexData*/, size_t /*indexCount*/) { return 0; }
+        virtual void freeMeshBuffers(uint32_t /*allocation*/) {}
+        
+        // 流式数据：写入当前帧的环形缓冲区，返回 false 表示不支持或本帧空间不足
+        virtual bool writeStreamData(const VertexLayout& /*layout*/,
+                                     const void* /*vertexData*/, size_t /*vertexCount*/,
+                                     const unsigned int* /*indexData*/, size_t /*indexCount*/,
+                                     StreamBufferRange& /*outRange*/) { return false; }
+        
+        // 纹理操作（data 按 format 紧密排列，见 TextureFormat）
+        virtual TextureHandle createTexture(int width, int height, const void* data = nullptr,
+                                            TextureFormat format = TextureFormat::RGBA8) = 0;
+        virtual void deleteTexture(TextureHandle texture) = 0;
+        virtual void writeTexture(TextureHandle texture, const void* data, int width, int height) = 0;
+        // 写入第 level 级 Mip（从第 1 级起按顺序写入），data 按纹理格式紧密排列
+        virtual void writeTextureLevel(TextureHandle /*texture*/, int /*level*/, const void* /*data*/, int /*width*/, int /*height*/) {}
+        // 由 GPU 生成完整 Mip 链，用于没有 CPU Mip 数据的纹理
+        virtual void generateMipmaps(TextureHandle /*texture*/) {}
+        virtual void setTextureSampler(TextureHandle /*texture*/, const TextureSamplerDesc& /*sampler*/) {}
+        // 纹理数组：各层尺寸、格式和 Mip 级数相同，内容未初始化
+        virtual TextureHandle createTextureArray(int /*width*/, int /*height*/, int /*layers*/, int /*levels*/,
+                                                 TextureFormat /*format*/) { return TextureHandle{}; }
+        // 写入第 layer 层第 level 级中以 (x, y) 为起点的区域，data 按数组格式紧密排列
+        virtual void writeTextureArrayRegion(TextureHandle /*texture*/, int /*level*/, int /*layer*/, int /*x*/, int /*y*/,
+                                             int /*width*/, int /*height*/, const void* /*data*/) {}
+        // 写入 2D 纹理第 0 级中以 (x, y) 为起点的区域（不支持块压缩格式），data 按纹理格式紧密排列
+        virtual void writeTextureRegion(TextureHandle /*texture*/, int /*x*/, int /*y*/, int /*width*/, int /*height*/,
+                                        const void* /*data*/) {}
+        // 同上，像素来自像素上传缓冲区中 offset 处，GPU 异步读取，调用方用 fence 确认读取完成后再改写
+        virtual void writeTextureRegionFromBuffer(TextureHandle /*texture*/, int /*x*/, int /*y*/, int /*width*/, int /*height*/,
+                                                  BufferHandle /*buffer*/, size_t /*offset*/) {}
+        // 像素上传缓冲区：持久映射，outMapped 可在任意线程写入；不支持持久映射时返回无效句柄
+        virtual BufferHandle createPixelUploadBuffer(size_t /*size*/, void** outMapped) {
+            if (outMapped) *outMapped = nullptr;
+            return BufferHandle{};
+        }
+        // GPU 同步点：createFence 在命令流中插入 fence，isFenceSignaled 只查询不等待
+        virtual void* createFence() { return nullptr; }
+        virtual bool isFenceSignaled(void* /*fence*/) { return true; }
+        virtual void deleteFence(void* /*fence*/) {}
+        // 是否能直接上传该格式；不支持的块压缩格式由上下文解压后上传
+        virtual bool supportsTextureFormat(TextureFormat /*format*/) const { return true; }
         
-        // 纹理操作
-        virtual void* createTexture(int width, int height, const void* data = nullptr) = 0;
-        virtual void deleteTexture(void* texture) = 0;
-        virtual void writeTexture(void* texture, const void* data, int width, int height) = 0;
+        // 按类型统计的 GPU 资源数量和显存占用
+        virtual GpuResourceStats getResourceStats() const { return GpuResourceStats{}; }
         
-        // 绘制操作
-        virtual void draw(std::shared_ptr<class Mesh> mesh) = 0;
+        // 绘制操作（lodLevel 为使用的 LOD 级别，0 为原始网格）
+        virtual void draw(std::shared_ptr<class Mesh> mesh, size_t lodLevel = 0) = 0;
     };
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../core/Enums.h"
+
+namespace iengine {
+    /**
+     * @brief 类型化的 GPU 资源句柄
+     *
+     * 句柄只是槽位表中的 (index, generation)，由后端解析为真正的 API 对象。
+     * 资源销毁后旧句柄自动失效，不同类型的句柄之间不能互相传递。
+     */
+    template <typename Tag>
+    struct GpuHandle {
+        uint32_t index = 0;
+        uint32_t generation = 0;  // 0 表示空句柄
+
+        bool isValid() const { return generation != 0; }
+        explicit operator bool() const { return isValid(); }
+
+        bool operator==(const GpuHandle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const GpuHandle& other) const { return !(*this == other); }
+    };
+
+    // 缓冲区的用途，创建时确定，写入时无需再猜测绑定目标
+    enum class BufferTarget {
+        Vertex,
+        Index,
+        PixelUnpack
+    };
+
+    struct BufferHandleTag {};
+    struct TextureHandleTag {};
+    struct ProgramHandleTag {};
+
+    struct BufferHandle : GpuHandle<BufferHandleTag> {
+        BufferTarget target = BufferTarget::Vertex;
+        BufferUsage usage = BufferUsage::Static;
+    };
+    using TextureHandle = GpuHandle<TextureHandleTag>;
+    using ProgramHandle = GpuHandle<ProgramHandleTag>;
+
+    // 单类资源的统计
+    struct GpuResourceTypeStats {
+        size_t count = 0;          // 存活的对象数
+        size_t bytes = 0;          // 存活对象占用的显存（估算）
+        size_t pendingCount = 0;   // 已释放、等待在途帧结束后删除的对象数
+        size_t pendingBytes = 0;
+    };
+
+    struct GpuResourceStats {
+        GpuResourceTypeStats buffers;
+        GpuResourceTypeStats textures;
+        GpuResourceTypeStats programs;
+        uint64_t frame = 0;
+
+        size_t getTotalBytes() const {
+            return buffers.bytes + buffers.pendingBytes + textures.bytes + textures.pendingBytes +
+                   programs.bytes + programs.pendingBytes;
+        }
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "../math/Matrix4.h"
+#include "../math/Vector3.h"
+#include "../scenes/SceneComponents.h"
+
+namespace iengine {
+    class Scene;
+    class Camera;
+    class Mesh;
+    class Material;
+    class Light;
+    class RenderResourceTable;
+
+    struct RenderSnapshotStats {
+        size_t components = 0;          // 场景中可渲染的实体数（包括 Model 和 createEntity 创建的实体）
+        size_t visible = 0;             // 通过视锥体剔除、进入快照的绘制项数
+        size_t materials = 0;           // 本帧复制的材质数（首次出现或参数改变过的材质）
+        size_t resourceUpdates = 0;     // 本帧携带的网格和材质表更新数
+        size_t lights = 0;
+        double buildMilliseconds = 0.0; // 构建快照耗时
+    };
+
+    // 一个可见实体的绘制数据；网格和材质是场景资源句柄，渲染时通过 RenderResourceTable 查找
+    struct RenderDrawItem {
+        Matrix4 transform;
+        Vector3 center;                 // 世界包围球，半径小于 0 表示没有几何
+        float radius = -1.0f;
+        SceneResourceHandle mesh = 0;
+        SceneResourceHandle material = 0;
+        uint32_t lod = 0;               // 构建时选择的 LOD 级别
+    };
+
+    // 资源表的一条更新，resource 为空表示句柄已释放
+    template <typename T>
+    struct RenderResourceUpdate {
+        SceneResourceHandle handle = 0;
+        std::shared_ptr<T> resource;
+    };
+
+    /**
+     * @brief 一帧的渲染数据，由主线程构建后交给渲染线程，渲染期间不再修改
+     *
+     * 相机和灯光是构建时的副本，可见实体是只含句柄、变换和 LOD 级别的绘制项。
+     * 网格和材质不随每帧复制：快照只携带自上一个快照以来变化的资源表条目（参数改变过的材质为副本），
+     * 渲染前按顺序应用到构建器的 RenderResourceTable。网格和纹理与场景共享，
+     * 对它们的修改需要通过渲染命令（commands）在渲染线程上执行。
+     */
+    class RenderSnapshot {
+    public:
+        uint64_t frame = 0;
+        float interpolationAlpha = 0.0f; // 固定步长模拟的插值比例，见 Engine::getInterpolationAlpha
+        std::shared_ptr<Camera> camera;
+        std::vector<RenderDrawItem> items;
+        std::vector<std::shared_ptr<Light>> lights;
+        std::vector<RenderResourceUpdate<Mesh>> meshUpdates;
+        std::vector<RenderResourceUpdate<Material>> materialUpdates;
+        // 绘制项的句柄在这张表中查找，同一构建器的快照共享
+        std::shared_ptr<RenderResourceTable> resources;
+        // 渲染本帧前在渲染线程上按顺序执行
+        std::vector<std::function<void()>> commands;
+        RenderSnapshotStats stats;
+
+        void clear();
+    };
+
+    /**
+     * @brief 渲染一侧的网格和材质表，按场景资源句柄索引
+     *
+     * 只在渲染快照的线程上修改和读取。快照按提交顺序渲染，应用某个快照的更新后，
+     * 表的内容与该快照构建时的场景一致。
+     */
+    class RenderResourceTable {
+    public:
+        // 应用快照携带的更新，对同一快照重复调用没有影响
+        void apply(const RenderSnapshot& snapshot);
+
+        const std::shared_ptr<Mesh>& getMesh(SceneResourceHandle handle) const;
+        const std::shared_ptr<Material>& getMaterial(SceneResourceHandle handle) const;
+
+    private:
+        std::vector<std::shared_ptr<Mesh>> meshes_;
+        std::vector<std::shared_ptr<Material>> materials_;
+    };
+
+    struct RenderSnapshotOptions {
+        bool frustumCulling = true;     // 构建时剔除视锥体外的组件，不可见的组件不进入快照
+        // 复制相机、灯光和改变过的材质；在渲染线程上使用快照时需要，同一线程上立即渲染时可以直接共享
+        bool copySceneState = true;
+    };
+
+    /**
+     * @brief 在主线程上从场景构建渲染快照
+     *
+     * 剔除由 Scene::cull 在实体存储上按列完成，只为可见的实体生成绘制项，LOD 也在这里选择，
+     * 选择结果保存在实体的 LodComponent 中供下一帧的切换迟滞使用。
+     * 构建器记录已发送给资源表的网格和材质（及材质参数版本），只有新出现、被替换、释放或参数改变的条目进入快照；
+     * 不支持复制的材质（clone 返回空）直接共享原对象，调用方需保证渲染期间不修改它。
+     */
+    class RenderSnapshotBuilder {
+    public:
+        explicit RenderSnapshotBuilder(const RenderSnapshotOptions& options = RenderSnapshotOptions());
+
+        // 场景没有活动相机时返回 false，此时快照为空
+        bool build(Scene& scene, uint64_t frame, RenderSnapshot& snapshot);
+
+        const RenderSnapshotOptions& getOptions() const { return options_; }
+        void setOptions(const RenderSnapshotOptions& options);
+
+        // 选择 LOD 使用的视口高度（像素），为 0 时全部使用最精细的级别
+        void setViewportHeight(float height) { viewportHeight_ = height; }
+        float getViewportHeight() const { return viewportHeight_; }
+
+    private:
+        // 已发送给资源表的条目；pointer 只用于比较，source 未过期时说明仍是同一个对象
+        struct SentResource {
+            const void* pointer = nullptr;
+            std::weak_ptr<void> source;
+            uint64_t version = 0;
+        };
+
+        void syncResources(const Scene& scene, RenderSnapshot& snapshot);
+
+        RenderSnapshotOptions options_;
+        float viewportHeight_ = 0.0f;
+        std::shared_ptr<RenderResourceTable> resources_;
+        std::vector<SentResource> sentMeshes_;
+        std::vector<SentResource> sentMaterials_;
+    };
+}
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <iostream>
 #include <memory>
 
 // 前向声明
 namespace iengine {
     class Scene;
     class Context;
+    class RenderSnapshot;
     
     enum class RendererType {
         OpenGL,
@@ -19,6 +21,13 @@ namespace iengine {
         virtual bool initialize(std::shared_ptr<Context> context) = 0;
         virtual void cleanup() = 0;
         virtual void render(std::shared_ptr<Scene> scene) = 0;
+        // 渲染主线程构建的快照（渲染线程模式），不访问场景
+        virtual void renderSnapshot(const RenderSnapshot& snapshot) {
+            (void)snapshot;
+            std::cerr << "Renderer: snapshot rendering not supported" << std::endl;
+        }
+        // 上一帧之后仍有需要继续出帧才能完成的工作（分帧上传、异步回读等），按需渲染时据此决定是否重绘
+        virtual bool hasPendingWork() const { return false; }
         virtual void resize(int width, int height) = 0;
         virtual void clear() = 0;
 		virtual bool isInitialized() const noexcept = 0;
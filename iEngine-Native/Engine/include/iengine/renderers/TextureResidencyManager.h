@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace iengine {
+    class Context;
+    class Texture;
+    class TextureLoader;
+
+    struct TextureResidencyOptions {
+        size_t budgetBytes = 256 * 1024 * 1024;  // 2D 纹理显存预算
+        int maxDroppedMips = 2;                  // 每张纹理最多丢弃的顶层 Mip 数
+        int minMipSize = 64;                     // 丢弃后的宽高不小于该值
+        uint64_t minIdleFrames = 2;              // 至少这么多帧未使用才整体驱逐，正在使用的纹理只丢 Mip
+        float restoreThreshold = 0.85f;          // 占用低于预算的该比例时逐步恢复丢弃的 Mip
+        size_t maxRestoresPerFrame = 1;          // 每帧最多恢复的纹理数，避免恢复时集中上传
+        bool releaseCpuData = false;             // 驱逐时释放 CPU 副本（需有源文件），再次使用时重新加载
+    };
+
+    struct TextureResidencyStats {
+        size_t budgetBytes = 0;
+        size_t residentBytes = 0;
+        float pressure = 0.0f;          // residentBytes / budgetBytes
+        size_t trackedTextures = 0;
+        size_t residentTextures = 0;
+        size_t droppedMipLevels = 0;    // 当前所有纹理丢弃的 Mip 级数之和
+        uint64_t evictions = 0;         // 以下为累计次数
+        uint64_t mipDrops = 0;
+        uint64_t mipRestores = 0;
+        uint64_t reloads = 0;
+        uint64_t framesOverBudget = 0;  // 驱逐后仍超出预算的帧数
+    };
+
+    /**
+     * @brief 2D 纹理的显存预算和 LRU 驻留管理
+     *
+     * 渲染器每帧对本帧引用的纹理调用 track()，再调用 update()。纹理最近使用的帧在 OpenGLUniforms
+     * 绑定时记录。超出预算时按最近使用帧从旧到新先逐级丢弃顶层 Mip，仍超出时整体驱逐空闲的纹理；
+     * 被驱逐的纹理在再次使用时由上传调度器从 CPU 副本重新上传，CPU 副本也已释放时从源文件重新加载
+     * （设置了 TextureLoader 时异步加载）。占用回落到 restoreThreshold 以下时按最近使用顺序恢复 Mip。
+     * 纹理数组中的贴图由 TextureArrayAllocator 管理，不在此统计。
+     */
+    class TextureResidencyManager {
+    public:
+        explicit TextureResidencyManager(const TextureResidencyOptions& options = TextureResidencyOptions{});
+
+        void track(const std::shared_ptr<Texture>& texture);
+        // 每帧调用，frame 为上下文的当前帧序号
+        void update(const std::shared_ptr<Context>& context, uint64_t frame);
+
+        // 异步重新加载使用的加载器，为空时同步加载
+        void setTextureLoader(TextureLoader* loader) { loader_ = loader; }
+
+        void setOptions(const TextureResidencyOptions& options) { options_ = options; }
+        const TextureResidencyOptions& getOptions() const { return options_; }
+        void setBudget(size_t budgetBytes) { options_.budgetBytes = budgetBytes; }
+
+        const TextureResidencyStats& getStats() const { return stats_; }
+        void printStats() const;
+
+    private:
+        struct Entry {
+            std::weak_ptr<Texture> texture;
+            int reloadDroppedMips = -1;  // 重新加载完成后恢复的丢弃 Mip 数，-1 表示没有进行中的加载
+        };
+
+        TextureResidencyOptions options_;
+        TextureResidencyStats stats_;
+        std::unordered_map<const Texture*, Entry> entries_;
+        TextureLoader* loader_ = nullptr;
+
+        bool canDropMip(const Texture& texture) const;
+        void reload(const std::shared_ptr<Texture>& texture, Entry& entry);
+    };
+}
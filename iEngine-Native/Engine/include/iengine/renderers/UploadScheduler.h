@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace iengine {
+    class Context;
+    class Mesh;
+    class Texture;
+
+    // 每帧上传预算
+    struct UploadBudget {
+        size_t maxBytesPerFrame = 8 * 1024 * 1024;  // 每帧最多上传的字节数
+        double maxMillisecondsPerFrame = 4.0;       // 每帧最多花在上传上的时间
+        size_t minUploadsPerFrame = 1;              // 无论预算如何每帧至少上传的数量，保证超大资源也能推进
+    };
+
+    struct UploadSchedulerStats {
+        size_t queueDepth = 0;          // 等待上传的资源数
+        size_t queuedBytes = 0;
+        size_t uploadsThisFrame = 0;
+        size_t bytesThisFrame = 0;
+        double millisecondsThisFrame = 0.0;
+        size_t totalUploads = 0;
+        size_t totalBytes = 0;
+        double averageLatencyMs = 0.0;  // 从首次请求到上传完成的平均时间
+        double maxLatencyMs = 0.0;
+        double averageLatencyFrames = 0.0;
+    };
+
+    /**
+     * @brief 按帧预算执行的网格/纹理上传调度器
+     *
+     * 渲染器每帧为尚未驻留的资源调用 request() 并给出优先级，然后调用 process()，
+     * 调度器按优先级从高到低上传，直到本帧的字节或时间预算用完。
+     * 本帧没有再被请求的资源（例如已移出场景）会从队列中移除。
+     * 优先级由调用方决定，通常可见对象高于不可见对象，屏幕上越大越优先。
+     */
+    class UploadScheduler {
+    public:
+        explicit UploadScheduler(const UploadBudget& budget = UploadBudget{});
+
+        void request(const std::shared_ptr<Mesh>& mesh, float priority);
+        void request(const std::shared_ptr<Texture>& texture, float priority);
+
+        // 在预算内执行上传，返回本帧上传的资源数
+        size_t process(const std::shared_ptr<Context>& context);
+        // 忽略预算，上传队列中的全部资源
+        size_t flush(const std::shared_ptr<Context>& context);
+
+        bool isPending(const void* resource) const { return requests_.count(resource) > 0; }
+        size_t getPendingCount() const { return requests_.size(); }
+
+        void setBudget(const UploadBudget& budget) { budget_ = budget; }
+        const UploadBudget& getBudget() const { return budget_; }
+
+        const UploadSchedulerStats& getStats() const { return stats_; }
+        void printStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request {
+            std::weak_ptr<Mesh> mesh;
+            std::weak_ptr<Texture> texture;
+            size_t bytes = 0;
+            float priority = 0.0f;
+            uint64_t lastRequestFrame = 0;
+            uint64_t enqueueFrame = 0;
+            Clock::time_point enqueueTime;
+        };
+
+        Request& touch(const void* key, float priority);
+        size_t run(const std::shared_ptr<Context>& context, bool ignoreBudget);
+
+        UploadBudget budget_;
+        std::unordered_map<const void*, Request> requests_;
+        uint64_t frame_ = 0;
+
+        UploadSchedulerStats stats_;
+        double totalLatencyMs_ = 0.0;
+        double totalLatencyFrames_ = 0.0;
+    };
+}
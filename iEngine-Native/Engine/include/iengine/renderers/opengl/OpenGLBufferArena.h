@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../BufferRangeAllocator.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace iengine {
+    struct VertexLayout;
+
+    struct BufferArenaOptions {
+        size_t vertexPageBytes = 4 * 1024 * 1024;   // 每个池页的顶点缓冲区大小
+        size_t indexPageBytes = 2 * 1024 * 1024;    // 每个池页的索引缓冲区大小
+        float defragmentThreshold = 0.5f;           // 碎片率超过该值时整理
+        float defragmentMinFreeRatio = 0.25f;       // 空闲空间占比不足时不值得整理
+        size_t maxDefragmentPagesPerFrame = 1;      // 每帧最多整理的池页数，避免卡顿
+    };
+
+    // 单个顶点布局池的统计
+    struct BufferPoolStats {
+        std::string layoutKey;
+        size_t pageCount = 0;
+        size_t allocationCount = 0;
+        size_t vertexBytesCapacity = 0;
+        size_t vertexBytesUsed = 0;
+        size_t indexBytesCapacity = 0;
+        size_t indexBytesUsed = 0;
+        float fragmentation = 0.0f;  // 池内各页碎片率按空闲量加权
+    };
+
+    struct BufferArenaStats {
+        size_t pageCount = 0;
+        size_t allocationCount = 0;
+        size_t vertexBytesCapacity = 0;
+        size_t vertexBytesUsed = 0;
+        size_t indexBytesCapacity = 0;
+        size_t indexBytesUsed = 0;
+        float fragmentation = 0.0f;
+        size_t defragmentCount = 0;     // 累计整理次数
+        size_t defragmentBytesMoved = 0;
+        std::vector<BufferPoolStats> pools;
+
+        float getOccupancy() const {
+            size_t capacity = vertexBytesCapacity + indexBytesCapacity;
+            return capacity ? static_cast<float>(vertexBytesUsed + indexBytesUsed) / capacity : 0.0f;
+        }
+    };
+
+    /**
+     * @brief OpenGL 网格缓冲区池
+     *
+     * 按顶点布局分池，每个池由若干固定大小的页组成，每页包含一个大 VBO 和一个大 IBO。
+     * 网格只占用页内的一段顶点区间和索引区间，绘制时通过 baseVertex / firstIndex 定位，
+     * 因此同一页内的所有网格可以共用同一个 VAO。页一旦创建不会移动或重建，
+     * 碎片整理只在页内搬移数据并更新分配记录，已建立的 VAO 保持有效。
+     */
+    class OpenGLBufferArena {
+    public:
+        struct Page {
+            unsigned int vbo = 0;
+            unsigned int ibo = 0;
+            size_t stride = 0;
+            std::string layoutKey;
+            BufferRangeAllocator vertices;  // 以顶点为单位
+            BufferRangeAllocator indices;   // 以索引为单位
+            size_t allocationCount = 0;
+        };
+
+        struct Allocation {
+            Page* page = nullptr;
+            size_t baseVertex = 0;
+            size_t vertexCount = 0;
+            size_t firstIndex = 0;
+            size_t indexCount = 0;
+        };
+
+        explicit OpenGLBufferArena(const BufferArenaOptions& options = BufferArenaOptions{});
+        ~OpenGLBufferArena();
+
+        OpenGLBufferArena(const OpenGLBufferArena&) = delete;
+        OpenGLBufferArena& operator=(const OpenGLBufferArena&) = delete;
+
+        /**
+         * @brief 分配并写入一个网格的顶点与索引数据
+         * @return 分配句柄，0 表示失败
+         */
+        uint32_t allocate(const VertexLayout& layout,
+                          const void* vertexData, size_t vertexCount,
+                          const unsigned int* indexData, size_t indexCount);
+        void free(uint32_t handle);
+
+        // 查询分配记录（碎片整理后偏移会变化，绘制时应每次查询）
+        const Allocation* getAllocation(uint32_t handle) const;
+
+        // 整理碎片率超过阈值的页，返回本次搬移的字节数
+        size_t defragment(bool force = false);
+
+        BufferArenaStats getStats() const;
+        void printStats() const;
+
+        void cleanup();
+
+        static std::string makeLayoutKey(const VertexLayout& layout);
+
+    private:
+        Page* createPage(const std::string& layoutKey, size_t stride, size_t minVertices, size_t minIndices);
+        bool tryAllocateInPage(Page& page, size_t vertexCount, size_t indexCount, Allocation& out);
+        size_t defragmentPage(Page& page);
+        bool shouldDefragment(const BufferRangeAllocator& allocator) const;
+
+        BufferArenaOptions options_;
+        std::map<std::string, std::vector<std::unique_ptr<Page>>> pools_;
+
+        // 分配记录，句柄为下标 + 1
+        std::vector<Allocation> allocations_;
+        std::vector<uint32_t> freeHandles_;
+
+        size_t defragmentCount_ = 0;
+        size_t defragmentBytesMoved_ = 0;
+    };
+}
@@ -1,8 +1,19 @@
 #pragma once
 
 #include "../Context.h"
+#include "OpenGLBufferArena.h"
+#include "OpenGLStreamBuffer.h"
+#include "OpenGLResourceRegistry.h"
+#include "OpenGLTextureBindings.h"
+#include "OpenGLReadback.h"
+#include "OpenGLRenderTarget.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace iengine {
     // 前向声明
@@ -15,6 +26,8 @@ namespace iengine {
         bool useOpenGL41 = false;
         bool useOpenGL43 = false;
         bool useOpenGL45 = true;
+        // 关闭后块压缩纹理总是在 CPU 上解压后以未压缩格式上传
+        bool compressedTextures = true;
     };
     
     class OpenGLContext : public Context {
@@ -26,19 +39,83 @@ namespace iengine {
         void clear() override;
         void resize(int width, int height) override;
         
-        // Buffer操作
-        void* createVertexBuffer(size_t size) override;
-        void* createIndexBuffer(size_t size) override;
-        void deleteBuffer(void* buffer) override;
-        void writeBuffer(void* buffer, const void* data, size_t size, size_t offset = 0) override;
+        // Buffer操作；deleteBuffer、freeMeshBuffers 和 deleteTexture 可以在任意线程调用，
+        // 不在渲染线程（最近调用 beginFrame 的线程）上时推迟到渲染线程的 endFrame 执行
+        BufferHandle createVertexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) override;
+        BufferHandle createIndexBuffer(size_t size, BufferUsage usage = BufferUsage::Static) override;
+        void deleteBuffer(BufferHandle buffer) override;
+        void writeBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset = 0) override;
+        
+        // 网格缓冲区池
+        uint32_t allocateMeshBuffers(const VertexLayout& layout,
+                                     const void* vertexData, size_t vertexCount,
+                                     const unsigned int* indexData, size_t indexCount) override;
+        void freeMeshBuffers(uint32_t allocation) override;
+        OpenGLBufferArena* getBufferArena() const { return bufferArena_.get(); }
+        
+        // 流式环形缓冲区（首次写入时创建）
+        bool writeStreamData(const VertexLayout& layout,
+                             const void* vertexData, size_t vertexCount,
+                             const unsigned int* indexData, size_t indexCount,
+                             StreamBufferRange& outRange) override;
+        OpenGLStreamBuffer* getStreamBuffer() const { return streamBuffer_.get(); }
+        bool isStreamRangeCurrent(const StreamBufferRange& range) const;
+        
+        // 帧边界，用于推进流式环形缓冲区
+        void beginFrame();
+        void endFrame();
+        // 当前帧序号（每次 beginFrame 递增），用于记录纹理最近使用的帧
+        uint64_t getFrameIndex() const { return frameIndex_; }
+        
+        // 异步回读：读取默认帧缓冲或 FBO 颜色附件的区域，不阻塞，几帧后在 endFrame 中兑现 future
+        std::future<ReadbackResult> readPixelsAsync(const ReadbackRequest& request = ReadbackRequest());
+        // 连续采集：按目标帧率把帧交给回调或写入文件
+        bool startFrameCapture(const FrameCaptureOptions& options);
+        void stopFrameCapture();
+        OpenGLReadbackQueue* getReadbackQueue() const { return readbacks_.get(); }
+        
+        // 离屏渲染目标：从池中取用，bindRenderTarget 切换绘制目标并设置视口，nullptr 为默认帧缓冲
+        OpenGLRenderTargetPool* getRenderTargetPool() const { return renderTargets_.get(); }
+        void bindRenderTarget(OpenGLRenderTarget* target);
+        unsigned int getBoundFramebuffer() const { return boundFramebuffer_; }
+        // 由 OpenGLRenderTarget 在删除帧缓冲前调用
+        void onFramebufferDeleted(unsigned int framebuffer);
         
         // 纹理操作
-        void* createTexture(int width, int height, const void* data = nullptr) override;
-        void deleteTexture(void* texture) override;
-        void writeTexture(void* texture, const void* data, int width, int height) override;
+        TextureHandle createTexture(int width, int height, const void* data = nullptr,
+                                    TextureFormat format = TextureFormat::RGBA8) override;
+        void deleteTexture(TextureHandle texture) override;
+        void writeTexture(TextureHandle texture, const void* data, int width, int height) override;
+        void writeTextureLevel(TextureHandle texture, int level, const void* data, int width, int height) override;
+        void generateMipmaps(TextureHandle texture) override;
+        void setTextureSampler(TextureHandle texture, const TextureSamplerDesc& sampler) override;
+        bool supportsTextureFormat(TextureFormat format) const override;
+        void writeTextureRegion(TextureHandle texture, int x, int y, int width, int height, const void* data) override;
+        void writeTextureRegionFromBuffer(TextureHandle texture, int x, int y, int width, int height,
+                                          BufferHandle buffer, size_t offset) override;
+        BufferHandle createPixelUploadBuffer(size_t size, void** outMapped) override;
+        void* createFence() override;
+        bool isFenceSignaled(void* fence) override;
+        void deleteFence(void* fence) override;
+        TextureHandle createTextureArray(int width, int height, int layers, int levels, TextureFormat format) override;
+        void writeTextureArrayRegion(TextureHandle texture, int level, int layer, int x, int y,
+                                     int width, int height, const void* data) override;
+        // 纹理尚未驻留时绑定的占位纹理（init 之后可用）
+        TextureHandle getPlaceholderTexture() const { return placeholderTexture_; }
+        
+        // 资源统计（包含缓冲区池和流式环形缓冲区）
+        GpuResourceStats getResourceStats() const override;
+        void printResourceStats() const;
+        
+        // 句柄解析为 GL 对象名，句柄失效时返回 0
+        unsigned int getBufferId(BufferHandle buffer) const;
+        unsigned int getTextureId(TextureHandle texture) const;
+        unsigned int getProgramId(ProgramHandle program) const;
         
         // 绘制操作
-        void draw(std::shared_ptr<class Mesh> mesh) override;
+        void draw(std::shared_ptr<class Mesh> mesh, size_t lodLevel = 0) override;
+        // 实例化绘制，instanceCount 为 1 时与 draw 相同；实例数据由着色器按 gl_InstanceID 获取
+        void drawInstanced(const std::shared_ptr<class Mesh>& mesh, size_t lodLevel, size_t instanceCount);
         void draw(std::shared_ptr<Renderable> renderable);
         
         void* getDevice() const { return device_; }
@@ -55,9 +132,9 @@ namespace iengine {
         void deleteVAO(unsigned int vao);
         
         // 着色器操作
-        unsigned int createProgram(const std::string& vertexSource, const std::string& fragmentSource);
+        ProgramHandle createProgram(const std::string& vertexSource, const std::string& fragmentSource);
         void useProgram(unsigned int program);
-        void deleteProgram(unsigned int program);
+        void deleteProgram(ProgramHandle program);
         
         // Uniform操作
         int getUniformLocation(unsigned int program, const std::string& name);
@@ -69,7 +146,14 @@ namespace iengine {
         
         // 纹理操作（新增）
         void activeTexture(int unit);  // 激活纹理单元
-        void bindTexture(void* texture);  // 绑定纹理
+        void bindTexture(TextureHandle texture);  // 绑定纹理
+        // 把纹理绑定到指定单元并绑定对应的采样器对象（sampler 为空时使用纹理自身的采样参数），
+        // 单元已绑定同一纹理时跳过
+        void bindTextureUnit(int unit, TextureHandle texture, const TextureSamplerDesc* sampler = nullptr);
+        int getTextureUnitCount() const { return textureBindings_ ? textureBindings_->getUnitCount() : 0; }
+        const TextureBindingStats& getTextureBindingStats() const { return textureBindings_->getStats(); }
+        // 设置指定程序的 uniform，不改变当前使用的程序（链接时设置采样器单元）
+        void setProgramUniform1i(unsigned int program, int location, int value);
         
         // 新增：动态uniform查询（参考Web版本）
         int getUniformCount(unsigned int program);
@@ -100,6 +184,41 @@ namespace iengine {
         
         // VAO支持
         bool vaoSupported_ = false;
+        unsigned int boundVAO_ = 0;  // 当前绑定的 VAO，用于跳过重复绑定
+        
+        // 网格缓冲区池（init 之后可用）
+        std::unique_ptr<OpenGLBufferArena> bufferArena_;
+        std::unique_ptr<OpenGLStreamBuffer> streamBuffer_;
+        
+        // 独立缓冲区、纹理和着色器程序的句柄登记表，负责延迟删除
+        std::unique_ptr<OpenGLResourceRegistry> resources_;
+        std::unique_ptr<OpenGLTextureBindings> textureBindings_;
+        std::unique_ptr<OpenGLReadbackQueue> readbacks_;
+        std::unique_ptr<OpenGLRenderTargetPool> renderTargets_;
+        unsigned int boundFramebuffer_ = 0;
+        TextureHandle placeholderTexture_;
+        uint64_t frameIndex_ = 0;
+        
+        // 其他线程释放的资源，登记表和缓冲区池没有加锁，只能在渲染线程上修改
+        std::atomic<std::thread::id> renderThreadId_;
+        std::mutex deferredReleasesMutex_;
+        std::vector<std::function<void()>> deferredReleases_;
+        // 不在渲染线程上时把 release 放入队列并返回 true
+        bool deferRelease(std::function<void()> release);
+        void runDeferredReleases();
+        
+        BufferHandle createBuffer(size_t size, BufferTarget target, BufferUsage usage);
+        
+        // 块压缩格式支持（init 时按版本和扩展检测）
+        bool s3tcSupported_ = false;      // BC1/BC3
+        bool s3tcSrgbSupported_ = false;  // BC1/BC3 sRGB
+        bool rgtcSupported_ = false;      // BC4/BC5
+        bool bptcSupported_ = false;      // BC7
+        void detectCompressedFormats();
+        // 纹理在显存中的实际格式（不支持的压缩格式为解压后的格式）
+        TextureFormat getStorageFormat(TextureFormat format) const;
+        // 写入一个 Mip 级别；驱动不支持的压缩格式在 CPU 上解压后上传
+        void uploadTextureLevel(TextureFormat format, int level, int width, int height, const void* data, bool update);
         
         // 最大纹理单元数
         int maxTextureUnits_ = 0;
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../../core/Enums.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace iengine {
+    class ThreadPool;
+
+    struct ReadbackRequest {
+        unsigned int framebuffer = 0;  // GL 帧缓冲对象名，0 为默认帧缓冲
+        int colorAttachment = 0;       // FBO 的颜色附件序号
+        int x = 0;
+        int y = 0;
+        int width = 0;                 // 为 0 时读到默认帧缓冲的右/上边缘，读取 FBO 时必须指定
+        int height = 0;
+        TextureFormat format = TextureFormat::RGBA8;  // 不支持块压缩格式
+        bool flipY = true;             // 结果按从上到下的行序排列（GL 原点在左下角）
+    };
+
+    struct ReadbackResult {
+        bool success = false;
+        int width = 0;
+        int height = 0;
+        TextureFormat format = TextureFormat::RGBA8;
+        uint64_t frame = 0;            // 发起读取的帧
+        std::vector<uint8_t> data;     // 按 format 紧密排列
+    };
+
+    struct FrameCaptureOptions {
+        double framesPerSecond = 30.0;  // 目标采集帧率，0 表示每帧都采集
+        ReadbackRequest region;         // 采集的帧缓冲和区域
+        std::string filePath;           // 非空时把原始帧依次追加写入该文件（无文件头的 rawvideo）
+        std::function<void(const ReadbackResult&)> callback;  // 在渲染线程上调用
+        size_t maxPendingFrames = 4;    // 未完成的采集达到该数时跳过本次，不等待 GPU
+    };
+
+    struct ReadbackStats {
+        size_t pending = 0;             // 尚未完成的读取
+        size_t pooledBuffers = 0;       // 空闲的 PBO
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        uint64_t capturedFrames = 0;
+        uint64_t skippedCaptures = 0;   // 因未完成的读取过多而跳过的采集
+        uint64_t bytesRead = 0;
+        double averageLatencyFrames = 0.0;  // 从发起到完成的平均帧数
+    };
+
+    /**
+     * @brief 经由 PBO 的异步帧缓冲回读
+     *
+     * submit() 把区域 glReadPixels 到 GL_PIXEL_PACK_BUFFER 并插入 fence，立即返回 future；
+     * 每帧 poll() 以零超时查询 fence，完成后映射 PBO 拷出数据并兑现 future，PBO 回到池中复用。
+     * 稳态下 CPU 从不等待 GPU，结果通常在一到几帧后可用。
+     * 连续采集模式在帧末按目标帧率发起读取，结果交给回调，或由后台线程写入文件。
+     */
+    class OpenGLReadbackQueue {
+    public:
+        OpenGLReadbackQueue();
+        ~OpenGLReadbackQueue();
+
+        OpenGLReadbackQueue(const OpenGLReadbackQueue&) = delete;
+        OpenGLReadbackQueue& operator=(const OpenGLReadbackQueue&) = delete;
+
+        // defaultWidth/defaultHeight 为默认帧缓冲的尺寸，frame 为当前帧序号
+        std::future<ReadbackResult> submit(const ReadbackRequest& request, int defaultWidth, int defaultHeight,
+                                           uint64_t frame);
+        // 收取已完成的读取，每帧调用
+        void poll(uint64_t frame);
+
+        bool startCapture(const FrameCaptureOptions& options);
+        void stopCapture();
+        bool isCapturing() const { return capturing_; }
+        // 有未完成的读取或正在连续采集时为 true，此时需要继续出帧才能收取结果
+        bool hasPendingWork() const { return capturing_ || !pending_.empty(); }
+        // 帧末调用：到达采集间隔时发起一次读取
+        void captureFrame(int defaultWidth, int defaultHeight, uint64_t frame);
+
+        const ReadbackStats& getStats() const { return stats_; }
+        void printStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Pending {
+            std::promise<ReadbackResult> promise;
+            ReadbackResult result;      // 尺寸、格式和帧序号，数据在完成时填入
+            unsigned int buffer = 0;
+            size_t size = 0;            // 读取的字节数
+            size_t capacity = 0;        // PBO 的容量
+            void* fence = nullptr;
+            bool flipY = true;
+            bool capture = false;
+        };
+
+        struct PooledBuffer {
+            unsigned int buffer = 0;
+            size_t size = 0;
+        };
+
+        bool issue(Pending& pending, const ReadbackRequest& request, int defaultWidth, int defaultHeight);
+        unsigned int acquireBuffer(size_t size, size_t& outCapacity);
+        void releaseBuffer(unsigned int buffer, size_t size);
+        void deliverCapture(ReadbackResult result);
+
+        std::deque<Pending> pending_;
+        std::vector<PooledBuffer> buffers_;
+        ReadbackStats stats_;
+        uint64_t latencyTotal_ = 0;
+
+        // 连续采集
+        bool capturing_ = false;
+        FrameCaptureOptions capture_;
+        Clock::time_point nextCapture_;
+        size_t pendingCaptures_ = 0;
+        std::shared_ptr<std::ofstream> captureFile_;
+        std::unique_ptr<ThreadPool> writer_;  // 文件写入线程，避免在渲染线程上做磁盘 IO
+    };
+}
@@ -13,6 +13,7 @@ namespace iengine {
     // 前向声明
     class Mesh;
     class OpenGLContext;
+    struct VertexLayout;
 
     class OpenGLRenderPipeline {
     public:
@@ -30,6 +31,9 @@ namespace iengine {
         
         // 设置 VAO 和顶点属性
         void setupVAO(std::shared_ptr<Mesh> mesh, std::shared_ptr<OpenGLShaderProgram> shader, std::shared_ptr<OpenGLContext> context);
+        // 直接指定缓冲区（缓冲区池的页被多个网格共享）
+        void setupVAO(const VertexLayout& layout, unsigned int vbo, unsigned int ibo,
+                      std::shared_ptr<OpenGLShaderProgram> shader, std::shared_ptr<OpenGLContext> context);
 
         void setUniform(const std::string& name, const UniformValue& value);
         void setUniforms(const std::unordered_map<std::string, UniformValue>& uniforms);
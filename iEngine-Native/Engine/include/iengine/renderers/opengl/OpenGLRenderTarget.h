@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../GpuResource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace iengine {
+    class OpenGLContext;
+
+    struct RenderTargetDesc {
+        std::string name;
+        int width = 0;                  // 为 0 时跟随视口尺寸（乘以 scale），视口变化后在下次使用时重建
+        int height = 0;
+        float scale = 1.0f;             // 跟随视口时的缩放，如 0.5 用于半分辨率后处理
+        TextureFormat colorFormat = TextureFormat::RGBA8;  // 不支持块压缩格式
+        int colorAttachments = 1;       // 0 表示只有深度附件（阴影贴图）
+        bool depth = true;
+        TextureFormat depthFormat = TextureFormat::DEPTH24_STENCIL8;
+        bool sampleDepth = false;       // 深度附件可作为纹理采样，否则使用渲染缓冲
+        int samples = 1;                // 大于 1 时为 MSAA，附件为多重采样渲染缓冲，需解析到单采样目标后采样
+
+        bool isViewportRelative() const { return width <= 0 || height <= 0; }
+    };
+
+    /**
+     * @brief OpenGL 帧缓冲对象及其颜色/深度附件
+     *
+     * 单采样的颜色附件（以及 sampleDepth 的深度附件）是登记在上下文中的普通纹理，
+     * 可以像其他纹理一样通过句柄绑定采样；多重采样的附件是渲染缓冲，用 blitTo 解析。
+     * 附件尺寸变化时整体重建，纹理经登记表延迟删除，仍在 GPU 上执行的帧不受影响。
+     */
+    class OpenGLRenderTarget {
+    public:
+        OpenGLRenderTarget(OpenGLContext& context, const RenderTargetDesc& desc, int width, int height);
+        ~OpenGLRenderTarget();
+
+        OpenGLRenderTarget(const OpenGLRenderTarget&) = delete;
+        OpenGLRenderTarget& operator=(const OpenGLRenderTarget&) = delete;
+
+        // 尺寸不同时重建附件，返回是否发生了重建
+        bool resize(int width, int height);
+        bool isComplete() const { return complete_; }
+
+        const RenderTargetDesc& getDesc() const { return desc_; }
+        unsigned int getFramebuffer() const { return framebuffer_; }
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        int getSamples() const { return samples_; }
+        // 单采样颜色附件的纹理，多重采样时为无效句柄
+        TextureHandle getColorTexture(int index = 0) const;
+        TextureHandle getDepthTexture() const { return depthTexture_; }
+        // 附件占用的显存（估算，多重采样按采样数计）
+        size_t getByteSize() const { return bytes_; }
+
+        // 把第 0 个颜色附件（可选深度）复制/解析到 dst，dst 为空时写入默认帧缓冲（尺寸为 dstWidth x dstHeight）
+        void blitTo(const OpenGLRenderTarget* dst, int dstWidth, int dstHeight, bool depth = false) const;
+
+    private:
+        void create();
+        void destroy();
+
+        OpenGLContext& context_;
+        RenderTargetDesc desc_;
+        int width_ = 0;
+        int height_ = 0;
+        int samples_ = 1;
+        bool complete_ = false;
+        size_t bytes_ = 0;
+
+        unsigned int framebuffer_ = 0;
+        std::vector<TextureHandle> colorTextures_;
+        std::vector<unsigned int> colorRenderbuffers_;
+        TextureHandle depthTexture_;
+        unsigned int depthRenderbuffer_ = 0;
+    };
+
+    struct RenderTargetPoolOptions {
+        int maxIdleFrames = 4;                   // 空闲目标超过该帧数未被取用即释放
+        size_t budgetBytes = 256 * 1024 * 1024;  // 空闲目标占用超过预算时从最久未用的开始释放
+    };
+
+    struct RenderTargetPoolStats {
+        size_t targets = 0;             // 池中的目标数（含使用中的）
+        size_t inUse = 0;
+        size_t bytes = 0;
+        size_t idleBytes = 0;
+        uint64_t allocations = 0;       // 新建的目标数
+        uint64_t reuses = 0;            // 从池中复用的次数
+        uint64_t reallocations = 0;     // 跟随视口的目标因尺寸变化重建的次数
+        uint64_t evictions = 0;         // 空闲过久或超出预算而释放的目标数
+    };
+
+    /**
+     * @brief 渲染目标池
+     *
+     * acquire 按（尺寸、格式、采样数、附件配置）查找空闲目标，找不到时才新建；
+     * release 把目标放回池中供之后的帧复用。acquireTransient 取得的目标在帧末自动归还，
+     * 适合每帧申请的临时目标（后处理中间结果等）。
+     * 跟随视口的目标只在取用或 ensureSize 时按当前视口尺寸解析，
+     * 同一帧内的多次 resize（窗口拖动产生的大量事件）只会导致至多一次重建；
+     * 旧尺寸的空闲目标按空闲帧数和预算逐步释放，来回拖动时可直接复用。
+     */
+    class OpenGLRenderTargetPool {
+    public:
+        explicit OpenGLRenderTargetPool(OpenGLContext& context,
+                                        const RenderTargetPoolOptions& options = RenderTargetPoolOptions());
+        ~OpenGLRenderTargetPool();
+
+        OpenGLRenderTargetPool(const OpenGLRenderTargetPool&) = delete;
+        OpenGLRenderTargetPool& operator=(const OpenGLRenderTargetPool&) = delete;
+
+        // 取得目标，直到 release 前一直有效；失败（附件不完整）时返回 nullptr
+        OpenGLRenderTarget* acquire(const RenderTargetDesc& desc);
+        // 取得本帧的临时目标，endFrame 时自动归还
+        OpenGLRenderTarget* acquireTransient(const RenderTargetDesc& desc);
+        void release(OpenGLRenderTarget* target);
+        // 跟随视口的目标按当前视口尺寸重建（尺寸未变时什么都不做）
+        void ensureSize(OpenGLRenderTarget* target);
+
+        void setViewportSize(int width, int height);
+        void endFrame(uint64_t frame);
+        void clear();
+
+        const RenderTargetPoolOptions& getOptions() const { return options_; }
+        void setOptions(const RenderTargetPoolOptions& options) { options_ = options; }
+        RenderTargetPoolStats getStats() const;
+        void printStats() const;
+
+    private:
+        struct Entry {
+            std::unique_ptr<OpenGLRenderTarget> target;
+            bool inUse = false;
+            bool transient = false;
+            uint64_t lastUsedFrame = 0;
+        };
+
+        void resolveSize(const RenderTargetDesc& desc, int& width, int& height) const;
+        static bool isCompatible(const RenderTargetDesc& a, const RenderTargetDesc& b);
+        Entry* findEntry(const OpenGLRenderTarget* target);
+        void evictIdle();
+
+        OpenGLContext& context_;
+        RenderTargetPoolOptions options_;
+        std::vector<Entry> entries_;
+        int viewportWidth_ = 1;
+        int viewportHeight_ = 1;
+        uint64_t frame_ = 0;
+        RenderTargetPoolStats stats_;
+    };
+}
@@ -1,22 +1,57 @@
 #pragma once
 
 #include "../Renderer.h"
+#include "../CommandList.h"
+#include "../RenderSnapshot.h"
+#include "../UploadScheduler.h"
+#include "../TextureResidencyManager.h"
+#include "../../textures/TextureArrayAllocator.h"
+#include <cstddef>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace iengine {
     // 前向声明
     class Camera;
     class Scene;
     class Mesh;
+    class Model;
     class Material;
     class OpenGLContext;
     class Light;
     class OpenGLContext;
     class OpenGLShaderProgram;
     class OpenGLRenderPipeline;
+    class JobSystem;
     
+    struct CommandRecordingOptions {
+        bool parallel = true;           // 设置了任务调度器时在工作线程上并行录制命令
+        int minModelsPerChunk = 64;     // 每个录制任务至少处理的模型数，模型较少时在渲染线程上直接录制
+        bool sortByState = true;        // 按管线和材质排序绘制，减少状态切换
+    };
+    
+    struct CommandRecordingStats {
+        size_t draws = 0;
+        size_t commands = 0;
+        size_t chunks = 0;              // 本帧并行录制的分段数
+        size_t pipelineBinds = 0;       // 实际执行的管线切换
+        size_t resolvedPipelines = 0;   // 录制时缓存未命中、执行前创建/查找的管线
+        double recordMilliseconds = 0.0;
+        double executeMilliseconds = 0.0;
+    };
+    
+    /**
+     * @brief OpenGL 渲染器
+     *
+     * 每帧分三步：在渲染线程上上传网格（需要上下文）；把快照中可绘制的项分段交给工作线程，
+     * 并行完成着色器变体查找、uniform 收集和排序键计算，录制成 CommandList（LOD 已在构建快照时选好）；
+     * 最后在渲染线程上合并、排序并在一个循环中执行。录制期间只读取着色器和管线缓存，
+     * 缓存未命中的管线在执行前创建。
+     */
     class OpenGLRenderer : public Renderer {
     public:
         OpenGLRenderer();
@@ -25,31 +60,104 @@ namespace iengine {
         bool initialize(std::shared_ptr<Context> context) override;
         void cleanup() override;
         void render(std::shared_ptr<Scene> scene) override;
+        void renderSnapshot(const RenderSnapshot& snapshot) override;
         void resize(int width, int height) override;
         void clear() override;
 		bool isInitialized() const noexcept override;
+        bool hasPendingWork() const override;
         
         // 获取或创建渲染管线
         std::shared_ptr<OpenGLRenderPipeline> getOrCreatePipeline(
             std::shared_ptr<Mesh> mesh, 
             std::shared_ptr<OpenGLShaderProgram> shader);
         
+        // 网格/纹理上传调度器，可调整每帧上传预算
+        UploadScheduler& getUploadScheduler() { return uploadScheduler_; }
+        
+        // useTextureArrays 材质的贴图所在的纹理数组/图集
+        TextureArrayAllocator& getTextureArrayAllocator() { return textureArrays_; }
+        
+        // 2D 纹理的显存预算和 LRU 驱逐
+        TextureResidencyManager& getTextureResidencyManager() { return textureResidency_; }
+        
+        // 命令录制和纹理数组 Mip 生成使用的任务调度器，为空时在渲染线程上执行
+        void setJobSystem(JobSystem* jobSystem) {
+            jobSystem_ = jobSystem;
+            textureArrays_.setJobSystem(jobSystem);
+        }
+        void setRecordingOptions(const CommandRecordingOptions& options) { recordingOptions_ = options; }
+        const CommandRecordingOptions& getRecordingOptions() const { return recordingOptions_; }
+        const CommandRecordingStats& getRecordingStats() const { return recordingStats_; }
+        
+        // 执行命令列表（回放捕获的列表也可直接调用），缓存未命中的管线在这里创建
+        void executeCommandList(CommandList& commands);
+        // 上一帧录制的命令列表，可用于捕获
+        const CommandList& getLastCommandList() const { return frameCommands_; }
+        
     private:
         std::shared_ptr<OpenGLContext> m_openGLContext;
         std::shared_ptr<Camera> currentCamera_;
 		bool m_isInitialized = false;
         
+        // render(scene) 与渲染线程模式一样按实体剔除并生成绘制项，但在同一线程上立即绘制，
+        // 相机、灯光和材质直接共享
+        RenderSnapshotBuilder sceneSnapshotBuilder_;
+        RenderSnapshot sceneSnapshot_;
+        uint64_t sceneSnapshotFrame_ = 0;
+        
+        // 命令录制
+        JobSystem* jobSystem_ = nullptr;
+        CommandRecordingOptions recordingOptions_;
+        CommandRecordingStats recordingStats_;
+        CommandList frameCommands_;
+        // 本帧要录制的绘制项，指向正在渲染的快照，网格和材质在 frameResources_ 中查找
+        std::vector<const RenderDrawItem*> drawables_;
+        const RenderResourceTable* frameResources_ = nullptr;
+        // 并行录制的分段列表，跨帧复用容量
+        std::vector<std::unique_ptr<CommandList>> listPool_;
+        std::vector<std::pair<int, CommandList*>> recordedChunks_;
+        std::mutex recordMutex_;
+        
+        // 按帧预算执行网格和纹理上传
+        UploadScheduler uploadScheduler_;
+        TextureArrayAllocator textureArrays_;
+        TextureResidencyManager textureResidency_;
+        
         // 着色器缓存
         std::map<std::string, std::shared_ptr<OpenGLShaderProgram>> shaders_;
         
         // 渲染管线缓存
         std::map<std::string, std::shared_ptr<OpenGLRenderPipeline>> renderPipelineCache_;
+        // 使用独立缓冲区的网格的管线 -> 其顶点缓冲区；缓冲区释放后管线随之移除，VAO 不再引用旧缓冲区
+        std::map<std::string, BufferHandle> dedicatedPipelineBuffers_;
         
         // 获取或创建着色器
         std::shared_ptr<OpenGLShaderProgram> getOrCreateShader(
             const std::string& shaderName,
             const std::map<std::string, bool>& defines);
         
+        // render 和 renderSnapshot 共用的一帧绘制
+        void renderFrame(const RenderSnapshot& snapshot);
+        
+        // 录制 drawables_ 的绘制命令到 frameCommands_
+        void recordCommands(const std::shared_ptr<Camera>& camera,
+                            const std::vector<std::shared_ptr<Light>>& lights);
+        void recordRange(const std::shared_ptr<Camera>& camera,
+                         const std::vector<std::shared_ptr<Light>>& lights,
+                         size_t begin, size_t end, CommandList& commands);
+        // 只查找缓存，不创建（可在工作线程上调用）
+        std::shared_ptr<OpenGLRenderPipeline> findPipeline(const std::shared_ptr<Mesh>& mesh,
+                                                           const std::string& shaderKey);
+        
+        // 移除顶点缓冲区已释放的网格的管线
+        void releaseStalePipelines();
+        
+        // 把本帧需要但尚未驻留的网格和纹理提交给上传调度器
+        void scheduleUploads(const RenderSnapshot& snapshot);
+        
+        // 着色器变体的缓存键
+        static std::string makeShaderKey(const std::string& shaderName, const std::map<std::string, bool>& defines);
+        
         // 生成渲染管线的哈希键
         std::string makePipelineKey(std::shared_ptr<Mesh> mesh, 
                                    std::shared_ptr<OpenGLShaderProgram> shader);
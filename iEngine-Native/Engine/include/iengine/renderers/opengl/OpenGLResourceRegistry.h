@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../GpuResource.h"
+#include "../../core/SlotMap.h"
+
+#include <deque>
+
+namespace iengine {
+    /**
+     * @brief OpenGL 对象的登记表
+     *
+     * 所有经由 OpenGLContext 创建的缓冲区、纹理和着色器程序都登记在这里，对外只暴露类型化句柄。
+     * 释放时句柄立即失效，但 GL 对象进入延迟删除队列，等待 framesInFlight 帧之后再真正删除，
+     * 保证仍在 GPU 上执行的帧不会引用到已删除（或名称已被复用）的对象。
+     */
+    class OpenGLResourceRegistry {
+    public:
+        struct BufferRecord {
+            unsigned int id = 0;
+            BufferTarget target = BufferTarget::Vertex;
+            BufferUsage usage = BufferUsage::Static;
+            size_t size = 0;
+        };
+
+        struct TextureRecord {
+            unsigned int id = 0;
+            int width = 0;
+            int height = 0;
+            size_t bytes = 0;
+            TextureFormat format = TextureFormat::RGBA8;
+            int levels = 1;  // 已分配的 Mip 级数
+            int layers = 0;  // 纹理数组的层数，0 表示普通 2D 纹理
+        };
+
+        struct ProgramRecord {
+            unsigned int id = 0;
+        };
+
+        explicit OpenGLResourceRegistry(size_t framesInFlight = 3);
+        ~OpenGLResourceRegistry();
+
+        OpenGLResourceRegistry(const OpenGLResourceRegistry&) = delete;
+        OpenGLResourceRegistry& operator=(const OpenGLResourceRegistry&) = delete;
+
+        BufferHandle addBuffer(unsigned int id, BufferTarget target, BufferUsage usage, size_t size);
+        BufferRecord* getBuffer(BufferHandle handle);
+        void releaseBuffer(BufferHandle handle);
+
+        TextureHandle addTexture(unsigned int id, int width, int height, size_t bytes,
+                                 TextureFormat format = TextureFormat::RGBA8);
+        TextureRecord* getTexture(TextureHandle handle);
+        void releaseTexture(TextureHandle handle);
+
+        ProgramHandle addProgram(unsigned int id);
+        ProgramRecord* getProgram(ProgramHandle handle);
+        void releaseProgram(ProgramHandle handle);
+
+        // 帧结束：推进帧号，删除已经不被任何在途帧引用的对象
+        void endFrame();
+        // 立即删除所有待删除对象（调用方需保证 GPU 已空闲）
+        void flush();
+        // 删除所有对象，包括仍然存活的（上下文销毁时使用）
+        void destroyAll();
+
+        GpuResourceStats getStats() const;
+
+    private:
+        enum class ResourceType { Buffer, Texture, Program };
+
+        struct PendingDeletion {
+            ResourceType type;
+            unsigned int id;
+            size_t bytes;
+            uint64_t frame;
+        };
+
+        void deleteObject(ResourceType type, unsigned int id);
+
+        size_t framesInFlight_;
+        uint64_t frame_ = 0;
+
+        SlotMap<BufferRecord> buffers_;
+        SlotMap<TextureRecord> textures_;
+        SlotMap<ProgramRecord> programs_;
+        std::deque<PendingDeletion> pending_;
+    };
+}
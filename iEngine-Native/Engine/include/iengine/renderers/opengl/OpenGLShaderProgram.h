@@ -1,6 +1,7 @@
 #pragma once
 
 #include "OpenGLUniforms.h"
+#include "../GpuResource.h"
 #include <memory>
 #include <string>
 #include <map>
@@ -11,7 +12,7 @@ namespace iengine {
     
     class OpenGLShaderProgram {
     public:
-        void* program = nullptr;
+        ProgramHandle program;
         std::shared_ptr<OpenGLContext> context;
         std::string vertCode;
         std::string fragCode;
@@ -28,7 +29,10 @@ namespace iengine {
         void setUniform(const std::string& name, const UniformValue& value);
         void setUniforms(const std::map<std::string, UniformValue>& uniforms);
         
+        // GL 程序对象名，句柄失效时为 0
+        unsigned int getProgramId() const;
+        
     private:
-        void* createProgram();
+        ProgramHandle createProgram();
     };
 }
\ No newline at end of file
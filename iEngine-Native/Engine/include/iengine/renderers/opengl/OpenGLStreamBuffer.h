@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iengine {
+    struct StreamBufferOptions {
+        size_t frameBytes = 4 * 1024 * 1024;  // 每帧可写入的最大字节数
+        size_t frameCount = 3;                // 环形缓冲的帧数（三重缓冲）
+    };
+
+    struct StreamBufferStats {
+        bool persistent = false;        // 是否使用持久映射
+        size_t capacity = 0;
+        size_t bytesThisFrame = 0;
+        size_t peakFrameBytes = 0;
+        size_t overflowCount = 0;       // 单帧空间不足、调用方需回退的次数
+        size_t stallCount = 0;          // 等待 GPU 释放区段的次数
+        size_t orphanCount = 0;         // 回退路径下孤立缓冲区存储的次数
+    };
+
+    /**
+     * @brief 每帧重写的流式数据使用的环形缓冲区
+     *
+     * 缓冲区被均分为 frameCount 个区段，每帧只写当前区段：
+     * - 支持 GL 4.4（glBufferStorage）时使用持久一致映射，帧末插入 fence，
+     *   再次轮到该区段时等待 fence，CPU 直接 memcpy，无需每次映射；
+     * - 否则每次写入用 GL_MAP_UNSYNCHRONIZED_BIT 映射一段区间，
+     *   环绕回第0段时孤立（orphan）整个缓冲区，由驱动分配新存储，避免同步等待。
+     * 同一个缓冲区同时存放顶点和索引，写入偏移按调用方给定的对齐取整，
+     * 因此顶点区间可以直接换算为 baseVertex。
+     */
+    class OpenGLStreamBuffer {
+    public:
+        static constexpr size_t InvalidOffset = SIZE_MAX;
+
+        explicit OpenGLStreamBuffer(const StreamBufferOptions& options = StreamBufferOptions{});
+        ~OpenGLStreamBuffer();
+
+        OpenGLStreamBuffer(const OpenGLStreamBuffer&) = delete;
+        OpenGLStreamBuffer& operator=(const OpenGLStreamBuffer&) = delete;
+
+        bool initialize();
+        void cleanup();
+
+        // 帧开始：确认当前区段已被 GPU 用完
+        void beginFrame();
+        // 帧结束：为当前区段插入 fence 并前进到下一个区段
+        void endFrame();
+
+        /**
+         * @brief 在当前帧区段中写入数据
+         * @return 相对缓冲区起点的字节偏移（alignment 的整数倍），空间不足时返回 InvalidOffset
+         */
+        size_t write(const void* data, size_t size, size_t alignment);
+
+        unsigned int getBuffer() const { return buffer_; }
+        uint64_t getFrameIndex() const { return frameIndex_; }
+        bool isPersistent() const { return persistent_; }
+        const StreamBufferStats& getStats() const { return stats_; }
+
+    private:
+        void waitForSegment(size_t segment);
+
+        StreamBufferOptions options_;
+        unsigned int buffer_ = 0;
+        bool persistent_ = false;
+        unsigned char* mapped_ = nullptr;  // 持久映射的指针
+
+        size_t segment_ = 0;
+        size_t cursor_ = 0;                // 当前区段内已写入的字节数
+        uint64_t frameIndex_ = 0;
+        std::vector<void*> fences_;        // 每个区段的 GLsync
+
+        StreamBufferStats stats_;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../GpuResource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace iengine {
+    struct TextureSamplerDesc;
+
+    struct TextureBindingStats {
+        size_t textureBinds = 0;   // 本帧实际执行的 glBindTexture 次数（不含纹理编辑）
+        size_t skippedBinds = 0;   // 纹理单元已绑定同一纹理而跳过的次数
+        size_t samplerBinds = 0;   // 本帧实际执行的 glBindSampler 次数
+        size_t samplerObjects = 0; // 缓存的采样器对象数
+    };
+
+    /**
+     * @brief 纹理单元绑定状态和采样器对象缓存
+     *
+     * 记录每个纹理单元当前绑定的纹理（按句柄，句柄带代数，名称复用不会误判）和采样器对象，
+     * 单元已绑定同一纹理时跳过绑定。采样器对象按寻址/过滤状态去重，多张纹理共用同一个对象。
+     * 最后一个纹理单元保留给纹理创建、写入等编辑操作，不参与绘制，编辑不会破坏绘制单元的绑定记录。
+     */
+    class OpenGLTextureBindings {
+    public:
+        explicit OpenGLTextureBindings(int maxUnits);
+        ~OpenGLTextureBindings();
+
+        OpenGLTextureBindings(const OpenGLTextureBindings&) = delete;
+        OpenGLTextureBindings& operator=(const OpenGLTextureBindings&) = delete;
+
+        // 可用于绘制的纹理单元数
+        int getUnitCount() const { return static_cast<int>(units_.size()); }
+
+        // 把纹理绑定到绘制单元；sampler 为 0 时使用纹理自身的采样参数
+        void bind(int unit, unsigned int target, unsigned int texture, TextureHandle handle, unsigned int sampler);
+        // 在编辑单元上绑定纹理，供创建/写入/设置参数使用
+        void bindForEdit(unsigned int target, unsigned int texture);
+        void setActiveUnit(int unit);
+        int getActiveUnit() const { return activeUnit_; }
+
+        // 获取（必要时创建）与采样参数对应的采样器对象
+        unsigned int getSampler(const TextureSamplerDesc& desc);
+
+        void beginFrame();
+        const TextureBindingStats& getStats() const { return stats_; }
+
+    private:
+        struct Unit {
+            TextureHandle texture;
+            unsigned int target = 0;
+            unsigned int sampler = 0;
+        };
+
+        std::vector<Unit> units_;
+        int editUnit_ = 0;
+        int activeUnit_ = -1;
+        std::unordered_map<uint32_t, unsigned int> samplers_;
+        TextureBindingStats stats_;
+    };
+}
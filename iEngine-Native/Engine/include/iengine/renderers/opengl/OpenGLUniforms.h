@@ -6,6 +6,8 @@
 #include <vector>
 #include <functional>
 
+#include "../GpuResource.h"
+
 namespace iengine {
     // 前向声明
     class OpenGLContext;
@@ -75,7 +77,8 @@ namespace iengine {
             VEC3,
             VEC4,
             MAT4,
-            TEXTURE
+            TEXTURE,
+            TEXTURE_HANDLE  // 直接绑定 GPU 纹理（如纹理数组），不经过 Texture 对象
         };
         
         // 默认构造函数
@@ -87,6 +90,7 @@ namespace iengine {
         UniformValue(bool value) : type_(Type::BOOL), bool_(value) {}
         UniformValue(const std::vector<float>& value);
         UniformValue(const std::shared_ptr<Texture>& value) : type_(Type::TEXTURE), texture_(value) {}
+        UniformValue(TextureHandle value) : type_(Type::TEXTURE_HANDLE), float_(0.0f), textureHandle_(value) {}
         
         // 用于矩阵的构造函数
         static UniformValue fromMatrix4(const class Matrix4& matrix);
@@ -101,6 +105,7 @@ namespace iengine {
         bool asBool() const { return bool_; }
         const std::vector<float>& asVec() const { return vec_; }
         const std::shared_ptr<Texture>& asTexture() const { return texture_; }
+        TextureHandle asTextureHandle() const { return textureHandle_; }
         
     private:
         Type type_;
@@ -112,24 +117,40 @@ namespace iengine {
         };
         std::vector<float> vec_;
         std::shared_ptr<Texture> texture_;
+        TextureHandle textureHandle_;
     };
     
     class OpenGLUniforms {
     public:
-        OpenGLUniforms(std::shared_ptr<OpenGLContext> context, void* program);
+        OpenGLUniforms(std::shared_ptr<OpenGLContext> context, unsigned int program);
         ~OpenGLUniforms();
         
         void set(const std::string& name, const UniformValue& value);
         void setUniforms(const std::map<std::string, UniformValue>& uniforms);
+        
+        // 每次绘制设置纹理前后调用：结束时为本次未设置纹理的 2D 采样器绑定占位纹理，
+        // 避免采样到上一次绘制留在该单元上的纹理
+        void beginTextureBindings();
+        void endTextureBindings();
 
     private:
+        // 采样器 uniform 在链接时按反射顺序分配固定的纹理单元，只设置一次单元号
+        struct SamplerSlot {
+            std::string name;
+            unsigned int type = 0;
+            int unit = 0;
+            bool bound = false;  // 本次绘制是否已设置纹理
+        };
+        
         std::shared_ptr<OpenGLContext> context_;
-        void* program_;
-		int textureUnit_ = 0; // 当前纹理单元，从0开始递增
+        unsigned int program_;
+        std::vector<SamplerSlot> samplerSlots_;
         std::map<std::string, std::function<void(const UniformValue&)>> uniformSetters_;
         
         void initUniformSetters(); // 移到public，供OpenGLShaderProgram调用
 
         void setUniformByType(unsigned int type, int location, const UniformValue& value);
+        void bindSamplerSlot(SamplerSlot& slot, const UniformValue& value);
+        static bool isSamplerType(unsigned int type);
     };
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "../core/SlotMap.h"
+
+namespace iengine {
+    class JobSystem;
+
+    /**
+     * @brief 实体句柄，与 SlotMap 的键相同：实体销毁后槽位复用但代数加一，旧句柄失效
+     */
+    struct Entity {
+        uint32_t index = 0;
+        uint32_t generation = 0;    // 0 表示空实体
+
+        bool isValid() const { return generation != 0; }
+        // 打包成 64 位，可作为哈希表的键
+        uint64_t id() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = uint64_t;
+
+    struct ComponentTypeInfo {
+        size_t size = 0;
+        void (*construct)(void*) = nullptr;     // 在未初始化的内存上默认构造
+    };
+
+    /**
+     * @brief 组件类型登记：每种组件类型首次使用时分配一个序号，最多 kMaxComponentTypes 种
+     *
+     * 组件在原型之间按字节搬移，必须可平凡复制（不能持有 shared_ptr、std::function 等），
+     * 需要引用资源时保存句柄。
+     */
+    class ComponentTypes {
+    public:
+        static constexpr size_t kMaxComponentTypes = 64;
+
+        template <typename T>
+        static ComponentTypeId id() {
+            static_assert(std::is_trivially_copyable<T>::value, "组件必须可平凡复制");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "组件对齐要求超出列存储的对齐");
+            static const ComponentTypeId typeId = registerType(sizeof(T), [](void* memory) { new (memory) T(); });
+            return typeId;
+        }
+
+        template <typename T>
+        static ComponentMask mask() { return ComponentMask(1) << id<T>(); }
+
+        static const ComponentTypeInfo& info(ComponentTypeId id);
+
+    private:
+        static ComponentTypeId registerType(size_t size, void (*construct)(void*));
+    };
+
+    /**
+     * @brief 原型：组件组合相同的一组实体，每种组件一列连续存储（SoA）
+     *
+     * 第 i 行的各列属于 entities()[i]。删除实体时用末行填补空位，行号会变化，只在遍历期间有效。
+     */
+    class Archetype {
+    public:
+        explicit Archetype(ComponentMask mask);
+
+        ComponentMask getMask() const { return mask_; }
+        bool has(ComponentTypeId type) const { return (mask_ >> type) & 1; }
+        template <typename T>
+        bool has() const { return has(ComponentTypes::id<T>()); }
+
+        size_t size() const { return entities_.size(); }
+        bool empty() const { return entities_.empty(); }
+        const Entity* entities() const { return entities_.data(); }
+
+        // 组件列的起始地址，不含该组件时返回空
+        void* column(ComponentTypeId type);
+        const void* column(ComponentTypeId type) const { return const_cast<Archetype*>(this)->column(type); }
+        template <typename T>
+        T* column() { return static_cast<T*>(column(ComponentTypes::id<T>())); }
+        template <typename T>
+        const T* column() const { return static_cast<const T*>(column(ComponentTypes::id<T>())); }
+
+    private:
+        friend class EntityRegistry;
+
+        struct Column {
+            ComponentTypeId type = 0;
+            size_t stride = 0;
+            std::vector<unsigned char> data;
+        };
+
+        // 在末尾添加一行并默认构造所有组件，返回行号
+        size_t addRow(Entity entity);
+        // 用末行填补 row，返回被移动到 row 的实体；row 本身是末行时返回空实体
+        Entity removeRow(size_t row);
+        void reserve(size_t rows);
+
+        ComponentMask mask_;
+        std::array<int8_t, ComponentTypes::kMaxComponentTypes> columnIndex_;
+        std::vector<Column> columns_;
+        std::vector<Entity> entities_;
+    };
+
+    /**
+     * @brief 按原型存储的实体组件表
+     *
+     * 添加或移除组件会把实体移到对应组合的原型中。遍历按原型逐列顺序访问，
+     * 没有逐实体的指针跳转和引用计数。遍历（尤其是并行遍历）期间不能创建、销毁实体或增删组件，
+     * 需要时先记录下来，遍历结束后再执行。不是线程安全的，并行遍历中每次调用只能修改当前行的组件。
+     */
+    class EntityRegistry {
+    public:
+        EntityRegistry();
+
+        Entity create();
+        template <typename... Ts>
+        Entity create(const Ts&... components) {
+            Entity entity = createWithMask((ComponentMask(0) | ... | ComponentTypes::mask<Ts>()));
+            ((*get<Ts>(entity) = components), ...);
+            return entity;
+        }
+        bool destroy(Entity entity);
+        bool isAlive(Entity entity) const;
+        void clear();
+
+        size_t size() const { return locations_.size(); }
+        size_t getArchetypeCount() const { return archetypes_.size(); }
+        ComponentMask getMask(Entity entity) const;
+        // 预留原型的行数，批量创建实体前调用可以避免列反复扩容
+        template <typename... Ts>
+        void reserve(size_t count) {
+            archetypes_[findOrCreateArchetype((ComponentMask(0) | ... | ComponentTypes::mask<Ts>()))]->reserve(count);
+        }
+
+        template <typename T>
+        T* get(Entity entity) {
+            const Location* location = locations_.get(entity.index, entity.generation);
+            if (!location) return nullptr;
+            T* column = archetypes_[location->archetype]->template column<T>();
+            return column ? column + location->row : nullptr;
+        }
+        template <typename T>
+        const T* get(Entity entity) const { return const_cast<EntityRegistry*>(this)->get<T>(entity); }
+        template <typename T>
+        bool has(Entity entity) const { return get<T>(entity) != nullptr; }
+
+        // 添加组件（已有时覆盖），实体不存在时返回空
+        template <typename T>
+        T* add(Entity entity, const T& value = T()) {
+            if (!setMask(entity, getMask(entity) | ComponentTypes::mask<T>())) return nullptr;
+            T* component = get<T>(entity);
+            *component = value;
+            return component;
+        }
+        template <typename T>
+        bool remove(Entity entity) {
+            ComponentMask mask = getMask(entity);
+            if (!(mask & ComponentTypes::mask<T>())) return false;
+            return setMask(entity, mask & ~ComponentTypes::mask<T>());
+        }
+
+        // 遍历包含全部 Ts 组件的非空原型，fn(Archetype&)
+        template <typename... Ts, typename Fn>
+        void forEachArchetype(Fn&& fn) {
+            const ComponentMask required = (ComponentMask(0) | ... | ComponentTypes::mask<Ts>());
+            for (auto& archetype : archetypes_) {
+                if (!archetype->empty() && (archetype->getMask() & required) == required) {
+                    fn(*archetype);
+                }
+            }
+        }
+        template <typename... Ts, typename Fn>
+        void forEachArchetype(Fn&& fn) const {
+            const ComponentMask required = (ComponentMask(0) | ... | ComponentTypes::mask<Ts>());
+            for (const auto& archetype : archetypes_) {
+                if (!archetype->empty() && (archetype->getMask() & required) == required) {
+                    fn(static_cast<const Archetype&>(*archetype));
+                }
+            }
+        }
+
+        // 对每个包含全部 Ts 组件的实体调用 fn(Ts&...)
+        template <typename... Ts, typename Fn>
+        void each(Fn&& fn) {
+            forEachArchetype<Ts...>([&fn](Archetype& archetype) {
+                eachRow(fn, 0, archetype.size(), archetype.template column<Ts>()...);
+            });
+        }
+
+        /**
+         * @brief 并行遍历：每个原型的行区间分块交给任务调度器，fn(Archetype&, size_t begin, size_t end)
+         *
+         * jobSystem 为空或行数不超过 minChunk 时在调用线程上串行执行。
+         */
+        template <typename... Ts, typename Fn>
+        void parallelForEachChunk(JobSystem* jobSystem, int minChunk, Fn&& fn) {
+            forEachArchetype<Ts...>([&](Archetype& archetype) {
+                runChunks(jobSystem, archetype.size(), minChunk, [&fn, &archetype](size_t begin, size_t end) {
+                    fn(archetype, begin, end);
+                });
+            });
+        }
+
+        // 并行版本的 each，fn 在工作线程上调用
+        template <typename... Ts, typename Fn>
+        void parallelEach(JobSystem* jobSystem, int minChunk, Fn&& fn) {
+            parallelForEachChunk<Ts...>(jobSystem, minChunk, [&fn](Archetype& archetype, size_t begin, size_t end) {
+                eachRow(fn, begin, end, archetype.template column<Ts>()...);
+            });
+        }
+
+    private:
+        struct Location {
+            uint32_t archetype = 0;
+            uint32_t row = 0;
+        };
+
+        template <typename Fn, typename... Ts>
+        static void eachRow(Fn& fn, size_t begin, size_t end, Ts*... columns) {
+            for (size_t i = begin; i < end; ++i) {
+                fn(columns[i]...);
+            }
+        }
+
+        static void runChunks(JobSystem* jobSystem, size_t count, int minChunk,
+                              const std::function<void(size_t, size_t)>& fn);
+
+        Entity createWithMask(ComponentMask mask);
+        // 把实体移到 mask 对应的原型，共有的组件逐字节复制，新增的组件默认构造
+        bool setMask(Entity entity, ComponentMask mask);
+        uint32_t findOrCreateArchetype(ComponentMask mask);
+
+        SlotMap<Location> locations_;
+        std::vector<std::unique_ptr<Archetype>> archetypes_;
+        std::unordered_map<ComponentMask, uint32_t> archetypeIndex_;
+    };
+}
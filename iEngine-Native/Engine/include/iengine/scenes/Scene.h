@@ -1,18 +1,47 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "../renderers/Renderer.h"
 #include "../windowing/Window.h"
+#include "EntityRegistry.h"
+#include "SceneComponents.h"
 
 // 前向声明
 namespace iengine {
     class Camera;
     class Light;
     class Model;
+    class Mesh;
+    class Material;
     class Context;
     class OpenGLContext;
+    class JobSystem;
     
+    struct SceneUpdateOptions {
+        bool parallel = false;          // 把组件分给任务调度器的工作线程更新
+        int minModelsPerChunk = 256;    // 每个任务至少更新的组件数，组件较少时直接串行更新
+        int minEntitiesPerChunk = 16384; // 按列更新（运动积分、包围球、剔除）时每个任务至少处理的实体数
+    };
+    
+    /**
+     * @brief 场景：组件（模型）、灯光和活动相机
+     *
+     * 场景对象的数据存放在按原型组织的实体存储中（见 EntityRegistry、SceneComponents.h）：
+     * 变换、包围球、网格/材质句柄、显示与变化标记、运动状态各占一列，运动积分、包围球更新、
+     * 剔除和变化检查都按列顺序遍历，可以分给任务调度器并行执行。Model 加入场景时创建一个实体，
+     * 之后作为该实体的外观对象；也可以用 createEntity 直接创建不需要 Model 对象的实体。
+     *
+     * 并行更新的约定：动画回调只能读写回调参数中的 Model 自身，不能修改其他模型或共享对象
+     * （共享材质、网格等）。更新期间调用 addComponent/removeComponent/addLight/removeLight/destroyEntity
+     * 或 defer 不会立即生效，而是记录到延迟命令缓冲区，在 update 结束时的同步点按
+     * （实体序号，实体内调用顺序）依次执行，因此结果与串行更新一致，和线程数无关。
+     */
     class Scene {
     public:
         Scene(std::shared_ptr<WindowInterface> window);
@@ -26,19 +55,84 @@ namespace iengine {
         void removeLight(std::shared_ptr<Light> light);
         const std::vector<std::shared_ptr<Light>>& getLights() const;
         
+        // 直接创建可渲染的实体，可再通过 getRegistry() 添加 MotionComponent 等组件；更新期间不能创建
+        Entity createEntity(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material,
+                            const Matrix4& transform = Matrix4());
+        // 只用于 createEntity 创建的实体，Model 的实体随 removeComponent 销毁
+        void destroyEntity(Entity entity);
+        EntityRegistry& getRegistry() { return registry_; }
+        const EntityRegistry& getRegistry() const { return registry_; }
+        const std::shared_ptr<Mesh>& getMesh(SceneResourceHandle handle) const { return meshes_.get(handle); }
+        const std::shared_ptr<Material>& getMaterial(SceneResourceHandle handle) const { return materials_.get(handle); }
+        const SceneResourceTable<Mesh>& getMeshes() const { return meshes_; }
+        const SceneResourceTable<Material>& getMaterials() const { return materials_; }
+        
+        // 重新计算变换或网格改变过的实体的世界包围球，update 和 cull 会先调用
+        void updateBounds();
+        // 视锥体剔除，结果写入 EntityStateComponent::culled，返回可见的实体数
+        size_t cull(Camera& camera);
+        
         void update(float deltaTime);
+        // 更新期间记录，同步点执行；不在更新期间时立即执行
+        void defer(std::function<void(Scene&)> command);
+        bool isUpdating() const { return updating_.load(std::memory_order_acquire); }
+        
+        void setJobSystem(JobSystem* jobSystem) { jobSystem_ = jobSystem; }
+        void setUpdateOptions(const SceneUpdateOptions& options) { updateOptions_ = options; }
+        const SceneUpdateOptions& getUpdateOptions() const { return updateOptions_; }
         
         std::shared_ptr<Camera> getActiveCamera() const;
         void setActiveCamera(std::shared_ptr<Camera> camera);
         
+        // 按需渲染：自上次 clearDirty 以来场景成员、相机、实体、材质或灯光是否有变化，或有实体带动画
+        bool needsRedraw() const;
+        bool hasActiveAnimations() const;
+        void markDirty() { dirty_ = true; }
+        // 渲染后调用，清除场景及其相机、组件、材质和灯光的标记
+        void clearDirty();
+        
         // Context相关
         std::shared_ptr<Context> getContext() const;
+        std::shared_ptr<WindowInterface> getWindow() const { return window_; }
         void setContextType(RendererType type);
         
     private:
+        friend class Model;
+        
+        struct DeferredCommand {
+            size_t entity;      // 发出命令的实体序号，更新回调之外为 SIZE_MAX
+            uint32_t sequence;  // 同一实体内的调用顺序
+            std::function<void(Scene&)> apply;
+        };
+        
+        void updateAnimations(float deltaTime);
+        void updateMotion(float deltaTime);
+        void record(std::function<void(Scene&)> command);
+        void applyDeferredCommands();
+        
+        // Model 添加了动画回调，让场景更新时遍历它
+        void enableAnimation(Entity entity);
+        // 把 Model 的状态复制回它自身并销毁实体
+        void detach(Model& model);
+        void releaseResources(Entity entity);
+        JobSystem* getUpdateJobSystem() const { return updateOptions_.parallel ? jobSystem_ : nullptr; }
+        
+        EntityRegistry registry_;
+        SceneResourceTable<Mesh> meshes_;
+        SceneResourceTable<Material> materials_;
+        
         std::vector<std::shared_ptr<Model>> components_;
         std::vector<std::shared_ptr<Light>> lights_;
         std::shared_ptr<Camera> activeCamera_;
+        bool dirty_ = true;              // 成员变化（增删组件、灯光或切换相机）
+        
+        // 更新
+        JobSystem* jobSystem_ = nullptr;
+        SceneUpdateOptions updateOptions_;
+        // 并行更新期间工作线程会读取（isUpdating、增删组件时判断是否记录为延迟命令）
+        std::atomic<bool> updating_{false};
+        std::vector<DeferredCommand> deferred_;
+        std::mutex deferredMutex_;
         
         // Context管理
         std::shared_ptr<WindowInterface> window_;
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../math/Matrix4.h"
+#include "../math/Vector3.h"
+
+namespace iengine {
+    class Model;
+
+    // 场景资源表（网格、材质）中的序号，0 表示没有
+    using SceneResourceHandle = uint32_t;
+
+    // 世界变换
+    struct TransformComponent {
+        Matrix4 matrix;
+    };
+
+    // 包围球：局部部分来自网格几何的包围盒，世界部分在变换改变后由场景重新计算
+    struct BoundsComponent {
+        Vector3 localCenter;
+        float localRadius = -1.0f;      // 小于 0 表示没有几何，不参与剔除
+        Vector3 worldCenter;
+        float worldRadius = -1.0f;
+    };
+
+    struct RenderableComponent {
+        SceneResourceHandle mesh = 0;
+        SceneResourceHandle material = 0;
+    };
+
+    struct EntityStateComponent {
+        uint8_t visible = 1;            // 显示开关，隐藏的实体不剔除也不渲染
+        uint8_t culled = 0;             // 最近一次 Scene::cull 的结果
+        uint8_t dirty = 1;              // 按需渲染：自上次渲染以来有变化
+        uint8_t boundsDirty = 1;        // 变换改变，需要重新计算世界包围球
+        uint8_t resourcesDirty = 0;     // Model 的网格或材质可能已改变，需要重新读取句柄和局部包围盒
+    };
+
+    // 最近一次选择的 LOD 级别，跨帧保留用于切换迟滞；由构建渲染快照的线程更新
+    struct LodComponent {
+        uint32_t level = 0;
+    };
+
+    // 数据驱动的动画状态：每秒的平移量（世界空间）和绕自身原点的角速度（方向为转轴，长度为弧度/秒）
+    struct MotionComponent {
+        Vector3 velocity;
+        Vector3 angularVelocity;
+    };
+
+    // 由 Model 创建的实体，指回该 Model（Model 在场景中时由场景持有）
+    struct ModelComponent {
+        Model* model = nullptr;
+    };
+
+    // 标记带动画回调的 Model，场景更新时只遍历这些实体的回调
+    struct AnimationComponent {};
+
+    /**
+     * @brief 场景资源表：实体只保存句柄，同一资源只持有一份引用并按实体引用计数
+     */
+    template <typename T>
+    class SceneResourceTable {
+    public:
+        SceneResourceTable() : entries_(1) {}
+
+        SceneResourceHandle acquire(const std::shared_ptr<T>& resource) {
+            if (!resource) return 0;
+            auto it = handles_.find(resource.get());
+            if (it != handles_.end()) {
+                entries_[it->second].references++;
+                return it->second;
+            }
+
+            SceneResourceHandle handle;
+            if (!freeList_.empty()) {
+                handle = freeList_.back();
+                freeList_.pop_back();
+            } else {
+                handle = static_cast<SceneResourceHandle>(entries_.size());
+                entries_.emplace_back();
+            }
+            entries_[handle].resource = resource;
+            entries_[handle].references = 1;
+            handles_[resource.get()] = handle;
+            return handle;
+        }
+
+        void release(SceneResourceHandle handle) {
+            if (handle == 0 || handle >= entries_.size() || entries_[handle].references == 0) return;
+            Entry& entry = entries_[handle];
+            if (--entry.references == 0) {
+                handles_.erase(entry.resource.get());
+                entry.resource.reset();
+                freeList_.push_back(handle);
+            }
+        }
+
+        const std::shared_ptr<T>& get(SceneResourceHandle handle) const {
+            return handle < entries_.size() ? entries_[handle].resource : entries_[0].resource;
+        }
+
+        // 遍历被引用的资源，fn(const std::shared_ptr<T>&)
+        template <typename Fn>
+        void forEach(Fn&& fn) const {
+            for (const auto& entry : entries_) {
+                if (entry.resource) fn(entry.resource);
+            }
+        }
+
+        size_t size() const { return handles_.size(); }
+        // 已分配过的句柄都小于该值（包括已释放的）
+        SceneResourceHandle getHandleLimit() const { return static_cast<SceneResourceHandle>(entries_.size()); }
+
+    private:
+        struct Entry {
+            std::shared_ptr<T> resource;
+            uint32_t references = 0;
+        };
+
+        std::vector<Entry> entries_;    // 0 号保留为空
+        std::vector<SceneResourceHandle> freeList_;
+        std::unordered_map<const T*, SceneResourceHandle> handles_;
+    };
+}
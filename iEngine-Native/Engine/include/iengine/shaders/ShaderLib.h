@@ -4,8 +4,10 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 #include "../core/Enums.h"
+#include "ShaderVariantCache.h"
 
 namespace iengine {
 
@@ -41,6 +43,13 @@ namespace iengine {
 
     using ShaderVariantKey = std::string;
 
+    /**
+     * @brief 着色器注册表和变体缓存
+     *
+     * 进程内所有引擎共享：着色器源码和预处理结果与图形上下文无关，共享可以避免重复预处理。
+     * 所有方法线程安全，多个引擎可以在各自的线程上同时查询。变体缓存见 ShaderVariantCache：
+     * 同一变体只预处理一次，缓存总量超出预算时驱逐最久未用的变体。
+     */
     class ShaderLib {
     public:
         // 注册着色器
@@ -62,15 +71,23 @@ namespace iengine {
         // 获取所有着色器名称
         static std::vector<std::string> getAllShaderNames();
         
-        // 注册内置着色器
+        // 注册内置着色器，已注册的同名着色器保持不变（多个引擎启动时不会替换彼此正在使用的着色器）
         static void registerBuiltInShaders();
 
+        // 变体缓存的内存预算（字节），0 表示不限制
+        static void setCacheBudget(size_t bytes);
+        static ShaderVariantCacheStats getCacheStats();
+        static void printCacheStats();
+
     private:
+        // 保护 shaders_，查询取共享锁
+        static std::shared_mutex mutex_;
+        
         // 着色器存储
         static std::unordered_map<std::string, std::shared_ptr<ShaderVariants>> shaders_;
         
         // 变体缓存
-        static std::unordered_map<ShaderVariantKey, std::shared_ptr<ShaderVariants>> processedShaders_;
+        static ShaderVariantCache processedShaders_;
         
         // 生成着色器变体键
         static ShaderVariantKey makeShaderVariantKey(const std::string& shaderName, const DefineMap& defines);
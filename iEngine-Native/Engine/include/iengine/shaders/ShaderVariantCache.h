@@ -0,0 +1,98 @@
+#ifndef IENGINE_SHADER_VARIANT_CACHE_H
+#define IENGINE_SHADER_VARIANT_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace iengine {
+
+    struct ShaderVariants;
+
+    struct ShaderVariantCacheStats {
+        uint64_t hits = 0;          // 命中已完成的变体
+        uint64_t misses = 0;        // 未命中，由本线程预处理
+        uint64_t waits = 0;         // 命中其他线程正在预处理的变体，等待并共享其结果
+        uint64_t contended = 0;     // 获取分片锁时需要等待的次数
+        uint64_t evictions = 0;     // 超出预算被驱逐的变体数
+        size_t entries = 0;
+        size_t bytes = 0;           // 缓存的预处理源码总字节数
+        size_t budget = 0;
+    };
+
+    /**
+     * @brief 线程安全的着色器变体缓存
+     *
+     * 按键的哈希分成若干分片，每个分片一把读写锁，命中时只取共享锁。
+     * 同一变体只预处理一次（single-flight）：第一个未命中的线程放入未完成的条目后在锁外预处理，
+     * 其他线程拿到同一个 shared_future 等待结果。
+     * 总字节数超出预算时，在插入的分片内按最近使用时间驱逐已完成的条目；
+     * 已返回给调用方的变体由 shared_ptr 保持有效，再次请求时重新预处理。
+     */
+    class ShaderVariantCache {
+    public:
+        using Factory = std::function<std::shared_ptr<ShaderVariants>()>;
+
+        static constexpr size_t kShardCount = 16;
+
+        explicit ShaderVariantCache(size_t budgetBytes = 16 * 1024 * 1024);
+
+        ShaderVariantCache(const ShaderVariantCache&) = delete;
+        ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+        // 查找变体，未命中时调用 factory 生成；factory 返回空时不缓存
+        std::shared_ptr<ShaderVariants> getOrCreate(const std::string& key, const Factory& factory);
+
+        // 移除键满足条件的已完成条目，正在预处理的条目完成后照常返回给等待者
+        void eraseIf(const std::function<bool(const std::string&)>& predicate);
+        void clear();
+
+        // 预算为 0 表示不限制
+        void setBudget(size_t bytes);
+        size_t getBudget() const { return budget_.load(std::memory_order_relaxed); }
+
+        ShaderVariantCacheStats getStats() const;
+        void resetStats();
+        void printStats() const;
+
+    private:
+        using Result = std::shared_future<std::shared_ptr<ShaderVariants>>;
+
+        struct Entry {
+            Result result;
+            bool ready = false;
+            size_t bytes = 0;
+            std::atomic<uint64_t> lastUse{0};
+        };
+
+        struct Shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+            size_t bytes = 0;
+        };
+
+        Shard& shardFor(const std::string& key);
+        void evict(Shard& shard, const std::string& keep);
+        static size_t sizeOf(const std::string& key, const ShaderVariants& variants);
+
+        std::array<Shard, kShardCount> shards_;
+        std::atomic<size_t> budget_;
+        std::atomic<uint64_t> clock_{0};
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> waits_{0};
+        std::atomic<uint64_t> contended_{0};
+        std::atomic<uint64_t> evictions_{0};
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_SHADER_VARIANT_CACHE_H
@@ -0,0 +1,63 @@
+#ifndef IENGINE_MIPMAP_GENERATOR_H
+#define IENGINE_MIPMAP_GENERATOR_H
+
+#include "../core/Enums.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iengine {
+
+    class JobSystem;
+
+    // 下采样滤波器
+    enum class MipFilter {
+        Box,    // 按覆盖面积加权的盒式滤波，速度快，非 2 的幂尺寸也正确
+        Kaiser  // Kaiser 窗 sinc，更锐利、混叠更少
+    };
+
+    struct MipmapOptions {
+        MipFilter filter = MipFilter::Box;
+        bool srgb = false;        // RGB 通道在线性空间中平均（SRGB8_ALPHA8 格式自动开启）
+        bool normalMap = false;   // 每级重新归一化法线（8 位数据按 [0,1] -> [-1,1] 解码）
+        bool wrapU = true;        // 边缘按重复方式取样，与 Repeat 寻址一致
+        bool wrapV = true;
+        float kaiserWidth = 3.0f; // Kaiser 滤波半径（以目标像素为单位）
+        float kaiserAlpha = 4.0f;
+        JobSystem* jobSystem = nullptr;  // 按行分块并行使用的任务调度器，为空时在调用线程上生成
+    };
+
+    // 一个 Mip 级别在数据缓冲区中的位置
+    struct MipLevel {
+        int width = 0;
+        int height = 0;
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief CPU 端 Mip 链生成
+     *
+     * 每一级都由上一级的浮点（线性空间）数据分离地做水平、垂直两遍滤波得到，避免逐级量化误差累积；
+     * 每一遍按行分块交给任务调度器，内层循环是连续的浮点乘加，便于编译器自动向量化。
+     */
+    class MipmapGenerator {
+    public:
+        // 完整 Mip 链的级数（包含第 0 级）
+        static int getMipLevelCount(int width, int height);
+
+        /**
+         * @brief 生成第 1 级到 1x1 的所有级别
+         * @param level0 第 0 级数据，按 format 紧密排列
+         * @param outData 各级数据依次紧密排列写入
+         * @param outLevels 各级在 outData 中的位置（第 1 级起）
+         */
+        static bool generate(const void* level0, int width, int height, TextureFormat format,
+                             const MipmapOptions& options,
+                             std::vector<uint8_t>& outData, std::vector<MipLevel>& outLevels);
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_MIPMAP_GENERATOR_H
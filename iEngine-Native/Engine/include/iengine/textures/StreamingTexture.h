@@ -0,0 +1,105 @@
+#ifndef IENGINE_STREAMING_TEXTURE_H
+#define IENGINE_STREAMING_TEXTURE_H
+
+#include "Texture.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace iengine {
+
+    struct StreamingTextureOptions {
+        std::string name;
+        int width = 0;
+        int height = 0;
+        TextureFormat format = TextureFormat::RGBA8;  // 不支持块压缩格式
+        int bufferCount = 3;                          // 环形缓冲的缓冲区数
+        TextureWrapMode wrapS = TextureWrapMode::ClampToEdge;
+        TextureWrapMode wrapT = TextureWrapMode::ClampToEdge;
+        TextureMinFilter minFilter = TextureMinFilter::Linear;  // 每帧更新的纹理不使用 Mip
+        TextureMagFilter magFilter = TextureMagFilter::Linear;
+    };
+
+    struct StreamingTextureStats {
+        bool persistent = false;       // 是否使用持久映射的像素上传缓冲区
+        uint64_t framesWritten = 0;    // 生产者提交的更新数
+        uint64_t framesUploaded = 0;   // 已提交给 GPU 的更新数
+        uint64_t droppedWrites = 0;    // 没有空闲缓冲区而被丢弃的更新数
+        uint64_t bufferUploads = 0;    // 经像素上传缓冲区异步上传的次数
+        uint64_t directUploads = 0;    // 从客户端内存同步上传的次数（回退路径）
+        uint64_t bytesUploaded = 0;
+    };
+
+    /**
+     * @brief 每帧更新内容的纹理（视频帧、传感器热力图等）
+     *
+     * 内部是 bufferCount 个整帧大小的缓冲区组成的环：生产者线程用 beginWrite/endWrite（或 write）
+     * 把整帧或子区域写入空闲缓冲区，渲染线程上传时按提交顺序从缓冲区更新纹理并插入 fence，
+     * fence 完成后缓冲区才回到空闲状态，因此生产者写下一帧时 GPU 可以同时读取上一帧。
+     * 上下文支持持久映射（GL 4.4）时缓冲区即映射的 PBO，上传不经过 CPU 拷贝、不阻塞；
+     * 否则缓冲区位于客户端内存，上传时由驱动同步拷贝。没有空闲缓冲区时本次更新被丢弃。
+     * 纹理内容在 GPU 上，不保留 CPU 副本（不能放入纹理数组，被驻留管理驱逐后等待下一次更新）。
+     */
+    class StreamingTexture : public Texture {
+    public:
+        explicit StreamingTexture(const StreamingTextureOptions& options);
+        ~StreamingTexture() override;
+
+        /**
+         * @brief 开始写入一次更新，可在任意线程调用（同一时间只能有一个写入）
+         * @return 区域像素的写入位置，按行紧密排列（行距 width * 像素字节数）；
+         *         区域越界、已有未结束的写入或没有空闲缓冲区时返回 nullptr
+         */
+        uint8_t* beginWrite(int x, int y, int width, int height);
+        // 结束写入；commit 为 false 时放弃本次更新
+        void endWrite(bool commit = true);
+        // 拷贝一次整帧/子区域更新，data 按行紧密排列
+        bool write(const void* data);
+        bool write(const void* data, int x, int y, int width, int height);
+
+        bool needsUpdate() const override;
+        void upload(std::shared_ptr<Context> context, bool force = false) override;
+
+        size_t getFrameByteSize() const { return frameBytes_; }
+        StreamingTextureStats getStats() const;
+
+    private:
+        enum class SlotState {
+            Free,      // 可写入
+            Writing,   // 生产者正在写入
+            Ready,     // 等待上传
+            InFlight   // 已提交给 GPU，等待 fence
+        };
+
+        struct Slot {
+            SlotState state = SlotState::Free;
+            uint8_t* data = nullptr;          // 当前使用的存储：mapped 或 cpuData
+            std::vector<uint8_t> cpuData;
+            BufferHandle buffer;              // 持久映射的像素上传缓冲区
+            uint8_t* mapped = nullptr;
+            void* fence = nullptr;
+            uint64_t sequence = 0;
+            int x = 0;
+            int y = 0;
+            int width = 0;
+            int height = 0;
+        };
+
+        size_t frameBytes_ = 0;
+        size_t pixelBytes_ = 0;
+        std::vector<Slot> slots_;
+        int writingSlot_ = -1;
+        uint64_t sequence_ = 0;
+        bool buffersCreated_ = false;
+        StreamingTextureStats stats_;
+        mutable std::mutex mutex_;
+
+        void createBuffers(Context& context);
+        void useBufferStorage(Slot& slot);
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_STREAMING_TEXTURE_H
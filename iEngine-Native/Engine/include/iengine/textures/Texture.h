@@ -5,6 +5,13 @@
 #include <memory>
 #include <cstdint>
 
+#include "../core/Enums.h"
+#include "../renderers/GpuResource.h"
+#include "MipmapGenerator.h"
+#include "TextureCompressor.h"
+
+#include <vector>
+
 namespace iengine {
 
     enum class TextureKind {
@@ -61,19 +68,91 @@ namespace iengine {
         Linear
     };
 
+    // Mip 链的生成方式（只在缩小过滤使用 Mipmap 时生效）
+    enum class MipmapMode {
+        Cpu,  // 导入时在 CPU 上生成（可选滤波器、sRGB 正确、法线重新归一化），随纹理一起上传
+        Gpu   // 上传后由 glGenerateMipmap 生成，适合运行时生成/更新的纹理
+    };
+
+    // 采样参数
+    struct TextureSamplerDesc {
+        TextureWrapMode wrapS = TextureWrapMode::Repeat;
+        TextureWrapMode wrapT = TextureWrapMode::Repeat;
+        TextureMinFilter minFilter = TextureMinFilter::LinearMipmapLinear;
+        TextureMagFilter magFilter = TextureMagFilter::Linear;
+    };
+
+    // 异步加载状态
+    enum class TextureLoadState {
+        Default,   // 使用默认棋盘格数据（未指定来源）
+        Loading,   // 后台线程正在解码，期间显示默认棋盘格
+        Ready,     // 图像数据已就绪
+        Failed,    // 加载失败，保持棋盘格
+        Unloaded   // 驱逐时释放了 CPU 副本，再次使用时从源文件重新加载
+    };
+
     // 前向声明
     class OpenGLContext;
     class WebGPUContext;
     class Context;
+    class TextureLoader;
+
+    // 图像数据的释放方式：解码器分配的内存交给解码器释放，其余使用 delete[]
+    struct ImageDataDeleter {
+        void (*release)(void*) = nullptr;
+        void operator()(uint8_t* data) const {
+            if (release) release(data);
+            else delete[] data;
+        }
+    };
+    using ImageBuffer = std::unique_ptr<uint8_t[], ImageDataDeleter>;
+
+    // 解码结果：紧密排列，8 位图每通道 uint8，HDR 图每通道 float
+    struct DecodedImage {
+        ImageBuffer data;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        bool hdr = false;
+        // 以下由 Texture::importImage 填写
+        TextureFormat format = TextureFormat::RGBA8;
+        std::vector<uint8_t> mipData;
+        std::vector<MipLevel> mipLevels;  // 第 1 级起
+        double compressionPsnr = 0.0;     // 块压缩后第 0 级的 PSNR（dB），未压缩时为 0
+    };
+
+    // 导入设置：纹理创建时确定，解码线程据此选择格式并生成 Mip 链
+    struct TextureImportSettings {
+        int decodeChannels = 0;
+        bool autoFormat = true;
+        TextureFormat requestedFormat = TextureFormat::RGBA8;
+        bool srgb = false;
+        bool generateMipmaps = false;
+        MipmapOptions mipmap;
+        bool compress = false;
+        CompressionOptions compression;
+    };
 
     struct TextureOptions {
         std::string name;
         TextureWrapMode wrapS = TextureWrapMode::Repeat;
         TextureWrapMode wrapT = TextureWrapMode::Repeat;
-        TextureMinFilter minFilter = TextureMinFilter::Linear;
+        TextureMinFilter minFilter = TextureMinFilter::LinearMipmapLinear;
         TextureMagFilter magFilter = TextureMagFilter::Linear;
         // 在C++版本中，我们使用文件路径而不是图像对象
         std::string sourcePath;
+        // 像素格式；autoFormat 为 true 时按源图通道数选择能容纳的最小格式（见 chooseTextureFormat）
+        TextureFormat format = TextureFormat::RGBA8;
+        bool autoFormat = true;
+        // 颜色贴图（baseColor、emissive）可开启，按 sRGB 存储以保留暗部精度
+        bool srgb = false;
+        // Mip 链
+        MipmapMode mipmaps = MipmapMode::Cpu;
+        MipFilter mipFilter = MipFilter::Box;
+        bool normalMap = false;  // 法线贴图：Mip 各级重新归一化；压缩时使用 BC5 两通道
+        // 导入时块压缩（BC1/BC3/BC4/BC5/BC7），Mip 链强制在 CPU 上生成
+        bool compress = false;
+        CompressionQuality compressionQuality = CompressionQuality::Normal;
     };
 
     class Texture {
@@ -90,7 +169,35 @@ namespace iengine {
         TextureWrapMode getWrapT() const;
         TextureMinFilter getMinFilter() const;
         TextureMagFilter getMagFilter() const;
-        void* getGpuTexture() const;
+        TextureHandle getGpuTexture() const;
+        TextureFormat getFormat() const { return format_; }
+        TextureSamplerDesc getSamplerDesc() const { return TextureSamplerDesc{wrapS_, wrapT_, minFilter_, magFilter_}; }
+        bool usesMipmaps() const;
+        // CPU 生成的 Mip 级数（不含第 0 级），为 0 时按需使用 GPU 生成
+        size_t getMipLevelCount() const { return mipLevels_.size(); }
+        bool isResident() const { return gpuTexture_.isValid(); }
+        double getCompressionPsnr() const { return compressionPsnr_; }
+        // 图像数据版本，每次设置新数据时递增
+        uint32_t getDataVersion() const { return dataVersion_; }
+        TextureLoadState getLoadState() const { return loadState_; }
+        bool isLoading() const { return loadState_ == TextureLoadState::Loading; }
+        // 上传到 GPU 的数据量，用于上传预算估算
+        size_t getGpuByteSize() const;
+        
+        // 驻留管理
+        const std::string& getSourcePath() const { return sourcePath_; }
+        uint64_t getLastUsedFrame() const { return lastUsedFrame_; }
+        void markUsed(uint64_t frame) { lastUsedFrame_ = frame; }
+        // 当前 GPU 纹理实际占用的显存，未驻留时为 0
+        size_t getResidentByteSize() const;
+        // 为节省显存丢弃的顶层 Mip 数：上传时以第 count 级作为 GPU 纹理的第 0 级
+        int getDroppedMips() const { return droppedMips_; }
+        // 需要时在 CPU 上补全 Mip 链；Mip 不足（如压缩纹理没有 Mip 链）时返回 false
+        bool setDroppedMips(int count);
+        // 释放 GPU 纹理，下次使用时重新上传；releaseCpuData 为 true 且有源文件时同时释放 CPU 副本
+        void evict(bool releaseCpuData = false);
+        // 同步从源文件重新加载（Unloaded 状态且没有异步加载器时使用）
+        bool reloadFromSource();
 
         // Setters
         void setUnit(int unit);
@@ -99,7 +206,7 @@ namespace iengine {
         void setMinFilter(TextureMinFilter minFilter);
         void setMagFilter(TextureMagFilter magFilter);
 
-        // 状态检查
+        // 状态检查（异步加载期间不上传，由占位纹理代替）
         virtual bool needsUpdate() const;
         void markUpdated();
 
@@ -113,39 +220,92 @@ namespace iengine {
         static const uint8_t* getDefaultImageData();
         static int getDefaultWidth() { return DEFAULT_WIDTH; }
         static int getDefaultHeight() { return DEFAULT_HEIGHT; }
+        
+        /**
+         * @brief 解码图像文件，可在任意线程调用
+         *
+         * 解码器直接输出目标通道数，返回的缓冲区即最终的纹理数据，不再做额外拷贝或通道转换。
+         * @param desiredChannels 目标通道数，0 表示保持源图通道数（HDR 图为 1 或 4 通道）
+         */
+        static bool decodeImage(const std::string& filePath, DecodedImage& outImage, int desiredChannels = 0);
+        
+        /**
+         * @brief 导入图像：解码、按导入规则选择格式并在需要时生成 Mip 链，可在任意线程调用
+         */
+        static bool importImage(const std::string& filePath, const TextureImportSettings& settings, DecodedImage& outImage);
 
     protected:
         std::string name_;
         int width_;
         int height_;
         int unit_;
-        void* gpuTexture_;
+        TextureHandle gpuTexture_;
+        std::weak_ptr<Context> context_;  // 创建 GPU 纹理的上下文，析构时用于释放
         int gpuTextureWidth_;
         int gpuTextureHeight_;
+        TextureFormat gpuTextureFormat_;
         TextureWrapMode wrapS_;
         TextureWrapMode wrapT_;
         TextureMinFilter minFilter_;
         TextureMagFilter magFilter_;
         bool needsUpdate_;
         
+        TextureLoadState loadState_;
+        std::string sourcePath_;
+        
+        // 驻留状态
+        uint64_t lastUsedFrame_;
+        int droppedMips_;
+        
+        // 像素格式
+        TextureFormat format_;
+        TextureFormat requestedFormat_;
+        bool autoFormat_;
+        bool srgb_;
+        
+        // Mip 设置
+        MipmapMode mipmapMode_;
+        MipFilter mipFilter_;
+        bool normalMap_;
+        
+        // 块压缩设置
+        bool compress_;
+        CompressionQuality compressionQuality_;
+        double compressionPsnr_;
+        
         // 图像数据
-        std::unique_ptr<uint8_t[]> imageData_;
+        ImageBuffer imageData_;
         int channels_; // RGBA = 4, RGB = 3
+        uint32_t dataVersion_;
+        
+        // CPU 生成的 Mip 链（第 1 级起），运行时设置新数据后清空
+        std::vector<uint8_t> mipData_;
+        std::vector<MipLevel> mipLevels_;
         
         // 加载图像数据
         void loadFromFile(const std::string& filePath);
         
         // 设置原始图像数据
         void setImageData(const uint8_t* data, int width, int height, int channels);
+        // 接管已有缓冲区，不拷贝；数据按 format 紧密排列
+        void setImageData(ImageBuffer data, int width, int height, TextureFormat format);
+        
+        // 导入设置，以及接管导入结果
+        TextureImportSettings getImportSettings() const;
+        void setDecodedImage(DecodedImage image);
+        static void compressImage(const std::string& filePath, const TextureImportSettings& settings, DecodedImage& image);
         
         // 获取图像数据
         const uint8_t* getImageData() const { return imageData_.get(); }
         int getChannels() const { return channels_; }
 
     private:
+        friend class TextureLoader;
+        friend class TextureArrayAllocator;
+        
         static const int DEFAULT_WIDTH = 2;
         static const int DEFAULT_HEIGHT = 2;
-        static uint8_t defaultImageData_[16]; // 2x2 RGBA 数据
+        static const uint8_t defaultImageData_[16]; // 2x2 RGBA 数据（只读，多个引擎共享）
     };
 
 } // namespace iengine
@@ -0,0 +1,128 @@
+#ifndef IENGINE_TEXTURE_ARRAY_ALLOCATOR_H
+#define IENGINE_TEXTURE_ARRAY_ALLOCATOR_H
+
+#include "../core/Enums.h"
+#include "../renderers/GpuResource.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace iengine {
+
+    class Texture;
+    class Context;
+    class JobSystem;
+
+    struct TextureArrayOptions {
+        int maxLayersPerArray = 64;     // 整层数组的最大层数，满了以后再创建新数组
+        int atlasSize = 1024;           // 图集层的边长
+        int maxAtlasLayers = 16;        // 每个图集数组的最大层数
+        int maxAtlasTextureSize = 256;  // 宽高都不超过该值的未压缩纹理打包进图集
+        int atlasPadding = 4;           // 图集中每张纹理四周复制的边缘像素，避免过滤时串色
+        int atlasMipLevels = 4;         // 图集的 Mip 级数，纹理位置按 2^(级数-1) 对齐
+        size_t maxWritesPerFrame = 8;   // 每帧最多写入的纹理数
+    };
+
+    // 纹理在数组中的位置：着色器在第 layer 层以 uv * uvScale + uvOffset 取样
+    struct TextureArraySlot {
+        TextureHandle array;
+        int layer = 0;
+        float uvScale[2] = {1.0f, 1.0f};
+        float uvOffset[2] = {0.0f, 0.0f};
+        bool repeatU = true;  // 在层内区域中按 Repeat 回绕，否则夹取到边缘
+        bool repeatV = true;
+    };
+
+    /**
+     * @brief 把纹理分组放进 GL_TEXTURE_2D_ARRAY，让使用不同贴图的材质共用同一组绑定
+     *
+     * 尺寸、格式和 Mip 级数都相同的纹理各占一整层；不超过 maxAtlasTextureSize 的未压缩纹理
+     * 按格式用货架算法打包进图集层，并在四周复制边缘像素（按纹理的寻址方式回绕或夹取）。
+     * 数组按需扩容（层数翻倍后重新写入该数组中的全部纹理），纹理数据从 Texture 的 CPU 副本写入，
+     * 纹理尺寸或格式变化（如异步加载完成）时重新分配位置。
+     */
+    class TextureArrayAllocator {
+    public:
+        explicit TextureArrayAllocator(const TextureArrayOptions& options = TextureArrayOptions{});
+        ~TextureArrayAllocator();
+
+        TextureArrayAllocator(const TextureArrayAllocator&) = delete;
+        TextureArrayAllocator& operator=(const TextureArrayAllocator&) = delete;
+
+        // 为纹理分配位置（已分配时直接返回 true），数据在下一次 update 时写入
+        bool acquire(const std::shared_ptr<Texture>& texture);
+        // 获取已写入数组的纹理位置，尚未写入时返回 false
+        bool getSlot(const Texture* texture, TextureArraySlot& outSlot) const;
+
+        // 渲染线程每帧调用：回收已销毁纹理的位置，创建/扩容数组，写入新纹理或内容已变化的纹理
+        void update(const std::shared_ptr<Context>& context);
+
+        size_t getArrayCount() const;
+        size_t getTextureCount() const { return entries_.size(); }
+        void setOptions(const TextureArrayOptions& options) { options_ = options; }
+        const TextureArrayOptions& getOptions() const { return options_; }
+        // 在这里补生成 Mip 链时使用的任务调度器，为空时在调用线程上生成
+        void setJobSystem(JobSystem* jobSystem) { jobSystem_ = jobSystem; }
+        void printStats() const;
+
+    private:
+        // 图集层中的一行货架
+        struct Shelf {
+            int y = 0;
+            int height = 0;
+            int x = 0;
+        };
+
+        struct Layer {
+            std::vector<Shelf> shelves;
+            int nextY = 0;
+            int used = 0;  // 该层中的纹理数
+        };
+
+        struct Pool {
+            int width = 0;
+            int height = 0;
+            int levels = 1;
+            TextureFormat format = TextureFormat::RGBA8;
+            bool atlas = false;
+            std::vector<Layer> layers;
+            TextureHandle array;
+            int arrayLayers = 0;  // GPU 数组当前的层数，小于 layers.size() 时需要扩容
+        };
+
+        struct Entry {
+            std::weak_ptr<Texture> texture;
+            size_t pool = 0;
+            int layer = 0;
+            int x = 0;             // 区域（图集中包含边缘像素）
+            int y = 0;
+            int width = 0;
+            int height = 0;
+            int textureWidth = 0;  // 分配时纹理的尺寸和格式
+            int textureHeight = 0;
+            TextureFormat format = TextureFormat::RGBA8;
+            uint32_t writtenVersion = 0;
+            bool written = false;
+            TextureArraySlot slot;
+        };
+
+        TextureArrayOptions options_;
+        JobSystem* jobSystem_ = nullptr;
+        std::vector<Pool> pools_;
+        std::unordered_map<const Texture*, Entry> entries_;
+        std::weak_ptr<Context> context_;
+
+        bool allocate(Texture& texture, Entry& entry);
+        bool allocateAtlasRegion(Pool& pool, int width, int height, int& outLayer, int& outX, int& outY);
+        void release(const Entry& entry);
+        void writeEntry(Context& context, Entry& entry, Texture& texture);
+        int getPoolLevels(const Texture& texture) const;
+        bool fitsAtlas(const Texture& texture) const;
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_TEXTURE_ARRAY_ALLOCATOR_H
@@ -0,0 +1,66 @@
+#ifndef IENGINE_TEXTURE_COMPRESSOR_H
+#define IENGINE_TEXTURE_COMPRESSOR_H
+
+#include "../core/Enums.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace iengine {
+
+    class JobSystem;
+
+    // 压缩质量/速度预设，影响端点拟合的迭代次数和搜索范围
+    enum class CompressionQuality {
+        Fast,
+        Normal,
+        High
+    };
+
+    struct CompressionOptions {
+        CompressionQuality quality = CompressionQuality::Normal;
+        JobSystem* jobSystem = nullptr;  // 按块行分块并行使用的任务调度器，为空时在调用线程上编码
+    };
+
+    /**
+     * @brief BC1/BC3/BC4/BC5/BC7 块压缩编码器
+     *
+     * 每个 4x4 块独立编码：沿主成分方向取端点，再按质量预设做若干轮最小二乘端点修正。
+     * BC7 只使用模式 6（单子集、RGBA 7 位端点 + P 位、4 位索引），对颜色和透明度都适用。
+     * 块行分块交给任务调度器并行编码，同时逐块解码与源数据比较得到 PSNR。
+     */
+    class TextureCompressor {
+    public:
+        // 可以压缩的源格式（8 位格式）
+        static bool canCompress(TextureFormat source);
+
+        /**
+         * @brief 导入规则：单通道用 BC4，法线贴图用 BC5，不透明颜色用 BC1（High 质量用 BC7），带透明度的颜色用 BC7
+         * @return 不可压缩时返回源格式
+         */
+        static TextureFormat chooseCompressedFormat(const void* data, int width, int height, TextureFormat source,
+                                                    bool normalMap, CompressionQuality quality);
+
+        // 解压后对应的未压缩格式（驱动不支持压缩格式时使用）
+        static TextureFormat getDecompressedFormat(TextureFormat compressed);
+
+        /**
+         * @brief 压缩一个 Mip 级别
+         * @param out 输出缓冲区，大小为 getTextureLevelDataSize(target, width, height)
+         * @param outPsnr 输出与源数据相比的 PSNR（dB，可选）
+         */
+        static bool compress(const void* source, int width, int height, TextureFormat sourceFormat,
+                             TextureFormat target, const CompressionOptions& options,
+                             uint8_t* out, double* outPsnr = nullptr);
+
+        /**
+         * @brief 解压一个 Mip 级别，输出按 getDecompressedFormat(format) 紧密排列
+         *
+         * BC7 只支持本编码器生成的模式 6 块。
+         */
+        static bool decompress(const void* source, int width, int height, TextureFormat format, uint8_t* out);
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_TEXTURE_COMPRESSOR_H
@@ -0,0 +1,77 @@
+#ifndef IENGINE_TEXTURE_LOADER_H
+#define IENGINE_TEXTURE_LOADER_H
+
+#include "Texture.h"
+#include "../core/JobSystem.h"
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace iengine {
+
+    class JobSystem;
+
+    /**
+     * @brief 异步纹理加载器
+     *
+     * 文件读取、解码和 Mip 链生成作为任务提交给引擎的任务调度器，Mip 生成和块压缩也在同一调度器上并行；解码结果直接作为纹理的最终数据缓冲区；
+     * GPU 上传仍在渲染线程进行：processCompleted() 把解码结果交给纹理后，
+     * 纹理重新进入需要上传的状态，由渲染器的上传调度器按帧预算上传。
+     * 加载完成前纹理保持默认棋盘格（渲染时绑定占位纹理）。
+     *
+     * load() 和 processCompleted() 必须在渲染线程调用；future 和回调在 processCompleted() 中完成，
+     * 因此不要在渲染线程上阻塞等待 future，需要同步等待时使用 finishAll()。
+     */
+    class TextureLoader {
+    public:
+        // 参数为加载结果（true 表示成功）
+        using Callback = std::function<void(const std::shared_ptr<Texture>&, bool)>;
+
+        // jobSystem 必须比加载器存活更久，析构时会等待本加载器提交的解码任务
+        explicit TextureLoader(JobSystem& jobSystem);
+        ~TextureLoader();
+
+        TextureLoader(const TextureLoader&) = delete;
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        // 创建纹理并异步加载 options.sourcePath
+        std::shared_ptr<Texture> load(const TextureOptions& options, Callback onComplete = nullptr);
+        // 为已有纹理异步加载文件，返回的 future 在数据交给纹理后完成
+        std::shared_future<bool> load(const std::shared_ptr<Texture>& texture, const std::string& filePath,
+                                      Callback onComplete = nullptr);
+
+        // 渲染线程每帧调用：把已解码的数据交给纹理并触发回调，返回处理的数量
+        size_t processCompleted();
+        // 等待所有解码任务完成并处理结果
+        size_t finishAll();
+
+        // 尚未交给纹理的加载请求数（包括正在解码和已解码待处理的）
+        size_t getPendingCount() const;
+
+    private:
+        struct Job {
+            std::weak_ptr<Texture> texture;
+            std::string filePath;
+            Callback onComplete;
+            std::promise<bool> promise;
+            TextureImportSettings settings;
+            // 以下字段由工作线程写入
+            DecodedImage image;
+            bool success = false;
+        };
+
+        JobSystem& jobSystem_;
+        mutable std::mutex mutex_;
+        std::vector<JobHandle> decoding_;  // 已提交的解码任务，processCompleted 时移除已完成的
+        std::vector<std::shared_ptr<Job>> completed_;
+        size_t pending_ = 0;
+    };
+
+} // namespace iengine
+
+#endif // IENGINE_TEXTURE_LOADER_H
@@ -3,6 +3,8 @@
 
 #include "Texture.h"
 
+#include <cstddef>
+
 // OpenGL 前向声明
 class OpenGLContext;
 
@@ -13,6 +15,36 @@ namespace iengine {
     unsigned int getOpenGLMinFilter(TextureMinFilter filter);
     unsigned int getOpenGLMagFilter(TextureMagFilter filter);
 
+    // OpenGL 纹理格式三元组：内部格式、像素数据格式、像素数据类型
+    struct OpenGLTextureFormat {
+        unsigned int internalFormat;
+        unsigned int format;
+        unsigned int type;
+    };
+    OpenGLTextureFormat getOpenGLTextureFormat(TextureFormat format);
+
+    // 像素格式信息
+    int getTextureFormatChannels(TextureFormat format);
+    bool isFloatTextureFormat(TextureFormat format);
+    bool isCompressedTextureFormat(TextureFormat format);
+    bool isSrgbTextureFormat(TextureFormat format);
+    bool isDepthTextureFormat(TextureFormat format);
+    // GPU 上每像素占用的字节数（压缩格式返回 0，请使用 getTextureLevelSize）
+    size_t getTextureFormatBytesPerPixel(TextureFormat format);
+    // CPU 端紧密排列的数据每像素字节数（浮点格式按 float 提供数据，压缩格式返回 0）
+    size_t getTextureFormatDataBytesPerPixel(TextureFormat format);
+    // 一个 Mip 级别在 GPU 上占用的字节数，以及 CPU 端数据的字节数（压缩格式按 4x4 块计算）
+    size_t getTextureLevelSize(TextureFormat format, int width, int height);
+    size_t getTextureLevelDataSize(TextureFormat format, int width, int height);
+
+    /**
+     * @brief 导入规则：选择能容纳源图通道的最小格式
+     * @param channels 源数据通道数
+     * @param hdr 源数据是否为浮点（HDR）
+     * @param srgb 是否为颜色贴图，4 通道时使用 SRGB8_ALPHA8
+     */
+    TextureFormat chooseTextureFormat(int channels, bool hdr, bool srgb);
+
     // WebGPU 映射 (预留)
     // 在实际实现中，这些函数将映射到 WebGPU 的枚举值
     // 由于 WebGPU 需要 dawn 库，这里只提供声明
@@ -28,9 +28,27 @@ namespace iengine {
         // 获取投影矩阵
         virtual const Matrix4& getProjectionMatrix() = 0;
         
+        // 复制相机当前状态，供渲染线程使用
+        virtual std::shared_ptr<Camera> clone() const = 0;
+        
         // 获取视图投影矩阵
         Matrix4 getViewProjectionMatrix();
         
+        // 计算世界空间中位于 center 处、长度为 worldSize 的量投影到屏幕上的像素大小
+        float getProjectedSize(const Vector3& center, float worldSize, float viewportHeight);
+        
+        // 包围球是否与视锥体相交
+        bool intersectsSphere(const Vector3& center, float radius);
+        
+        // 视锥体的六个裁剪平面 (a, b, c, d)，已归一化，点在内侧时 a*x + b*y + c*z + d >= 0；
+        // 大量包围球剔除时先取一次平面再逐个测试
+        void getFrustumPlanes(float planes[6][4]);
+        
+        // 按需渲染：位置、朝向或投影参数改变后为 true，渲染后由引擎清除
+        bool isDirty() const { return dirty_; }
+        void markDirty() { dirty_ = true; }
+        void clearDirty() { dirty_ = false; }
+        
     protected:
         virtual void updateProjectionMatrix() = 0;
         void updateViewMatrix();
@@ -44,5 +62,6 @@ namespace iengine {
         
         bool viewMatrixDirty_ = true;
         bool projectionMatrixDirty_ = true;
+        bool dirty_ = true;
     };
 }
\ No newline at end of file
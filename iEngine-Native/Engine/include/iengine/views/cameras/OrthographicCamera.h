@@ -25,6 +25,9 @@ namespace iengine {
         void setFar(float far);
 
         void updateProjectionMatrix() override;
+        const Matrix4& getProjectionMatrix() override;
+
+        std::shared_ptr<Camera> clone() const override;
 
     private:
         float left_;
@@ -31,5 +31,7 @@ namespace iengine {
         
         // 实现获取投影矩阵的方法
         const Matrix4& getProjectionMatrix() override;
+        
+        std::shared_ptr<Camera> clone() const override;
     };
 }
\ No newline at end of file
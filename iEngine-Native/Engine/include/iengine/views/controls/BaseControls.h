@@ -7,5 +7,8 @@ namespace iengine {
         
         // 子类实现：移除事件监听
         virtual void dispose() = 0;
+        
+        // 把累积的输入应用到相机，每批事件分发完后自动调用，也可以手动调用
+        virtual void update() {}
     };
 }
\ No newline at end of file
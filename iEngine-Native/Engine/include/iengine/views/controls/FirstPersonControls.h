@@ -14,10 +14,12 @@ namespace iengine {
         ~FirstPersonControls() override;
         
         void dispose() override;
+        void update() override;
         
         // WindowEventListener 接口实现
         bool onWindowEvent(const WindowEvent& event) override;
         int getPriority() const override { return 100; } // 控制器优先级
+        void onEventsDispatched() override { update(); }
         
         // 向后兼容的事件处理方法
         void handleWindowEvent(const WindowEvent& event);
@@ -36,6 +38,12 @@ namespace iengine {
         // 维护本地相机位置状态（因为Camera::position_是protected）
         Vector3 currentPosition_ = Vector3(0.0f, 0.0f, 5.0f);
         
+        // 本帧累积、尚未应用的输入
+        float pendingYaw_ = 0;
+        float pendingPitch_ = 0;
+        float pendingForward_ = 0;
+        float pendingRight_ = 0;
+        
         void onMouseDown(float x, float y);
         void onMouseMove(float x, float y);
         void onMouseUp();
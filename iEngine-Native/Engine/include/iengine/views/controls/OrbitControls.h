@@ -15,10 +15,12 @@ namespace iengine {
         ~OrbitControls() override;
         
         void dispose() override;
+        void update() override;
         
         // WindowEventListener 接口实现
         bool onWindowEvent(const WindowEvent& event) override;
         int getPriority() const override { return 100; } // 控制器优先级
+        void onEventsDispatched() override { update(); }
         
         // 向后兼容的事件处理方法
         void handleWindowEvent(const WindowEvent& event);
@@ -34,6 +36,11 @@ namespace iengine {
         float phi_ = 0;
         float radius_ = 5;
         
+        // 本帧累积、尚未应用的输入
+        float pendingTheta_ = 0;
+        float pendingPhi_ = 0;
+        float pendingZoom_ = 0;
+        
         void onMouseDown(float x, float y);
         void onMouseMove(float x, float y);
         void onMouseUp();
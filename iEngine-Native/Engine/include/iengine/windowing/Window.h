@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <functional>
@@ -78,6 +81,50 @@ namespace iengine {
          * @return 优先级值
          */
         virtual int getPriority() const { return 0; }
+        
+        /**
+         * @brief 一批事件分发完后调用（排队事件每帧一批，立即分发的事件每个一批）
+         * 
+         * 控制器可以在事件回调中只累积输入，在这里一次性更新相机
+         */
+        virtual void onEventsDispatched() {}
+    };
+    
+    /**
+     * @brief 单生产者/单消费者的无锁窗口事件队列
+     * 
+     * 固定容量的环形缓冲区：生产者（窗口后端的事件回调）只写 tail_，消费者（引擎每帧）只写 head_，
+     * 两端都不加锁。队列满时 push 返回 false，由生产者决定如何处理。
+     */
+    class WindowEventQueue {
+    public:
+        // 容量向上取整为 2 的幂
+        explicit WindowEventQueue(size_t capacity = 1024);
+        
+        WindowEventQueue(const WindowEventQueue&) = delete;
+        WindowEventQueue& operator=(const WindowEventQueue&) = delete;
+        
+        // 仅生产者线程调用
+        bool push(const WindowEvent& event);
+        // 仅消费者线程调用
+        bool pop(WindowEvent& event);
+        // 任意线程调用，结果只是当时的近似值
+        bool empty() const;
+        size_t capacity() const { return buffer_.size(); }
+        
+    private:
+        std::vector<WindowEvent> buffer_;
+        size_t mask_ = 0;
+        // 两端的索引放在不同的缓存行，避免生产者和消费者互相使对方的缓存失效
+        alignas(64) std::atomic<size_t> head_{0};
+        alignas(64) std::atomic<size_t> tail_{0};
+    };
+    
+    struct WindowEventQueueStats {
+        uint64_t queued = 0;        // 进入队列的事件数
+        uint64_t dispatched = 0;    // 合并后分发的事件数
+        uint64_t coalesced = 0;     // 被合并掉的鼠标移动/滚轮事件数
+        uint64_t overflowed = 0;    // 队列满而未能入队的事件数
     };
     
     /**
@@ -85,6 +132,12 @@ namespace iengine {
      * 
      * 负责管理事件监听器的注册、注销和事件分发
      * 线程安全，支持监听器优先级
+     * 
+     * 监听器列表在增删时重建为按优先级排序的只读快照，分发时不加锁，
+     * 监听器在回调中增删监听器（如切换控制器）也不会死锁，变更从下一个事件开始生效。
+     * 
+     * 输入事件可以由窗口后端 queueEvent 放入无锁队列，引擎每帧 dispatchQueuedEvents 一次，
+     * 连续的鼠标移动只保留最后一个位置，连续的滚轮偏移累加，按键和鼠标按键保持原有顺序。
      */
     class WindowEventDispatcher {
     public:
@@ -120,6 +173,27 @@ namespace iengine {
          * @return true表示有监听器处理了事件，false表示无监听器处理
          */
         bool dispatchEvent(const WindowEvent& event);
+        
+        /**
+         * @brief 把事件放入队列，等待 dispatchQueuedEvents 分发（窗口后端的单一生产者线程调用）
+         * @return false 表示队列已满，事件未入队；生产者同时也是消费者线程时，应先 dispatchQueuedEvents
+         *         再直接分发该事件，否则它会先于队列中较早的事件送达
+         */
+        bool queueEvent(const WindowEvent& event);
+        
+        /**
+         * @brief 合并并分发队列中的事件（单一消费者线程调用，通常每帧一次）
+         * @return 分发的事件数（合并后）
+         */
+        size_t dispatchQueuedEvents();
+        
+        bool hasQueuedEvents() const { return !queue_.empty(); }
+        
+        // 是否合并连续的鼠标移动和滚轮事件，需要完整轨迹（如绘图）时关闭
+        void setCoalesceEvents(bool coalesce) { coalesceEvents_ = coalesce; }
+        bool getCoalesceEvents() const { return coalesceEvents_; }
+        
+        WindowEventQueueStats getQueueStats() const;
 
         /**
          * @brief 获取当前监听器数量
@@ -128,8 +202,41 @@ namespace iengine {
         size_t getListenerCount() const;
 
     private:
+        using ListenerList = std::vector<std::weak_ptr<WindowEventListener>>;
+        
         mutable std::mutex listenersMutex_;
-        std::vector<std::weak_ptr<WindowEventListener>> listeners_;
+        ListenerList listeners_;
+        // 分发使用的快照，增删监听器时在锁内重建，通过 atomic_load/atomic_store 读写
+        std::shared_ptr<const ListenerList> snapshot_;
+        std::atomic<uint64_t> listenersVersion_{0};
+        std::atomic<bool> hasExpiredListeners_{false};
+        
+        // 事件队列，batch_、active_ 和 received_ 只由消费者使用
+        WindowEventQueue queue_;
+        std::vector<WindowEvent> batch_;
+        std::vector<std::shared_ptr<WindowEventListener>> active_;
+        // 本批中已替换掉的快照里的监听器，批末同样要通知
+        std::vector<std::shared_ptr<WindowEventListener>> received_;
+        bool coalesceEvents_ = true;
+        std::atomic<uint64_t> queued_{0};
+        std::atomic<uint64_t> overflowed_{0};
+        uint64_t dispatched_ = 0;
+        uint64_t coalesced_ = 0;
+        
+        /**
+         * @brief 取得当前快照中仍然存活的监听器
+         */
+        void lockListeners(std::vector<std::shared_ptr<WindowEventListener>>& listeners);
+        
+        /**
+         * @brief 把事件依次交给监听器，直到有监听器处理
+         */
+        bool dispatchTo(const std::vector<std::shared_ptr<WindowEventListener>>& listeners, const WindowEvent& event);
+        
+        /**
+         * @brief 重建监听器快照（需持有锁）
+         */
+        void rebuildSnapshot();
 
         /**
          * @brief 清理已失效的监听器
@@ -154,6 +261,10 @@ namespace iengine {
         // 上下文管理（引擎核心需要）
         virtual std::shared_ptr<Context> getContext() const = 0;
         virtual void makeContextCurrent() = 0;
+        // 在调用线程上释放上下文，以便其他线程（渲染线程）使其成为当前上下文
+        virtual void doneContextCurrent() {}
+        // 呈现当前帧；由引擎的渲染线程调用，单线程模式下由应用自行交换缓冲区
+        virtual void swapBuffers() {}
         
         // 事件回调（供引擎注册，保留向后兼容）
         virtual void setEventCallback(const WindowEventCallback& callback) = 0;
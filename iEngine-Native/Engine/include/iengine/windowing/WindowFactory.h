@@ -5,6 +5,7 @@
 #include <functional>
 #include <vector>
 #include <map>
+#include <mutex>
 
 namespace iengine {
     
@@ -18,7 +19,7 @@ namespace iengine {
     // 窗口创建函数类型（返回WindowInterface指针）
     using WindowCreatorFunction = std::function<std::unique_ptr<WindowInterface>()>;
     
-    // 简化的窗口工厂（仅供注册和创建）
+    // 简化的窗口工厂（仅供注册和创建），进程内共享，所有方法线程安全
     class WindowFactory {
     public:
         // 注册窗口创建器
@@ -40,6 +41,7 @@ namespace iengine {
         WindowFactory() = delete;
         
         static std::map<WindowType, WindowCreatorFunction> creators_;
+        static std::mutex mutex_;
     };
     
 } // namespace iengine
\ No newline at end of file
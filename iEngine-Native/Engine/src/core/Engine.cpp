@@ -3,6 +3,10 @@
 #include "iengine/renderers/opengl/OpenGLRenderer.h"
 #include "iengine/shaders/ShaderLib.h"
 #include "iengine/materials/MaterialManager.h"
+#include "iengine/textures/TextureLoader.h"
+#include "iengine/core/JobSystem.h"
+#include "iengine/core/RenderThread.h"
+#include "iengine/renderers/RenderSnapshot.h"
 #include "iengine/views/cameras/PerspectiveCamera.h" // 新增：为 resize 方法中的相机类型转换
 
 #ifdef IENGINE_WEBGPU_SUPPORT
@@ -11,7 +15,6 @@
 
 #include <iostream>
 #include <memory>
-#include <chrono>
 
 namespace iengine {
 
@@ -21,7 +24,7 @@ namespace iengine {
     Engine::Engine(const EngineOptions& options) {
         // 👇 提醒用户不要创建多个实例
         int count = ++s_instanceCount;
-        if (count > 1) {
+        if (count > 1 && !options.multipleInstances) {
             std::cerr << "\n========================================" << std::endl;
             std::cerr << "[iengine] ⚠️  WARNING: Multiple Engine Instances!" << std::endl;
             std::cerr << "========================================" << std::endl;
@@ -37,11 +40,21 @@ namespace iengine {
             std::cerr << "========================================\n" << std::endl;
         }
 
+        JobSystemOptions jobOptions;
+        jobOptions.workerCount = options.jobWorkerThreads;
+        jobSystem_ = std::make_unique<JobSystem>(jobOptions);
+        textureLoader_ = std::make_unique<TextureLoader>(*jobSystem_);
+        textureMemoryBudget_ = options.textureMemoryBudget;
+        renderThreadEnabled_ = options.renderThread;
+        framePacer_.setOptions(options.framePacing);
+        onDemandRendering_ = options.onDemandRendering;
+        
         setRenderer(options.renderer, false);
     }
 
     Engine::~Engine() {
         stop();
+        --s_instanceCount;
     }
 
     void Engine::start() {
@@ -50,7 +63,8 @@ namespace iengine {
         }
 
         running_ = true;
-        lastTime_ = 0.0f;
+        framePacer_.reset();
+        requestRedraw();
 
         // 初始化渲染器（从场景获取context）
         initRenderer();
@@ -58,6 +72,11 @@ namespace iengine {
 		// 预热材质管理器中的内置着色器
         ShaderLib::registerBuiltInShaders();
 
+        // 渲染器在主线程上初始化完成后再把上下文交给渲染线程
+        if (renderThreadEnabled_) {
+            startRenderThread();
+        }
+
 		// 预热材质管理器中的内置材质
 		//registerBuiltInMaterials();   // 需要实现，甚至是作为 MaterialManager 的静态方法
 
@@ -74,6 +93,9 @@ namespace iengine {
 
         running_ = false;
 
+        // 先渲染完已提交的帧，把上下文收回主线程，再释放 GL 资源
+        stopRenderThread();
+
         // 显式释放所有 Scene
         scenes_.clear();
 
@@ -86,6 +108,10 @@ namespace iengine {
     }
 
     void Engine::addScene(const std::string& name, std::shared_ptr<Scene> scene) {
+        // 并行更新（SceneUpdateOptions::parallel）使用引擎的任务调度器
+        if (scene) {
+            scene->setJobSystem(jobSystem_.get());
+        }
         scenes_[name] = scene;
         setActiveScene(name);
     }
@@ -94,6 +120,7 @@ namespace iengine {
         auto it = scenes_.find(name);
         if (it != scenes_.end()) {
             activeScene_ = it->second;
+            requestRedraw();
             // 设置Scene的Context类型与当前渲染器匹配
             if (activeRenderer_) {
                 if (dynamic_cast<OpenGLRenderer*>(activeRenderer_.get())) {
@@ -169,6 +196,16 @@ namespace iengine {
             auto context = activeScene_->getContext();
             if (context) {
                 activeRenderer_->initialize(context);
+                // 被驱逐的纹理通过纹理加载器异步重新加载
+                if (auto* openglRenderer = dynamic_cast<OpenGLRenderer*>(activeRenderer_.get())) {
+                    auto& residency = openglRenderer->getTextureResidencyManager();
+                    residency.setTextureLoader(textureLoader_.get());
+                    if (textureMemoryBudget_ > 0) {
+                        residency.setBudget(textureMemoryBudget_);
+                    }
+                    // 绘制命令在任务调度器的工作线程上并行录制
+                    openglRenderer->setJobSystem(jobSystem_.get());
+                }
                 std::cout << "Renderer initialized with context from scene" << std::endl;
             } else {
                 std::cerr << "Error: Scene has no context" << std::endl;
@@ -176,6 +213,90 @@ namespace iengine {
         }
     }
 
+    void Engine::startRenderThread() {
+        renderWindow_ = activeScene_ ? activeScene_->getWindow() : nullptr;
+        if (!renderWindow_ || !activeRenderer_ || !activeRenderer_->isInitialized()) {
+            std::cerr << "Warning: Renderer not initialized, render thread disabled" << std::endl;
+            renderWindow_.reset();
+            renderThreadEnabled_ = false;
+            return;
+        }
+
+        snapshotBuilder_ = std::make_unique<RenderSnapshotBuilder>();
+        int width = 0;
+        int height = 0;
+        renderWindow_->getSize(width, height);
+        snapshotBuilder_->setViewportHeight(static_cast<float>(height));
+        renderThread_ = std::make_unique<RenderThread>();
+
+        // 上下文同一时刻只能在一个线程上为当前上下文
+        renderWindow_->doneContextCurrent();
+        auto window = renderWindow_;
+        renderThread_->start(
+            [this, window]() {
+                window->makeContextCurrent();
+                // GL 相关的主线程任务改由渲染线程执行
+                jobSystem_->setMainThread();
+            },
+            [this, window](RenderSnapshot& snapshot) {
+                renderSnapshot(snapshot);
+                window->swapBuffers();
+            },
+            [window]() {
+                window->doneContextCurrent();
+            });
+        std::cout << "Engine: Render thread started" << std::endl;
+    }
+
+    void Engine::stopRenderThread() {
+        if (!renderThread_) {
+            return;
+        }
+
+        renderThread_->printStats();
+        renderThread_->stop();
+        renderThread_.reset();
+        snapshotBuilder_.reset();
+
+        renderWindow_->makeContextCurrent();
+        jobSystem_->setMainThread();
+        renderWindow_.reset();
+
+        // 尚未随快照提交的渲染命令在主线程上执行完
+        std::vector<std::function<void()>> commands;
+        {
+            std::lock_guard<std::mutex> lock(renderCommandsMutex_);
+            commands.swap(renderCommands_);
+        }
+        runRenderCommands(commands);
+    }
+
+    void Engine::enqueueRenderCommand(std::function<void()> command) {
+        if (!command) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(renderCommandsMutex_);
+        renderCommands_.push_back(std::move(command));
+    }
+
+    void Engine::runRenderCommands(std::vector<std::function<void()>>& commands) {
+        for (auto& command : commands) {
+            command();
+        }
+        commands.clear();
+    }
+
+    void Engine::renderSnapshot(RenderSnapshot& snapshot) {
+        runRenderCommands(snapshot.commands);
+        jobSystem_->runMainThreadJobs();
+        textureLoader_->processCompleted();
+
+        if (activeRenderer_) {
+            activeRenderer_->renderSnapshot(snapshot);
+            rendererPendingWork_ = activeRenderer_->hasPendingWork();
+        }
+    }
+
     void Engine::update(float deltaTime) {
         // 更新场景
         if (activeScene_) {
@@ -183,34 +304,155 @@ namespace iengine {
         }
     }
 
+    void Engine::simulate(float deltaTime) {
+        // 固定步长：按积累的时间执行整数步，剩余部分由 getInterpolationAlpha() 交给渲染
+        if (framePacer_.isFixedTimestep()) {
+            const float step = static_cast<float>(framePacer_.getFixedTimestep());
+            for (int i = 0; i < framePacer_.getFixedSteps(); ++i) {
+                update(step);
+            }
+            return;
+        }
+
+        update(deltaTime);
+    }
+
     void Engine::render() {
-        if (activeRenderer_ && activeScene_) {
+        // 没有上下文（纯代码模式的场景）时渲染器未初始化，只更新不渲染
+        if (activeRenderer_ && activeRenderer_->isInitialized() && activeScene_) {
             activeRenderer_->render(activeScene_);
+            rendererPendingWork_ = activeRenderer_->hasPendingWork();
         }
     }
 
-    void Engine::tick() {
-        // 计算时间差
-        // 这里应该使用实际的时间函数
-        static auto startTime = std::chrono::steady_clock::now();
-        auto currentTime = std::chrono::steady_clock::now();
-        float currentTimeSeconds = std::chrono::duration<float>(currentTime - startTime).count();
-        float deltaTime = currentTimeSeconds - lastTime_;
-        lastTime_ = currentTimeSeconds;
+    void Engine::setOnDemandRendering(bool enabled) {
+        onDemandRendering_ = enabled;
+        requestRedraw();
+    }
+
+    bool Engine::needsRedraw() const {
+        if (!onDemandRendering_ || redrawRequested_ || rendererPendingWork_) {
+            return true;
+        }
+        if (activeScene_ && activeScene_->needsRedraw()) {
+            return true;
+        }
+        // 排队的输入事件在下一次 tick() 开始时分发，可能移动相机
+        auto window = activeScene_ ? activeScene_->getWindow() : nullptr;
+        if (window && window->getEventDispatcher().hasQueuedEvents()) {
+            return true;
+        }
+        // 这些工作在下一帧渲染前执行，需要出帧才能完成
+        if (textureLoader_->getPendingCount() > 0 || jobSystem_->hasMainThreadJobs()) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(renderCommandsMutex_);
+        return !renderCommands_.empty();
+    }
+
+    void Engine::finishRedraw() {
+        redrawRequested_ = false;
+        if (activeScene_) {
+            activeScene_->clearDirty();
+        }
+    }
+
+    void Engine::dispatchInputEvents() {
+        if (!activeScene_) {
+            return;
+        }
+        if (auto window = activeScene_->getWindow()) {
+            window->getEventDispatcher().dispatchQueuedEvents();
+        }
+    }
+
+    bool Engine::tick() {
+        // 计算时间差（钳制过长的间隔）
+        float deltaTime = static_cast<float>(framePacer_.beginFrame());
+
+        // 输入事件在更新前分发，控制器每帧只更新一次相机
+        dispatchInputEvents();
+
+        // 渲染线程模式：更新后构建快照交给渲染线程，渲染线程仍占用两个快照缓冲时在此等待
+        if (renderThread_) {
+            simulate(deltaTime);
+
+            // 场景没有变化时不构建快照，渲染线程保持空闲
+            if (!needsRedraw()) {
+                framePacer_.limitFrameRate();
+                return false;
+            }
+
+            RenderSnapshot& snapshot = renderThread_->beginSnapshot();
+            snapshot.clear();
+            {
+                std::lock_guard<std::mutex> lock(renderCommandsMutex_);
+                snapshot.commands.swap(renderCommands_);
+            }
+            if (activeScene_) {
+                snapshotBuilder_->build(*activeScene_, ++snapshotFrame_, snapshot);
+            }
+            snapshot.interpolationAlpha = getInterpolationAlpha();
+            // 快照保存的是构建时的状态，之后的修改重新标记
+            finishRedraw();
+            renderThread_->submitSnapshot();
+
+            framePacer_.limitFrameRate();
+            return true;
+        }
+
+        // 执行渲染命令和工作线程提交的主线程任务（GL 资源操作等）
+        {
+            std::vector<std::function<void()>> commands;
+            {
+                std::lock_guard<std::mutex> lock(renderCommandsMutex_);
+                commands.swap(renderCommands_);
+            }
+            if (!commands.empty()) {
+                requestRedraw();
+            }
+            runRenderCommands(commands);
+        }
+        size_t jobsRun = jobSystem_->runMainThreadJobs();
+
+        // 把后台解码完成的纹理数据交给纹理，随后由渲染器按预算上传
+        size_t texturesCompleted = textureLoader_->processCompleted();
+
+        // 任务和纹理加载可能改变了要渲染的内容
+        if (jobsRun > 0 || texturesCompleted > 0) {
+            requestRedraw();
+        }
 
         // 更新逻辑
-        update(deltaTime);
+        simulate(deltaTime);
 
-        // 渲染
-        render();
+        // 按需渲染：场景没有变化时跳过
+        bool rendered = needsRedraw();
+        if (rendered) {
+            render();
+            finishRedraw();
+        }
+
+        // 按目标帧率等待
+        framePacer_.limitFrameRate();
+        return rendered;
     }
     
     void Engine::resize(int width, int height) {
         // 参考 Web 版本的 resize 事件处理
         if (activeRenderer_) {
-            activeRenderer_->resize(width, height);
+            // 渲染线程模式下上下文不在当前线程，交给渲染线程在下一帧前执行
+            if (renderThread_) {
+                Renderer* renderer = activeRenderer_.get();
+                enqueueRenderCommand([renderer, width, height]() { renderer->resize(width, height); });
+                // LOD 在主线程构建快照时选择
+                snapshotBuilder_->setViewportHeight(static_cast<float>(height));
+            } else {
+                activeRenderer_->resize(width, height);
+            }
             std::cout << "Engine: Resized to " << width << "x" << height << std::endl;
         }
+        requestRedraw();
         
         // 更新活动场景中相机的宽高比（如果是透视相机）
         if (activeScene_) {
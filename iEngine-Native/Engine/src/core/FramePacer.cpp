@@ -0,0 +1,131 @@
+#include "iengine/core/FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace iengine {
+    namespace {
+        double secondsBetween(FramePacer::Clock::time_point from, FramePacer::Clock::time_point to) {
+            return std::chrono::duration<double>(to - from).count();
+        }
+    }
+
+    FramePacer::FramePacer(const FramePacingOptions& options) {
+        setOptions(options);
+    }
+
+    void FramePacer::setOptions(const FramePacingOptions& options) {
+        options_ = options;
+        options_.maxStepsPerFrame = std::max(options_.maxStepsPerFrame, 1);
+        options_.smoothing = std::min(std::max(options_.smoothing, 0.0), 1.0);
+        // 帧率变化后从下一帧重新对齐
+        hasDeadline_ = false;
+    }
+
+    void FramePacer::reset() {
+        started_ = false;
+        hasDeadline_ = false;
+        rawDeltaTime_ = 0.0;
+        deltaTime_ = 0.0;
+        accumulator_ = 0.0;
+        fixedSteps_ = 0;
+        alpha_ = 0.0;
+    }
+
+    double FramePacer::beginFrame() {
+        Clock::time_point now = Clock::now();
+        if (!started_) {
+            started_ = true;
+            rawDeltaTime_ = 0.0;
+        } else {
+            rawDeltaTime_ = secondsBetween(lastFrame_, now);
+        }
+        lastFrame_ = now;
+
+        deltaTime_ = rawDeltaTime_;
+        if (options_.maxDeltaTime > 0.0 && deltaTime_ > options_.maxDeltaTime) {
+            ++stats_.clampedFrames;
+            stats_.clampedSeconds += deltaTime_ - options_.maxDeltaTime;
+            deltaTime_ = options_.maxDeltaTime;
+        }
+
+        // 第一次有效间隔直接作为平滑值的初值
+        if (smoothedDeltaTime_ <= 0.0) {
+            smoothedDeltaTime_ = deltaTime_;
+        } else if (deltaTime_ > 0.0) {
+            smoothedDeltaTime_ += (deltaTime_ - smoothedDeltaTime_) * options_.smoothing;
+        }
+
+        time_ += deltaTime_;
+        ++frameIndex_;
+        ++stats_.frames;
+
+        fixedSteps_ = 0;
+        alpha_ = 0.0;
+        if (isFixedTimestep()) {
+            const double step = options_.fixedTimestep;
+            accumulator_ += deltaTime_;
+            int steps = static_cast<int>(std::floor(accumulator_ / step));
+            if (steps > options_.maxStepsPerFrame) {
+                stats_.droppedSteps += static_cast<uint64_t>(steps - options_.maxStepsPerFrame);
+                steps = options_.maxStepsPerFrame;
+                accumulator_ = std::fmod(accumulator_, step) + steps * step;
+            }
+            accumulator_ -= steps * step;
+            fixedSteps_ = steps;
+            alpha_ = std::min(std::max(accumulator_ / step, 0.0), 1.0);
+            stats_.simulationSteps += static_cast<uint64_t>(steps);
+        }
+
+        return deltaTime_;
+    }
+
+    void FramePacer::limitFrameRate() {
+        if (options_.targetFps <= 0.0 || !started_) {
+            return;
+        }
+
+        const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / options_.targetFps));
+        Clock::time_point now = Clock::now();
+
+        deadline_ = hasDeadline_ ? deadline_ + interval : lastFrame_ + interval;
+        hasDeadline_ = true;
+        if (now >= deadline_) {
+            // 落后超过一帧时不再追赶，避免之后连续不等待地突发多帧
+            if (now - deadline_ > interval) {
+                deadline_ = now;
+            }
+            return;
+        }
+
+        ++stats_.limitedFrames;
+        const auto spin = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(std::max(options_.spinThreshold, 0.0)));
+
+        // 休眠的实际时长通常比请求的长，只休眠到距目标还剩 spinThreshold 为止
+        Clock::time_point sleepStart = now;
+        while (deadline_ - now > spin) {
+            std::this_thread::sleep_for(deadline_ - now - spin);
+            now = Clock::now();
+        }
+        stats_.sleepMilliseconds += secondsBetween(sleepStart, now) * 1000.0;
+
+        Clock::time_point spinStart = now;
+        while (now < deadline_) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+        stats_.spinMilliseconds += secondsBetween(spinStart, now) * 1000.0;
+    }
+
+    void FramePacer::printStats() const {
+        std::cout << "FramePacer stats: " << stats_.frames << " frames, " << getSmoothedFps() << " fps (smoothed), "
+                  << stats_.clampedFrames << " clamped (" << stats_.clampedSeconds << " s dropped), "
+                  << stats_.simulationSteps << " fixed steps / " << stats_.droppedSteps << " dropped, "
+                  << stats_.limitedFrames << " limited frames, " << stats_.sleepMilliseconds << " ms sleep, "
+                  << stats_.spinMilliseconds << " ms spin" << std::endl;
+    }
+}
@@ -0,0 +1,413 @@
+#include "iengine/core/JobSystem.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace iengine {
+    namespace detail {
+        struct JobState {
+            std::function<void()> fn;
+            const char* name = nullptr;
+            bool mainThread = false;
+            // 未完成的依赖数，另加 1 由提交者持有，登记完全部依赖后释放
+            std::atomic<int> pendingDependencies{1};
+            std::atomic<bool> done{false};
+
+            std::mutex mutex;  // 保护 finished 和 continuations
+            bool finished = false;
+            std::vector<std::shared_ptr<JobState>> continuations;
+        };
+
+        struct ParallelForGroup {
+            const std::function<void(int, int)>* fn = nullptr;
+            const char* name = nullptr;
+            int grain = 1;
+            std::atomic<int> pending{0};  // 尚未执行完的区间数
+
+            // 第一个抛出的异常，parallelFor 等待全部区间结束后重新抛出；之后的区间不再执行
+            std::atomic<bool> failed{false};
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+    }
+
+    // 当前线程所属的调度器和工作线程序号
+    static thread_local const JobSystem* tlsJobSystem = nullptr;
+    static thread_local int tlsWorkerIndex = -1;
+
+    // 工作线程休眠前的空转次数
+    static const int SpinCount = 64;
+
+    bool JobHandle::isDone() const {
+        return !state_ || state_->done.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem(const JobSystemOptions& options)
+        : options_(options), mainThreadId_(std::this_thread::get_id()) {
+        size_t workerCount = options.workerCount;
+        if (workerCount == 0) {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 1;
+        }
+
+        for (size_t i = 0; i <= workerCount; ++i) {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+            counters_.push_back(std::make_unique<WorkerCounters>());
+        }
+        workers_.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers_.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+        std::cout << "JobSystem: started " << workerCount << " worker threads" << std::endl;
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        // 未执行的主线程任务随调度器一起丢弃
+        mainThreadJobs_.clear();
+    }
+
+    int JobSystem::getCurrentWorker() const {
+        return tlsJobSystem == this ? tlsWorkerIndex : -1;
+    }
+
+    size_t JobSystem::getCurrentQueue() const {
+        int worker = getCurrentWorker();
+        return worker >= 0 ? static_cast<size_t>(worker) : workers_.size();
+    }
+
+    size_t JobSystem::getQueueSize(size_t queue) {
+        WorkerQueue& workerQueue = *queues_[queue];
+        std::lock_guard<std::mutex> lock(workerQueue.mutex);
+        return workerQueue.jobs.size();
+    }
+
+    JobHandle JobSystem::schedule(std::function<void()> job, const char* name) {
+        return submit(std::move(job), {}, name, false);
+    }
+
+    JobHandle JobSystem::schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies,
+                                  const char* name) {
+        return submit(std::move(job), dependencies, name, false);
+    }
+
+    JobHandle JobSystem::then(const JobHandle& dependency, std::function<void()> job, const char* name) {
+        return submit(std::move(job), {dependency}, name, false);
+    }
+
+    JobHandle JobSystem::scheduleMainThread(std::function<void()> job, const std::vector<JobHandle>& dependencies,
+                                            const char* name) {
+        return submit(std::move(job), dependencies, name, true);
+    }
+
+    JobHandle JobSystem::submit(std::function<void()> job, const std::vector<JobHandle>& dependencies,
+                                const char* name, bool mainThread) {
+        auto state = std::make_shared<detail::JobState>();
+        state->fn = std::move(job);
+        state->name = name;
+        state->mainThread = mainThread;
+        jobsScheduled_.fetch_add(1, std::memory_order_relaxed);
+
+        // 依赖未完成时登记为其后续任务，依赖完成时由完成者放入队列
+        for (const auto& dependency : dependencies) {
+            if (!dependency.state_) continue;
+            std::lock_guard<std::mutex> lock(dependency.state_->mutex);
+            if (dependency.state_->finished) continue;
+            state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency.state_->continuations.push_back(state);
+        }
+        if (state->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            enqueue(state);
+        }
+        return JobHandle(state);
+    }
+
+    void JobSystem::enqueue(const JobPtr& job) {
+        if (job->mainThread) {
+            std::lock_guard<std::mutex> lock(mainThreadMutex_);
+            mainThreadJobs_.push_back(job);
+            return;
+        }
+
+        WorkerQueue& queue = *queues_[getCurrentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(job);
+            queuedJobs_.fetch_add(1, std::memory_order_release);
+        }
+        {
+            // 与休眠线程检查条件互斥，避免丢失唤醒
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+        }
+        wake_.notify_one();
+    }
+
+    JobSystem::JobPtr JobSystem::popLocal(size_t queue) {
+        WorkerQueue& workerQueue = *queues_[queue];
+        std::lock_guard<std::mutex> lock(workerQueue.mutex);
+        if (workerQueue.jobs.empty()) {
+            return nullptr;
+        }
+        JobPtr job = std::move(workerQueue.jobs.back());
+        workerQueue.jobs.pop_back();
+        queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    JobSystem::JobPtr JobSystem::steal(size_t thief) {
+        size_t count = queues_.size();
+        for (size_t i = 1; i < count; ++i) {
+            WorkerQueue& victim = *queues_[(thief + i) % count];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.jobs.empty()) continue;
+            JobPtr job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+            counters_[thief]->jobsStolen.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+        return nullptr;
+    }
+
+    bool JobSystem::runOne(size_t queue) {
+        JobPtr job = popLocal(queue);
+        if (!job) {
+            job = steal(queue);
+        }
+        if (!job) {
+            return false;
+        }
+        execute(job, queue);
+        return true;
+    }
+
+    void JobSystem::execute(const JobPtr& job, size_t queue) {
+        Clock::time_point start = Clock::now();
+        if (job->fn) {
+            // 异常不能离开工作线程，记录后照常完成任务，等待者和后续任务不会被卡住
+            try {
+                job->fn();
+            } catch (const std::exception& e) {
+                std::cerr << "JobSystem: job " << (job->name ? job->name : "(unnamed)") << " threw: " << e.what()
+                          << std::endl;
+            } catch (...) {
+                std::cerr << "JobSystem: job " << (job->name ? job->name : "(unnamed)") << " threw an unknown exception"
+                          << std::endl;
+            }
+        }
+        Clock::time_point end = Clock::now();
+
+        WorkerCounters& counters = *counters_[queue];
+        counters.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+        counters.busyMicroseconds.fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()),
+            std::memory_order_relaxed);
+        if (profileCallback_) {
+            JobProfileEvent event;
+            event.name = job->name;
+            event.worker = queue < workers_.size() ? static_cast<int>(queue) : -1;
+            event.start = start;
+            event.end = end;
+            profileCallback_(event);
+        }
+        complete(job);
+    }
+
+    void JobSystem::complete(const JobPtr& job) {
+        // 释放任务捕获的资源
+        job->fn = nullptr;
+
+        std::vector<JobPtr> continuations;
+        {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            job->finished = true;
+            continuations.swap(job->continuations);
+        }
+        job->done.store(true, std::memory_order_release);
+
+        for (const auto& continuation : continuations) {
+            if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                enqueue(continuation);
+            }
+        }
+    }
+
+    void JobSystem::workerLoop(size_t index) {
+        tlsJobSystem = this;
+        tlsWorkerIndex = static_cast<int>(index);
+
+        int idleSpins = 0;
+        for (;;) {
+            if (runOne(index)) {
+                idleSpins = 0;
+                continue;
+            }
+            if (++idleSpins < SpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+            idleSpins = 0;
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait(lock, [this] {
+                return stopping_.load() || queuedJobs_.load(std::memory_order_acquire) > 0;
+            });
+            // 停止时仍先把队列中的任务执行完
+            if (stopping_ && queuedJobs_.load(std::memory_order_acquire) <= 0) {
+                return;
+            }
+        }
+    }
+
+    size_t JobSystem::runMainThreadJobs() {
+        if (!isMainThread()) {
+            std::cerr << "JobSystem::runMainThreadJobs - must be called on the main thread" << std::endl;
+            return 0;
+        }
+
+        // 只执行调用时已就绪的任务，执行中新就绪的留到下一次
+        std::deque<JobPtr> jobs;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex_);
+            jobs.swap(mainThreadJobs_);
+        }
+        for (const auto& job : jobs) {
+            execute(job, workers_.size());
+        }
+        mainThreadJobsRun_.fetch_add(jobs.size(), std::memory_order_relaxed);
+        return jobs.size();
+    }
+
+    bool JobSystem::hasMainThreadJobs() const {
+        std::lock_guard<std::mutex> lock(mainThreadMutex_);
+        return !mainThreadJobs_.empty();
+    }
+
+    void JobSystem::wait(const JobHandle& handle) {
+        size_t queue = getCurrentQueue();
+        bool mainThread = isMainThread();
+        while (!handle.isDone()) {
+            if (runOne(queue)) continue;
+            // 等待的任务可能依赖主线程任务
+            if (mainThread && runMainThreadJobs() > 0) continue;
+            std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::waitAll(const std::vector<JobHandle>& handles) {
+        for (const auto& handle : handles) {
+            wait(handle);
+        }
+    }
+
+    void JobSystem::runRange(const std::shared_ptr<detail::ParallelForGroup>& group, int begin, int end) {
+        // 自己的队列里没有待窃取的工作时才拆分，工作已经够分时不再产生新任务
+        size_t queue = getCurrentQueue();
+        while (end - begin > group->grain && getQueueSize(queue) < 2 && !group->failed.load(std::memory_order_relaxed)) {
+            int mid = begin + (end - begin) / 2;
+            group->pending.fetch_add(1, std::memory_order_relaxed);
+            schedule([this, group, mid, end]() { runRange(group, mid, end); }, group->name);
+            end = mid;
+        }
+
+        // 无论成功与否都要减少 pending，否则 parallelFor 会一直等待
+        if (!group->failed.load(std::memory_order_acquire)) {
+            try {
+                (*group->fn)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group->errorMutex);
+                if (!group->error) {
+                    group->error = std::current_exception();
+                }
+                group->failed.store(true, std::memory_order_release);
+            }
+        }
+        parallelForChunks_.fetch_add(1, std::memory_order_relaxed);
+        group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void JobSystem::parallelFor(int count, const std::function<void(int, int)>& fn, int minChunk, const char* name) {
+        if (count <= 0) return;
+        parallelForCalls_.fetch_add(1, std::memory_order_relaxed);
+
+        int threads = static_cast<int>(workers_.size()) + 1;
+        int splits = threads * std::max(options_.parallelForSplitsPerThread, 1);
+        int grain = std::max(std::max(minChunk, 1), count / splits);
+        if (workers_.empty() || count <= grain) {
+            fn(0, count);
+            parallelForChunks_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto group = std::make_shared<detail::ParallelForGroup>();
+        group->fn = &fn;
+        group->name = name;
+        group->grain = grain;
+        group->pending.store(1, std::memory_order_relaxed);
+        runRange(group, 0, count);
+
+        // 全部区间结束后 group->fn 才不再被引用，即使有区间抛出异常也要等完
+        size_t queue = getCurrentQueue();
+        while (group->pending.load(std::memory_order_acquire) > 0) {
+            if (!runOne(queue)) {
+                std::this_thread::yield();
+            }
+        }
+        if (group->failed.load(std::memory_order_acquire)) {
+            std::rethrow_exception(group->error);
+        }
+    }
+
+    void JobSystem::setProfileCallback(ProfileCallback callback) {
+        profileCallback_ = std::move(callback);
+    }
+
+    JobSystemStats JobSystem::getStats() const {
+        JobSystemStats stats;
+        stats.jobsScheduled = jobsScheduled_.load(std::memory_order_relaxed);
+        stats.mainThreadJobs = mainThreadJobsRun_.load(std::memory_order_relaxed);
+        stats.parallelForCalls = parallelForCalls_.load(std::memory_order_relaxed);
+        stats.parallelForChunks = parallelForChunks_.load(std::memory_order_relaxed);
+        for (const auto& counters : counters_) {
+            JobWorkerStats worker;
+            worker.jobsExecuted = counters->jobsExecuted.load(std::memory_order_relaxed);
+            worker.jobsStolen = counters->jobsStolen.load(std::memory_order_relaxed);
+            worker.busyMicroseconds = counters->busyMicroseconds.load(std::memory_order_relaxed);
+            stats.workers.push_back(worker);
+        }
+        return stats;
+    }
+
+    void JobSystem::resetStats() {
+        jobsScheduled_ = 0;
+        mainThreadJobsRun_ = 0;
+        parallelForCalls_ = 0;
+        parallelForChunks_ = 0;
+        for (auto& counters : counters_) {
+            counters->jobsExecuted = 0;
+            counters->jobsStolen = 0;
+            counters->busyMicroseconds = 0;
+        }
+    }
+
+    void JobSystem::printStats() const {
+        JobSystemStats stats = getStats();
+        std::cout << "JobSystem stats: " << stats.jobsScheduled << " jobs scheduled, " << stats.mainThreadJobs
+                  << " main thread jobs, " << stats.parallelForCalls << " parallelFor calls (" << stats.parallelForChunks
+                  << " chunks)" << std::endl;
+        for (size_t i = 0; i < stats.workers.size(); ++i) {
+            const JobWorkerStats& worker = stats.workers[i];
+            std::cout << "  " << (i < workers_.size() ? "worker " + std::to_string(i) : std::string("external"))
+                      << ": " << worker.jobsExecuted << " executed, " << worker.jobsStolen << " stolen, "
+                      << worker.busyMicroseconds / 1000.0 << " ms busy" << std::endl;
+        }
+    }
+}
@@ -29,6 +29,13 @@ namespace iengine {
         }
     }
     
+    Mesh::~Mesh() {
+        // 上下文已销毁时其资源也已随之释放
+        if (auto context = uploadContext.lock()) {
+            release(context);
+        }
+    }
+    
     bool Mesh::hasNormal() const {
         for (const auto& pair : vertexAttributeDataMap) {
             if (pair.first == "aNormal" && !pair.second.empty()) {
@@ -148,33 +155,109 @@ namespace iengine {
         return defines;
     }
     
+    bool Mesh::hasLods() const {
+        return primitive->type == PrimitiveType::TRIANGLES && geometry->getLodCount() > 1;
+    }
+    
+    size_t Mesh::getLodCount() const {
+        return hasLods() ? geometry->getLodCount() : 1;
+    }
+    
+    size_t Mesh::getGpuByteSize() const {
+        size_t indexCount = geometry->indices.size() + geometry->lodIndices.size();
+        return geometry->vertexCount * getVertexLayout().arrayStride + indexCount * sizeof(unsigned int);
+    }
+    
     void Mesh::upload(std::shared_ptr<Context> context, bool force) {
-        if (uploaded && !force) return;
+        if (uploaded && !force && !dirty) return;
+        uploadContext = context;
         
-        std::cout << "Uploading mesh to GPU..." << std::endl;
+        // 流式数据每帧都会重写，不输出逐步日志
+        const bool verbose = usage != BufferUsage::Stream;
+        if (verbose) std::cout << "Uploading mesh to GPU..." << std::endl;
         
         // 1. 获取顶点布局
-        std::cout << "Getting vertex layout..." << std::endl;
         VertexLayout layout = getVertexLayout();
-        std::cout << "Vertex layout created, stride: " << layout.arrayStride << std::endl;
+        if (verbose) std::cout << "Vertex layout created, stride: " << layout.arrayStride << std::endl;
         
         // 2. 构建交错缓冲区
-        std::cout << "Building interleaved buffer..." << std::endl;
         std::vector<float> interleavedBuffer = buildInterleavedBuffer(layout);
-        std::cout << "Interleaved buffer size: " << interleavedBuffer.size() << " floats" << std::endl;
+        if (verbose) std::cout << "Interleaved buffer size: " << interleavedBuffer.size() << " floats" << std::endl;
+        
+        // LOD 索引拼接在第0级索引之后，放在同一段索引区间中
+        const std::vector<unsigned int>* indexData = &geometry->indices;
+        std::vector<unsigned int> combinedIndices;
+        if (!geometry->indices.empty() && !geometry->lodIndices.empty()) {
+            combinedIndices.reserve(geometry->indices.size() + geometry->lodIndices.size());
+            combinedIndices.insert(combinedIndices.end(), geometry->indices.begin(), geometry->indices.end());
+            combinedIndices.insert(combinedIndices.end(), geometry->lodIndices.begin(), geometry->lodIndices.end());
+            indexData = &combinedIndices;
+        }
+        
+        // 3. 流式数据写入当前帧的环形缓冲区；空间不足时本帧回退到动态缓冲区
+        streamRange = StreamBufferRange{};
+        if (usage == BufferUsage::Stream && !interleavedBuffer.empty()) {
+            if (context->writeStreamData(layout, interleavedBuffer.data(), geometry->vertexCount,
+                                         indexData->empty() ? nullptr : indexData->data(), indexData->size(),
+                                         streamRange)) {
+                uploaded = true;
+                dirty = false;
+                return;
+            }
+        }
+        
+        // 4. 动态数据原地更新独立缓冲区（孤立旧存储或扩容），保持缓冲区对象不变，已建立的 VAO 仍然有效
+        if (usage != BufferUsage::Static) {
+            if (bufferAllocation) {
+                context->freeMeshBuffers(bufferAllocation);
+                bufferAllocation = 0;
+            }
+            if (!interleavedBuffer.empty()) {
+                size_t bytes = interleavedBuffer.size() * sizeof(float);
+                if (!vbo) vbo = context->createVertexBuffer(bytes, usage);
+                context->writeBuffer(vbo, interleavedBuffer.data(), bytes, 0);
+            }
+            if (!indexData->empty()) {
+                size_t bytes = indexData->size() * sizeof(unsigned int);
+                if (!ibo) ibo = context->createIndexBuffer(bytes, usage);
+                context->writeBuffer(ibo, indexData->data(), bytes, 0);
+            }
+            uploaded = true;
+            dirty = false;
+            return;
+        }
         
-        // 3. 清理旧缓冲区
+        // 5. 清理旧缓冲区
         std::cout << "Cleaning old buffers..." << std::endl;
+        if (bufferAllocation) {
+            context->freeMeshBuffers(bufferAllocation);
+            bufferAllocation = 0;
+        }
         if (vbo) {
             context->deleteBuffer(vbo);
-            vbo = nullptr;
+            vbo = BufferHandle{};
         }
         if (ibo && !geometry->indices.empty()) {
             context->deleteBuffer(ibo);
-            ibo = nullptr;
+            ibo = BufferHandle{};
         }
         
-        // 4. 创建新缓冲区
+        // 6. 优先从缓冲区池中子分配
+        if (usePooledBuffers && !interleavedBuffer.empty()) {
+            bufferAllocation = context->allocateMeshBuffers(
+                layout, interleavedBuffer.data(), geometry->vertexCount,
+                indexData->empty() ? nullptr : indexData->data(), indexData->size());
+            if (bufferAllocation) {
+                uploaded = true;
+                dirty = false;
+                std::cout << "Mesh uploaded to buffer pool. Vertices: " << geometry->vertexCount
+                          << ", Indices: " << geometry->indexCount << std::endl;
+                return;
+            }
+            std::cout << "Buffer pool unavailable, falling back to dedicated buffers" << std::endl;
+        }
+        
+        // 7. 创建独立缓冲区
         std::cout << "Creating new buffers..." << std::endl;
         if (!interleavedBuffer.empty()) {
             std::cout << "Creating vertex buffer..." << std::endl;
@@ -185,20 +268,40 @@ namespace iengine {
             std::cout << "Vertex buffer created and written" << std::endl;
         }
         
-        if (!geometry->indices.empty()) {
+        if (!indexData->empty()) {
             std::cout << "Creating index buffer..." << std::endl;
-            ibo = context->createIndexBuffer(geometry->indices.size() * sizeof(unsigned int));
+            ibo = context->createIndexBuffer(indexData->size() * sizeof(unsigned int));
             std::cout << "Writing index buffer data..." << std::endl;
-            context->writeBuffer(ibo, geometry->indices.data(), 
-                               geometry->indices.size() * sizeof(unsigned int), 0);
+            context->writeBuffer(ibo, indexData->data(), 
+                               indexData->size() * sizeof(unsigned int), 0);
             std::cout << "Index buffer created and written" << std::endl;
         }
         
         uploaded = true;
+        dirty = false;
         std::cout << "Mesh uploaded successfully. Vertices: " << geometry->vertexCount 
                   << ", Indices: " << geometry->indexCount << std::endl;
     }
     
+    void Mesh::release(std::shared_ptr<Context> context) {
+        if (!context) return;
+        
+        if (bufferAllocation) {
+            context->freeMeshBuffers(bufferAllocation);
+            bufferAllocation = 0;
+        }
+        if (vbo) {
+            context->deleteBuffer(vbo);
+            vbo = BufferHandle{};
+        }
+        if (ibo) {
+            context->deleteBuffer(ibo);
+            ibo = BufferHandle{};
+        }
+        streamRange = StreamBufferRange{};
+        uploaded = false;
+    }
+    
     std::vector<float> Mesh::buildInterleavedBuffer(const VertexLayout& layout) const {
         if (geometry->vertexCount == 0) {
             return {};
@@ -1,4 +1,10 @@
 #include "iengine/core/Model.h"
+#include "iengine/scenes/Scene.h"
+#include "iengine/scenes/SceneComponents.h"
+#include "iengine/views/cameras/Camera.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace iengine {
     Model::Model(const std::string& name, 
@@ -7,20 +13,109 @@ namespace iengine {
         : name(name), mesh(mesh), material(material) {}
     
     void Model::setPosition(float x, float y, float z) {
-        transform_.setIdentity();
+        Matrix4 transform;
+        transform.setIdentity();
         // 这里应该设置平移变换
+        setTransform(transform);
     }
     
     void Model::setRotation(float x, float y, float z) {
         // 这里应该设置旋转变换
+        markTransformDirty();
     }
     
     void Model::setScale(float x, float y, float z) {
         // 这里应该设置缩放变换
+        markTransformDirty();
+    }
+    
+    Matrix4 Model::getTransform() const {
+        if (scene_) {
+            if (const auto* transform = scene_->getRegistry().get<TransformComponent>(entity_)) {
+                return transform->matrix;
+            }
+        }
+        return transform_;
+    }
+    
+    void Model::setTransform(const Matrix4& transform) {
+        // 实体增删组件后组件列会搬移，每次写入时重新查找
+        TransformComponent* component = scene_ ? scene_->getRegistry().get<TransformComponent>(entity_) : nullptr;
+        if (component) {
+            component->matrix = transform;
+        } else {
+            transform_ = transform;
+        }
+        markTransformDirty();
+    }
+    
+    void Model::setMesh(std::shared_ptr<Mesh> mesh) {
+        this->mesh = std::move(mesh);
+        markDirty();
+    }
+    
+    void Model::setMaterial(std::shared_ptr<Material> material) {
+        this->material = std::move(material);
+        markDirty();
+    }
+    
+    EntityStateComponent* Model::getState() const {
+        return scene_ ? scene_->getRegistry().get<EntityStateComponent>(entity_) : nullptr;
+    }
+    
+    void Model::setVisible(bool visible) {
+        if (auto* state = getState()) {
+            state->visible = visible ? 1 : 0;
+            state->dirty = 1;
+        } else {
+            visible_ = visible;
+            dirty_ = true;
+        }
+    }
+    
+    bool Model::isVisible() const {
+        const auto* state = getState();
+        return state ? state->visible != 0 : visible_;
+    }
+    
+    bool Model::isDirty() const {
+        const auto* state = getState();
+        return state ? state->dirty != 0 : dirty_;
+    }
+    
+    void Model::markDirty() {
+        if (auto* state = getState()) {
+            state->dirty = 1;
+            state->boundsDirty = 1;
+            state->resourcesDirty = 1;
+        } else {
+            dirty_ = true;
+        }
+    }
+    
+    void Model::clearDirty() {
+        if (auto* state = getState()) {
+            state->dirty = 0;
+        } else {
+            dirty_ = false;
+        }
+    }
+    
+    void Model::markTransformDirty() {
+        if (auto* state = getState()) {
+            state->dirty = 1;
+            state->boundsDirty = 1;
+        } else {
+            dirty_ = true;
+        }
     }
     
     void Model::addAnimation(const AnimationCallback& callback) {
         animations_.push_back(callback);
+        markDirty();
+        if (scene_) {
+            scene_->enableAnimation(entity_);
+        }
     }
     
     void Model::update(float deltaTime) {
@@ -28,4 +123,95 @@ namespace iengine {
             callback(*this, deltaTime);
         }
     }
+    
+    bool Model::getWorldBoundingSphere(Vector3& center, float& radius) const {
+        if (!mesh || !mesh->geometry) {
+            return false;
+        }
+        
+        const auto& geometry = *mesh->geometry;
+        const Matrix4 transform = getTransform();
+        const auto& m = transform.elements;
+        
+        // 包围盒中心变换到世界空间
+        float cx = (geometry.boundingBox.min[0] + geometry.boundingBox.max[0]) * 0.5f;
+        float cy = (geometry.boundingBox.min[1] + geometry.boundingBox.max[1]) * 0.5f;
+        float cz = (geometry.boundingBox.min[2] + geometry.boundingBox.max[2]) * 0.5f;
+        center = Vector3(
+            m[0] * cx + m[4] * cy + m[8] * cz + m[12],
+            m[1] * cx + m[5] * cy + m[9] * cz + m[13],
+            m[2] * cx + m[6] * cy + m[10] * cz + m[14]);
+        
+        // 半径为包围盒半对角线乘以最大轴向缩放
+        float scale = std::sqrt(std::max({
+            m[0] * m[0] + m[1] * m[1] + m[2] * m[2],
+            m[4] * m[4] + m[5] * m[5] + m[6] * m[6],
+            m[8] * m[8] + m[9] * m[9] + m[10] * m[10]}));
+        radius = geometry.getBoundingDiagonal() * scale * 0.5f;
+        return true;
+    }
+    
+    size_t Model::getCurrentLod() const {
+        if (scene_) {
+            if (const auto* lod = scene_->getRegistry().get<LodComponent>(entity_)) {
+                return lod->level;
+            }
+        }
+        return currentLod_;
+    }
+    
+    size_t Model::selectLod(Camera& camera, float viewportHeight) {
+        size_t level = 0;
+        if (mesh && mesh->hasLods() && lodOptions_.enabled && viewportHeight > 0.0f) {
+            // LOD 误差是相对包围盒对角线的，即包围球直径
+            Vector3 center;
+            float radius = 0.0f;
+            getWorldBoundingSphere(center, radius);
+            float pixelsPerUnitError = camera.getProjectedSize(center, radius * 2.0f, viewportHeight);
+            level = selectLodLevel(*mesh->geometry, lodOptions_, getCurrentLod(), pixelsPerUnitError);
+        }
+        
+        LodComponent* lod = scene_ ? scene_->getRegistry().get<LodComponent>(entity_) : nullptr;
+        if (lod) {
+            lod->level = static_cast<uint32_t>(level);
+        } else {
+            currentLod_ = level;
+        }
+        return level;
+    }
+    
+    size_t Model::selectLodLevel(const Geometry& geometry, const LodSelectionOptions& options,
+                                 size_t currentLevel, float pixelsPerUnitError) {
+        const size_t lodCount = geometry.getLodCount();
+        if (lodCount <= 1) {
+            return 0;
+        }
+        const float threshold = options.pixelErrorThreshold * options.bias;
+        auto projectedError = [&](size_t level) {
+            return geometry.getLodLevel(level).error * pixelsPerUnitError;
+        };
+        
+        // 找到误差不超过 limit 的最粗糙级别（级别越高误差越大）
+        auto coarsestWithin = [&](float limit) {
+            size_t level = 0;
+            for (size_t i = 1; i < lodCount; ++i) {
+                if (projectedError(i) <= limit) level = i;
+                else break;
+            }
+            return level;
+        };
+        
+        size_t level = std::min(currentLevel, lodCount - 1);
+        if (projectedError(level) > threshold * (1.0f + options.hysteresis)) {
+            // 当前级别误差明显超标，切换到更精细的级别
+            level = coarsestWithin(threshold);
+        } else {
+            // 只有误差足够小时才切换到更粗糙的级别
+            size_t coarser = coarsestWithin(threshold * (1.0f - options.hysteresis));
+            if (coarser > level) {
+                level = coarser;
+            }
+        }
+        return level;
+    }
 }
\ No newline at end of file
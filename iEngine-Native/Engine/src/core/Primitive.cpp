@@ -2,7 +2,7 @@
 
 namespace iengine {
     // 静态成员初始化
-    std::map<std::string, VertexFormatInfo> Primitive::VertexFormatInfoMap = {
+    const std::map<std::string, VertexFormatInfo> Primitive::VertexFormatInfoMap = {
         {"float32", {1, 0x1406, false}},     // GL_FLOAT
         {"float32x2", {2, 0x1406, false}},   // GL_FLOAT
         {"float32x3", {3, 0x1406, false}},   // GL_FLOAT  
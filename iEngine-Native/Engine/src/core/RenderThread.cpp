@@ -0,0 +1,174 @@
+#include "iengine/core/RenderThread.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace iengine {
+    namespace {
+        double millisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    RenderThread::~RenderThread() {
+        stop();
+    }
+
+    bool RenderThread::start(Callback onStart, RenderFunction render, Callback onStop) {
+        if (thread_.joinable()) {
+            std::cerr << "RenderThread: already running" << std::endl;
+            return false;
+        }
+        if (!render) {
+            std::cerr << "RenderThread: render function not set" << std::endl;
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = false;
+        }
+        thread_ = std::thread(&RenderThread::loop, this, std::move(onStart), std::move(render), std::move(onStop));
+        return true;
+    }
+
+    void RenderThread::stop() {
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+        threadId_ = std::thread::id();
+
+        // 线程已退出，未渲染的缓冲（正在写入的除外）全部归还
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.clear();
+        for (int i = 0; i < kBufferCount; ++i) {
+            if (states_[i] != BufferState::Writing) {
+                states_[i] = BufferState::Free;
+            }
+        }
+    }
+
+    RenderSnapshot& RenderThread::beginSnapshot() {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (writing_ >= 0) {
+            std::cerr << "RenderThread: beginSnapshot called twice without submitSnapshot" << std::endl;
+            return buffers_[writing_];
+        }
+
+        auto findFree = [this]() {
+            for (int i = 0; i < kBufferCount; ++i) {
+                if (states_[i] == BufferState::Free) {
+                    return i;
+                }
+            }
+            return -1;
+        };
+        changed_.wait(lock, [&]() { return findFree() >= 0; });
+
+        writing_ = findFree();
+        states_[writing_] = BufferState::Writing;
+        stats_.mainWaitMilliseconds += millisecondsSince(start);
+        return buffers_[writing_];
+    }
+
+    void RenderThread::submitSnapshot() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (writing_ < 0) {
+                std::cerr << "RenderThread: submitSnapshot called without beginSnapshot" << std::endl;
+                return;
+            }
+            // 线程未运行时丢弃，避免缓冲永远不被归还
+            if (!thread_.joinable() || stopping_) {
+                states_[writing_] = BufferState::Free;
+                writing_ = -1;
+                return;
+            }
+            states_[writing_] = BufferState::Ready;
+            ready_.push_back(writing_);
+            writing_ = -1;
+            ++stats_.framesSubmitted;
+        }
+        changed_.notify_all();
+    }
+
+    void RenderThread::waitIdle() {
+        if (isRenderThread()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this]() {
+            if (!ready_.empty()) {
+                return false;
+            }
+            for (int i = 0; i < kBufferCount; ++i) {
+                if (states_[i] == BufferState::Rendering) {
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    void RenderThread::loop(Callback onStart, RenderFunction render, Callback onStop) {
+        threadId_ = std::this_thread::get_id();
+        if (onStart) {
+            onStart();
+        }
+
+        while (true) {
+            int index = -1;
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::unique_lock<std::mutex> lock(mutex_);
+                // 停止前先渲染完已提交的快照
+                changed_.wait(lock, [this]() { return !ready_.empty() || stopping_; });
+                if (ready_.empty()) {
+                    break;
+                }
+                index = ready_.front();
+                ready_.pop_front();
+                states_[index] = BufferState::Rendering;
+                stats_.renderWaitMilliseconds += millisecondsSince(start);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            render(buffers_[index]);
+            double elapsed = millisecondsSince(start);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                states_[index] = BufferState::Free;
+                ++stats_.framesRendered;
+                stats_.renderMilliseconds += elapsed;
+            }
+            changed_.notify_all();
+        }
+
+        if (onStop) {
+            onStop();
+        }
+    }
+
+    RenderThreadStats RenderThread::getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void RenderThread::printStats() const {
+        RenderThreadStats stats = getStats();
+        double rendered = stats.framesRendered > 0 ? static_cast<double>(stats.framesRendered) : 1.0;
+        std::cout << "RenderThread stats: " << stats.framesSubmitted << " frames submitted, " << stats.framesRendered
+                  << " rendered, " << stats.renderMilliseconds / rendered << " ms/frame render, "
+                  << stats.mainWaitMilliseconds << " ms main thread waiting, " << stats.renderWaitMilliseconds
+                  << " ms render thread waiting" << std::endl;
+    }
+}
@@ -0,0 +1,70 @@
+#include "iengine/core/ThreadPool.h"
+
+namespace iengine {
+    ThreadPool::ThreadPool(size_t threadCount) {
+        if (threadCount == 0) {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            threadCount = hardware > 1 ? hardware - 1 : 1;
+        }
+        workers_.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        taskAvailable_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::enqueue(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        taskAvailable_.notify_one();
+    }
+
+    void ThreadPool::waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return tasks_.empty() && activeCount_ == 0; });
+    }
+
+    size_t ThreadPool::getPendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size() + activeCount_;
+    }
+
+    void ThreadPool::workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                taskAvailable_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                // 停止时仍先把队列中的任务执行完
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                activeCount_++;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                activeCount_--;
+                if (tasks_.empty() && activeCount_ == 0) {
+                    idle_.notify_all();
+                }
+            }
+        }
+    }
+}
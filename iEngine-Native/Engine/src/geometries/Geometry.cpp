@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <cmath>
 
 namespace iengine {
     Geometry::Geometry(const std::vector<float>& vertices,
@@ -22,6 +23,23 @@ namespace iengine {
         boundingBox = computeBoundingBox();
     }
     
+    Geometry::LodLevel Geometry::getLodLevel(size_t level) const {
+        if (lodLevels.empty()) {
+            LodLevel base;
+            base.indexCount = indexCount;
+            return base;
+        }
+        return lodLevels[std::min(level, lodLevels.size() - 1)];
+    }
+    
+    float Geometry::getBoundingDiagonal() const {
+        if (vertexCount == 0) return 0.0f;
+        float dx = boundingBox.max[0] - boundingBox.min[0];
+        float dy = boundingBox.max[1] - boundingBox.min[1];
+        float dz = boundingBox.max[2] - boundingBox.min[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    
     Geometry::BoundingBox Geometry::computeBoundingBox() {
         BoundingBox box;
         box.min = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
@@ -0,0 +1,411 @@
+#include "iengine/geometries/MeshSimplifier.h"
+#include "iengine/geometries/Geometry.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace iengine {
+
+    namespace {
+
+        // 对称 4x4 矩阵，只存上三角 10 个元素
+        struct Quadric {
+            double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+            double a11 = 0, a12 = 0, a13 = 0;
+            double a22 = 0, a23 = 0;
+            double a33 = 0;
+            double w = 0;  // 累积权重，用于把误差归一化为平均平方距离
+
+            void addPlane(double a, double b, double c, double d, double weight) {
+                a00 += weight * a * a; a01 += weight * a * b; a02 += weight * a * c; a03 += weight * a * d;
+                a11 += weight * b * b; a12 += weight * b * c; a13 += weight * b * d;
+                a22 += weight * c * c; a23 += weight * c * d;
+                a33 += weight * d * d;
+                w += weight;
+            }
+
+            void add(const Quadric& q) {
+                a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+                a11 += q.a11; a12 += q.a12; a13 += q.a13;
+                a22 += q.a22; a23 += q.a23;
+                a33 += q.a33;
+                w += q.w;
+            }
+
+            // v^T Q v / w，v = (x, y, z, 1)
+            double evaluate(double x, double y, double z) const {
+                if (w <= 0.0) return 0.0;
+                double r = a00 * x * x + a11 * y * y + a22 * z * z + a33
+                    + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z + a03 * x + a13 * y + a23 * z);
+                return r < 0.0 ? 0.0 : r / w;
+            }
+        };
+
+        enum class VertexKind : unsigned char {
+            Manifold,  // 内部顶点，可自由折叠
+            Border,    // 开放边界顶点，只能沿边界边折叠
+            Locked     // 接缝/非流形/锁定的边界顶点，不允许移动
+        };
+
+        struct Collapse {
+            unsigned int v0;  // 被移除的顶点
+            unsigned int v1;  // 折叠目标顶点
+            double cost;      // 排序用代价（几何误差 + 属性误差）
+            double error;     // 纯几何误差，用于屏幕空间 LOD 选择
+        };
+
+        inline unsigned long long edgeKey(unsigned int a, unsigned int b) {
+            return (static_cast<unsigned long long>(a) << 32) | b;
+        }
+
+        struct Vec3d {
+            double x, y, z;
+        };
+
+        inline Vec3d sub(const Vec3d& a, const Vec3d& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+        inline Vec3d cross(const Vec3d& a, const Vec3d& b) {
+            return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+        }
+        inline double dot(const Vec3d& a, const Vec3d& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+        // 邻接表（CSR 格式）：每个顶点引用到的三角形列表
+        struct Adjacency {
+            std::vector<unsigned int> offsets;
+            std::vector<unsigned int> triangles;
+
+            void build(const std::vector<unsigned int>& indices, size_t vertexCount) {
+                offsets.assign(vertexCount + 1, 0);
+                for (unsigned int index : indices) {
+                    offsets[index + 1]++;
+                }
+                for (size_t i = 0; i < vertexCount; ++i) {
+                    offsets[i + 1] += offsets[i];
+                }
+                triangles.resize(indices.size());
+                std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    triangles[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+                }
+            }
+        };
+
+        // 计算两个顶点之间的属性差异（法线、UV、颜色），用于属性感知的折叠代价
+        double attributeDistance(const Geometry& geometry, unsigned int a, unsigned int b, const SimplifyOptions& options) {
+            double result = 0.0;
+            auto accumulate = [&](const std::vector<float>& data, size_t components, float weight) {
+                if (weight <= 0.0f || data.size() < (std::max(a, b) + 1) * components) return;
+                double sum = 0.0;
+                for (size_t c = 0; c < components; ++c) {
+                    double d = static_cast<double>(data[a * components + c]) - data[b * components + c];
+                    sum += d * d;
+                }
+                result += weight * sum;
+            };
+            accumulate(geometry.normals, 3, options.normalWeight);
+            accumulate(geometry.texCoords, 2, options.uvWeight);
+            accumulate(geometry.colors0, 4, options.colorWeight);
+            return result;
+        }
+    }
+
+    std::vector<unsigned int> MeshSimplifier::simplify(
+        const Geometry& geometry,
+        const std::vector<unsigned int>& indices,
+        size_t targetIndexCount,
+        const SimplifyOptions& options,
+        float* outError) {
+
+        if (outError) *outError = 0.0f;
+
+        const size_t vertexCount = geometry.vertexCount;
+        if (indices.size() % 3 != 0 || vertexCount == 0 || indices.size() <= targetIndexCount) {
+            return indices;
+        }
+
+        // 1. 把位置归一化到包围盒对角线尺度，使误差成为相对值
+        const float diagonal = geometry.getBoundingDiagonal();
+        const double invScale = diagonal > 0.0f ? 1.0 / diagonal : 1.0;
+        std::vector<Vec3d> positions(vertexCount);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            positions[i] = {
+                (geometry.vertices[i * 3 + 0] - geometry.boundingBox.min[0]) * invScale,
+                (geometry.vertices[i * 3 + 1] - geometry.boundingBox.min[1]) * invScale,
+                (geometry.vertices[i * 3 + 2] - geometry.boundingBox.min[2]) * invScale
+            };
+        }
+
+        // 2. 按位置焊接顶点，找出属性接缝（同一位置存在多个顶点）
+        std::vector<unsigned int> weld(vertexCount);
+        std::vector<unsigned int> weldCount(vertexCount, 0);
+        {
+            struct PositionHash {
+                size_t operator()(const std::array<float, 3>& p) const {
+                    unsigned int h[3];
+                    std::memcpy(h, p.data(), sizeof(h));
+                    return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+                }
+            };
+            std::unordered_map<std::array<float, 3>, unsigned int, PositionHash> firstByPosition;
+            firstByPosition.reserve(vertexCount);
+            for (size_t i = 0; i < vertexCount; ++i) {
+                std::array<float, 3> p = {geometry.vertices[i * 3], geometry.vertices[i * 3 + 1], geometry.vertices[i * 3 + 2]};
+                auto result = firstByPosition.emplace(p, static_cast<unsigned int>(i));
+                weld[i] = result.first->second;
+                weldCount[weld[i]]++;
+            }
+        }
+
+        // 3. 基于焊接后的拓扑统计有向边，识别边界边与非流形边
+        std::unordered_map<unsigned long long, unsigned int> directedEdges;
+        directedEdges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            for (int e = 0; e < 3; ++e) {
+                unsigned int a = weld[indices[i + e]];
+                unsigned int b = weld[indices[i + (e + 1) % 3]];
+                directedEdges[edgeKey(a, b)]++;
+            }
+        }
+
+        std::vector<VertexKind> kinds(vertexCount, VertexKind::Manifold);
+        auto isBorderEdge = [&](unsigned int a, unsigned int b) {
+            return directedEdges.find(edgeKey(weld[b], weld[a])) == directedEdges.end();
+        };
+        for (const auto& pair : directedEdges) {
+            unsigned int a = static_cast<unsigned int>(pair.first >> 32);
+            unsigned int b = static_cast<unsigned int>(pair.first & 0xffffffffu);
+            if (pair.second > 1) {
+                kinds[a] = VertexKind::Locked;
+                kinds[b] = VertexKind::Locked;
+            } else if (directedEdges.find(edgeKey(b, a)) == directedEdges.end()) {
+                if (kinds[a] != VertexKind::Locked) kinds[a] = options.lockBorder ? VertexKind::Locked : VertexKind::Border;
+                if (kinds[b] != VertexKind::Locked) kinds[b] = options.lockBorder ? VertexKind::Locked : VertexKind::Border;
+            }
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            // 接缝顶点保守处理：整组锁定，保证不同属性的副本不会被撕开
+            if (weldCount[weld[i]] > 1) {
+                kinds[weld[i]] = VertexKind::Locked;
+            }
+        }
+        for (size_t i = 0; i < vertexCount; ++i) {
+            kinds[i] = kinds[weld[i]];
+        }
+
+        // 4. 累积每个顶点的平面二次误差（按面积加权），边界边额外加入垂直平面约束
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            unsigned int i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+            Vec3d p0 = positions[i0], p1 = positions[i1], p2 = positions[i2];
+            Vec3d n = cross(sub(p1, p0), sub(p2, p0));
+            double length = std::sqrt(dot(n, n));
+            if (length <= 0.0) continue;
+            n = {n.x / length, n.y / length, n.z / length};
+            double area = length * 0.5;
+            double d = -dot(n, p0);
+
+            Quadric q;
+            q.addPlane(n.x, n.y, n.z, d, area);
+            quadrics[weld[i0]].add(q);
+            quadrics[weld[i1]].add(q);
+            quadrics[weld[i2]].add(q);
+
+            const unsigned int corners[3] = {i0, i1, i2};
+            for (int e = 0; e < 3; ++e) {
+                unsigned int a = corners[e], b = corners[(e + 1) % 3];
+                if (!isBorderEdge(a, b)) continue;
+                Vec3d edge = sub(positions[b], positions[a]);
+                Vec3d perpendicular = cross(edge, n);
+                double perpendicularLength = std::sqrt(dot(perpendicular, perpendicular));
+                if (perpendicularLength <= 0.0) continue;
+                perpendicular = {perpendicular.x / perpendicularLength, perpendicular.y / perpendicularLength, perpendicular.z / perpendicularLength};
+                Quadric border;
+                border.addPlane(perpendicular.x, perpendicular.y, perpendicular.z, -dot(perpendicular, positions[a]), dot(edge, edge) * 10.0);
+                quadrics[weld[a]].add(border);
+                quadrics[weld[b]].add(border);
+            }
+        }
+
+        // 5. 迭代执行折叠，每一轮按代价从小到大贪心处理互不相邻的折叠
+        std::vector<unsigned int> result = indices;
+        const double maxCost = static_cast<double>(options.targetError) * options.targetError;
+        double resultError = 0.0;
+
+        Adjacency adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<unsigned int> remap(vertexCount);
+        std::vector<unsigned char> touched(vertexCount);
+
+        while (result.size() > targetIndexCount) {
+            adjacency.build(result, vertexCount);
+
+            // 收集候选折叠
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int e = 0; e < 3; ++e) {
+                    unsigned int a = result[i + e];
+                    unsigned int b = result[i + (e + 1) % 3];
+                    // 两个方向都作为候选，由代价决定保留哪个顶点
+                    for (int dir = 0; dir < 2; ++dir) {
+                        unsigned int v0 = dir == 0 ? a : b;
+                        unsigned int v1 = dir == 0 ? b : a;
+                        if (kinds[v0] == VertexKind::Locked) continue;
+                        if (kinds[v0] == VertexKind::Border && (kinds[v1] == VertexKind::Manifold || !isBorderEdge(a, b))) continue;
+
+                        Quadric q = quadrics[weld[v0]];
+                        q.add(quadrics[weld[v1]]);
+                        const Vec3d& target = positions[v1];
+                        double error = q.evaluate(target.x, target.y, target.z);
+                        double cost = error + attributeDistance(geometry, v0, v1, options);
+                        if (cost <= maxCost) {
+                            collapses.push_back({v0, v1, cost, error});
+                        }
+                    }
+                }
+            }
+
+            if (collapses.empty()) break;
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+                return lhs.cost < rhs.cost;
+            });
+
+            for (size_t i = 0; i < vertexCount; ++i) remap[i] = static_cast<unsigned int>(i);
+            std::fill(touched.begin(), touched.end(), 0);
+
+            size_t triangleCount = result.size() / 3;
+            const size_t targetTriangles = targetIndexCount / 3;
+            size_t performed = 0;
+
+            for (const Collapse& collapse : collapses) {
+                if (triangleCount <= targetTriangles) break;
+                unsigned int v0 = collapse.v0, v1 = collapse.v1;
+                if (touched[v0] || touched[v1]) continue;
+
+                // 检查折叠后相邻三角形是否翻转
+                bool flipped = false;
+                size_t removed = 0;
+                for (unsigned int t = adjacency.offsets[v0]; t < adjacency.offsets[v0 + 1] && !flipped; ++t) {
+                    unsigned int triangle = adjacency.triangles[t];
+                    unsigned int c0 = result[triangle * 3], c1 = result[triangle * 3 + 1], c2 = result[triangle * 3 + 2];
+                    if (c0 == v1 || c1 == v1 || c2 == v1) {
+                        removed++;
+                        continue;
+                    }
+                    // 把 v0 旋转到第一个位置，保持绕序
+                    unsigned int b = c0 == v0 ? c1 : (c1 == v0 ? c2 : c0);
+                    unsigned int c = c0 == v0 ? c2 : (c1 == v0 ? c0 : c1);
+                    Vec3d before = cross(sub(positions[b], positions[v0]), sub(positions[c], positions[v0]));
+                    Vec3d after = cross(sub(positions[b], positions[v1]), sub(positions[c], positions[v1]));
+                    if (dot(before, after) <= 0.0) {
+                        flipped = true;
+                    }
+                }
+                if (flipped || removed == 0) continue;
+
+                // 连接条件：v0、v1 的公共邻点数必须等于被删除的三角形数，否则折叠会产生非流形结构
+                size_t common = 0;
+                for (unsigned int t0 = adjacency.offsets[v0]; t0 < adjacency.offsets[v0 + 1]; ++t0) {
+                    const unsigned int* tri0 = &result[adjacency.triangles[t0] * 3];
+                    for (int k0 = 0; k0 < 3; ++k0) {
+                        unsigned int n = tri0[k0];
+                        if (n == v0 || n == v1) continue;
+                        bool shared = false;
+                        for (unsigned int t1 = adjacency.offsets[v1]; t1 < adjacency.offsets[v1 + 1] && !shared; ++t1) {
+                            const unsigned int* tri1 = &result[adjacency.triangles[t1] * 3];
+                            shared = tri1[0] == n || tri1[1] == n || tri1[2] == n;
+                        }
+                        if (shared) common++;
+                    }
+                }
+                // 每个公共邻点在 v0 的一环中会被两个三角形各统计一次（边界处为一次）
+                if (common > removed * 2) continue;
+
+                remap[v0] = v1;
+                quadrics[weld[v1]].add(quadrics[weld[v0]]);
+                resultError = std::max(resultError, collapse.error);
+                triangleCount -= removed;
+                performed++;
+
+                // 锁定受影响的一环邻域，保证本轮剩余折叠的代价与翻转检查仍然有效
+                for (unsigned int t = adjacency.offsets[v0]; t < adjacency.offsets[v0 + 1]; ++t) {
+                    unsigned int triangle = adjacency.triangles[t];
+                    touched[result[triangle * 3]] = 1;
+                    touched[result[triangle * 3 + 1]] = 1;
+                    touched[result[triangle * 3 + 2]] = 1;
+                }
+            }
+
+            if (performed == 0) break;
+
+            // 应用重映射并剔除退化三角形
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3) {
+                unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+                if (a == b || b == c || a == c) continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (outError) *outError = static_cast<float>(std::sqrt(resultError));
+        return result;
+    }
+
+    size_t MeshSimplifier::generateLodChain(Geometry& geometry, const LodChainOptions& options) {
+        geometry.lodLevels.clear();
+        geometry.lodIndices.clear();
+
+        Geometry::LodLevel base;
+        base.indexOffset = 0;
+        base.indexCount = geometry.indices.size();
+        base.error = 0.0f;
+        geometry.lodLevels.push_back(base);
+
+        if (geometry.indices.empty() || geometry.indices.size() % 3 != 0) {
+            std::cout << "MeshSimplifier: geometry is not an indexed triangle list, LOD chain skipped" << std::endl;
+            return geometry.lodLevels.size();
+        }
+
+        std::vector<unsigned int> source = geometry.indices;
+        float accumulatedError = 0.0f;
+
+        while (geometry.lodLevels.size() < options.maxLevels) {
+            size_t sourceTriangles = source.size() / 3;
+            if (sourceTriangles <= options.minTriangles) break;
+
+            size_t targetTriangles = std::max(options.minTriangles,
+                static_cast<size_t>(sourceTriangles * options.reductionRatio));
+            float error = 0.0f;
+            std::vector<unsigned int> simplified = simplify(geometry, source, targetTriangles * 3, options.simplify, &error);
+
+            // 简化幅度不足（例如受锁定顶点或误差上限限制），继续生成也只是重复数据
+            if (simplified.size() >= source.size() * 0.95f) break;
+
+            // 在上一级的基础上继续简化，误差保守地累加
+            accumulatedError += error;
+
+            Geometry::LodLevel level;
+            level.indexOffset = geometry.indices.size() + geometry.lodIndices.size();
+            level.indexCount = simplified.size();
+            level.error = accumulatedError;
+            geometry.lodLevels.push_back(level);
+            geometry.lodIndices.insert(geometry.lodIndices.end(), simplified.begin(), simplified.end());
+
+            source = std::move(simplified);
+        }
+
+        std::cout << "MeshSimplifier: generated " << geometry.lodLevels.size() << " LOD levels (";
+        for (size_t i = 0; i < geometry.lodLevels.size(); ++i) {
+            std::cout << (i > 0 ? ", " : "") << geometry.lodLevels[i].indexCount / 3;
+        }
+        std::cout << " triangles)" << std::endl;
+
+        return geometry.lodLevels.size();
+    }
+}
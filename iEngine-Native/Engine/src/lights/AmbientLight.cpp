@@ -7,4 +7,8 @@ namespace iengine {
         // Ambient light specific initialization
     }
 
+    std::shared_ptr<Light> AmbientLight::clone() const {
+        return std::make_shared<AmbientLight>(*this);
+    }
+
 } // namespace iengine
\ No newline at end of file
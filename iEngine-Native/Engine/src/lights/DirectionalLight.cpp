@@ -3,4 +3,8 @@
 namespace iengine {
     DirectionalLight::DirectionalLight(const Color& color, float intensity, const Vector3& direction)
         : Light(color, intensity), direction(direction) {}
+    
+    std::shared_ptr<Light> DirectionalLight::clone() const {
+        return std::make_shared<DirectionalLight>(*this);
+    }
 }
\ No newline at end of file
@@ -3,4 +3,8 @@
 namespace iengine {
     Light::Light(const Color& color, float intensity)
         : color(color), intensity(intensity) {}
+    
+    std::shared_ptr<Light> Light::clone() const {
+        return std::make_shared<Light>(*this);
+    }
 }
\ No newline at end of file
@@ -17,10 +17,16 @@ namespace iengine {
 
     void PointLight::setPosition(const Vector3& position) {
         this->position = position;
+        markDirty();
     }
 
     void PointLight::setRange(float range) {
         this->range = range;
+        markDirty();
+    }
+
+    std::shared_ptr<Light> PointLight::clone() const {
+        return std::make_shared<PointLight>(*this);
     }
 
 } // namespace iengine
\ No newline at end of file
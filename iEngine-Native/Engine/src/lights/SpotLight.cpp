@@ -27,18 +27,26 @@ namespace iengine {
 
     void SpotLight::setPosition(const Vector3& position) {
         this->position = position;
+        markDirty();
     }
 
     void SpotLight::setDirection(const Vector3& direction) {
         this->direction = direction;
+        markDirty();
     }
 
     void SpotLight::setAngle(float angle) {
         this->angle = angle;
+        markDirty();
     }
 
     void SpotLight::setRange(float range) {
         this->range = range;
+        markDirty();
+    }
+
+    std::shared_ptr<Light> SpotLight::clone() const {
+        return std::make_shared<SpotLight>(*this);
     }
 
 } // namespace iengine
\ No newline at end of file
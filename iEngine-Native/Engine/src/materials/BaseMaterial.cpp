@@ -2,12 +2,9 @@
 #include "iengine/renderers/Context.h"
 #include "iengine/renderers/opengl/OpenGLUniforms.h"
 #include "iengine/views/cameras/Camera.h"
-#include "iengine/core/Model.h"  // 改为包含 Model 而不是 Mesh
 #include "iengine/math/Matrix4.h"
 #include "iengine/math/Matrix3.h"
 
-#include <iostream>
-
 namespace iengine {
     BaseMaterial::BaseMaterial(const BaseMaterialParams& params)
         : Material(params.name, params.shaderName), color(params.color) {}
@@ -16,6 +13,7 @@ namespace iengine {
         color.r = r;
         color.g = g;
         color.b = b;
+        markDirty();
     }
     
     std::map<std::string, bool> BaseMaterial::getShaderMacroDefines() const {
@@ -27,13 +25,11 @@ namespace iengine {
     std::map<std::string, UniformValue> BaseMaterial::getUniforms(
         std::shared_ptr<Context> context,
         std::shared_ptr<Camera> camera,
-        std::shared_ptr<Model> model,  // 改为传递 Model
+        const Matrix4& modelMatrix,
         const std::vector<std::shared_ptr<Light>>& lights) {
         
         std::map<std::string, UniformValue> uniforms;
         
-        // 从 Model 获取变换矩阵（与 Web 版本一致）
-        Matrix4 modelMatrix = model->getTransform(); // 需要在 Model 类中添加这个方法
         Matrix4 viewMatrix = camera->getViewMatrix();
         Matrix4 modelViewMatrix = viewMatrix;
         modelViewMatrix.multiply(modelMatrix);
@@ -46,14 +42,13 @@ namespace iengine {
         uniforms["uProjectionMatrix"] = UniformValue::fromMatrix4(projectionMatrix);
         uniforms["uBaseColor"] = UniformValue::fromVec3(color.r, color.g, color.b);
         
-        // 输出调试信息
-        std::cout << "BaseMaterial::getUniforms() - 颜色: (" << color.r << ", " << color.g << ", " << color.b << ")" << std::endl;
-        std::cout << "BaseMaterial::getUniforms() - Computed uniforms: "
-                  << "uModelViewMatrix, uProjectionMatrix, uBaseColor" << std::endl;
-        
         return uniforms;
     }
     
+    std::shared_ptr<Material> BaseMaterial::clone() const {
+        return std::make_shared<BaseMaterial>(*this);
+    }
+    
     TextureInfo BaseMaterial::getTextures() {
         TextureInfo info;
         // 基础材质没有纹理
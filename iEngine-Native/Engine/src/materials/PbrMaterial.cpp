@@ -2,13 +2,10 @@
 #include "iengine/renderers/Context.h"
 #include "iengine/renderers/opengl/OpenGLUniforms.h"
 #include "iengine/views/cameras/Camera.h"
-#include "iengine/core/Model.h"
 #include "iengine/lights/Light.h"
 #include "iengine/textures/Texture.h"
 #include "iengine/math/Matrix4.h"
 
-#include <iostream>
-
 namespace iengine {
     PbrMaterial::PbrMaterial(const PbrMaterialParams& params)
         : Material(params.name, params.shaderName),
@@ -29,53 +26,65 @@ namespace iengine {
         baseColor.r = r;
         baseColor.g = g;
         baseColor.b = b;
+        markDirty();
     }
     
     void PbrMaterial::setMetallic(float metallic) {
         this->metallic = metallic;
+        markDirty();
     }
     
     void PbrMaterial::setRoughness(float roughness) {
         this->roughness = roughness;
+        markDirty();
     }
     
     void PbrMaterial::setNormalScale(float scale) {
         this->normalScale = scale;
+        markDirty();
     }
     
     void PbrMaterial::setAoStrength(float strength) {
         this->aoStrength = strength;
+        markDirty();
     }
     
     void PbrMaterial::setEmissiveColor(float r, float g, float b) {
         emissiveColor.r = r;
         emissiveColor.g = g;
         emissiveColor.b = b;
+        markDirty();
     }
     
     void PbrMaterial::setEmissiveIntensity(float intensity) {
         this->emissiveIntensity = intensity;
+        markDirty();
     }
     
     // 贴图 setters
     void PbrMaterial::setBaseColorMap(std::shared_ptr<Texture> texture) {
         this->baseColorMap = texture;
+        markDirty();
     }
     
     void PbrMaterial::setMetallicRoughnessMap(std::shared_ptr<Texture> texture) {
         this->metallicRoughnessMap = texture;
+        markDirty();
     }
     
     void PbrMaterial::setNormalMap(std::shared_ptr<Texture> texture) {
         this->normalMap = texture;
+        markDirty();
     }
     
     void PbrMaterial::setAoMap(std::shared_ptr<Texture> texture) {
         this->aoMap = texture;
+        markDirty();
     }
     
     void PbrMaterial::setEmissiveMap(std::shared_ptr<Texture> texture) {
         this->emissiveMap = texture;
+        markDirty();
     }
     
     std::map<std::string, bool> PbrMaterial::getShaderMacroDefines() const {
@@ -84,6 +93,8 @@ namespace iengine {
         if (baseColorMap) defines["HAS_BASECOLORMAP"] = true;
         if (metallicRoughnessMap) defines["HAS_METALLICROUGHNESSMAP"] = true;
         if (normalMap) defines["HAS_NORMALMAP"] = true;
+        if (normalMap && normalMap->getFormat() == TextureFormat::BC5) defines["NORMALMAP_RG"] = true;
+        if (useTextureArrays) defines["USE_TEXTURE_ARRAYS"] = true;
         if (aoMap) defines["HAS_AOMAP"] = true;
         if (emissiveMap) defines["HAS_EMISSIVEMAP"] = true;
         return defines;
@@ -92,13 +103,12 @@ namespace iengine {
     std::map<std::string, UniformValue> PbrMaterial::getUniforms(
         std::shared_ptr<Context> context,
         std::shared_ptr<Camera> camera,
-        std::shared_ptr<Model> model,
+        const Matrix4& modelMatrix,
         const std::vector<std::shared_ptr<Light>>& lights) {
         
         std::map<std::string, UniformValue> uniforms;
         
-        // 使用Model的变换矩阵，与Web版本一致
-        Matrix4 modelMatrix = model->getTransform();
+        // 使用模型的变换矩阵，与Web版本一致
         Matrix4 viewMatrix = camera->getViewMatrix();
         Matrix4 modelViewMatrix = viewMatrix;
         modelViewMatrix.multiply(modelMatrix);
@@ -119,11 +129,13 @@ namespace iengine {
         uniforms["uEmissiveColor"] = UniformValue::fromVec3(emissiveColor.r, emissiveColor.g, emissiveColor.b);
         uniforms["uEmissiveIntensity"] = UniformValue(emissiveIntensity);
         
-        std::cout << "PbrMaterial::getUniforms() - Computed PBR uniforms" << std::endl;
-        
         return uniforms;
     }
     
+    std::shared_ptr<Material> PbrMaterial::clone() const {
+        return std::make_shared<PbrMaterial>(*this);
+    }
+    
     TextureInfo PbrMaterial::getTextures() {
         TextureInfo info;
         // 返回所有贴图，与TS版本保持一致
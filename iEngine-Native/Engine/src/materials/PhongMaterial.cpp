@@ -2,12 +2,9 @@
 #include "iengine/renderers/Context.h"
 #include "iengine/renderers/opengl/OpenGLUniforms.h"
 #include "iengine/views/cameras/Camera.h"
-#include "iengine/core/Model.h"
 #include "iengine/lights/Light.h"
 #include "iengine/math/Matrix4.h"
 
-#include <iostream>
-
 namespace iengine {
     PhongMaterial::PhongMaterial(const PhongMaterialParams& params)
         : Material(params.name, params.shaderName), 
@@ -19,16 +16,19 @@ namespace iengine {
         color.r = r;
         color.g = g;
         color.b = b;
+        markDirty();
     }
     
     void PhongMaterial::setSpecular(float r, float g, float b) {
         specular.r = r;
         specular.g = g;
         specular.b = b;
+        markDirty();
     }
     
     void PhongMaterial::setShininess(float shininess) {
         this->shininess = shininess;
+        markDirty();
     }
     
     std::map<std::string, bool> PhongMaterial::getShaderMacroDefines() const {
@@ -41,13 +41,12 @@ namespace iengine {
     std::map<std::string, UniformValue> PhongMaterial::getUniforms(
         std::shared_ptr<Context> context,
         std::shared_ptr<Camera> camera,
-        std::shared_ptr<Model> model,
+        const Matrix4& modelMatrix,
         const std::vector<std::shared_ptr<Light>>& lights) {
         
         std::map<std::string, UniformValue> uniforms;
         
-        // 使用Model的变换矩阵，与Web版本一致
-        Matrix4 modelMatrix = model->getTransform();
+        // 使用模型的变换矩阵，与Web版本一致
         Matrix4 viewMatrix = camera->getViewMatrix();
         Matrix4 modelViewMatrix = viewMatrix;
         modelViewMatrix.multiply(modelMatrix);
@@ -64,11 +63,13 @@ namespace iengine {
         uniforms["uSpecular"] = UniformValue::fromVec3(specular.r, specular.g, specular.b);
         uniforms["uShininess"] = UniformValue(this->shininess);
         
-        std::cout << "PhongMaterial::getUniforms() - Computed Phong uniforms" << std::endl;
-        
         return uniforms;
     }
     
+    std::shared_ptr<Material> PhongMaterial::clone() const {
+        return std::make_shared<PhongMaterial>(*this);
+    }
+    
     TextureInfo PhongMaterial::getTextures() {
         TextureInfo info;
         // Phong材质没有纹理（可以在未来扩展）
@@ -0,0 +1,102 @@
+#include "iengine/renderers/BufferRangeAllocator.h"
+
+#include <iostream>
+
+namespace iengine {
+    BufferRangeAllocator::BufferRangeAllocator(size_t capacity) {
+        reset(capacity);
+    }
+
+    size_t BufferRangeAllocator::allocate(size_t size) {
+        if (size == 0) {
+            return InvalidOffset;
+        }
+
+        // 最佳适配：找到不小于 size 的最小空闲块
+        auto fit = freeBySize_.lower_bound(size);
+        if (fit == freeBySize_.end()) {
+            return InvalidOffset;
+        }
+
+        size_t blockOffset = fit->second;
+        size_t blockSize = fit->first;
+        eraseFreeBlock(freeByOffset_.find(blockOffset));
+
+        // 剩余部分放回空闲列表
+        if (blockSize > size) {
+            insertFreeBlock(blockOffset + size, blockSize - size);
+        }
+        return blockOffset;
+    }
+
+    void BufferRangeAllocator::free(size_t offset, size_t size) {
+        if (size == 0 || offset == InvalidOffset) {
+            return;
+        }
+        if (offset + size > capacity_) {
+            std::cerr << "BufferRangeAllocator::free - Range out of bounds: " << offset << "+" << size << std::endl;
+            return;
+        }
+
+        // 先检查与前后空闲块是否重叠，检查通过前不修改任何状态
+        auto next = freeByOffset_.lower_bound(offset);
+        auto prev = next != freeByOffset_.begin() ? std::prev(next) : freeByOffset_.end();
+        if ((next != freeByOffset_.end() && next->first < offset + size) ||
+            (prev != freeByOffset_.end() && prev->first + prev->second > offset)) {
+            std::cerr << "BufferRangeAllocator::free - Double free detected at offset " << offset << std::endl;
+            return;
+        }
+
+        // 与后一个、前一个空闲块合并
+        if (next != freeByOffset_.end() && next->first == offset + size) {
+            size += next->second;
+            eraseFreeBlock(next);
+        }
+        if (prev != freeByOffset_.end() && prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            eraseFreeBlock(prev);
+        }
+
+        insertFreeBlock(offset, size);
+    }
+
+    void BufferRangeAllocator::reset(size_t capacity, size_t usedPrefix) {
+        capacity_ = capacity;
+        freeTotal_ = 0;
+        freeByOffset_.clear();
+        freeBySize_.clear();
+        if (usedPrefix < capacity) {
+            insertFreeBlock(usedPrefix, capacity - usedPrefix);
+        }
+    }
+
+    size_t BufferRangeAllocator::getLargestFreeBlock() const {
+        return freeBySize_.empty() ? 0 : freeBySize_.rbegin()->first;
+    }
+
+    float BufferRangeAllocator::getFragmentation() const {
+        if (freeTotal_ == 0) {
+            return 0.0f;
+        }
+        return 1.0f - static_cast<float>(getLargestFreeBlock()) / static_cast<float>(freeTotal_);
+    }
+
+    void BufferRangeAllocator::insertFreeBlock(size_t offset, size_t size) {
+        freeByOffset_[offset] = size;
+        freeBySize_.emplace(size, offset);
+        freeTotal_ += size;
+    }
+
+    void BufferRangeAllocator::eraseFreeBlock(std::map<size_t, size_t>::iterator it) {
+        auto range = freeBySize_.equal_range(it->second);
+        for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+            if (sizeIt->second == it->first) {
+                freeBySize_.erase(sizeIt);
+                break;
+            }
+        }
+        freeTotal_ -= it->second;
+        freeByOffset_.erase(it);
+    }
+}
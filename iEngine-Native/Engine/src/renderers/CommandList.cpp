@@ -0,0 +1,172 @@
+#include "iengine/renderers/CommandList.h"
+#include "iengine/core/Mesh.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace iengine {
+    uint32_t CommandList::addPipeline(RenderPipelineBinding binding) {
+        // 未解析的管线不去重，由提交线程逐个解析（后端缓存保证同一变体只创建一次）
+        if (binding.resolved) {
+            auto it = pipelineIndices_.find(binding.resolved.get());
+            if (it != pipelineIndices_.end()) {
+                return it->second;
+            }
+        }
+
+        uint32_t index = static_cast<uint32_t>(pipelines_.size());
+        if (binding.resolved) {
+            pipelineIndices_[binding.resolved.get()] = index;
+        }
+        pipelines_.push_back(std::move(binding));
+        return index;
+    }
+
+    uint32_t CommandList::addMesh(const std::shared_ptr<Mesh>& mesh) {
+        auto it = meshIndices_.find(mesh.get());
+        if (it != meshIndices_.end()) {
+            return it->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(meshes_.size());
+        meshIndices_[mesh.get()] = index;
+        meshes_.push_back(mesh);
+        return index;
+    }
+
+    void CommandList::beginDraw(uint64_t sortKey) {
+        if (recording_) {
+            std::cerr << "CommandList: beginDraw called twice without endDraw" << std::endl;
+            endDraw();
+        }
+
+        RenderDrawRecord record;
+        record.sortKey = sortKey;
+        record.firstCommand = static_cast<uint32_t>(commands_.size());
+        draws_.push_back(record);
+        recording_ = true;
+    }
+
+    void CommandList::push(RenderCommandType type, uint32_t index, uint32_t count, uint32_t lod) {
+        if (!recording_) {
+            std::cerr << "CommandList: command recorded outside beginDraw/endDraw" << std::endl;
+            return;
+        }
+
+        RenderCommand command;
+        command.type = type;
+        command.index = index;
+        command.count = count;
+        command.lod = lod;
+        commands_.push_back(command);
+    }
+
+    void CommandList::bindPipeline(uint32_t pipeline) {
+        push(RenderCommandType::BindPipeline, pipeline, 0, 0);
+    }
+
+    void CommandList::setUniforms(const std::map<std::string, UniformValue>& uniforms) {
+        uint32_t first = static_cast<uint32_t>(uniforms_.size());
+        uniforms_.insert(uniforms_.end(), uniforms.begin(), uniforms.end());
+        push(RenderCommandType::SetUniforms, first, static_cast<uint32_t>(uniforms.size()), 0);
+    }
+
+    void CommandList::bindTextures(const std::map<std::string, UniformValue>& textures) {
+        uint32_t first = static_cast<uint32_t>(uniforms_.size());
+        uniforms_.insert(uniforms_.end(), textures.begin(), textures.end());
+        push(RenderCommandType::BindTextures, first, static_cast<uint32_t>(textures.size()), 0);
+    }
+
+    void CommandList::draw(uint32_t mesh, uint32_t lod) {
+        push(RenderCommandType::Draw, mesh, 0, lod);
+    }
+
+    void CommandList::drawInstanced(uint32_t mesh, uint32_t lod, uint32_t instanceCount) {
+        push(RenderCommandType::DrawInstanced, mesh, instanceCount, lod);
+    }
+
+    void CommandList::cancelDraw() {
+        if (!recording_) {
+            return;
+        }
+
+        // 命令引用的 uniform 留在表中，不影响执行
+        commands_.resize(draws_.back().firstCommand);
+        draws_.pop_back();
+        recording_ = false;
+    }
+
+    void CommandList::endDraw() {
+        if (!recording_) {
+            return;
+        }
+
+        RenderDrawRecord& record = draws_.back();
+        record.commandCount = static_cast<uint32_t>(commands_.size()) - record.firstCommand;
+        recording_ = false;
+    }
+
+    void CommandList::append(CommandList& other) {
+        other.endDraw();
+
+        // 重定位 other 中的管线和网格序号
+        std::vector<uint32_t> pipelineMap(other.pipelines_.size());
+        for (size_t i = 0; i < other.pipelines_.size(); ++i) {
+            pipelineMap[i] = addPipeline(std::move(other.pipelines_[i]));
+        }
+        std::vector<uint32_t> meshMap(other.meshes_.size());
+        for (size_t i = 0; i < other.meshes_.size(); ++i) {
+            meshMap[i] = addMesh(other.meshes_[i]);
+        }
+
+        const uint32_t commandOffset = static_cast<uint32_t>(commands_.size());
+        const uint32_t uniformOffset = static_cast<uint32_t>(uniforms_.size());
+
+        commands_.reserve(commands_.size() + other.commands_.size());
+        for (RenderCommand command : other.commands_) {
+            switch (command.type) {
+            case RenderCommandType::BindPipeline:
+                command.index = pipelineMap[command.index];
+                break;
+            case RenderCommandType::SetUniforms:
+            case RenderCommandType::BindTextures:
+                command.index += uniformOffset;
+                break;
+            case RenderCommandType::Draw:
+            case RenderCommandType::DrawInstanced:
+                command.index = meshMap[command.index];
+                break;
+            }
+            commands_.push_back(command);
+        }
+
+        uniforms_.reserve(uniforms_.size() + other.uniforms_.size());
+        std::move(other.uniforms_.begin(), other.uniforms_.end(), std::back_inserter(uniforms_));
+
+        draws_.reserve(draws_.size() + other.draws_.size());
+        for (RenderDrawRecord record : other.draws_) {
+            record.firstCommand += commandOffset;
+            draws_.push_back(record);
+        }
+
+        other.clear();
+    }
+
+    void CommandList::sort() {
+        std::stable_sort(draws_.begin(), draws_.end(), [](const RenderDrawRecord& a, const RenderDrawRecord& b) {
+            return a.sortKey < b.sortKey;
+        });
+    }
+
+    void CommandList::clear() {
+        draws_.clear();
+        commands_.clear();
+        uniforms_.clear();
+        pipelines_.clear();
+        meshes_.clear();
+        pipelineIndices_.clear();
+        meshIndices_.clear();
+        recording_ = false;
+    }
+}
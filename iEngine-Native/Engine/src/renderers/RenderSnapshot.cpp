@@ -0,0 +1,199 @@
+#include "iengine/renderers/RenderSnapshot.h"
+#include "iengine/scenes/Scene.h"
+#include "iengine/core/Model.h"
+#include "iengine/core/Mesh.h"
+#include "iengine/materials/Material.h"
+#include "iengine/lights/Light.h"
+#include "iengine/views/cameras/Camera.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace iengine {
+    namespace {
+        uint64_t versionOf(const Mesh&) { return 0; }
+        uint64_t versionOf(const Material& material) { return material.getVersion(); }
+
+        // 对比场景资源表和已发送的条目，变化的条目经 capture 转换后写入 updates
+        template <typename T, typename SentResource, typename Capture>
+        void syncTable(const SceneResourceTable<T>& table, std::vector<SentResource>& sent,
+                       std::vector<RenderResourceUpdate<T>>& updates, Capture&& capture) {
+            const size_t limit = std::max(static_cast<size_t>(table.getHandleLimit()), sent.size());
+            sent.resize(limit);
+            for (size_t handle = 1; handle < limit; ++handle) {
+                const std::shared_ptr<T>& resource = table.get(static_cast<SceneResourceHandle>(handle));
+                SentResource& entry = sent[handle];
+                const uint64_t version = resource ? versionOf(*resource) : 0;
+                if (entry.pointer == resource.get() &&
+                    (!resource || (!entry.source.expired() && entry.version == version))) {
+                    continue;
+                }
+                entry.pointer = resource.get();
+                entry.source = resource;
+                entry.version = version;
+
+                RenderResourceUpdate<T> update;
+                update.handle = static_cast<SceneResourceHandle>(handle);
+                update.resource = resource ? capture(resource) : nullptr;
+                updates.push_back(std::move(update));
+            }
+        }
+
+        template <typename T>
+        void applyUpdates(const std::vector<RenderResourceUpdate<T>>& updates, std::vector<std::shared_ptr<T>>& table) {
+            for (const auto& update : updates) {
+                if (update.handle >= table.size()) {
+                    table.resize(update.handle + 1);
+                }
+                table[update.handle] = update.resource;
+            }
+        }
+
+        template <typename T>
+        const std::shared_ptr<T>& lookup(const std::vector<std::shared_ptr<T>>& table, SceneResourceHandle handle) {
+            static const std::shared_ptr<T> none;
+            return handle < table.size() ? table[handle] : none;
+        }
+    }
+
+    void RenderSnapshot::clear() {
+        frame = 0;
+        interpolationAlpha = 0.0f;
+        camera.reset();
+        items.clear();
+        lights.clear();
+        meshUpdates.clear();
+        materialUpdates.clear();
+        resources.reset();
+        commands.clear();
+        stats = RenderSnapshotStats();
+    }
+
+    void RenderResourceTable::apply(const RenderSnapshot& snapshot) {
+        applyUpdates(snapshot.meshUpdates, meshes_);
+        applyUpdates(snapshot.materialUpdates, materials_);
+    }
+
+    const std::shared_ptr<Mesh>& RenderResourceTable::getMesh(SceneResourceHandle handle) const {
+        return lookup(meshes_, handle);
+    }
+
+    const std::shared_ptr<Material>& RenderResourceTable::getMaterial(SceneResourceHandle handle) const {
+        return lookup(materials_, handle);
+    }
+
+    RenderSnapshotBuilder::RenderSnapshotBuilder(const RenderSnapshotOptions& options)
+        : options_(options), resources_(std::make_shared<RenderResourceTable>()) {}
+
+    void RenderSnapshotBuilder::setOptions(const RenderSnapshotOptions& options) {
+        // 是否复制材质改变后，已发送的材质全部重新发送
+        if (options.copySceneState != options_.copySceneState) {
+            sentMaterials_.clear();
+        }
+        options_ = options;
+    }
+
+    bool RenderSnapshotBuilder::build(Scene& scene, uint64_t frame, RenderSnapshot& snapshot) {
+        auto start = std::chrono::steady_clock::now();
+
+        // 渲染命令由调用方在构建前放入，这里保留
+        auto commands = std::move(snapshot.commands);
+        snapshot.clear();
+        snapshot.commands = std::move(commands);
+        snapshot.frame = frame;
+
+        auto camera = scene.getActiveCamera();
+        if (!camera) {
+            return false;
+        }
+        snapshot.camera = options_.copySceneState ? camera->clone() : camera;
+
+        // 剔除使用相机副本，不改变场景相机的状态；同时刷新 Model 实体的资源句柄
+        if (options_.frustumCulling) {
+            snapshot.items.reserve(scene.cull(*snapshot.camera));
+        } else {
+            scene.updateBounds();
+        }
+        syncResources(scene, snapshot);
+        snapshot.resources = resources_;
+
+        const LodSelectionOptions defaultLodOptions;
+        Camera& lodCamera = *snapshot.camera;
+        scene.getRegistry().forEachArchetype<TransformComponent, BoundsComponent, RenderableComponent, EntityStateComponent>(
+            [&](Archetype& archetype) {
+                const auto* transforms = archetype.column<TransformComponent>();
+                const auto* bounds = archetype.column<BoundsComponent>();
+                const auto* renderables = archetype.column<RenderableComponent>();
+                const auto* states = archetype.column<EntityStateComponent>();
+                const auto* models = archetype.column<ModelComponent>();
+                auto* lods = archetype.column<LodComponent>();
+                snapshot.stats.components += archetype.size();
+
+                for (size_t i = 0; i < archetype.size(); ++i) {
+                    if (!states[i].visible || (options_.frustumCulling && states[i].culled)) {
+                        continue;
+                    }
+                    const auto& mesh = scene.getMesh(renderables[i].mesh);
+                    if (!mesh || !renderables[i].material) {
+                        continue;
+                    }
+
+                    RenderDrawItem item;
+                    item.transform = transforms[i].matrix;
+                    item.center = bounds[i].worldCenter;
+                    item.radius = bounds[i].worldRadius;
+                    item.mesh = renderables[i].mesh;
+                    item.material = renderables[i].material;
+
+                    // 根据屏幕空间误差选择 LOD，只有可见的实体才访问 Model 对象
+                    if (lods) {
+                        const LodSelectionOptions& lodOptions = models ? models[i].model->getLodOptions() : defaultLodOptions;
+                        size_t level = 0;
+                        if (mesh->hasLods() && lodOptions.enabled && viewportHeight_ > 0.0f && item.radius >= 0.0f) {
+                            float pixelsPerUnitError = lodCamera.getProjectedSize(item.center, item.radius * 2.0f, viewportHeight_);
+                            level = Model::selectLodLevel(*mesh->geometry, lodOptions, lods[i].level, pixelsPerUnitError);
+                        }
+                        lods[i].level = static_cast<uint32_t>(level);
+                        item.lod = lods[i].level;
+                    }
+                    snapshot.items.push_back(item);
+                }
+            });
+        snapshot.stats.visible = snapshot.items.size();
+
+        const auto& lights = scene.getLights();
+        snapshot.lights.reserve(lights.size());
+        for (const auto& light : lights) {
+            if (light) {
+                snapshot.lights.push_back(options_.copySceneState ? light->clone() : light);
+            }
+        }
+        snapshot.stats.lights = snapshot.lights.size();
+
+        snapshot.stats.buildMilliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    void RenderSnapshotBuilder::syncResources(const Scene& scene, RenderSnapshot& snapshot) {
+        // 网格与场景共享
+        syncTable(scene.getMeshes(), sentMeshes_, snapshot.meshUpdates,
+                  [](const std::shared_ptr<Mesh>& mesh) { return mesh; });
+
+        // 材质只在首次出现或参数版本改变时复制
+        syncTable(scene.getMaterials(), sentMaterials_, snapshot.materialUpdates,
+                  [&](const std::shared_ptr<Material>& material) {
+                      if (!options_.copySceneState) {
+                          return material;
+                      }
+                      auto copy = material->clone();
+                      if (!copy) {
+                          return material;
+                      }
+                      ++snapshot.stats.materials;
+                      return copy;
+                  });
+
+        snapshot.stats.resourceUpdates = snapshot.meshUpdates.size() + snapshot.materialUpdates.size();
+    }
+}
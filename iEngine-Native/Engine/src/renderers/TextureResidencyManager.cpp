@@ -0,0 +1,148 @@
+#include "iengine/renderers/TextureResidencyManager.h"
+#include "iengine/renderers/Context.h"
+#include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureLoader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace iengine {
+    TextureResidencyManager::TextureResidencyManager(const TextureResidencyOptions& options)
+        : options_(options) {}
+
+    void TextureResidencyManager::track(const std::shared_ptr<Texture>& texture) {
+        if (!texture) return;
+        Entry& entry = entries_[texture.get()];
+        entry.texture = texture;
+    }
+
+    bool TextureResidencyManager::canDropMip(const Texture& texture) const {
+        if (!texture.isResident() || !texture.usesMipmaps() || texture.isLoading()) {
+            return false;
+        }
+        int next = texture.getDroppedMips() + 1;
+        return next <= options_.maxDroppedMips &&
+               (texture.getWidth() >> next) >= options_.minMipSize &&
+               (texture.getHeight() >> next) >= options_.minMipSize;
+    }
+
+    void TextureResidencyManager::reload(const std::shared_ptr<Texture>& texture, Entry& entry) {
+        ++stats_.reloads;
+        if (loader_) {
+            // 加载完成后 setDecodedImage 会清空丢弃的 Mip 数，在下一次 update 时恢复
+            entry.reloadDroppedMips = texture->getDroppedMips();
+            loader_->load(texture, texture->getSourcePath());
+        } else {
+            texture->reloadFromSource();
+        }
+    }
+
+    void TextureResidencyManager::update(const std::shared_ptr<Context>& context, uint64_t frame) {
+        std::vector<std::shared_ptr<Texture>> textures;
+        textures.reserve(entries_.size());
+        size_t residentBytes = 0;
+
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            auto texture = it->second.texture.lock();
+            if (!texture) {
+                it = entries_.erase(it);
+                continue;
+            }
+
+            Entry& entry = it->second;
+            if (entry.reloadDroppedMips >= 0 && !texture->isLoading()) {
+                texture->setDroppedMips(entry.reloadDroppedMips);
+                entry.reloadDroppedMips = -1;
+            }
+            // CPU 副本已释放的纹理在上一帧又被使用时重新加载
+            if (texture->getLoadState() == TextureLoadState::Unloaded && texture->getLastUsedFrame() + 1 >= frame) {
+                reload(texture, entry);
+            }
+
+            residentBytes += texture->getResidentByteSize();
+            textures.push_back(std::move(texture));
+            ++it;
+        }
+
+        const size_t budget = options_.budgetBytes;
+        if (residentBytes > budget) {
+            // 最久未使用的在前，同一帧使用的纹理先处理占用大的
+            std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b) {
+                if (a->getLastUsedFrame() != b->getLastUsedFrame()) {
+                    return a->getLastUsedFrame() < b->getLastUsedFrame();
+                }
+                return a->getResidentByteSize() > b->getResidentByteSize();
+            });
+
+            // 1. 先丢弃顶层 Mip，每丢一级显存约减少 3/4
+            for (const auto& texture : textures) {
+                while (residentBytes > budget && canDropMip(*texture)) {
+                    size_t before = texture->getResidentByteSize();
+                    if (!texture->setDroppedMips(texture->getDroppedMips() + 1)) {
+                        break;
+                    }
+                    texture->upload(context);
+                    residentBytes = residentBytes - before + texture->getResidentByteSize();
+                    ++stats_.mipDrops;
+                }
+                if (residentBytes <= budget) break;
+            }
+
+            // 2. 仍超出预算时整体驱逐空闲的纹理，正在使用的纹理驱逐后会在下一帧重新上传，造成反复抖动
+            for (const auto& texture : textures) {
+                if (residentBytes <= budget) break;
+                if (!texture->isResident() || frame - texture->getLastUsedFrame() < options_.minIdleFrames) {
+                    continue;
+                }
+                residentBytes -= texture->getResidentByteSize();
+                texture->evict(options_.releaseCpuData);
+                ++stats_.evictions;
+            }
+
+            if (residentBytes > budget) {
+                ++stats_.framesOverBudget;
+            }
+        } else if (residentBytes < static_cast<size_t>(budget * options_.restoreThreshold)) {
+            // 最近使用的纹理先恢复；恢复一级约使占用变为 4 倍，恢复后仍低于阈值才执行，避免在阈值附近反复丢弃/恢复
+            const size_t limit = static_cast<size_t>(budget * options_.restoreThreshold);
+            std::sort(textures.begin(), textures.end(), [](const auto& a, const auto& b) {
+                return a->getLastUsedFrame() > b->getLastUsedFrame();
+            });
+
+            size_t restores = 0;
+            for (const auto& texture : textures) {
+                if (restores >= options_.maxRestoresPerFrame) break;
+                if (!texture->isResident() || texture->getDroppedMips() == 0) continue;
+
+                size_t before = texture->getResidentByteSize();
+                if (residentBytes + before * 3 > limit) continue;
+                texture->setDroppedMips(texture->getDroppedMips() - 1);
+                texture->upload(context);
+                residentBytes = residentBytes - before + texture->getResidentByteSize();
+                ++restores;
+                ++stats_.mipRestores;
+            }
+        }
+
+        stats_.budgetBytes = budget;
+        stats_.residentBytes = residentBytes;
+        stats_.pressure = budget > 0 ? static_cast<float>(residentBytes) / static_cast<float>(budget) : 0.0f;
+        stats_.trackedTextures = textures.size();
+        stats_.residentTextures = 0;
+        stats_.droppedMipLevels = 0;
+        for (const auto& texture : textures) {
+            if (texture->isResident()) ++stats_.residentTextures;
+            stats_.droppedMipLevels += texture->getDroppedMips();
+        }
+    }
+
+    void TextureResidencyManager::printStats() const {
+        std::cout << "TextureResidencyManager stats: " << stats_.residentBytes << " / " << stats_.budgetBytes
+                  << " bytes (pressure " << stats_.pressure << "), " << stats_.residentTextures << " / "
+                  << stats_.trackedTextures << " textures resident, " << stats_.droppedMipLevels
+                  << " mip levels dropped, total " << stats_.evictions << " evictions / " << stats_.mipDrops
+                  << " mip drops / " << stats_.mipRestores << " restores / " << stats_.reloads << " reloads, "
+                  << stats_.framesOverBudget << " frames over budget" << std::endl;
+    }
+}
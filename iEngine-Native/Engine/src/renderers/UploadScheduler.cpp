@@ -0,0 +1,146 @@
+#include "iengine/renderers/UploadScheduler.h"
+#include "iengine/renderers/Context.h"
+#include "iengine/core/Mesh.h"
+#include "iengine/textures/Texture.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace iengine {
+    UploadScheduler::UploadScheduler(const UploadBudget& budget)
+        : budget_(budget) {}
+
+    UploadScheduler::Request& UploadScheduler::touch(const void* key, float priority) {
+        auto it = requests_.find(key);
+        if (it == requests_.end()) {
+            Request request;
+            request.enqueueFrame = frame_;
+            request.enqueueTime = Clock::now();
+            it = requests_.emplace(key, request).first;
+        }
+        // 同一帧被多个对象引用时取最高优先级
+        Request& request = it->second;
+        if (request.lastRequestFrame != frame_ + 1) {
+            request.priority = priority;
+        } else {
+            request.priority = std::max(request.priority, priority);
+        }
+        request.lastRequestFrame = frame_ + 1;  // 加一以区分"从未请求"
+        return request;
+    }
+
+    void UploadScheduler::request(const std::shared_ptr<Mesh>& mesh, float priority) {
+        if (!mesh) return;
+        Request& request = touch(mesh.get(), priority);
+        if (request.mesh.expired()) {
+            request.mesh = mesh;
+            request.bytes = mesh->getGpuByteSize();
+        }
+    }
+
+    void UploadScheduler::request(const std::shared_ptr<Texture>& texture, float priority) {
+        if (!texture) return;
+        Request& request = touch(texture.get(), priority);
+        if (request.texture.expired()) {
+            request.texture = texture;
+            request.bytes = texture->getGpuByteSize();
+        }
+    }
+
+    size_t UploadScheduler::process(const std::shared_ptr<Context>& context) {
+        return run(context, false);
+    }
+
+    size_t UploadScheduler::flush(const std::shared_ptr<Context>& context) {
+        return run(context, true);
+    }
+
+    size_t UploadScheduler::run(const std::shared_ptr<Context>& context, bool ignoreBudget) {
+        stats_.uploadsThisFrame = 0;
+        stats_.bytesThisFrame = 0;
+        stats_.millisecondsThisFrame = 0.0;
+
+        // 1. 清理已释放、已在别处上传或本帧不再需要的请求
+        std::vector<std::pair<const void*, Request*>> queue;
+        queue.reserve(requests_.size());
+        for (auto it = requests_.begin(); it != requests_.end();) {
+            Request& request = it->second;
+            auto mesh = request.mesh.lock();
+            auto texture = request.texture.lock();
+            bool needed = (mesh && !mesh->uploaded) || (texture && texture->needsUpdate());
+            bool current = ignoreBudget || request.lastRequestFrame == frame_ + 1;
+            if (!needed || !current) {
+                it = requests_.erase(it);
+                continue;
+            }
+            queue.emplace_back(it->first, &request);
+            ++it;
+        }
+
+        // 2. 按优先级排序，同优先级先来先服务
+        std::sort(queue.begin(), queue.end(), [](const auto& a, const auto& b) {
+            if (a.second->priority != b.second->priority) {
+                return a.second->priority > b.second->priority;
+            }
+            return a.second->enqueueTime < b.second->enqueueTime;
+        });
+
+        // 3. 在预算内依次上传
+        const Clock::time_point start = Clock::now();
+        size_t uploaded = 0;
+        for (auto& entry : queue) {
+            Request& request = *entry.second;
+            if (!ignoreBudget && uploaded >= budget_.minUploadsPerFrame) {
+                double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                if (elapsedMs >= budget_.maxMillisecondsPerFrame ||
+                    stats_.bytesThisFrame + request.bytes > budget_.maxBytesPerFrame) {
+                    break;
+                }
+            }
+
+            if (auto mesh = request.mesh.lock()) {
+                mesh->upload(context);
+            } else if (auto texture = request.texture.lock()) {
+                texture->upload(context);
+            }
+
+            const Clock::time_point now = Clock::now();
+            double latencyMs = std::chrono::duration<double, std::milli>(now - request.enqueueTime).count();
+            totalLatencyMs_ += latencyMs;
+            totalLatencyFrames_ += static_cast<double>(frame_ - request.enqueueFrame);
+            stats_.maxLatencyMs = std::max(stats_.maxLatencyMs, latencyMs);
+
+            stats_.bytesThisFrame += request.bytes;
+            stats_.totalBytes += request.bytes;
+            stats_.totalUploads++;
+            uploaded++;
+
+            requests_.erase(entry.first);
+            entry.second = nullptr;
+        }
+
+        stats_.uploadsThisFrame = uploaded;
+        stats_.millisecondsThisFrame = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        stats_.queueDepth = requests_.size();
+        stats_.queuedBytes = 0;
+        for (const auto& pair : requests_) {
+            stats_.queuedBytes += pair.second.bytes;
+        }
+        if (stats_.totalUploads > 0) {
+            stats_.averageLatencyMs = totalLatencyMs_ / stats_.totalUploads;
+            stats_.averageLatencyFrames = totalLatencyFrames_ / stats_.totalUploads;
+        }
+
+        frame_++;
+        return uploaded;
+    }
+
+    void UploadScheduler::printStats() const {
+        std::cout << "UploadScheduler stats: queue " << stats_.queueDepth << " (" << stats_.queuedBytes << " bytes), "
+                  << "this frame " << stats_.uploadsThisFrame << " uploads / " << stats_.bytesThisFrame << " bytes / "
+                  << stats_.millisecondsThisFrame << " ms, total " << stats_.totalUploads << " uploads / "
+                  << stats_.totalBytes << " bytes, latency avg " << stats_.averageLatencyMs << " ms ("
+                  << stats_.averageLatencyFrames << " frames), max " << stats_.maxLatencyMs << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,356 @@
+#include "iengine/renderers/opengl/OpenGLBufferArena.h"
+#include "iengine/core/Primitive.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace iengine {
+    OpenGLBufferArena::OpenGLBufferArena(const BufferArenaOptions& options)
+        : options_(options) {}
+
+    OpenGLBufferArena::~OpenGLBufferArena() {
+        cleanup();
+    }
+
+    std::string OpenGLBufferArena::makeLayoutKey(const VertexLayout& layout) {
+        std::string key = std::to_string(layout.arrayStride);
+        for (const auto& attr : layout.attributes) {
+            key += "|" + attr.name + ":" + attr.format + ":" + std::to_string(attr.offset);
+        }
+        return key;
+    }
+
+    uint32_t OpenGLBufferArena::allocate(const VertexLayout& layout,
+                                         const void* vertexData, size_t vertexCount,
+                                         const unsigned int* indexData, size_t indexCount) {
+        size_t stride = layout.arrayStride;
+        if (stride == 0 || vertexCount == 0 || !vertexData) {
+            std::cerr << "OpenGLBufferArena::allocate - Invalid vertex data" << std::endl;
+            return 0;
+        }
+        if (indexCount > 0 && !indexData) {
+            std::cerr << "OpenGLBufferArena::allocate - Index data is null" << std::endl;
+            return 0;
+        }
+
+        std::string layoutKey = makeLayoutKey(layout);
+        auto& pages = pools_[layoutKey];
+
+        // 1. 在已有页中查找能容纳的空闲区间
+        Allocation allocation;
+        bool found = false;
+        for (auto& page : pages) {
+            if (tryAllocateInPage(*page, vertexCount, indexCount, allocation)) {
+                found = true;
+                break;
+            }
+        }
+
+        // 2. 空闲总量足够但不连续的页，整理后再试
+        if (!found) {
+            for (auto& page : pages) {
+                if (page->vertices.getFree() >= vertexCount && page->indices.getFree() >= indexCount) {
+                    defragmentPage(*page);
+                    if (tryAllocateInPage(*page, vertexCount, indexCount, allocation)) {
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // 3. 新建一页（超大网格会得到一个恰好容纳它的页）
+        if (!found) {
+            Page* page = createPage(layoutKey, stride, vertexCount, indexCount);
+            if (!page || !tryAllocateInPage(*page, vertexCount, indexCount, allocation)) {
+                std::cerr << "OpenGLBufferArena::allocate - Out of buffer memory" << std::endl;
+                return 0;
+            }
+        }
+
+        // 写入数据，使用 COPY_WRITE 目标以免改动当前 VAO 的索引缓冲区绑定
+        Page* page = allocation.page;
+        glBindBuffer(GL_COPY_WRITE_BUFFER, page->vbo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER,
+                        static_cast<GLintptr>(allocation.baseVertex * stride),
+                        static_cast<GLsizeiptr>(vertexCount * stride), vertexData);
+        if (indexCount > 0) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, page->ibo);
+            glBufferSubData(GL_COPY_WRITE_BUFFER,
+                            static_cast<GLintptr>(allocation.firstIndex * sizeof(unsigned int)),
+                            static_cast<GLsizeiptr>(indexCount * sizeof(unsigned int)), indexData);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        page->allocationCount++;
+
+        uint32_t handle;
+        if (!freeHandles_.empty()) {
+            handle = freeHandles_.back();
+            freeHandles_.pop_back();
+            allocations_[handle - 1] = allocation;
+        } else {
+            allocations_.push_back(allocation);
+            handle = static_cast<uint32_t>(allocations_.size());
+        }
+        return handle;
+    }
+
+    void OpenGLBufferArena::free(uint32_t handle) {
+        if (handle == 0 || handle > allocations_.size() || !allocations_[handle - 1].page) {
+            std::cerr << "OpenGLBufferArena::free - Invalid handle: " << handle << std::endl;
+            return;
+        }
+
+        Allocation& allocation = allocations_[handle - 1];
+        Page* page = allocation.page;
+        page->vertices.free(allocation.baseVertex, allocation.vertexCount);
+        if (allocation.indexCount > 0) {
+            page->indices.free(allocation.firstIndex, allocation.indexCount);
+        }
+        page->allocationCount--;
+
+        allocation = Allocation{};
+        freeHandles_.push_back(handle);
+    }
+
+    const OpenGLBufferArena::Allocation* OpenGLBufferArena::getAllocation(uint32_t handle) const {
+        if (handle == 0 || handle > allocations_.size() || !allocations_[handle - 1].page) {
+            return nullptr;
+        }
+        return &allocations_[handle - 1];
+    }
+
+    size_t OpenGLBufferArena::defragment(bool force) {
+        size_t bytesMoved = 0;
+        size_t pagesDone = 0;
+        for (auto& pool : pools_) {
+            for (auto& page : pool.second) {
+                if (!force && !shouldDefragment(page->vertices) && !shouldDefragment(page->indices)) {
+                    continue;
+                }
+                bytesMoved += defragmentPage(*page);
+                if (!force && ++pagesDone >= options_.maxDefragmentPagesPerFrame) {
+                    return bytesMoved;
+                }
+            }
+        }
+        return bytesMoved;
+    }
+
+    bool OpenGLBufferArena::tryAllocateInPage(Page& page, size_t vertexCount, size_t indexCount, Allocation& out) {
+        size_t baseVertex = page.vertices.allocate(vertexCount);
+        if (baseVertex == BufferRangeAllocator::InvalidOffset) {
+            return false;
+        }
+
+        size_t firstIndex = 0;
+        if (indexCount > 0) {
+            firstIndex = page.indices.allocate(indexCount);
+            if (firstIndex == BufferRangeAllocator::InvalidOffset) {
+                page.vertices.free(baseVertex, vertexCount);
+                return false;
+            }
+        }
+
+        out.page = &page;
+        out.baseVertex = baseVertex;
+        out.vertexCount = vertexCount;
+        out.firstIndex = firstIndex;
+        out.indexCount = indexCount;
+        return true;
+    }
+
+    OpenGLBufferArena::Page* OpenGLBufferArena::createPage(const std::string& layoutKey, size_t stride,
+                                                           size_t minVertices, size_t minIndices) {
+        auto page = std::make_unique<Page>();
+        page->stride = stride;
+        page->layoutKey = layoutKey;
+
+        size_t vertexCapacity = std::max(options_.vertexPageBytes / stride, minVertices);
+        size_t indexCapacity = std::max(options_.indexPageBytes / sizeof(unsigned int), minIndices);
+        page->vertices.reset(vertexCapacity);
+        page->indices.reset(indexCapacity);
+
+        // 清掉之前遗留的错误，以便判断本次分配是否成功
+        while (glGetError() != GL_NO_ERROR) {}
+
+        GLuint buffers[2] = {0, 0};
+        glGenBuffers(2, buffers);
+        page->vbo = buffers[0];
+        page->ibo = buffers[1];
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, page->vbo);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(vertexCapacity * stride), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, page->ibo);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(indexCapacity * sizeof(unsigned int)), nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        if (glGetError() != GL_NO_ERROR) {
+            std::cerr << "OpenGLBufferArena::createPage - Failed to allocate page buffers" << std::endl;
+            glDeleteBuffers(2, buffers);
+            return nullptr;
+        }
+
+        std::cout << "OpenGLBufferArena: Created page (VBO " << page->vbo << ", IBO " << page->ibo
+                  << ", " << vertexCapacity << " vertices, " << indexCapacity << " indices) for layout "
+                  << layoutKey << std::endl;
+
+        auto& pages = pools_[layoutKey];
+        pages.push_back(std::move(page));
+        return pages.back().get();
+    }
+
+    bool OpenGLBufferArena::shouldDefragment(const BufferRangeAllocator& allocator) const {
+        return allocator.getFreeBlockCount() > 1 &&
+               allocator.getFragmentation() > options_.defragmentThreshold &&
+               allocator.getFree() >= static_cast<size_t>(allocator.getCapacity() * options_.defragmentMinFreeRatio);
+    }
+
+    size_t OpenGLBufferArena::defragmentPage(Page& page) {
+        std::vector<Allocation*> live;
+        for (auto& allocation : allocations_) {
+            if (allocation.page == &page) {
+                live.push_back(&allocation);
+            }
+        }
+
+        size_t bytesMoved = 0;
+
+        // 把一组区间紧凑地搬到缓冲区开头：先拷到临时缓冲区，再整体拷回，避免源和目标区间重叠
+        auto compact = [&](GLuint buffer, size_t unitSize,
+                           size_t Allocation::* offsetMember, size_t Allocation::* countMember) -> size_t {
+            std::sort(live.begin(), live.end(), [&](const Allocation* a, const Allocation* b) {
+                return a->*offsetMember < b->*offsetMember;
+            });
+
+            size_t usedUnits = 0;
+            for (const auto* allocation : live) {
+                usedUnits += allocation->*countMember;
+            }
+            if (usedUnits == 0) {
+                return 0;
+            }
+
+            GLuint scratch = 0;
+            glGenBuffers(1, &scratch);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, scratch);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(usedUnits * unitSize), nullptr, GL_STREAM_COPY);
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+            size_t cursor = 0;
+            for (auto* allocation : live) {
+                size_t count = allocation->*countMember;
+                if (count == 0) {
+                    continue;
+                }
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                                    static_cast<GLintptr>((allocation->*offsetMember) * unitSize),
+                                    static_cast<GLintptr>(cursor * unitSize),
+                                    static_cast<GLsizeiptr>(count * unitSize));
+                allocation->*offsetMember = cursor;
+                cursor += count;
+            }
+
+            glBindBuffer(GL_COPY_READ_BUFFER, scratch);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                static_cast<GLsizeiptr>(usedUnits * unitSize));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &scratch);
+
+            bytesMoved += usedUnits * unitSize;
+            return usedUnits;
+        };
+
+        size_t usedVertices = compact(page.vbo, page.stride, &Allocation::baseVertex, &Allocation::vertexCount);
+        size_t usedIndices = compact(page.ibo, sizeof(unsigned int), &Allocation::firstIndex, &Allocation::indexCount);
+
+        page.vertices.reset(page.vertices.getCapacity(), usedVertices);
+        page.indices.reset(page.indices.getCapacity(), usedIndices);
+
+        defragmentCount_++;
+        defragmentBytesMoved_ += bytesMoved;
+
+        std::cout << "OpenGLBufferArena: Defragmented page (VBO " << page.vbo << "), "
+                  << live.size() << " allocations, " << bytesMoved << " bytes moved" << std::endl;
+        return bytesMoved;
+    }
+
+    BufferArenaStats OpenGLBufferArena::getStats() const {
+        BufferArenaStats stats;
+        stats.defragmentCount = defragmentCount_;
+        stats.defragmentBytesMoved = defragmentBytesMoved_;
+
+        float weightedFragmentation = 0.0f;
+        size_t totalFreeBytes = 0;
+
+        for (const auto& pool : pools_) {
+            BufferPoolStats poolStats;
+            poolStats.layoutKey = pool.first;
+
+            float poolWeighted = 0.0f;
+            size_t poolFreeBytes = 0;
+            for (const auto& page : pool.second) {
+                size_t vertexFree = page->vertices.getFree() * page->stride;
+                size_t indexFree = page->indices.getFree() * sizeof(unsigned int);
+
+                poolStats.pageCount++;
+                poolStats.allocationCount += page->allocationCount;
+                poolStats.vertexBytesCapacity += page->vertices.getCapacity() * page->stride;
+                poolStats.vertexBytesUsed += page->vertices.getUsed() * page->stride;
+                poolStats.indexBytesCapacity += page->indices.getCapacity() * sizeof(unsigned int);
+                poolStats.indexBytesUsed += page->indices.getUsed() * sizeof(unsigned int);
+
+                poolWeighted += page->vertices.getFragmentation() * vertexFree +
+                                page->indices.getFragmentation() * indexFree;
+                poolFreeBytes += vertexFree + indexFree;
+            }
+            poolStats.fragmentation = poolFreeBytes ? poolWeighted / poolFreeBytes : 0.0f;
+
+            stats.pageCount += poolStats.pageCount;
+            stats.allocationCount += poolStats.allocationCount;
+            stats.vertexBytesCapacity += poolStats.vertexBytesCapacity;
+            stats.vertexBytesUsed += poolStats.vertexBytesUsed;
+            stats.indexBytesCapacity += poolStats.indexBytesCapacity;
+            stats.indexBytesUsed += poolStats.indexBytesUsed;
+            weightedFragmentation += poolWeighted;
+            totalFreeBytes += poolFreeBytes;
+
+            stats.pools.push_back(std::move(poolStats));
+        }
+        stats.fragmentation = totalFreeBytes ? weightedFragmentation / totalFreeBytes : 0.0f;
+        return stats;
+    }
+
+    void OpenGLBufferArena::printStats() const {
+        BufferArenaStats stats = getStats();
+        std::cout << "OpenGLBufferArena stats: " << stats.pageCount << " pages, "
+                  << stats.allocationCount << " allocations, occupancy "
+                  << stats.getOccupancy() * 100.0f << "%, fragmentation "
+                  << stats.fragmentation * 100.0f << "%, defragmented "
+                  << stats.defragmentCount << " times (" << stats.defragmentBytesMoved << " bytes)" << std::endl;
+        for (const auto& pool : stats.pools) {
+            std::cout << "  [" << pool.layoutKey << "] pages: " << pool.pageCount
+                      << ", allocations: " << pool.allocationCount
+                      << ", vertex: " << pool.vertexBytesUsed << "/" << pool.vertexBytesCapacity
+                      << ", index: " << pool.indexBytesUsed << "/" << pool.indexBytesCapacity
+                      << ", fragmentation: " << pool.fragmentation * 100.0f << "%" << std::endl;
+        }
+    }
+
+    void OpenGLBufferArena::cleanup() {
+        for (auto& pool : pools_) {
+            for (auto& page : pool.second) {
+                GLuint buffers[2] = {page->vbo, page->ibo};
+                glDeleteBuffers(2, buffers);
+            }
+        }
+        pools_.clear();
+        allocations_.clear();
+        freeHandles_.clear();
+    }
+}
@@ -2,12 +2,17 @@
 #include "iengine/windowing/Window.h"
 #include "iengine/core/Mesh.h"
 #include "iengine/core/Model.h"
+#include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureUtils.h"
+#include "iengine/textures/TextureCompressor.h"
 
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <string>
 
 namespace iengine {
     OpenGLContext::OpenGLContext(std::shared_ptr<WindowInterface> window, const OpenGLContextOptions& options)
@@ -18,12 +23,19 @@ namespace iengine {
     }
     
     OpenGLContext::~OpenGLContext() {
-        // OpenGL资源由窗口管理，这里不需要显式清理
+        // 上下文本身由窗口管理；仍登记在册或等待延迟删除的 GL 对象随登记表一起销毁
+        readbacks_.reset();
+        renderTargets_.reset();
+        streamBuffer_.reset();
+        bufferArena_.reset();
+        resources_.reset();
+        textureBindings_.reset();
     }
     
     void OpenGLContext::init() {
         // 通过窗口接口确保 OpenGL 上下文已创建并激活
         window_->makeContextCurrent();
+        renderThreadId_ = std::this_thread::get_id();
         
         if (!gladLoadGL()) {
             throw std::runtime_error("Failed to initialize OpenGL context");
@@ -48,6 +60,7 @@ namespace iengine {
         
         // 获取最大纹理单元数
         glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits_);
+        textureBindings_ = std::make_unique<OpenGLTextureBindings>(maxTextureUnits_);
         
         // 获取OpenGL版本
         glGetIntegerv(GL_MAJOR_VERSION, &majorVersion_);
@@ -55,6 +68,19 @@ namespace iengine {
         
         device_ = (void*)this;
         
+        detectCompressedFormats();
+        
+        // 创建资源登记表和网格缓冲区池
+        resources_ = std::make_unique<OpenGLResourceRegistry>();
+        bufferArena_ = std::make_unique<OpenGLBufferArena>();
+        readbacks_ = std::make_unique<OpenGLReadbackQueue>();
+        renderTargets_ = std::make_unique<OpenGLRenderTargetPool>(*this);
+        renderTargets_->setViewportSize(width_, height_);
+        
+        // 占位纹理：纹理数据尚未上传时使用默认棋盘格图案
+        placeholderTexture_ = createTexture(Texture::getDefaultWidth(), Texture::getDefaultHeight(),
+                                            Texture::getDefaultImageData());
+        
         std::cout << "OpenGLContext初始化成功" << std::endl;
     }
     
@@ -68,117 +94,675 @@ namespace iengine {
         displayWidth_ = width;
         displayHeight_ = height;
         
-        // 设置视口
-        glViewport(0, 0, width, height);
+        // 离屏目标在下次使用时才按新尺寸重建，连续的 resize 事件不会反复分配显存
+        if (renderTargets_) {
+            renderTargets_->setViewportSize(width, height);
+        }
+        
+        // 设置视口（渲染到离屏目标时在切回默认帧缓冲时设置）
+        if (boundFramebuffer_ == 0) {
+            glViewport(0, 0, width, height);
+        }
         std::cout << "OpenGLContext::resize(" << width << ", " << height << ") - 视口已更新" << std::endl;
     }
     
-    void* OpenGLContext::createVertexBuffer(size_t size) {
-        GLuint buffer;
-        glGenBuffers(1, &buffer);
-        glBindBuffer(GL_ARRAY_BUFFER, buffer);
-        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW);
-        std::cout << "Created vertex buffer: " << buffer << " (size: " << size << ")" << std::endl;
-        return reinterpret_cast<void*>(static_cast<uintptr_t>(buffer));
+    static GLenum toGLUsage(BufferUsage usage) {
+        switch (usage) {
+            case BufferUsage::Dynamic: return GL_DYNAMIC_DRAW;
+            case BufferUsage::Stream:  return GL_STREAM_DRAW;
+            default:                   return GL_STATIC_DRAW;
+        }
     }
     
-    void* OpenGLContext::createIndexBuffer(size_t size) {
+    BufferHandle OpenGLContext::createBuffer(size_t size, BufferTarget target, BufferUsage usage) {
+        if (!resources_) {
+            std::cerr << "OpenGLContext::createBuffer - Context not initialized" << std::endl;
+            return BufferHandle{};
+        }
+        
+        // 通过 GL_COPY_WRITE_BUFFER 分配存储，不改动当前 VAO 的索引缓冲区绑定
         GLuint buffer;
         glGenBuffers(1, &buffer);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, nullptr, GL_STATIC_DRAW);
-        std::cout << "Created index buffer: " << buffer << " (size: " << size << ")" << std::endl;
-        return reinterpret_cast<void*>(static_cast<uintptr_t>(buffer));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, toGLUsage(usage));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return resources_->addBuffer(buffer, target, usage, size);
+    }
+    
+    BufferHandle OpenGLContext::createVertexBuffer(size_t size, BufferUsage usage) {
+        BufferHandle buffer = createBuffer(size, BufferTarget::Vertex, usage);
+        std::cout << "Created vertex buffer: " << getBufferId(buffer) << " (size: " << size << ")" << std::endl;
+        return buffer;
+    }
+    
+    BufferHandle OpenGLContext::createIndexBuffer(size_t size, BufferUsage usage) {
+        BufferHandle buffer = createBuffer(size, BufferTarget::Index, usage);
+        std::cout << "Created index buffer: " << getBufferId(buffer) << " (size: " << size << ")" << std::endl;
+        return buffer;
     }
     
-    void OpenGLContext::deleteBuffer(void* buffer) {
-        if (buffer) {
-            GLuint bufferId = static_cast<GLuint>(reinterpret_cast<uintptr_t>(buffer));
-            glDeleteBuffers(1, &bufferId);
-            std::cout << "Deleted buffer: " << bufferId << std::endl;
+    void OpenGLContext::deleteBuffer(BufferHandle buffer) {
+        if (!buffer || !resources_ || deferRelease([this, buffer]() { deleteBuffer(buffer); })) {
+            return;
         }
+        resources_->releaseBuffer(buffer);
     }
     
-    void OpenGLContext::writeBuffer(void* buffer, const void* data, size_t size, size_t offset) {
-        GLuint bufferId = static_cast<GLuint>(reinterpret_cast<uintptr_t>(buffer));
+    void OpenGLContext::writeBuffer(BufferHandle buffer, const void* data, size_t size, size_t offset) {
+        auto* record = resources_ ? resources_->getBuffer(buffer) : nullptr;
+        if (!record) {
+            std::cerr << "OpenGLContext::writeBuffer - Invalid buffer handle" << std::endl;
+            return;
+        }
+        GLuint bufferId = record->id;
+        auto& info = *record;
+        GLenum usage = toGLUsage(info.usage);
         
-        // 先绑定为顶点缓冲区尝试
-        glBindBuffer(GL_ARRAY_BUFFER, bufferId);
-        GLenum error = glGetError();
-        if (error == GL_NO_ERROR) {
-            // 成功绑定为顶点缓冲区
-            if (offset == 0) {
-                glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, bufferId);
+        if (offset == 0) {
+            // 从头写入视为替换整个缓冲区内容
+            if (size > info.size || (info.usage == BufferUsage::Static && size != info.size)) {
+                glBufferData(GL_COPY_WRITE_BUFFER, size, data, usage);
+                info.size = size;
             } else {
-                glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+                if (info.usage != BufferUsage::Static) {
+                    // 孤立旧存储，GPU 仍在使用的数据由驱动保留，写入无需等待
+                    glBufferData(GL_COPY_WRITE_BUFFER, info.size, nullptr, usage);
+                }
+                glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, data);
             }
-            std::cout << "Written " << size << " bytes to vertex buffer " << bufferId << std::endl;
+        } else if (offset + size <= info.size) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
         } else {
-            // 尝试绑定为索引缓冲区
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
-            if (offset == 0) {
-                glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
-            } else {
-                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+            std::cerr << "OpenGLContext::writeBuffer - Write out of range: " << offset << "+" << size
+                      << " > " << info.size << " (buffer " << bufferId << ")" << std::endl;
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    
+    bool OpenGLContext::writeStreamData(const VertexLayout& layout,
+                                        const void* vertexData, size_t vertexCount,
+                                        const unsigned int* indexData, size_t indexCount,
+                                        StreamBufferRange& outRange) {
+        outRange = StreamBufferRange{};
+        if (layout.arrayStride == 0 || vertexCount == 0 || !vertexData) {
+            return false;
+        }
+        
+        if (!streamBuffer_) {
+            streamBuffer_ = std::make_unique<OpenGLStreamBuffer>();
+            if (!streamBuffer_->initialize()) {
+                streamBuffer_.reset();
+                return false;
+            }
+            streamBuffer_->beginFrame();
+        }
+        
+        // 顶点按 stride 对齐，使偏移可以换算为 baseVertex
+        size_t vertexOffset = streamBuffer_->write(vertexData, vertexCount * layout.arrayStride, layout.arrayStride);
+        if (vertexOffset == OpenGLStreamBuffer::InvalidOffset) {
+            return false;
+        }
+        size_t indexOffset = 0;
+        if (indexCount > 0) {
+            indexOffset = streamBuffer_->write(indexData, indexCount * sizeof(unsigned int), sizeof(unsigned int));
+            if (indexOffset == OpenGLStreamBuffer::InvalidOffset) {
+                return false;
+            }
+        }
+        
+        outRange.valid = true;
+        outRange.frame = streamBuffer_->getFrameIndex();
+        outRange.baseVertex = vertexOffset / layout.arrayStride;
+        outRange.firstIndex = indexOffset / sizeof(unsigned int);
+        outRange.indexCount = indexCount;
+        return true;
+    }
+    
+    bool OpenGLContext::isStreamRangeCurrent(const StreamBufferRange& range) const {
+        return range.valid && streamBuffer_ && range.frame == streamBuffer_->getFrameIndex();
+    }
+    
+    void OpenGLContext::beginFrame() {
+        // 渲染线程模式下上下文随渲染线程迁移，以最近开始帧的线程为准
+        renderThreadId_ = std::this_thread::get_id();
+        ++frameIndex_;
+        if (textureBindings_) {
+            textureBindings_->beginFrame();
+        }
+        if (streamBuffer_) {
+            streamBuffer_->beginFrame();
+        }
+    }
+    
+    void OpenGLContext::endFrame() {
+        // 采集在本帧绘制完成后发起，再收取此前已完成的读取
+        if (readbacks_) {
+            readbacks_->captureFrame(width_, height_, frameIndex_);
+            readbacks_->poll(frameIndex_);
+        }
+        if (streamBuffer_) {
+            streamBuffer_->endFrame();
+        }
+        // 归还本帧的临时渲染目标
+        if (renderTargets_) {
+            renderTargets_->endFrame(frameIndex_);
+        }
+        // 先登记其他线程释放的资源，再删除已经不被在途帧引用的资源
+        runDeferredReleases();
+        if (resources_) {
+            resources_->endFrame();
+        }
+    }
+    
+    void OpenGLContext::bindRenderTarget(OpenGLRenderTarget* target) {
+        if (target) {
+            renderTargets_->ensureSize(target);
+        }
+        GLuint framebuffer = target ? target->getFramebuffer() : 0;
+        if (framebuffer != boundFramebuffer_) {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            boundFramebuffer_ = framebuffer;
+        }
+        if (target) {
+            glViewport(0, 0, target->getWidth(), target->getHeight());
+        } else {
+            glViewport(0, 0, width_, height_);
+        }
+    }
+    
+    void OpenGLContext::onFramebufferDeleted(unsigned int framebuffer) {
+        // 删除当前绑定的帧缓冲后 GL 回到默认帧缓冲
+        if (boundFramebuffer_ == framebuffer) {
+            boundFramebuffer_ = 0;
+            glViewport(0, 0, width_, height_);
+        }
+    }
+    
+    std::future<ReadbackResult> OpenGLContext::readPixelsAsync(const ReadbackRequest& request) {
+        return readbacks_->submit(request, width_, height_, frameIndex_);
+    }
+    
+    bool OpenGLContext::startFrameCapture(const FrameCaptureOptions& options) {
+        return readbacks_->startCapture(options);
+    }
+    
+    void OpenGLContext::stopFrameCapture() {
+        readbacks_->stopCapture();
+    }
+    
+    uint32_t OpenGLContext::allocateMeshBuffers(const VertexLayout& layout,
+                                                const void* vertexData, size_t vertexCount,
+                                                const unsigned int* indexData, size_t indexCount) {
+        if (!bufferArena_) {
+            return 0;
+        }
+        return bufferArena_->allocate(layout, vertexData, vertexCount, indexData, indexCount);
+    }
+    
+    void OpenGLContext::freeMeshBuffers(uint32_t allocation) {
+        if (!bufferArena_ || deferRelease([this, allocation]() { freeMeshBuffers(allocation); })) {
+            return;
+        }
+        bufferArena_->free(allocation);
+    }
+    
+    bool OpenGLContext::deferRelease(std::function<void()> release) {
+        if (std::this_thread::get_id() == renderThreadId_.load()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(deferredReleasesMutex_);
+        deferredReleases_.push_back(std::move(release));
+        return true;
+    }
+    
+    void OpenGLContext::runDeferredReleases() {
+        std::vector<std::function<void()>> releases;
+        {
+            std::lock_guard<std::mutex> lock(deferredReleasesMutex_);
+            releases.swap(deferredReleases_);
+        }
+        for (auto& release : releases) {
+            release();
+        }
+    }
+    
+    // 紧密排列的数据行宽不一定是 4 的倍数（如 R8/RGB8），按行字节数设置解包对齐
+    static void setUnpackAlignment(int width, TextureFormat format) {
+        size_t rowBytes = static_cast<size_t>(width) * getTextureFormatDataBytesPerPixel(format);
+        GLint alignment = rowBytes % 8 == 0 ? 8 : rowBytes % 4 == 0 ? 4 : rowBytes % 2 == 0 ? 2 : 1;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+    }
+    
+    void OpenGLContext::detectCompressedFormats() {
+        if (!options_.compressedTextures) {
+            std::cout << "块压缩纹理已禁用，将在 CPU 上解压后上传" << std::endl;
+            return;
+        }
+        
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        bool s3tcSrgb = false;
+        for (GLint i = 0; i < extensionCount; ++i) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (!name) continue;
+            std::string extension(name);
+            if (extension == "GL_EXT_texture_compression_s3tc") s3tcSupported_ = true;
+            else if (extension == "GL_EXT_texture_sRGB" || extension == "GL_EXT_texture_compression_s3tc_srgb") s3tcSrgb = true;
+            else if (extension == "GL_ARB_texture_compression_rgtc") rgtcSupported_ = true;
+            else if (extension == "GL_ARB_texture_compression_bptc") bptcSupported_ = true;
+        }
+        
+        // RGTC 自 3.0、BPTC 自 4.2 起为核心功能；S3TC 始终需要扩展
+        int version = majorVersion_ * 10 + minorVersion_;
+        rgtcSupported_ = rgtcSupported_ || version >= 30;
+        bptcSupported_ = bptcSupported_ || version >= 42;
+        s3tcSrgbSupported_ = s3tcSupported_ && s3tcSrgb;
+        
+        std::cout << "块压缩格式支持: S3TC=" << s3tcSupported_ << " S3TC_sRGB=" << s3tcSrgbSupported_
+                  << " RGTC=" << rgtcSupported_ << " BPTC=" << bptcSupported_ << std::endl;
+    }
+    
+    bool OpenGLContext::supportsTextureFormat(TextureFormat format) const {
+        switch (format) {
+            case TextureFormat::BC1:
+            case TextureFormat::BC3: return s3tcSupported_;
+            case TextureFormat::BC1_SRGB:
+            case TextureFormat::BC3_SRGB: return s3tcSrgbSupported_;
+            case TextureFormat::BC4:
+            case TextureFormat::BC5: return rgtcSupported_;
+            case TextureFormat::BC7:
+            case TextureFormat::BC7_SRGB: return bptcSupported_;
+            default: return true;
+        }
+    }
+    
+    TextureFormat OpenGLContext::getStorageFormat(TextureFormat format) const {
+        if (isCompressedTextureFormat(format) && !supportsTextureFormat(format)) {
+            return TextureCompressor::getDecompressedFormat(format);
+        }
+        return format;
+    }
+    
+    void OpenGLContext::uploadTextureLevel(TextureFormat format, int level, int width, int height,
+                                           const void* data, bool update) {
+        std::vector<uint8_t> decompressed;
+        if (isCompressedTextureFormat(format)) {
+            if (supportsTextureFormat(format)) {
+                GLenum internalFormat = getOpenGLTextureFormat(format).internalFormat;
+                GLsizei imageSize = static_cast<GLsizei>(getTextureLevelDataSize(format, width, height));
+                if (update) {
+                    glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, internalFormat, imageSize, data);
+                } else {
+                    glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, imageSize, data);
+                }
+                return;
+            }
+            
+            // 驱动不支持：解压为对应的未压缩格式
+            TextureFormat target = TextureCompressor::getDecompressedFormat(format);
+            if (data) {
+                decompressed.resize(getTextureLevelDataSize(target, width, height));
+                TextureCompressor::decompress(data, width, height, format, decompressed.data());
+                data = decompressed.data();
             }
-            std::cout << "Written " << size << " bytes to index buffer " << bufferId << std::endl;
+            format = target;
+        }
+        
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(format);
+        setUnpackAlignment(width, format);
+        if (update) {
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, glFormat.format, glFormat.type, data);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, level, glFormat.internalFormat, width, height, 0, glFormat.format, glFormat.type, data);
         }
     }
     
-    void* OpenGLContext::createTexture(int width, int height, const void* data) {
+    // 单/双通道格式按灰度、灰度+透明度采样，着色器无需区分通道数
+    static void applyTextureSwizzle(GLenum target, TextureFormat format) {
+        if (format == TextureFormat::R8 || format == TextureFormat::R16F || format == TextureFormat::BC4) {
+            const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_ONE};
+            glTexParameteriv(target, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        } else if (format == TextureFormat::RG8) {
+            const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+            glTexParameteriv(target, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+    }
+    
+    static GLenum getTextureTarget(const OpenGLResourceRegistry::TextureRecord& record) {
+        return record.layers > 0 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+    }
+    
+    TextureHandle OpenGLContext::createTexture(int width, int height, const void* data, TextureFormat format) {
+        if (!resources_) {
+            std::cerr << "OpenGLContext::createTexture - Context not initialized" << std::endl;
+            return TextureHandle{};
+        }
+        
         GLuint texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        textureBindings_->bindForEdit(GL_TEXTURE_2D, texture);
         
         // 设置纹理参数
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // 只有第 0 级时纹理也是完整的；写入更多 Mip 级别时再提高上限
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        
+        applyTextureSwizzle(GL_TEXTURE_2D, format);
         
         // 上传纹理数据
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        uploadTextureLevel(format, 0, width, height, data, false);
+        
+        size_t bytes = getTextureLevelSize(getStorageFormat(format), width, height);
+        std::cout << "Created texture: " << texture << " (" << width << "x" << height << ", " << bytes << " bytes)" << std::endl;
+        return resources_->addTexture(texture, width, height, bytes, format);
+    }
+    
+    TextureHandle OpenGLContext::createTextureArray(int width, int height, int layers, int levels, TextureFormat format) {
+        if (!resources_ || width <= 0 || height <= 0 || layers <= 0 || levels <= 0) {
+            std::cerr << "OpenGLContext::createTextureArray - invalid arguments or context not initialized" << std::endl;
+            return TextureHandle{};
+        }
         
-        std::cout << "Created texture: " << texture << " (" << width << "x" << height << ")" << std::endl;
-        return reinterpret_cast<void*>(static_cast<uintptr_t>(texture));
+        GLuint texture;
+        glGenTextures(1, &texture);
+        textureBindings_->bindForEdit(GL_TEXTURE_2D_ARRAY, texture);
+        
+        // 重复寻址由着色器在层内区域中完成，数组本身夹取到边缘
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        applyTextureSwizzle(GL_TEXTURE_2D_ARRAY, format);
+        
+        // 逐级分配存储
+        TextureFormat storage = getStorageFormat(format);
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(storage);
+        size_t bytes = 0;
+        for (int level = 0; level < levels; ++level) {
+            int levelWidth = std::max(1, width >> level);
+            int levelHeight = std::max(1, height >> level);
+            size_t levelBytes = getTextureLevelDataSize(storage, levelWidth, levelHeight) * layers;
+            if (isCompressedTextureFormat(storage)) {
+                glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, glFormat.internalFormat, levelWidth, levelHeight, layers,
+                                       0, static_cast<GLsizei>(levelBytes), nullptr);
+            } else {
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, level, glFormat.internalFormat, levelWidth, levelHeight, layers,
+                             0, glFormat.format, glFormat.type, nullptr);
+            }
+            bytes += getTextureLevelSize(storage, levelWidth, levelHeight) * layers;
+        }
+        
+        std::cout << "Created texture array: " << texture << " (" << width << "x" << height << "x" << layers
+                  << ", " << levels << " levels, " << bytes << " bytes)" << std::endl;
+        TextureHandle handle = resources_->addTexture(texture, width, height, bytes, format);
+        auto* record = resources_->getTexture(handle);
+        record->levels = levels;
+        record->layers = layers;
+        return handle;
+    }
+    
+    void OpenGLContext::writeTextureArrayRegion(TextureHandle texture, int level, int layer, int x, int y,
+                                                int width, int height, const void* data) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record || record->layers <= 0 || !data || level >= record->levels || layer >= record->layers) {
+            return;
+        }
+        
+        textureBindings_->bindForEdit(GL_TEXTURE_2D_ARRAY, record->id);
+        TextureFormat format = record->format;
+        std::vector<uint8_t> decompressed;
+        if (isCompressedTextureFormat(format)) {
+            if (supportsTextureFormat(format)) {
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, x, y, layer, width, height, 1,
+                                          getOpenGLTextureFormat(format).internalFormat,
+                                          static_cast<GLsizei>(getTextureLevelDataSize(format, width, height)), data);
+                return;
+            }
+            TextureFormat target = TextureCompressor::getDecompressedFormat(format);
+            decompressed.resize(getTextureLevelDataSize(target, width, height));
+            TextureCompressor::decompress(data, width, height, format, decompressed.data());
+            data = decompressed.data();
+            format = target;
+        }
+        
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(format);
+        setUnpackAlignment(width, format);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, x, y, layer, width, height, 1, glFormat.format, glFormat.type, data);
+    }
+    
+    void OpenGLContext::writeTextureRegion(TextureHandle texture, int x, int y, int width, int height, const void* data) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record || record->layers > 0 || !data || isCompressedTextureFormat(record->format)) {
+            return;
+        }
+        
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(record->format);
+        textureBindings_->bindForEdit(GL_TEXTURE_2D, record->id);
+        setUnpackAlignment(width, record->format);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat.format, glFormat.type, data);
+    }
+    
+    void OpenGLContext::writeTextureRegionFromBuffer(TextureHandle texture, int x, int y, int width, int height,
+                                                     BufferHandle buffer, size_t offset) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        auto* bufferRecord = resources_ ? resources_->getBuffer(buffer) : nullptr;
+        if (!record || !bufferRecord || record->layers > 0 || isCompressedTextureFormat(record->format)) {
+            return;
+        }
+        
+        // 像素从 PBO 读取，glTexSubImage2D 立即返回，由 GPU 异步完成拷贝
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(record->format);
+        textureBindings_->bindForEdit(GL_TEXTURE_2D, record->id);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bufferRecord->id);
+        setUnpackAlignment(width, record->format);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat.format, glFormat.type,
+                        reinterpret_cast<const void*>(offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    
+    BufferHandle OpenGLContext::createPixelUploadBuffer(size_t size, void** outMapped) {
+        if (outMapped) *outMapped = nullptr;
+        if (!resources_ || !GLAD_GL_VERSION_4_4) {
+            // 没有 glBufferStorage 时无法让其他线程直接写入，由调用方改用客户端内存上传
+            return BufferHandle{};
+        }
+        
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, flags);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!mapped) {
+            std::cerr << "OpenGLContext::createPixelUploadBuffer - Persistent mapping failed" << std::endl;
+            glDeleteBuffers(1, &buffer);
+            return BufferHandle{};
+        }
+        
+        if (outMapped) *outMapped = mapped;
+        return resources_->addBuffer(buffer, BufferTarget::PixelUnpack, BufferUsage::Stream, size);
+    }
+    
+    void* OpenGLContext::createFence() {
+        return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    
+    bool OpenGLContext::isFenceSignaled(void* fence) {
+        if (!fence) return true;
+        GLenum result = glClientWaitSync(static_cast<GLsync>(fence), 0, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED;
     }
     
-    void OpenGLContext::deleteTexture(void* texture) {
-        if (texture) {
-            GLuint textureId = static_cast<GLuint>(reinterpret_cast<uintptr_t>(texture));
-            glDeleteTextures(1, &textureId);
-            std::cout << "Deleted texture: " << textureId << std::endl;
+    void OpenGLContext::deleteFence(void* fence) {
+        if (fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+        }
+    }
+    
+    void OpenGLContext::deleteTexture(TextureHandle texture) {
+        if (!texture || !resources_ || deferRelease([this, texture]() { deleteTexture(texture); })) {
+            return;
         }
+        resources_->releaseTexture(texture);
     }
     
-    void OpenGLContext::writeTexture(void* texture, const void* data, int width, int height) {
-        if (texture && data) {
-            GLuint textureId = static_cast<GLuint>(reinterpret_cast<uintptr_t>(texture));
-            glBindTexture(GL_TEXTURE_2D, textureId);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    void OpenGLContext::writeTexture(TextureHandle texture, const void* data, int width, int height) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (record && data) {
+            GLuint textureId = record->id;
+            textureBindings_->bindForEdit(GL_TEXTURE_2D, textureId);
+            uploadTextureLevel(record->format, 0, width, height, data, true);
             std::cout << "Updated texture " << textureId << " with data (" << width << "x" << height << ")" << std::endl;
         }
     }
     
-    void OpenGLContext::draw(std::shared_ptr<class Mesh> mesh) {
+    void OpenGLContext::writeTextureLevel(TextureHandle texture, int level, const void* data, int width, int height) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record || !data || level <= 0) {
+            return;
+        }
+        
+        textureBindings_->bindForEdit(GL_TEXTURE_2D, record->id);
+        uploadTextureLevel(record->format, level, width, height, data, false);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
+        
+        // 第一次写入该级别时计入显存统计
+        if (level > record->levels - 1) {
+            record->bytes += getTextureLevelSize(getStorageFormat(record->format), width, height);
+            record->levels = level + 1;
+        }
+    }
+    
+    void OpenGLContext::generateMipmaps(TextureHandle texture) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record) {
+            return;
+        }
+        if (isCompressedTextureFormat(getStorageFormat(record->format))) {
+            // 压缩格式不能由 GPU 生成 Mip，应在导入时生成 CPU Mip 链（已解压上传的除外）
+            std::cerr << "OpenGLContext::generateMipmaps - compressed texture " << record->id
+                      << " has no CPU mip chain" << std::endl;
+            return;
+        }
+        
+        GLenum target = getTextureTarget(*record);
+        textureBindings_->bindForEdit(target, record->id);
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, 1000);
+        glGenerateMipmap(target);
+        
+        // 完整 Mip 链约为第 0 级的 4/3
+        if (record->levels == 1) {
+            record->bytes += record->bytes / 3;
+            record->levels = MipmapGenerator::getMipLevelCount(record->width, record->height);
+        }
+    }
+    
+    void OpenGLContext::setTextureSampler(TextureHandle texture, const TextureSamplerDesc& sampler) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record) {
+            return;
+        }
+        
+        GLenum target = getTextureTarget(*record);
+        textureBindings_->bindForEdit(target, record->id);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, getOpenGLWrapMode(sampler.wrapS));
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, getOpenGLWrapMode(sampler.wrapT));
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, getOpenGLMinFilter(sampler.minFilter));
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, getOpenGLMagFilter(sampler.magFilter));
+    }
+    
+    void OpenGLContext::draw(std::shared_ptr<class Mesh> mesh, size_t lodLevel) {
+        drawInstanced(mesh, lodLevel, 1);
+    }
+    
+    void OpenGLContext::drawInstanced(const std::shared_ptr<class Mesh>& mesh, size_t lodLevel, size_t instanceCount) {
         if (!mesh || !mesh->uploaded) {
             std::cerr << "Mesh not uploaded or invalid" << std::endl;
             return;
         }
+        if (instanceCount == 0) {
+            return;
+        }
+        
+        const GLsizei instances = static_cast<GLsizei>(instanceCount);
+        auto drawElements = [instances](GLenum mode, GLsizei count, const void* offset, GLint baseVertex) {
+            if (instances > 1) {
+                glDrawElementsInstancedBaseVertex(mode, count, GL_UNSIGNED_INT, offset, instances, baseVertex);
+            } else {
+                glDrawElementsBaseVertex(mode, count, GL_UNSIGNED_INT, offset, baseVertex);
+            }
+        };
+        auto drawArrays = [instances](GLenum mode, GLint first, GLsizei count) {
+            if (instances > 1) {
+                glDrawArraysInstanced(mode, first, count, instances);
+            } else {
+                glDrawArrays(mode, first, count);
+            }
+        };
+        
+        // 流式网格：数据位于本帧的环形缓冲区区段
+        const StreamBufferRange& streamRange = mesh->getStreamRange();
+        if (isStreamRangeCurrent(streamRange)) {
+            if (streamRange.indexCount > 0) {
+                auto lod = mesh->geometry->getLodLevel(mesh->hasLods() ? lodLevel : 0);
+                drawElements(
+                    static_cast<GLenum>(mesh->primitive->type),
+                    static_cast<GLsizei>(lod.indexCount),
+                    reinterpret_cast<const void*>((streamRange.firstIndex + lod.indexOffset) * sizeof(unsigned int)),
+                    static_cast<GLint>(streamRange.baseVertex)
+                );
+            } else {
+                drawArrays(
+                    static_cast<GLenum>(mesh->primitive->type),
+                    static_cast<GLint>(streamRange.baseVertex),
+                    static_cast<GLsizei>(mesh->geometry->vertexCount)
+                );
+            }
+            return;
+        }
+        
+        // 池化网格：所在页的 VAO 已由渲染管线绑定，通过 baseVertex / firstIndex 定位到网格自己的区间
+        const OpenGLBufferArena::Allocation* allocation =
+            bufferArena_ ? bufferArena_->getAllocation(mesh->getBufferAllocation()) : nullptr;
+        if (allocation) {
+            if (allocation->indexCount > 0) {
+                auto lod = mesh->geometry->getLodLevel(mesh->hasLods() ? lodLevel : 0);
+                drawElements(
+                    static_cast<GLenum>(mesh->primitive->type),
+                    static_cast<GLsizei>(lod.indexCount),
+                    reinterpret_cast<const void*>((allocation->firstIndex + lod.indexOffset) * sizeof(unsigned int)),
+                    static_cast<GLint>(allocation->baseVertex)
+                );
+            } else {
+                drawArrays(
+                    static_cast<GLenum>(mesh->primitive->type),
+                    static_cast<GLint>(allocation->baseVertex),
+                    static_cast<GLsizei>(allocation->vertexCount)
+                );
+            }
+            return;
+        }
         
         // 绘制网格
         if (mesh->geometry->indexCount > 0) {
-            // 使用索引绘制
-            glDrawElements(
+            // 使用索引绘制，LOD 级别对应共享 IBO 中的一段索引区间
+            auto lod = mesh->geometry->getLodLevel(mesh->hasLods() ? lodLevel : 0);
+            drawElements(
                 static_cast<GLenum>(mesh->primitive->type),
-                static_cast<GLsizei>(mesh->geometry->indexCount),
-                GL_UNSIGNED_INT,
+                static_cast<GLsizei>(lod.indexCount),
+                reinterpret_cast<const void*>(lod.indexOffset * sizeof(unsigned int)),
                 0
             );
-            std::cout << "Drew mesh with " << mesh->geometry->indexCount << " indices" << std::endl;
+            std::cout << "Drew mesh with " << lod.indexCount << " indices (LOD " << lodLevel << ")" << std::endl;
         } else {
             // 直接绘制顶点
-            glDrawArrays(
+            drawArrays(
                 static_cast<GLenum>(mesh->primitive->type),
                 0,
                 static_cast<GLsizei>(mesh->geometry->vertexCount)
@@ -204,32 +788,40 @@ namespace iengine {
     }
     
     void OpenGLContext::bindVAO(unsigned int vao) {
-        if (vaoSupported_) {
+        if (vaoSupported_ && vao != boundVAO_) {
             glBindVertexArray(vao);
-            std::cout << "Bound VAO: " << vao << std::endl;
+            boundVAO_ = vao;
         }
     }
     
     void OpenGLContext::unbindVAO() {
-        if (vaoSupported_) {
+        if (vaoSupported_ && boundVAO_ != 0) {
             glBindVertexArray(0);
-            std::cout << "Unbound VAO" << std::endl;
+            boundVAO_ = 0;
         }
     }
     
     void OpenGLContext::deleteVAO(unsigned int vao) {
         if (vaoSupported_ && vao > 0) {
+            if (vao == boundVAO_) {
+                boundVAO_ = 0;
+            }
             glDeleteVertexArrays(1, &vao);
             std::cout << "Deleted VAO: " << vao << std::endl;
         }
     }
     
-    unsigned int OpenGLContext::createProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    ProgramHandle OpenGLContext::createProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+        if (!resources_) {
+            std::cerr << "OpenGLContext::createProgram - Context not initialized" << std::endl;
+            return ProgramHandle{};
+        }
+        
         // 编译顶点着色器
         unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
         if (vertexShader == 0) {
             std::cerr << "Failed to compile vertex shader" << std::endl;
-            return 0;
+            return ProgramHandle{};
         }
         
         // 编译片段着色器
@@ -237,7 +829,7 @@ namespace iengine {
         if (fragmentShader == 0) {
             std::cerr << "Failed to compile fragment shader" << std::endl;
             glDeleteShader(vertexShader);
-            return 0;
+            return ProgramHandle{};
         }
         
         // 创建着色器程序
@@ -251,7 +843,7 @@ namespace iengine {
             glDeleteShader(vertexShader);
             glDeleteShader(fragmentShader);
             glDeleteProgram(program);
-            return 0;
+            return ProgramHandle{};
         }
         
         // 清理着色器对象
@@ -259,7 +851,7 @@ namespace iengine {
         glDeleteShader(fragmentShader);
         
         std::cout << "Created shader program: " << program << std::endl;
-        return program;
+        return resources_->addProgram(program);
     }
     
     void OpenGLContext::useProgram(unsigned int program) {
@@ -267,11 +859,53 @@ namespace iengine {
         std::cout << "Using shader program: " << program << std::endl;
     }
     
-    void OpenGLContext::deleteProgram(unsigned int program) {
-        if (program > 0) {
-            glDeleteProgram(program);
-            std::cout << "Deleted shader program: " << program << std::endl;
+    void OpenGLContext::deleteProgram(ProgramHandle program) {
+        if (program && resources_) {
+            resources_->releaseProgram(program);
+        }
+    }
+    
+    unsigned int OpenGLContext::getBufferId(BufferHandle buffer) const {
+        auto* record = resources_ ? resources_->getBuffer(buffer) : nullptr;
+        return record ? record->id : 0;
+    }
+    
+    unsigned int OpenGLContext::getTextureId(TextureHandle texture) const {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        return record ? record->id : 0;
+    }
+    
+    unsigned int OpenGLContext::getProgramId(ProgramHandle program) const {
+        auto* record = resources_ ? resources_->getProgram(program) : nullptr;
+        return record ? record->id : 0;
+    }
+    
+    GpuResourceStats OpenGLContext::getResourceStats() const {
+        GpuResourceStats stats = resources_ ? resources_->getStats() : GpuResourceStats{};
+        
+        // 缓冲区池的页和流式环形缓冲区不经过登记表，单独计入
+        if (bufferArena_) {
+            BufferArenaStats arenaStats = bufferArena_->getStats();
+            stats.buffers.count += arenaStats.pageCount * 2;
+            stats.buffers.bytes += arenaStats.vertexBytesCapacity + arenaStats.indexBytesCapacity;
+        }
+        if (streamBuffer_) {
+            stats.buffers.count += 1;
+            stats.buffers.bytes += streamBuffer_->getStats().capacity;
         }
+        return stats;
+    }
+    
+    void OpenGLContext::printResourceStats() const {
+        GpuResourceStats stats = getResourceStats();
+        auto print = [](const char* name, const GpuResourceTypeStats& typeStats) {
+            std::cout << "  " << name << ": " << typeStats.count << " (" << typeStats.bytes << " bytes), pending delete: "
+                      << typeStats.pendingCount << " (" << typeStats.pendingBytes << " bytes)" << std::endl;
+        };
+        std::cout << "OpenGLContext GPU resources (frame " << stats.frame << "):" << std::endl;
+        print("Buffers", stats.buffers);
+        print("Textures", stats.textures);
+        print("Programs", stats.programs);
     }
     
     int OpenGLContext::getUniformLocation(unsigned int program, const std::string& name) {
@@ -433,13 +1067,32 @@ namespace iengine {
     
     // 纹理操作方法（新增）
     void OpenGLContext::activeTexture(int unit) {
-        glActiveTexture(GL_TEXTURE0 + unit);
+        textureBindings_->setActiveUnit(unit);
+    }
+    
+    void OpenGLContext::bindTexture(TextureHandle texture) {
+        bindTextureUnit(textureBindings_->getActiveUnit(), texture);
     }
     
-    void OpenGLContext::bindTexture(void* texture) {
-        if (texture) {
-            unsigned int textureId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(texture));
-            glBindTexture(GL_TEXTURE_2D, textureId);
+    void OpenGLContext::bindTextureUnit(int unit, TextureHandle texture, const TextureSamplerDesc* sampler) {
+        auto* record = resources_ ? resources_->getTexture(texture) : nullptr;
+        if (!record) {
+            return;
         }
+        unsigned int samplerObject = sampler ? textureBindings_->getSampler(*sampler) : 0;
+        textureBindings_->bind(unit, getTextureTarget(*record), record->id, texture, samplerObject);
+    }
+    
+    void OpenGLContext::setProgramUniform1i(unsigned int program, int location, int value) {
+        if (majorVersion_ > 4 || (majorVersion_ == 4 && minorVersion_ >= 1)) {
+            glProgramUniform1i(program, location, value);
+            return;
+        }
+        // GL 4.1 之前没有 glProgramUniform，临时切换程序后恢复
+        GLint current = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+        glUseProgram(program);
+        glUniform1i(location, value);
+        glUseProgram(static_cast<GLuint>(current));
     }
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "iengine/renderers/opengl/OpenGLReadback.h"
+#include "iengine/core/ThreadPool.h"
+#include "iengine/textures/TextureUtils.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace iengine {
+    // 池中最多保留的空闲 PBO 数
+    static const size_t MaxPooledBuffers = 8;
+
+    OpenGLReadbackQueue::OpenGLReadbackQueue() = default;
+
+    OpenGLReadbackQueue::~OpenGLReadbackQueue() {
+        // 未完成的读取以失败结束，不再等待 GPU
+        for (auto& pending : pending_) {
+            glDeleteSync(static_cast<GLsync>(pending.fence));
+            glDeleteBuffers(1, &pending.buffer);
+            if (!pending.capture) {
+                pending.promise.set_value(std::move(pending.result));
+            }
+        }
+        pending_.clear();
+        for (const auto& pooled : buffers_) {
+            glDeleteBuffers(1, &pooled.buffer);
+        }
+        buffers_.clear();
+        // 等待文件写入完成
+        writer_.reset();
+    }
+
+    unsigned int OpenGLReadbackQueue::acquireBuffer(size_t size, size_t& outCapacity) {
+        // 选容量足够的最小缓冲区
+        auto best = buffers_.end();
+        for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+            if (it->size >= size && (best == buffers_.end() || it->size < best->size)) {
+                best = it;
+            }
+        }
+        if (best != buffers_.end()) {
+            unsigned int buffer = best->buffer;
+            outCapacity = best->size;
+            buffers_.erase(best);
+            return buffer;
+        }
+
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        outCapacity = size;
+        return buffer;
+    }
+
+    void OpenGLReadbackQueue::releaseBuffer(unsigned int buffer, size_t size) {
+        if (buffers_.size() >= MaxPooledBuffers) {
+            glDeleteBuffers(1, &buffer);
+            return;
+        }
+        buffers_.push_back(PooledBuffer{buffer, size});
+    }
+
+    bool OpenGLReadbackQueue::issue(Pending& pending, const ReadbackRequest& request, int defaultWidth, int defaultHeight) {
+        int width = request.width;
+        int height = request.height;
+        if (request.framebuffer == 0) {
+            if (width <= 0) width = defaultWidth - request.x;
+            if (height <= 0) height = defaultHeight - request.y;
+        }
+        if (width <= 0 || height <= 0 || request.x < 0 || request.y < 0 || isCompressedTextureFormat(request.format)) {
+            std::cerr << "OpenGLReadbackQueue: invalid readback region or format" << std::endl;
+            return false;
+        }
+
+        size_t size = getTextureLevelDataSize(request.format, width, height);
+        OpenGLTextureFormat glFormat = getOpenGLTextureFormat(request.format);
+        pending.buffer = acquireBuffer(size, pending.capacity);
+        pending.size = size;
+        pending.flipY = request.flipY;
+        pending.result.width = width;
+        pending.result.height = height;
+        pending.result.format = request.format;
+
+        // 读到 PBO 时 glReadPixels 只是把拷贝命令放进队列，立即返回
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, request.framebuffer);
+        if (request.framebuffer != 0) {
+            glReadBuffer(GL_COLOR_ATTACHMENT0 + request.colorAttachment);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pending.buffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(request.x, request.y, width, height, glFormat.format, glFormat.type, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        pending.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        return true;
+    }
+
+    std::future<ReadbackResult> OpenGLReadbackQueue::submit(const ReadbackRequest& request, int defaultWidth,
+                                                            int defaultHeight, uint64_t frame) {
+        Pending pending;
+        pending.result.frame = frame;
+        std::future<ReadbackResult> future = pending.promise.get_future();
+        if (!issue(pending, request, defaultWidth, defaultHeight)) {
+            stats_.failed++;
+            pending.promise.set_value(std::move(pending.result));
+            return future;
+        }
+        pending_.push_back(std::move(pending));
+        stats_.pending = pending_.size();
+        return future;
+    }
+
+    void OpenGLReadbackQueue::poll(uint64_t frame) {
+        // fence 按提交顺序完成，遇到第一个未完成的即可停止
+        while (!pending_.empty()) {
+            Pending& pending = pending_.front();
+            GLsync fence = static_cast<GLsync>(pending.fence);
+            GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            glDeleteSync(fence);
+
+            ReadbackResult result = std::move(pending.result);
+            if (status != GL_WAIT_FAILED) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, pending.buffer);
+                const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(pending.size),
+                                                      GL_MAP_READ_BIT);
+                if (mapped) {
+                    const uint8_t* src = static_cast<const uint8_t*>(mapped);
+                    size_t rowBytes = pending.size / static_cast<size_t>(result.height);
+                    result.data.resize(pending.size);
+                    if (pending.flipY) {
+                        for (int row = 0; row < result.height; ++row) {
+                            std::memcpy(result.data.data() + static_cast<size_t>(row) * rowBytes,
+                                        src + static_cast<size_t>(result.height - 1 - row) * rowBytes, rowBytes);
+                        }
+                    } else {
+                        std::memcpy(result.data.data(), src, pending.size);
+                    }
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    result.success = true;
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            }
+            releaseBuffer(pending.buffer, pending.capacity);
+
+            if (result.success) {
+                stats_.completed++;
+                stats_.bytesRead += pending.size;
+                latencyTotal_ += frame - result.frame;
+                stats_.averageLatencyFrames = static_cast<double>(latencyTotal_) / static_cast<double>(stats_.completed);
+            } else {
+                stats_.failed++;
+            }
+
+            bool capture = pending.capture;
+            std::promise<ReadbackResult> promise = std::move(pending.promise);
+            pending_.pop_front();
+            if (capture) {
+                pendingCaptures_--;
+                if (result.success) {
+                    deliverCapture(std::move(result));
+                }
+            } else {
+                promise.set_value(std::move(result));
+            }
+        }
+        stats_.pending = pending_.size();
+        stats_.pooledBuffers = buffers_.size();
+    }
+
+    bool OpenGLReadbackQueue::startCapture(const FrameCaptureOptions& options) {
+        stopCapture();
+        // 上一次采集的写入完成后再打开新文件
+        writer_.reset();
+        captureFile_.reset();
+
+        if (!options.filePath.empty()) {
+            auto file = std::make_shared<std::ofstream>(options.filePath, std::ios::binary | std::ios::trunc);
+            if (!file->is_open()) {
+                std::cerr << "OpenGLReadbackQueue: Failed to open capture file " << options.filePath << std::endl;
+                return false;
+            }
+            captureFile_ = file;
+            writer_ = std::make_unique<ThreadPool>(1);
+        }
+
+        capture_ = options;
+        capturing_ = true;
+        nextCapture_ = Clock::now();
+        std::cout << "OpenGLReadbackQueue: Frame capture started at " << options.framesPerSecond << " fps"
+                  << (options.filePath.empty() ? "" : " -> " + options.filePath) << std::endl;
+        return true;
+    }
+
+    void OpenGLReadbackQueue::stopCapture() {
+        // 已发起的采集仍会在完成时交付
+        capturing_ = false;
+    }
+
+    void OpenGLReadbackQueue::captureFrame(int defaultWidth, int defaultHeight, uint64_t frame) {
+        if (!capturing_) return;
+
+        Clock::time_point now = Clock::now();
+        if (capture_.framesPerSecond > 0.0) {
+            if (now < nextCapture_) return;
+            // 保持固定节拍，落后超过一个间隔时从当前时间重新计时
+            auto interval = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / capture_.framesPerSecond));
+            nextCapture_ += interval;
+            if (nextCapture_ <= now) {
+                nextCapture_ = now + interval;
+            }
+        }
+
+        if (pendingCaptures_ >= capture_.maxPendingFrames) {
+            stats_.skippedCaptures++;
+            return;
+        }
+
+        Pending pending;
+        pending.capture = true;
+        pending.result.frame = frame;
+        if (!issue(pending, capture_.region, defaultWidth, defaultHeight)) {
+            stats_.failed++;
+            return;
+        }
+        pending_.push_back(std::move(pending));
+        pendingCaptures_++;
+        stats_.pending = pending_.size();
+    }
+
+    void OpenGLReadbackQueue::deliverCapture(ReadbackResult result) {
+        stats_.capturedFrames++;
+        if (capture_.callback) {
+            capture_.callback(result);
+        }
+        if (captureFile_ && writer_) {
+            auto file = captureFile_;
+            auto data = std::make_shared<std::vector<uint8_t>>(std::move(result.data));
+            writer_->enqueue([file, data]() {
+                file->write(reinterpret_cast<const char*>(data->data()), static_cast<std::streamsize>(data->size()));
+            });
+        }
+    }
+
+    void OpenGLReadbackQueue::printStats() const {
+        std::cout << "OpenGLReadbackQueue stats: " << stats_.pending << " pending, " << stats_.pooledBuffers
+                  << " pooled buffers, " << stats_.completed << " completed / " << stats_.failed << " failed, "
+                  << stats_.bytesRead << " bytes read, latency avg " << stats_.averageLatencyFrames << " frames, "
+                  << stats_.capturedFrames << " frames captured / " << stats_.skippedCaptures << " skipped" << std::endl;
+    }
+}
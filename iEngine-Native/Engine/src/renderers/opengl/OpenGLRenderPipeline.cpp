@@ -28,10 +28,22 @@ namespace iengine {
     }
     
     void OpenGLRenderPipeline::setupVAO(std::shared_ptr<Mesh> mesh, std::shared_ptr<OpenGLShaderProgram> shader, std::shared_ptr<OpenGLContext> context) {
+        if (!mesh) {
+            std::cerr << "OpenGLRenderPipeline::setupVAO - Invalid parameters" << std::endl;
+            return;
+        }
+        
+        unsigned int vboId = context ? context->getBufferId(mesh->getVBO()) : 0;
+        unsigned int iboId = context ? context->getBufferId(mesh->getIBO()) : 0;
+        setupVAO(mesh->getVertexLayout(), vboId, iboId, shader, context);
+    }
+    
+    void OpenGLRenderPipeline::setupVAO(const VertexLayout& layout, unsigned int vboId, unsigned int iboId,
+                                        std::shared_ptr<OpenGLShaderProgram> shader, std::shared_ptr<OpenGLContext> context) {
         context_ = context;
         shaderProgram_ = shader;
         
-        if (!mesh || !shader || !context) {
+        if (!shader || !context) {
             std::cerr << "OpenGLRenderPipeline::setupVAO - Invalid parameters" << std::endl;
             return;
         }
@@ -47,18 +59,16 @@ namespace iengine {
         context->bindVAO(vao_);
         
         // 绑定 VBO
-        if (mesh->getVBO()) {
-            unsigned int vboId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mesh->getVBO()));
+        if (vboId) {
             glBindBuffer(GL_ARRAY_BUFFER, vboId);
         } else {
-            std::cerr << "OpenGLRenderPipeline::setupVAO - Mesh VBO is null" << std::endl;
+            std::cerr << "OpenGLRenderPipeline::setupVAO - VBO is null" << std::endl;
             context->unbindVAO();
             return;
         }
         
         // 设置顶点属性指针
-        auto layout = mesh->getVertexLayout();
-        unsigned int programId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(shader->program));
+        unsigned int programId = shader->getProgramId();
         
         for (const auto& attr : layout.attributes) {
             int location = context->getAttribLocation(programId, attr.name);
@@ -95,8 +105,7 @@ namespace iengine {
         }
         
         // 绑定 IBO（如果有）
-        if (mesh->getIBO()) {
-            unsigned int iboId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mesh->getIBO()));
+        if (iboId) {
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboId);
         }
         
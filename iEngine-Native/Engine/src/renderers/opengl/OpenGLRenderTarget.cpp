@@ -0,0 +1,358 @@
+#include "iengine/renderers/opengl/OpenGLRenderTarget.h"
+#include "iengine/renderers/opengl/OpenGLContext.h"
+#include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureUtils.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace iengine {
+    OpenGLRenderTarget::OpenGLRenderTarget(OpenGLContext& context, const RenderTargetDesc& desc, int width, int height)
+        : context_(context), desc_(desc), width_(std::max(width, 1)), height_(std::max(height, 1)) {
+        if (isCompressedTextureFormat(desc_.colorFormat) || isDepthTextureFormat(desc_.colorFormat)) {
+            std::cerr << "OpenGLRenderTarget " << desc_.name << ": unsupported color format, using RGBA8" << std::endl;
+            desc_.colorFormat = TextureFormat::RGBA8;
+        }
+        if (!isDepthTextureFormat(desc_.depthFormat)) {
+            desc_.depthFormat = TextureFormat::DEPTH24_STENCIL8;
+        }
+        desc_.colorAttachments = std::max(desc_.colorAttachments, 0);
+        create();
+    }
+
+    OpenGLRenderTarget::~OpenGLRenderTarget() {
+        destroy();
+    }
+
+    TextureHandle OpenGLRenderTarget::getColorTexture(int index) const {
+        if (index < 0 || index >= static_cast<int>(colorTextures_.size())) {
+            return TextureHandle{};
+        }
+        return colorTextures_[index];
+    }
+
+    void OpenGLRenderTarget::create() {
+        GLint maxSamples = 1;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        GLint maxColorAttachments = 1;
+        glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &maxColorAttachments);
+        samples_ = std::min(std::max(desc_.samples, 1), std::max(maxSamples, 1));
+        int colorCount = std::min(desc_.colorAttachments, static_cast<int>(maxColorAttachments));
+        bool multisample = samples_ > 1;
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGenFramebuffers(1, &framebuffer_);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+
+        // 附件作为渲染结果采样时夹取到边缘，不使用 Mip
+        TextureSamplerDesc sampler;
+        sampler.wrapS = TextureWrapMode::ClampToEdge;
+        sampler.wrapT = TextureWrapMode::ClampToEdge;
+        sampler.minFilter = TextureMinFilter::Linear;
+
+        bytes_ = 0;
+        std::vector<GLenum> drawBuffers;
+        OpenGLTextureFormat colorFormat = getOpenGLTextureFormat(desc_.colorFormat);
+        for (int i = 0; i < colorCount; ++i) {
+            GLenum attachment = GL_COLOR_ATTACHMENT0 + i;
+            if (multisample) {
+                GLuint renderbuffer = 0;
+                glGenRenderbuffers(1, &renderbuffer);
+                glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+                glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples_, colorFormat.internalFormat, width_, height_);
+                glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbuffer);
+                colorRenderbuffers_.push_back(renderbuffer);
+            } else {
+                TextureHandle texture = context_.createTexture(width_, height_, nullptr, desc_.colorFormat);
+                context_.setTextureSampler(texture, sampler);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, context_.getTextureId(texture), 0);
+                colorTextures_.push_back(texture);
+            }
+            bytes_ += getTextureLevelSize(desc_.colorFormat, width_, height_) * static_cast<size_t>(samples_);
+            drawBuffers.push_back(attachment);
+        }
+
+        if (desc_.depth) {
+            GLenum attachment = desc_.depthFormat == TextureFormat::DEPTH24_STENCIL8 ? GL_DEPTH_STENCIL_ATTACHMENT
+                                                                                      : GL_DEPTH_ATTACHMENT;
+            if (desc_.sampleDepth && !multisample) {
+                depthTexture_ = context_.createTexture(width_, height_, nullptr, desc_.depthFormat);
+                sampler.minFilter = TextureMinFilter::Nearest;
+                sampler.magFilter = TextureMagFilter::Nearest;
+                context_.setTextureSampler(depthTexture_, sampler);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, context_.getTextureId(depthTexture_), 0);
+            } else {
+                glGenRenderbuffers(1, &depthRenderbuffer_);
+                glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer_);
+                GLenum internalFormat = getOpenGLTextureFormat(desc_.depthFormat).internalFormat;
+                if (multisample) {
+                    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples_, internalFormat, width_, height_);
+                } else {
+                    glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width_, height_);
+                }
+                glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, depthRenderbuffer_);
+            }
+            bytes_ += getTextureLevelSize(desc_.depthFormat, width_, height_) * static_cast<size_t>(samples_);
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        if (drawBuffers.empty()) {
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        } else {
+            glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+            glReadBuffer(GL_COLOR_ATTACHMENT0);
+        }
+
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        complete_ = status == GL_FRAMEBUFFER_COMPLETE;
+        if (!complete_) {
+            std::cerr << "OpenGLRenderTarget " << desc_.name << ": framebuffer incomplete (0x" << std::hex << status
+                      << std::dec << ")" << std::endl;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    }
+
+    void OpenGLRenderTarget::destroy() {
+        // 纹理经登记表延迟删除；帧缓冲和渲染缓冲被在途命令引用时由驱动保证删除安全
+        for (TextureHandle texture : colorTextures_) {
+            context_.deleteTexture(texture);
+        }
+        colorTextures_.clear();
+        if (depthTexture_) {
+            context_.deleteTexture(depthTexture_);
+            depthTexture_ = TextureHandle{};
+        }
+        if (!colorRenderbuffers_.empty()) {
+            glDeleteRenderbuffers(static_cast<GLsizei>(colorRenderbuffers_.size()), colorRenderbuffers_.data());
+            colorRenderbuffers_.clear();
+        }
+        if (depthRenderbuffer_) {
+            glDeleteRenderbuffers(1, &depthRenderbuffer_);
+            depthRenderbuffer_ = 0;
+        }
+        if (framebuffer_) {
+            context_.onFramebufferDeleted(framebuffer_);
+            glDeleteFramebuffers(1, &framebuffer_);
+            framebuffer_ = 0;
+        }
+        bytes_ = 0;
+        complete_ = false;
+    }
+
+    bool OpenGLRenderTarget::resize(int width, int height) {
+        width = std::max(width, 1);
+        height = std::max(height, 1);
+        if (width == width_ && height == height_) {
+            return false;
+        }
+        destroy();
+        width_ = width;
+        height_ = height;
+        create();
+        return true;
+    }
+
+    void OpenGLRenderTarget::blitTo(const OpenGLRenderTarget* dst, int dstWidth, int dstHeight, bool depth) const {
+        if (dst) {
+            dstWidth = dst->width_;
+            dstHeight = dst->height_;
+        }
+        GLint previousRead = 0;
+        GLint previousDraw = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer_);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst ? dst->framebuffer_ : 0);
+        GLbitfield mask = 0;
+        if (desc_.colorAttachments > 0 && (!dst || dst->desc_.colorAttachments > 0)) {
+            mask |= GL_COLOR_BUFFER_BIT;
+        }
+        if (depth && desc_.depth && (!dst || dst->desc_.depth)) {
+            mask |= GL_DEPTH_BUFFER_BIT;
+        }
+        // 多重采样解析要求源和目标尺寸相同；深度只能用最近点过滤
+        bool scaled = dstWidth != width_ || dstHeight != height_;
+        GLenum filter = (mask & GL_DEPTH_BUFFER_BIT) || !scaled ? GL_NEAREST : GL_LINEAR;
+        if (mask) {
+            glBlitFramebuffer(0, 0, width_, height_, 0, 0, dstWidth, dstHeight, mask, filter);
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousRead));
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousDraw));
+    }
+
+    OpenGLRenderTargetPool::OpenGLRenderTargetPool(OpenGLContext& context, const RenderTargetPoolOptions& options)
+        : context_(context), options_(options) {}
+
+    OpenGLRenderTargetPool::~OpenGLRenderTargetPool() {
+        clear();
+    }
+
+    void OpenGLRenderTargetPool::resolveSize(const RenderTargetDesc& desc, int& width, int& height) const {
+        if (desc.isViewportRelative()) {
+            width = std::max(static_cast<int>(std::lround(viewportWidth_ * desc.scale)), 1);
+            height = std::max(static_cast<int>(std::lround(viewportHeight_ * desc.scale)), 1);
+        } else {
+            width = desc.width;
+            height = desc.height;
+        }
+    }
+
+    bool OpenGLRenderTargetPool::isCompatible(const RenderTargetDesc& a, const RenderTargetDesc& b) {
+        return a.colorFormat == b.colorFormat && a.colorAttachments == b.colorAttachments && a.depth == b.depth &&
+               (!a.depth || (a.depthFormat == b.depthFormat && a.sampleDepth == b.sampleDepth)) &&
+               std::max(a.samples, 1) == std::max(b.samples, 1) &&
+               a.isViewportRelative() == b.isViewportRelative() && (!a.isViewportRelative() || a.scale == b.scale);
+    }
+
+    OpenGLRenderTargetPool::Entry* OpenGLRenderTargetPool::findEntry(const OpenGLRenderTarget* target) {
+        for (auto& entry : entries_) {
+            if (entry.target.get() == target) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    OpenGLRenderTarget* OpenGLRenderTargetPool::acquire(const RenderTargetDesc& desc) {
+        int width = 0;
+        int height = 0;
+        resolveSize(desc, width, height);
+
+        // 复用配置和尺寸都相同、最近使用过的空闲目标
+        Entry* best = nullptr;
+        for (auto& entry : entries_) {
+            if (entry.inUse || entry.target->getWidth() != width || entry.target->getHeight() != height ||
+                !isCompatible(entry.target->getDesc(), desc)) {
+                continue;
+            }
+            if (!best || entry.lastUsedFrame > best->lastUsedFrame) {
+                best = &entry;
+            }
+        }
+        if (best) {
+            best->inUse = true;
+            best->transient = false;
+            best->lastUsedFrame = frame_;
+            stats_.reuses++;
+            return best->target.get();
+        }
+
+        auto target = std::make_unique<OpenGLRenderTarget>(context_, desc, width, height);
+        if (!target->isComplete()) {
+            return nullptr;
+        }
+        stats_.allocations++;
+        Entry entry;
+        entry.target = std::move(target);
+        entry.inUse = true;
+        entry.lastUsedFrame = frame_;
+        entries_.push_back(std::move(entry));
+        // 新分配可能使空闲目标超出预算
+        evictIdle();
+        return entries_.back().target.get();
+    }
+
+    OpenGLRenderTarget* OpenGLRenderTargetPool::acquireTransient(const RenderTargetDesc& desc) {
+        OpenGLRenderTarget* target = acquire(desc);
+        if (Entry* entry = findEntry(target)) {
+            entry->transient = true;
+        }
+        return target;
+    }
+
+    void OpenGLRenderTargetPool::release(OpenGLRenderTarget* target) {
+        Entry* entry = findEntry(target);
+        if (!entry) return;
+        entry->inUse = false;
+        entry->transient = false;
+        entry->lastUsedFrame = frame_;
+    }
+
+    void OpenGLRenderTargetPool::ensureSize(OpenGLRenderTarget* target) {
+        if (!target || !target->getDesc().isViewportRelative()) return;
+        int width = 0;
+        int height = 0;
+        resolveSize(target->getDesc(), width, height);
+        if (target->resize(width, height)) {
+            stats_.reallocations++;
+        }
+    }
+
+    void OpenGLRenderTargetPool::setViewportSize(int width, int height) {
+        // 只记录尺寸，目标在下次使用时才按新尺寸重建
+        viewportWidth_ = std::max(width, 1);
+        viewportHeight_ = std::max(height, 1);
+    }
+
+    void OpenGLRenderTargetPool::endFrame(uint64_t frame) {
+        for (auto& entry : entries_) {
+            if (entry.inUse && entry.transient) {
+                entry.inUse = false;
+                entry.transient = false;
+                entry.lastUsedFrame = frame;
+            }
+        }
+        frame_ = frame;
+        evictIdle();
+    }
+
+    void OpenGLRenderTargetPool::evictIdle() {
+        auto isExpired = [this](const Entry& entry) {
+            return !entry.inUse && frame_ > entry.lastUsedFrame + static_cast<uint64_t>(options_.maxIdleFrames);
+        };
+        size_t before = entries_.size();
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(), isExpired), entries_.end());
+        stats_.evictions += before - entries_.size();
+
+        size_t idleBytes = 0;
+        for (const auto& entry : entries_) {
+            if (!entry.inUse) idleBytes += entry.target->getByteSize();
+        }
+        while (idleBytes > options_.budgetBytes) {
+            auto oldest = entries_.end();
+            for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+                if (!it->inUse && (oldest == entries_.end() || it->lastUsedFrame < oldest->lastUsedFrame)) {
+                    oldest = it;
+                }
+            }
+            if (oldest == entries_.end()) break;
+            idleBytes -= oldest->target->getByteSize();
+            entries_.erase(oldest);
+            stats_.evictions++;
+        }
+    }
+
+    void OpenGLRenderTargetPool::clear() {
+        entries_.clear();
+    }
+
+    RenderTargetPoolStats OpenGLRenderTargetPool::getStats() const {
+        RenderTargetPoolStats stats = stats_;
+        stats.targets = entries_.size();
+        for (const auto& entry : entries_) {
+            size_t bytes = entry.target->getByteSize();
+            stats.bytes += bytes;
+            if (entry.inUse) {
+                stats.inUse++;
+            } else {
+                stats.idleBytes += bytes;
+            }
+        }
+        return stats;
+    }
+
+    void OpenGLRenderTargetPool::printStats() const {
+        RenderTargetPoolStats stats = getStats();
+        std::cout << "OpenGLRenderTargetPool stats: " << stats.targets << " targets (" << stats.inUse << " in use), "
+                  << stats.bytes / 1024 << " KB (" << stats.idleBytes / 1024 << " KB idle), " << stats.allocations
+                  << " allocations, " << stats.reuses << " reuses, " << stats.reallocations << " reallocations, "
+                  << stats.evictions << " evictions" << std::endl;
+    }
+}
@@ -1,20 +1,30 @@
 #include "iengine/renderers/opengl/OpenGLRenderer.h"
 #include "iengine/scenes/Scene.h"
-#include "iengine/core/Model.h"
 #include "iengine/core/Mesh.h"
 #include "iengine/materials/Material.h"
+#include "iengine/textures/Texture.h"
 #include "iengine/views/cameras/Camera.h"
 #include "iengine/lights/Light.h"
+#include "iengine/renderers/RenderSnapshot.h"
 #include "iengine/renderers/opengl/OpenGLContext.h"
 #include "iengine/renderers/opengl/OpenGLShaderProgram.h"
 #include "iengine/renderers/opengl/OpenGLRenderPipeline.h"
 #include "iengine/shaders/ShaderLib.h"
 #include "iengine/core/Enums.h"
 
+#include "iengine/core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
 
 namespace iengine {
-    OpenGLRenderer::OpenGLRenderer() {}
+    OpenGLRenderer::OpenGLRenderer() {
+        RenderSnapshotOptions options;
+        options.copySceneState = false;
+        sceneSnapshotBuilder_.setOptions(options);
+    }
     
     OpenGLRenderer::~OpenGLRenderer() {
         cleanup();
@@ -39,95 +49,351 @@ namespace iengine {
         // 清理缓存的着色器和渲染管线
         shaders_.clear();
         renderPipelineCache_.clear();
+        dedicatedPipelineBuffers_.clear();
     }
     
     void OpenGLRenderer::render(std::shared_ptr<Scene> scene) {
-        currentCamera_ = scene->getActiveCamera();
-        if (!currentCamera_) {
+        auto camera = scene->getActiveCamera();
+        if (!camera) {
             std::cerr << "No active camera set for rendering" << std::endl;
             return;
         }
         
-        // 获取场景中的所有组件（可渲染的对象）
-        const auto& components = scene->getComponents();
-        if (components.empty()) {
+        // 场景中的实体（Model 和直接创建的实体）
+        if (scene->getRegistry().size() == 0) {
             std::cout << "No components to render in the scene" << std::endl;
             return;
         }
         
-        // 获取场景中的所有光照
-        const auto& lights = scene->getLights();
+        // 剔除后只绘制可见的实体
+        sceneSnapshotBuilder_.setViewportHeight(static_cast<float>(m_openGLContext->getHeight()));
+        sceneSnapshotBuilder_.build(*scene, ++sceneSnapshotFrame_, sceneSnapshot_);
+        renderFrame(sceneSnapshot_);
+    }
+    
+    void OpenGLRenderer::renderSnapshot(const RenderSnapshot& snapshot) {
+        if (!snapshot.camera) {
+            std::cerr << "No camera in render snapshot" << std::endl;
+            return;
+        }
+        
+        if (!snapshot.resources) {
+            std::cerr << "No resource table in render snapshot" << std::endl;
+            return;
+        }
+        
+        // 组件全部被剔除时仍然清屏并完成一帧
+        renderFrame(snapshot);
+    }
+    
+    void OpenGLRenderer::renderFrame(const RenderSnapshot& snapshot) {
+        const auto& camera = snapshot.camera;
+        currentCamera_ = camera;
+        
+        // 先应用快照携带的网格和材质表更新
+        snapshot.resources->apply(snapshot);
+        frameResources_ = snapshot.resources.get();
+        
+        // 推进流式环形缓冲区到本帧区段
+        m_openGLContext->beginFrame();
+        releaseStalePipelines();
         
         // 清除画布
         clear();
         
-        // 遍历所有组件，渲染每个组件
-        for (const auto& component : components) {
-            if (!component || !component->mesh) {
+        // 在帧预算内上传尚未驻留的网格和纹理
+        scheduleUploads(snapshot);
+        
+        // 1. 确保mesh顶点、索引等Buffer资源已经传到GPU（需要上下文，在渲染线程上完成）
+        //    首次上传由调度器按预算完成，尚未驻留的网格本帧跳过；
+        //    流式网格每帧写入一次环形缓冲区，动态网格在标记修改后原地更新
+        drawables_.clear();
+        for (const auto& item : snapshot.items) {
+            const auto& mesh = frameResources_->getMesh(item.mesh);
+            if (!mesh || !frameResources_->getMaterial(item.material)) {
                 std::cout << "Invalid component instance found!" << std::endl;
                 continue;
             }
             
-            // 1. 确保mesh顶点、索引等Buffer资源已经传到GPU
-            if (!component->mesh->uploaded) {
-                component->mesh->upload(m_openGLContext);
+            bool isStream = mesh->usage == BufferUsage::Stream;
+            if (!mesh->uploaded && !isStream) {
+                continue;
+            }
+            bool streamStale = isStream && !m_openGLContext->isStreamRangeCurrent(mesh->getStreamRange());
+            if (!mesh->uploaded || mesh->isDirty() || streamStale) {
+                mesh->upload(m_openGLContext, true);
+            }
+            drawables_.push_back(&item);
+        }
+        
+        // 2. 录制绘制命令（可在工作线程上并行）
+        recordCommands(camera, snapshot.lights);
+        
+        // 3. 在一个循环中执行
+        executeCommandList(frameCommands_);
+        
+        // 4. 所有绘制完成后再解绑，避免每个网格都重新绑定 VAO
+        m_openGLContext->unbindVAO();
+        
+        // 5. 帧末按预算整理缓冲区池碎片
+        if (auto arena = m_openGLContext->getBufferArena()) {
+            arena->defragment();
+        }
+        
+        m_openGLContext->endFrame();
+        frameResources_ = nullptr;
+    }
+    
+    void OpenGLRenderer::recordCommands(const std::shared_ptr<Camera>& camera,
+                                        const std::vector<std::shared_ptr<Light>>& lights) {
+        auto start = std::chrono::steady_clock::now();
+        frameCommands_.clear();
+        recordingStats_ = CommandRecordingStats();
+        
+        // 预先计算相机矩阵，录制线程只读取
+        camera->getViewMatrix();
+        camera->getProjectionMatrix();
+        
+        const int count = static_cast<int>(drawables_.size());
+        const int minChunk = std::max(recordingOptions_.minModelsPerChunk, 1);
+        if (jobSystem_ && recordingOptions_.parallel && count > minChunk) {
+            recordedChunks_.clear();
+            jobSystem_->parallelFor(count, [&](int begin, int end) {
+                CommandList* list = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(recordMutex_);
+                    if (recordedChunks_.size() >= listPool_.size()) {
+                        listPool_.push_back(std::make_unique<CommandList>());
+                    }
+                    list = listPool_[recordedChunks_.size()].get();
+                    recordedChunks_.emplace_back(begin, list);
+                }
+                recordRange(camera, lights, static_cast<size_t>(begin), static_cast<size_t>(end), *list);
+            }, minChunk, "RecordCommands");
+            
+            // 按模型顺序合并，结果与线程数无关
+            std::sort(recordedChunks_.begin(), recordedChunks_.end(),
+                [](const std::pair<int, CommandList*>& a, const std::pair<int, CommandList*>& b) {
+                    return a.first < b.first;
+                });
+            for (auto& chunk : recordedChunks_) {
+                frameCommands_.append(*chunk.second);
             }
+            recordingStats_.chunks = recordedChunks_.size();
+        } else {
+            recordRange(camera, lights, 0, drawables_.size(), frameCommands_);
+            recordingStats_.chunks = 1;
+        }
+        
+        if (recordingOptions_.sortByState) {
+            frameCommands_.sort();
+        }
+        
+        recordingStats_.draws = frameCommands_.getDraws().size();
+        recordingStats_.commands = frameCommands_.getCommands().size();
+        recordingStats_.recordMilliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    void OpenGLRenderer::recordRange(const std::shared_ptr<Camera>& camera,
+                                     const std::vector<std::shared_ptr<Light>>& lights,
+                                     size_t begin, size_t end, CommandList& commands) {
+        std::hash<const void*> hashPointer;
+        
+        for (size_t i = begin; i < end; ++i) {
+            const RenderDrawItem& item = *drawables_[i];
+            const auto& mesh = frameResources_->getMesh(item.mesh);
+            const auto& material = frameResources_->getMaterial(item.material);
             
-            // 2. 根据材质特性，创建Shader
-            std::map<std::string, bool> defines;
-            // 合并mesh和material的宏定义
-            auto meshDefines = component->mesh->getShaderMacroDefines();
-            auto materialDefines = component->material->getShaderMacroDefines();
-            defines.insert(meshDefines.begin(), meshDefines.end());
+            // 根据网格和材质特性确定着色器变体
+            std::map<std::string, bool> defines = mesh->getShaderMacroDefines();
+            auto materialDefines = material->getShaderMacroDefines();
             defines.insert(materialDefines.begin(), materialDefines.end());
+            std::string shaderKey = makeShaderKey(material->shaderName, defines);
+            
+            RenderPipelineBinding binding;
+            binding.resolved = findPipeline(mesh, shaderKey);
+            if (!binding.resolved) {
+                binding.shaderName = material->shaderName;
+                binding.defines = std::move(defines);
+                binding.mesh = mesh;
+            }
+            
+            // 排序键：高 32 位区分着色器变体，低 32 位区分材质；
+            // 只由变体键得出，管线是否已创建不影响绘制顺序
+            uint64_t pipelineBits = std::hash<std::string>()(shaderKey);
+            uint64_t sortKey = ((pipelineBits & 0xffffffffull) << 32) | (hashPointer(material.get()) & 0xffffffffull);
+            
+            commands.beginDraw(sortKey);
+            commands.bindPipeline(commands.addPipeline(std::move(binding)));
+            
+            // 让材质/Shader自己决定需要哪些uniform
+            commands.setUniforms(material->getUniforms(m_openGLContext, camera, item.transform, lights));
             
-            // 调试输出：显示所有宏定义
-            std::cout << "OpenGLRenderer: Shader defines for " << component->material->shaderName << ":" << std::endl;
-            for (const auto& define : defines) {
-                std::cout << "  " << define.first << " = " << (define.second ? "true" : "false") << std::endl;
+            // 纹理作为特殊的 uniform 传给着色器（与Web版本保持一致）
+            // 使用纹理数组的材质改为绑定数组，并传入贴图在数组中的层号和 uv 变换
+            auto textures = material->getTextures();
+            std::map<std::string, UniformValue> textureUniforms;
+            for (const auto& texture : textures.textures) {
+                if (!material->useTextureArrays) {
+                    textureUniforms[texture.first] = UniformValue(texture.second);
+                    continue;
+                }
+                TextureArraySlot slot;
+                if (texture.second && textureArrays_.getSlot(texture.second.get(), slot)) {
+                    textureUniforms[texture.first + "Array"] = UniformValue(slot.array);
+                    textureUniforms[texture.first + "Slot"] = UniformValue::fromVec4(
+                        slot.uvScale[0], slot.uvScale[1], slot.uvOffset[0], slot.uvOffset[1]);
+                    textureUniforms[texture.first + "Layer"] = UniformValue::fromVec3(
+                        static_cast<float>(slot.layer), slot.repeatU ? 1.0f : 0.0f, slot.repeatV ? 1.0f : 0.0f);
+                }
             }
+            commands.bindTextures(textureUniforms);
             
-            // 获取或创建着色器
-            auto shader = getOrCreateShader(component->material->shaderName, defines);
+            commands.draw(commands.addMesh(mesh), item.lod);
+            commands.endDraw();
+        }
+    }
+    
+    void OpenGLRenderer::executeCommandList(CommandList& commands) {
+        auto start = std::chrono::steady_clock::now();
+        
+        // 录制时缓存未命中的管线在这里创建（需要上下文）
+        for (auto& binding : commands.getPipelines()) {
+            if (binding.resolved || !binding.mesh) continue;
+            auto shader = getOrCreateShader(binding.shaderName, binding.defines);
             if (!shader) {
                 std::cerr << "Failed to get or create shader." << std::endl;
                 continue;
             }
-            
-            // 3. 获取/创建 RenderPipeline
-            auto pipeline = getOrCreatePipeline(component->mesh, shader);
-            if (!pipeline) {
+            binding.resolved = getOrCreatePipeline(binding.mesh, shader);
+            if (!binding.resolved) {
                 std::cerr << "Failed to get or create render pipeline." << std::endl;
                 continue;
             }
+            ++recordingStats_.resolvedPipelines;
+        }
+        
+        const auto& pipelines = commands.getPipelines();
+        const auto& meshes = commands.getMeshes();
+        const auto& uniforms = commands.getUniforms();
+        const auto& list = commands.getCommands();
+        
+        OpenGLRenderPipeline* boundPipeline = nullptr;
+        std::shared_ptr<OpenGLShaderProgram> shader;
+        
+        for (const auto& draw : commands.getDraws()) {
+            const uint32_t last = draw.firstCommand + draw.commandCount;
+            for (uint32_t i = draw.firstCommand; i < last; ++i) {
+                const RenderCommand& command = list[i];
+                bool skipDraw = false;
+                switch (command.type) {
+                case RenderCommandType::BindPipeline: {
+                    // 切换着色器程序、绑定VAO；同一缓冲区池页内的网格共用 VAO，连续绘制时绑定会被跳过
+                    auto* pipeline = static_cast<OpenGLRenderPipeline*>(pipelines[command.index].resolved.get());
+                    if (!pipeline) {
+                        skipDraw = true;
+                        break;
+                    }
+                    if (pipeline != boundPipeline) {
+                        pipeline->bind();
+                        boundPipeline = pipeline;
+                        shader = pipeline->getShaderProgram();
+                        ++recordingStats_.pipelineBinds;
+                    }
+                    break;
+                }
+                case RenderCommandType::SetUniforms:
+                    if (shader && shader->uniforms) {
+                        for (uint32_t u = command.index; u < command.index + command.count; ++u) {
+                            shader->uniforms->set(uniforms[u].first, uniforms[u].second);
+                        }
+                    }
+                    break;
+                case RenderCommandType::BindTextures:
+                    // 采样器单元在链接时固定，这里只在单元上的纹理变化时重新绑定
+                    if (shader && shader->uniforms) {
+                        shader->uniforms->beginTextureBindings();
+                        for (uint32_t u = command.index; u < command.index + command.count; ++u) {
+                            shader->uniforms->set(uniforms[u].first, uniforms[u].second);
+                        }
+                        shader->uniforms->endTextureBindings();
+                    }
+                    break;
+                case RenderCommandType::Draw:
+                    m_openGLContext->draw(meshes[command.index], command.lod);
+                    break;
+                case RenderCommandType::DrawInstanced:
+                    m_openGLContext->drawInstanced(meshes[command.index], command.lod, command.count);
+                    break;
+                }
+                if (skipDraw) {
+                    break;
+                }
+            }
+        }
+        
+        recordingStats_.executeMilliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    std::shared_ptr<OpenGLRenderPipeline> OpenGLRenderer::findPipeline(const std::shared_ptr<Mesh>& mesh,
+                                                                       const std::string& shaderKey) {
+        auto shaderIt = shaders_.find(shaderKey);
+        if (shaderIt == shaders_.end()) {
+            return nullptr;
+        }
+        auto pipelineIt = renderPipelineCache_.find(makePipelineKey(mesh, shaderIt->second));
+        return pipelineIt != renderPipelineCache_.end() ? pipelineIt->second : nullptr;
+    }
+    
+    void OpenGLRenderer::scheduleUploads(const RenderSnapshot& snapshot) {
+        const float viewportHeight = static_cast<float>(m_openGLContext->getHeight());
+        
+        for (const auto& item : snapshot.items) {
+            const auto& mesh = frameResources_->getMesh(item.mesh);
+            const auto& material = frameResources_->getMaterial(item.material);
+            if (!mesh) continue;
             
-            // 4. 切换pipeline（切换着色器程序、绑定VAO、设置渲染状态）
-            pipeline->bind();
-            
-            // 5. 设置uniform，将相机、材质、光照等参数数据绑定到Shader的uniform
-            // 让材质/Shader自己决定需要哪些uniform
-            auto uniforms = component->material->getUniforms(m_openGLContext, currentCamera_, component, lights);  // 传递 component（Model）而不是 mesh
-            auto textures = component->material->getTextures();
-            
-            // 设置uniforms
-            shader->setUniforms(uniforms);
-            
-            // 设置纹理（参照Web版本：texture在OpenGL中也是特殊的uniform）
-            // 直接将纹理作为uniform传递给shader，与Web版本保持一致
-            std::map<std::string, UniformValue> textureUniforms;
-            for (const auto& texture : textures.textures) {
-                textureUniforms[texture.first] = UniformValue(texture.second);
+            bool meshPending = !mesh->uploaded && mesh->usage != BufferUsage::Stream;
+            auto textures = material ? material->getTextures() : TextureInfo{};
+            // 纹理数组中的贴图由 textureArrays_ 写入，不再单独上传为 2D 纹理
+            if (material && material->useTextureArrays) {
+                for (const auto& pair : textures.textures) {
+                    textureArrays_.acquire(pair.second);
+                }
+                textures.textures.clear();
             }
-            if (!textureUniforms.empty()) {
-                shader->setUniforms(textureUniforms);
+            for (const auto& pair : textures.textures) {
+                textureResidency_.track(pair.second);
             }
+            bool texturePending = std::any_of(textures.textures.begin(), textures.textures.end(),
+                [](const auto& pair) { return pair.second && pair.second->needsUpdate(); });
+            if (!meshPending && !texturePending) continue;
             
-            // 6. 绘制(DrawCall)
-            m_openGLContext->draw(component->mesh);
+            // 优先级：可见对象总是高于不可见对象，同类之间按屏幕上的像素大小排序
+            float priority = 1.0f;
+            if (item.radius >= 0.0f) {
+                float pixels = currentCamera_->getProjectedSize(item.center, item.radius * 2.0f, viewportHeight);
+                pixels = std::max(0.0f, std::min(pixels, viewportHeight * 4.0f));
+                bool visible = currentCamera_->intersectsSphere(item.center, item.radius);
+                priority = visible ? 1.0f + pixels : pixels / (1.0f + pixels);
+            }
             
-            // 7. 解绑渲染管线（可选）
-            pipeline->unbind();
+            if (meshPending) {
+                uploadScheduler_.request(mesh, priority);
+            }
+            for (const auto& pair : textures.textures) {
+                if (pair.second && pair.second->needsUpdate()) {
+                    uploadScheduler_.request(pair.second, priority);
+                }
+            }
         }
+        
+        // 先执行驱逐和 Mip 调整，本帧的上传按调整后的尺寸进行
+        textureResidency_.update(m_openGLContext, m_openGLContext->getFrameIndex());
+        uploadScheduler_.process(m_openGLContext);
+        textureArrays_.update(m_openGLContext);
     }
     
     void OpenGLRenderer::resize(int width, int height) {
@@ -153,16 +419,21 @@ namespace iengine {
     bool OpenGLRenderer::isInitialized() const noexcept {
 		return m_isInitialized;
     }
+
+    bool OpenGLRenderer::hasPendingWork() const {
+        if (uploadScheduler_.getPendingCount() > 0) {
+            return true;
+        }
+        auto* readbacks = m_openGLContext ? m_openGLContext->getReadbackQueue() : nullptr;
+        return readbacks && readbacks->hasPendingWork();
+    }
     
     std::shared_ptr<OpenGLShaderProgram> OpenGLRenderer::getOrCreateShader(
         const std::string& shaderName,
         const std::map<std::string, bool>& defines) {
         
         // 生成着色器变体的键
-        std::string key = shaderName;
-        for (const auto& define : defines) {
-            key += "_" + define.first + "_" + (define.second ? "1" : "0");
-        }
+        std::string key = makeShaderKey(shaderName, defines);
         
         // 查找缓存中的着色器
         auto it = shaders_.find(key);
@@ -191,6 +462,15 @@ namespace iengine {
         return nullptr;
     }
     
+    std::string OpenGLRenderer::makeShaderKey(const std::string& shaderName,
+                                              const std::map<std::string, bool>& defines) {
+        std::string key = shaderName;
+        for (const auto& define : defines) {
+            key += "_" + define.first + "_" + (define.second ? "1" : "0");
+        }
+        return key;
+    }
+    
     std::shared_ptr<OpenGLRenderPipeline> OpenGLRenderer::getOrCreatePipeline(
         std::shared_ptr<Mesh> mesh, 
         std::shared_ptr<OpenGLShaderProgram> shader) {
@@ -207,18 +487,56 @@ namespace iengine {
         // 创建新的渲染管线
         auto pipeline = std::make_shared<OpenGLRenderPipeline>();
         
-        // 设置 VAO 和顶点属性
-        pipeline->setupVAO(mesh, shader, m_openGLContext);
+        // 设置 VAO 和顶点属性，池化网格绑定所在页的共享缓冲区，流式网格绑定环形缓冲区
+        auto arena = m_openGLContext->getBufferArena();
+        auto allocation = arena ? arena->getAllocation(mesh->getBufferAllocation()) : nullptr;
+        if (m_openGLContext->isStreamRangeCurrent(mesh->getStreamRange())) {
+            unsigned int ring = m_openGLContext->getStreamBuffer()->getBuffer();
+            pipeline->setupVAO(mesh->getVertexLayout(), ring, ring, shader, m_openGLContext);
+        } else if (allocation) {
+            pipeline->setupVAO(mesh->getVertexLayout(), allocation->page->vbo, allocation->page->ibo, shader, m_openGLContext);
+        } else {
+            pipeline->setupVAO(mesh, shader, m_openGLContext);
+            dedicatedPipelineBuffers_[key] = mesh->getVBO();
+        }
         
         renderPipelineCache_[key] = pipeline;
         return pipeline;
     }
     
+    void OpenGLRenderer::releaseStalePipelines() {
+        for (auto it = dedicatedPipelineBuffers_.begin(); it != dedicatedPipelineBuffers_.end();) {
+            if (m_openGLContext->getBufferId(it->second) == 0) {
+                renderPipelineCache_.erase(it->first);
+                it = dedicatedPipelineBuffers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
     std::string OpenGLRenderer::makePipelineKey(
         std::shared_ptr<Mesh> mesh, 
         std::shared_ptr<OpenGLShaderProgram> shader) {
-        // 简单的哈希键生成，实际应该基于mesh和shader的特征
-        return std::to_string(reinterpret_cast<uintptr_t>(mesh.get())) + "_" + 
+        // 流式网格按顶点布局生成键，同布局的流式网格共享环形缓冲区上的同一个 VAO
+        if (m_openGLContext->isStreamRangeCurrent(mesh->getStreamRange())) {
+            return "stream_" + std::to_string(m_openGLContext->getStreamBuffer()->getBuffer()) + "_" +
+                   OpenGLBufferArena::makeLayoutKey(mesh->getVertexLayout()) + "_" +
+                   std::to_string(reinterpret_cast<uintptr_t>(shader.get()));
+        }
+        
+        // 池化网格按所在页生成键，同页网格共享同一个 VAO；页在缓冲区池清理前不会释放，键不会失效
+        auto arena = m_openGLContext->getBufferArena();
+        if (auto allocation = arena ? arena->getAllocation(mesh->getBufferAllocation()) : nullptr) {
+            return "pool_" + std::to_string(allocation->page->vbo) + "_" +
+                   std::to_string(reinterpret_cast<uintptr_t>(shader.get()));
+        }
+        
+        // 独立缓冲区的网格按缓冲区句柄生成键，句柄带代数，网格重新上传或新网格复用同一地址时不会取到旧的 VAO
+        BufferHandle vbo = mesh->getVBO();
+        BufferHandle ibo = mesh->getIBO();
+        return "mesh_" + std::to_string(vbo.index) + "_" + std::to_string(vbo.generation) + "_" +
+               std::to_string(ibo.index) + "_" + std::to_string(ibo.generation) + "_" +
                std::to_string(reinterpret_cast<uintptr_t>(shader.get()));
     }
 }
\ No newline at end of file
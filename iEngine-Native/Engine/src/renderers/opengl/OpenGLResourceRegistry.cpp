@@ -0,0 +1,139 @@
+#include "iengine/renderers/opengl/OpenGLResourceRegistry.h"
+
+#include <glad/glad.h>
+
+#include <iostream>
+
+namespace iengine {
+    OpenGLResourceRegistry::OpenGLResourceRegistry(size_t framesInFlight)
+        : framesInFlight_(framesInFlight) {}
+
+    OpenGLResourceRegistry::~OpenGLResourceRegistry() {
+        destroyAll();
+    }
+
+    BufferHandle OpenGLResourceRegistry::addBuffer(unsigned int id, BufferTarget target, BufferUsage usage, size_t size) {
+        auto key = buffers_.insert(BufferRecord{id, target, usage, size});
+        BufferHandle handle;
+        handle.index = key.index;
+        handle.generation = key.generation;
+        handle.target = target;
+        handle.usage = usage;
+        return handle;
+    }
+
+    OpenGLResourceRegistry::BufferRecord* OpenGLResourceRegistry::getBuffer(BufferHandle handle) {
+        return buffers_.get(handle.index, handle.generation);
+    }
+
+    void OpenGLResourceRegistry::releaseBuffer(BufferHandle handle) {
+        BufferRecord* record = getBuffer(handle);
+        if (!record) {
+            std::cerr << "OpenGLResourceRegistry: Releasing invalid buffer handle" << std::endl;
+            return;
+        }
+        pending_.push_back({ResourceType::Buffer, record->id, record->size, frame_});
+        buffers_.erase(handle.index, handle.generation);
+    }
+
+    TextureHandle OpenGLResourceRegistry::addTexture(unsigned int id, int width, int height, size_t bytes,
+                                                     TextureFormat format) {
+        auto key = textures_.insert(TextureRecord{id, width, height, bytes, format});
+        return TextureHandle{key.index, key.generation};
+    }
+
+    OpenGLResourceRegistry::TextureRecord* OpenGLResourceRegistry::getTexture(TextureHandle handle) {
+        return textures_.get(handle.index, handle.generation);
+    }
+
+    void OpenGLResourceRegistry::releaseTexture(TextureHandle handle) {
+        TextureRecord* record = getTexture(handle);
+        if (!record) {
+            std::cerr << "OpenGLResourceRegistry: Releasing invalid texture handle" << std::endl;
+            return;
+        }
+        pending_.push_back({ResourceType::Texture, record->id, record->bytes, frame_});
+        textures_.erase(handle.index, handle.generation);
+    }
+
+    ProgramHandle OpenGLResourceRegistry::addProgram(unsigned int id) {
+        auto key = programs_.insert(ProgramRecord{id});
+        return ProgramHandle{key.index, key.generation};
+    }
+
+    OpenGLResourceRegistry::ProgramRecord* OpenGLResourceRegistry::getProgram(ProgramHandle handle) {
+        return programs_.get(handle.index, handle.generation);
+    }
+
+    void OpenGLResourceRegistry::releaseProgram(ProgramHandle handle) {
+        ProgramRecord* record = getProgram(handle);
+        if (!record) {
+            std::cerr << "OpenGLResourceRegistry: Releasing invalid program handle" << std::endl;
+            return;
+        }
+        pending_.push_back({ResourceType::Program, record->id, 0, frame_});
+        programs_.erase(handle.index, handle.generation);
+    }
+
+    void OpenGLResourceRegistry::endFrame() {
+        frame_++;
+        // 队列按释放帧号有序，只需从队首检查
+        while (!pending_.empty() && frame_ - pending_.front().frame >= framesInFlight_) {
+            deleteObject(pending_.front().type, pending_.front().id);
+            pending_.pop_front();
+        }
+    }
+
+    void OpenGLResourceRegistry::flush() {
+        for (const auto& pending : pending_) {
+            deleteObject(pending.type, pending.id);
+        }
+        pending_.clear();
+    }
+
+    void OpenGLResourceRegistry::destroyAll() {
+        flush();
+        buffers_.forEach([this](const BufferRecord& record) { deleteObject(ResourceType::Buffer, record.id); });
+        textures_.forEach([this](const TextureRecord& record) { deleteObject(ResourceType::Texture, record.id); });
+        programs_.forEach([this](const ProgramRecord& record) { deleteObject(ResourceType::Program, record.id); });
+        buffers_.clear();
+        textures_.clear();
+        programs_.clear();
+    }
+
+    GpuResourceStats OpenGLResourceRegistry::getStats() const {
+        GpuResourceStats stats;
+        stats.frame = frame_;
+
+        stats.buffers.count = buffers_.size();
+        buffers_.forEach([&](const BufferRecord& record) { stats.buffers.bytes += record.size; });
+        stats.textures.count = textures_.size();
+        textures_.forEach([&](const TextureRecord& record) { stats.textures.bytes += record.bytes; });
+        stats.programs.count = programs_.size();
+
+        for (const auto& pending : pending_) {
+            GpuResourceTypeStats& typeStats =
+                pending.type == ResourceType::Buffer ? stats.buffers :
+                pending.type == ResourceType::Texture ? stats.textures : stats.programs;
+            typeStats.pendingCount++;
+            typeStats.pendingBytes += pending.bytes;
+        }
+        return stats;
+    }
+
+    void OpenGLResourceRegistry::deleteObject(ResourceType type, unsigned int id) {
+        if (id == 0) return;
+
+        switch (type) {
+            case ResourceType::Buffer:
+                glDeleteBuffers(1, &id);
+                break;
+            case ResourceType::Texture:
+                glDeleteTextures(1, &id);
+                break;
+            case ResourceType::Program:
+                glDeleteProgram(id);
+                break;
+        }
+    }
+}
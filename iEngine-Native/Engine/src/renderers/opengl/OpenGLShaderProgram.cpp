@@ -11,42 +11,48 @@ namespace iengine {
         : context(context), vertCode(vertCode), fragCode(fragCode) {
         program = createProgram();
         if (program) {
-            uniforms = std::make_shared<OpenGLUniforms>(context, program);
+            uniforms = std::make_shared<OpenGLUniforms>(context, getProgramId());
         }
     }
     
     OpenGLShaderProgram::~OpenGLShaderProgram() {
-        // 清理资源
+        // 程序对象进入延迟删除队列
+        if (context && program) {
+            context->deleteProgram(program);
+        }
     }
     
-    void* OpenGLShaderProgram::createProgram() {
+    ProgramHandle OpenGLShaderProgram::createProgram() {
         // 使用 OpenGLContext 创建着色器程序
         if (!context) {
             std::cerr << "OpenGLShaderProgram: No context set" << std::endl;
-            return nullptr;
+            return ProgramHandle{};
         }
         
         std::cout << "OpenGLShaderProgram: Creating shader program..." << std::endl;
         std::cout << "Vertex shader code length: " << vertCode.length() << std::endl;
         std::cout << "Fragment shader code length: " << fragCode.length() << std::endl;
         
-        unsigned int programId = context->createProgram(vertCode, fragCode);
-        if (programId == 0) {
+        ProgramHandle handle = context->createProgram(vertCode, fragCode);
+        if (!handle) {
             std::cerr << "OpenGLShaderProgram: Failed to create shader program" << std::endl;
             std::cerr << "Vertex shader:\n" << vertCode << std::endl;
             std::cerr << "Fragment shader:\n" << fragCode << std::endl;
-            return nullptr;
+            return ProgramHandle{};
         }
         
-        std::cout << "OpenGLShaderProgram: Successfully created program ID: " << programId << std::endl;
-        return reinterpret_cast<void*>(static_cast<uintptr_t>(programId));
+        std::cout << "OpenGLShaderProgram: Successfully created program ID: " << context->getProgramId(handle) << std::endl;
+        return handle;
+    }
+    
+    unsigned int OpenGLShaderProgram::getProgramId() const {
+        return context ? context->getProgramId(program) : 0;
     }
     
     void OpenGLShaderProgram::use() {
         // 使用着色器程序
         if (context && program) {
-            unsigned int programId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(program));
-            context->useProgram(programId);
+            context->useProgram(getProgramId());
         }
     }
     
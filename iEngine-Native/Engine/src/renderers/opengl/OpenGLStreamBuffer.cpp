@@ -0,0 +1,162 @@
+#include "iengine/renderers/opengl/OpenGLStreamBuffer.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace iengine {
+    OpenGLStreamBuffer::OpenGLStreamBuffer(const StreamBufferOptions& options)
+        : options_(options) {
+        options_.frameCount = std::max<size_t>(options_.frameCount, 1);
+    }
+
+    OpenGLStreamBuffer::~OpenGLStreamBuffer() {
+        cleanup();
+    }
+
+    bool OpenGLStreamBuffer::initialize() {
+        if (buffer_) return true;
+
+        size_t capacity = options_.frameBytes * options_.frameCount;
+        fences_.assign(options_.frameCount, nullptr);
+
+        glGenBuffers(1, &buffer_);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+
+        persistent_ = GLAD_GL_VERSION_4_4 != 0;
+        if (persistent_) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+            mapped_ = static_cast<unsigned char*>(
+                glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(capacity), flags));
+            if (!mapped_) {
+                // 持久映射失败时重建为普通缓冲区（immutable 存储不能再 glBufferData）
+                std::cerr << "OpenGLStreamBuffer: Persistent mapping failed, falling back to orphaning" << std::endl;
+                glDeleteBuffers(1, &buffer_);
+                glGenBuffers(1, &buffer_);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+                persistent_ = false;
+            }
+        }
+        if (!persistent_) {
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        stats_.persistent = persistent_;
+        stats_.capacity = capacity;
+
+        std::cout << "OpenGLStreamBuffer: Created buffer " << buffer_ << " (" << options_.frameCount
+                  << " x " << options_.frameBytes << " bytes, "
+                  << (persistent_ ? "persistent mapped" : "orphaning") << ")" << std::endl;
+        return true;
+    }
+
+    void OpenGLStreamBuffer::cleanup() {
+        for (auto& fence : fences_) {
+            if (fence) {
+                glDeleteSync(static_cast<GLsync>(fence));
+                fence = nullptr;
+            }
+        }
+        if (buffer_) {
+            if (mapped_) {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+                glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+                mapped_ = nullptr;
+            }
+            glDeleteBuffers(1, &buffer_);
+            buffer_ = 0;
+        }
+    }
+
+    void OpenGLStreamBuffer::beginFrame() {
+        if (!buffer_) return;
+
+        cursor_ = 0;
+        stats_.bytesThisFrame = 0;
+
+        if (persistent_) {
+            waitForSegment(segment_);
+        } else if (segment_ == 0) {
+            // 环绕回起点：孤立旧存储，GPU 仍在读取的旧数据由驱动保留
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+            glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(stats_.capacity), nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            stats_.orphanCount++;
+        }
+    }
+
+    void OpenGLStreamBuffer::endFrame() {
+        if (!buffer_) return;
+
+        if (persistent_) {
+            if (fences_[segment_]) {
+                glDeleteSync(static_cast<GLsync>(fences_[segment_]));
+            }
+            fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        stats_.peakFrameBytes = std::max(stats_.peakFrameBytes, stats_.bytesThisFrame);
+        segment_ = (segment_ + 1) % options_.frameCount;
+        cursor_ = 0;
+        frameIndex_++;
+    }
+
+    size_t OpenGLStreamBuffer::write(const void* data, size_t size, size_t alignment) {
+        if (!buffer_ || !data || size == 0) {
+            return InvalidOffset;
+        }
+        alignment = std::max<size_t>(alignment, 1);
+
+        size_t segmentStart = segment_ * options_.frameBytes;
+        size_t offset = (segmentStart + cursor_ + alignment - 1) / alignment * alignment;
+        if (offset + size > segmentStart + options_.frameBytes) {
+            stats_.overflowCount++;
+            return InvalidOffset;
+        }
+
+        if (persistent_) {
+            std::memcpy(mapped_ + offset, data, size);
+        } else {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+            void* dst = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size),
+                                         GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+            if (!dst) {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+                std::cerr << "OpenGLStreamBuffer::write - Failed to map buffer range" << std::endl;
+                return InvalidOffset;
+            }
+            std::memcpy(dst, data, size);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        cursor_ = offset + size - segmentStart;
+        stats_.bytesThisFrame += size;
+        return offset;
+    }
+
+    void OpenGLStreamBuffer::waitForSegment(size_t segment) {
+        GLsync fence = static_cast<GLsync>(fences_[segment]);
+        if (!fence) return;
+
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            // GPU 还没读完三帧前的数据，只能等待
+            stats_.stallCount++;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);  // 1ms
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        if (result == GL_WAIT_FAILED) {
+            std::cerr << "OpenGLStreamBuffer: glClientWaitSync failed" << std::endl;
+        }
+
+        glDeleteSync(fence);
+        fences_[segment] = nullptr;
+    }
+}
@@ -0,0 +1,85 @@
+#include "iengine/renderers/opengl/OpenGLTextureBindings.h"
+#include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureUtils.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace iengine {
+    OpenGLTextureBindings::OpenGLTextureBindings(int maxUnits) {
+        maxUnits = std::max(maxUnits, 2);
+        units_.resize(static_cast<size_t>(maxUnits - 1));
+        editUnit_ = maxUnits - 1;
+    }
+
+    OpenGLTextureBindings::~OpenGLTextureBindings() {
+        for (const auto& pair : samplers_) {
+            glDeleteSamplers(1, &pair.second);
+        }
+    }
+
+    void OpenGLTextureBindings::setActiveUnit(int unit) {
+        if (unit != activeUnit_) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            activeUnit_ = unit;
+        }
+    }
+
+    void OpenGLTextureBindings::bind(int unit, unsigned int target, unsigned int texture, TextureHandle handle,
+                                     unsigned int sampler) {
+        if (unit < 0 || unit >= getUnitCount()) {
+            std::cerr << "OpenGLTextureBindings: texture unit " << unit << " out of range (" << getUnitCount()
+                      << " units)" << std::endl;
+            return;
+        }
+
+        Unit& state = units_[unit];
+        if (state.texture == handle && state.target == target) {
+            ++stats_.skippedBinds;
+        } else {
+            setActiveUnit(unit);
+            glBindTexture(target, texture);
+            state.texture = handle;
+            state.target = target;
+            ++stats_.textureBinds;
+        }
+
+        if (state.sampler != sampler) {
+            glBindSampler(static_cast<GLuint>(unit), sampler);
+            state.sampler = sampler;
+            ++stats_.samplerBinds;
+        }
+    }
+
+    void OpenGLTextureBindings::bindForEdit(unsigned int target, unsigned int texture) {
+        setActiveUnit(editUnit_);
+        glBindTexture(target, texture);
+    }
+
+    unsigned int OpenGLTextureBindings::getSampler(const TextureSamplerDesc& desc) {
+        uint32_t key = static_cast<uint32_t>(desc.wrapS) | (static_cast<uint32_t>(desc.wrapT) << 4) |
+                       (static_cast<uint32_t>(desc.minFilter) << 8) | (static_cast<uint32_t>(desc.magFilter) << 12);
+        auto it = samplers_.find(key);
+        if (it != samplers_.end()) {
+            return it->second;
+        }
+
+        GLuint sampler = 0;
+        glGenSamplers(1, &sampler);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, getOpenGLWrapMode(desc.wrapS));
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, getOpenGLWrapMode(desc.wrapT));
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, getOpenGLMinFilter(desc.minFilter));
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, getOpenGLMagFilter(desc.magFilter));
+        samplers_.emplace(key, sampler);
+        stats_.samplerObjects = samplers_.size();
+        return sampler;
+    }
+
+    void OpenGLTextureBindings::beginFrame() {
+        stats_.textureBinds = 0;
+        stats_.skippedBinds = 0;
+        stats_.samplerBinds = 0;
+    }
+}
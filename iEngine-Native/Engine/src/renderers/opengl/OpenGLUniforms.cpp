@@ -3,6 +3,8 @@
 #include "iengine/math/Matrix4.h"
 #include "iengine/textures/Texture.h"
 
+#include <glad/glad.h>
+
 #include <iostream>
 
 namespace iengine {
@@ -36,7 +38,7 @@ namespace iengine {
     }
     
     // OpenGLUniforms 实现
-    OpenGLUniforms::OpenGLUniforms(std::shared_ptr<OpenGLContext> context, void* program)
+    OpenGLUniforms::OpenGLUniforms(std::shared_ptr<OpenGLContext> context, unsigned int program)
         : context_(context), program_(program)
     {
         // 重要：初始化uniform设置器，这一步不能省略！
@@ -62,7 +64,7 @@ namespace iengine {
     
     void OpenGLUniforms::initUniformSetters() {
         // 严格参考Web版本的动态uniform设置机制
-        unsigned int programId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(program_));
+        unsigned int programId = program_;
         int uniformCount = context_->getUniformCount(programId);
         
         std::cout << "OpenGLUniforms: Found " << uniformCount << " uniforms in program " << programId << std::endl;
@@ -82,9 +84,27 @@ namespace iengine {
             int location = context_->getUniformLocation(programId, uniformName);
             if (location < 0) continue;
             
+            // 采样器：分配固定纹理单元，链接时设置一次，之后绘制只绑定纹理
+            if (isSamplerType(info.type)) {
+                int unit = static_cast<int>(samplerSlots_.size());
+                if (unit >= context_->getTextureUnitCount()) {
+                    std::cerr << "OpenGLUniforms: Too many samplers in program " << programId
+                              << ", '" << uniformName << "' has no texture unit" << std::endl;
+                    continue;
+                }
+                context_->setProgramUniform1i(programId, location, unit);
+                samplerSlots_.push_back(SamplerSlot{uniformName, info.type, unit, false});
+                size_t slotIndex = samplerSlots_.size() - 1;
+                uniformSetters_[uniformName] = [this, slotIndex](const UniformValue& value) {
+                    bindSamplerSlot(samplerSlots_[slotIndex], value);
+                };
+                std::cout << "  - Registered sampler: " << uniformName << " (unit " << unit << ")" << std::endl;
+                continue;
+            }
+            
             // 为每个uniform创建setter，严格对应Web版本的 setter = (v: any) => this.context.setUniform(info.type, loc, v)
             uniformSetters_[uniformName] = [this, info, location](const UniformValue& value) {
-                setUniformByType(info.type, location, value);  // 内部根据uniform类型是否是 texture，而自行递增纹理单元
+                setUniformByType(info.type, location, value);
             };
             
             std::cout << "  - Registered uniform: " << uniformName 
@@ -128,40 +148,80 @@ namespace iengine {
                 }
                 break;
             }
-            case UniformValue::Type::TEXTURE: {
-                // 处理纹理uniform（参照Web版本）
-                auto texture = value.asTexture();
-                if (texture) {
-                    // 1. 上传纹理到GPU（如果还没有上传）
-                    if (texture->needsUpdate()) {
-                        texture->upload(context_);
-                    }
-                    
-                    //// 2. 获取纹理单元（由Texture对象维护）
-                    //int textureUnit = texture->getUnit();
-                    texture->setUnit(textureUnit_); // 记录纹理单元
-                    
-                    // 3. 激活纹理单元并绑定纹理
-                    //context_->activeTexture(textureUnit);
-					context_->activeTexture(textureUnit_);
-                    context_->bindTexture(texture->getGpuTexture());
-                    
-                    // 4. 设置uniform采样器的值为纹理单元索引
-                    //context_->setUniform1i(location, textureUnit);
-                    context_->setUniform1i(location, textureUnit_);
-                    
-                    std::cout << "OpenGLUniforms: Bound texture '" << texture->getName() 
-                              << "' to unit " << textureUnit_ << " for uniform location " << location << std::endl;
-
-                    // 纹理单元增加1
-                    textureUnit_++;
-                }
+            case UniformValue::Type::TEXTURE:
+            case UniformValue::Type::TEXTURE_HANDLE:
+                std::cerr << "OpenGLUniforms: Texture value set on non-sampler uniform at location " << location << std::endl;
                 break;
-            }
             default:
                 std::cerr << "OpenGLUniforms: Unsupported uniform value type: " 
                           << static_cast<int>(value.getType()) << std::endl;
                 break;
         }
     }
-}
\ No newline at end of file
+
+    void OpenGLUniforms::bindSamplerSlot(SamplerSlot& slot, const UniformValue& value) {
+        if (value.getType() == UniformValue::Type::TEXTURE) {
+            auto texture = value.asTexture();
+            if (!texture) return;
+            // 纹理上传由渲染器的上传调度器按帧预算完成，尚未驻留时绑定占位纹理
+            TextureHandle gpuTexture = texture->isResident() ? texture->getGpuTexture()
+                                                             : context_->getPlaceholderTexture();
+            // 记录最近使用的帧，供驻留管理按 LRU 驱逐（未驻留时也记录，以便按需重新加载）
+            texture->markUsed(context_->getFrameIndex());
+            texture->setUnit(slot.unit);
+            
+            // 采样参数来自按状态去重的采样器对象，单元已绑定同一纹理时不再绑定
+            TextureSamplerDesc sampler = texture->getSamplerDesc();
+            context_->bindTextureUnit(slot.unit, gpuTexture, &sampler);
+            slot.bound = true;
+        } else if (value.getType() == UniformValue::Type::TEXTURE_HANDLE) {
+            TextureHandle texture = value.asTextureHandle();
+            if (!texture) return;
+            // 直接绑定的纹理（如纹理数组）使用纹理自身的采样参数
+            context_->bindTextureUnit(slot.unit, texture);
+            slot.bound = true;
+        } else {
+            std::cerr << "OpenGLUniforms: Sampler '" << slot.name << "' expects a texture value" << std::endl;
+        }
+    }
+    
+    void OpenGLUniforms::beginTextureBindings() {
+        for (auto& slot : samplerSlots_) {
+            slot.bound = false;
+        }
+    }
+    
+    void OpenGLUniforms::endTextureBindings() {
+        for (auto& slot : samplerSlots_) {
+            if (!slot.bound && slot.type == GL_SAMPLER_2D) {
+                context_->bindTextureUnit(slot.unit, context_->getPlaceholderTexture());
+            }
+        }
+    }
+    
+    bool OpenGLUniforms::isSamplerType(unsigned int type) {
+        switch (type) {
+            case GL_SAMPLER_1D:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_CUBE_SHADOW:
+            case GL_SAMPLER_2D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_MULTISAMPLE:
+            case GL_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_2D:
+            case GL_INT_SAMPLER_3D:
+            case GL_INT_SAMPLER_CUBE:
+            case GL_INT_SAMPLER_2D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_3D:
+            case GL_UNSIGNED_INT_SAMPLER_CUBE:
+            case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
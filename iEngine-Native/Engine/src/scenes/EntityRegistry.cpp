@@ -0,0 +1,191 @@
+#include "iengine/scenes/EntityRegistry.h"
+#include "iengine/core/JobSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace iengine {
+    namespace {
+        // 组件类型在静态局部变量初始化时登记，可能来自多个线程
+        std::mutex s_componentTypesMutex;
+        std::array<ComponentTypeInfo, ComponentTypes::kMaxComponentTypes> s_componentTypes;
+        size_t s_componentTypeCount = 0;
+    }
+
+    ComponentTypeId ComponentTypes::registerType(size_t size, void (*construct)(void*)) {
+        std::lock_guard<std::mutex> lock(s_componentTypesMutex);
+        if (s_componentTypeCount >= kMaxComponentTypes) {
+            throw std::runtime_error("Too many component types");
+        }
+        s_componentTypes[s_componentTypeCount].size = size;
+        s_componentTypes[s_componentTypeCount].construct = construct;
+        return static_cast<ComponentTypeId>(s_componentTypeCount++);
+    }
+
+    const ComponentTypeInfo& ComponentTypes::info(ComponentTypeId id) {
+        // 序号由 id<T>() 的静态初始化返回，登记的写入对拿到序号的线程可见
+        return s_componentTypes[id];
+    }
+
+    Archetype::Archetype(ComponentMask mask) : mask_(mask) {
+        columnIndex_.fill(-1);
+        for (ComponentTypeId type = 0; type < ComponentTypes::kMaxComponentTypes; ++type) {
+            if (!has(type)) continue;
+            columnIndex_[type] = static_cast<int8_t>(columns_.size());
+            Column column;
+            column.type = type;
+            column.stride = ComponentTypes::info(type).size;
+            columns_.push_back(std::move(column));
+        }
+    }
+
+    void* Archetype::column(ComponentTypeId type) {
+        if (type >= ComponentTypes::kMaxComponentTypes || columnIndex_[type] < 0) {
+            return nullptr;
+        }
+        return columns_[columnIndex_[type]].data.data();
+    }
+
+    size_t Archetype::addRow(Entity entity) {
+        size_t row = entities_.size();
+        entities_.push_back(entity);
+        for (auto& column : columns_) {
+            column.data.resize(column.data.size() + column.stride);
+            ComponentTypes::info(column.type).construct(column.data.data() + row * column.stride);
+        }
+        return row;
+    }
+
+    Entity Archetype::removeRow(size_t row) {
+        size_t last = entities_.size() - 1;
+        Entity moved;
+        if (row != last) {
+            for (auto& column : columns_) {
+                std::memcpy(column.data.data() + row * column.stride,
+                            column.data.data() + last * column.stride, column.stride);
+            }
+            entities_[row] = entities_[last];
+            moved = entities_[row];
+        }
+        for (auto& column : columns_) {
+            column.data.resize(column.data.size() - column.stride);
+        }
+        entities_.pop_back();
+        return moved;
+    }
+
+    void Archetype::reserve(size_t rows) {
+        entities_.reserve(rows);
+        for (auto& column : columns_) {
+            column.data.reserve(rows * column.stride);
+        }
+    }
+
+    EntityRegistry::EntityRegistry() {
+        // 原型 0 为不含组件的空原型
+        findOrCreateArchetype(0);
+    }
+
+    Entity EntityRegistry::create() {
+        return createWithMask(0);
+    }
+
+    Entity EntityRegistry::createWithMask(ComponentMask mask) {
+        uint32_t archetypeIndex = findOrCreateArchetype(mask);
+        auto key = locations_.insert(Location());
+        Entity entity{key.index, key.generation};
+
+        Location* location = locations_.get(key.index, key.generation);
+        location->archetype = archetypeIndex;
+        location->row = static_cast<uint32_t>(archetypes_[archetypeIndex]->addRow(entity));
+        return entity;
+    }
+
+    bool EntityRegistry::destroy(Entity entity) {
+        Location* location = locations_.get(entity.index, entity.generation);
+        if (!location) {
+            return false;
+        }
+
+        Entity moved = archetypes_[location->archetype]->removeRow(location->row);
+        if (moved.isValid()) {
+            locations_.get(moved.index, moved.generation)->row = location->row;
+        }
+        locations_.erase(entity.index, entity.generation);
+        return true;
+    }
+
+    bool EntityRegistry::isAlive(Entity entity) const {
+        return locations_.get(entity.index, entity.generation) != nullptr;
+    }
+
+    void EntityRegistry::clear() {
+        locations_.clear();
+        archetypes_.clear();
+        archetypeIndex_.clear();
+        findOrCreateArchetype(0);
+    }
+
+    ComponentMask EntityRegistry::getMask(Entity entity) const {
+        const Location* location = locations_.get(entity.index, entity.generation);
+        return location ? archetypes_[location->archetype]->getMask() : 0;
+    }
+
+    bool EntityRegistry::setMask(Entity entity, ComponentMask mask) {
+        Location* location = locations_.get(entity.index, entity.generation);
+        if (!location) {
+            return false;
+        }
+        if (archetypes_[location->archetype]->getMask() == mask) {
+            return true;
+        }
+
+        // 查找目标原型可能扩充 archetypes_，原型本身由 unique_ptr 持有，地址不变
+        uint32_t targetIndex = findOrCreateArchetype(mask);
+        Archetype& source = *archetypes_[location->archetype];
+        Archetype& target = *archetypes_[targetIndex];
+
+        size_t row = target.addRow(entity);
+        for (auto& column : target.columns_) {
+            const void* from = source.column(column.type);
+            if (from) {
+                std::memcpy(column.data.data() + row * column.stride,
+                            static_cast<const unsigned char*>(from) + location->row * column.stride, column.stride);
+            }
+        }
+
+        Entity moved = source.removeRow(location->row);
+        if (moved.isValid()) {
+            locations_.get(moved.index, moved.generation)->row = location->row;
+        }
+        location->archetype = targetIndex;
+        location->row = static_cast<uint32_t>(row);
+        return true;
+    }
+
+    uint32_t EntityRegistry::findOrCreateArchetype(ComponentMask mask) {
+        auto it = archetypeIndex_.find(mask);
+        if (it != archetypeIndex_.end()) {
+            return it->second;
+        }
+        uint32_t index = static_cast<uint32_t>(archetypes_.size());
+        archetypes_.push_back(std::make_unique<Archetype>(mask));
+        archetypeIndex_[mask] = index;
+        return index;
+    }
+
+    void EntityRegistry::runChunks(JobSystem* jobSystem, size_t count, int minChunk,
+                                   const std::function<void(size_t, size_t)>& fn) {
+        minChunk = std::max(minChunk, 1);
+        if (!jobSystem || count <= static_cast<size_t>(minChunk)) {
+            fn(0, count);
+            return;
+        }
+        jobSystem->parallelFor(static_cast<int>(count), [&fn](int begin, int end) {
+            fn(static_cast<size_t>(begin), static_cast<size_t>(end));
+        }, minChunk, "EntityRegistry::parallelEach");
+    }
+}
@@ -1,12 +1,38 @@
 #include "iengine/scenes/Scene.h"
 #include "iengine/core/Model.h"
+#include "iengine/core/Mesh.h"
+#include "iengine/core/JobSystem.h"
+#include "iengine/lights/Light.h"
+#include "iengine/materials/Material.h"
+#include "iengine/views/cameras/Camera.h"
 #include "iengine/renderers/opengl/OpenGLContext.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
 
 namespace iengine {
+    // 当前线程正在更新的场景、实体序号和该实体已记录的命令数，用于给延迟命令排序
+    static thread_local const Scene* tlsUpdatingScene = nullptr;
+    static thread_local size_t tlsUpdatingEntity = SIZE_MAX;
+    static thread_local uint32_t tlsCommandSequence = 0;
+    
+    // 局部包围球取几何包围盒的中心和半对角线
+    static void setLocalBounds(const Mesh* mesh, BoundsComponent& bounds) {
+        if (!mesh || !mesh->geometry) {
+            bounds.localRadius = -1.0f;
+            return;
+        }
+        const auto& box = mesh->geometry->boundingBox;
+        bounds.localCenter = Vector3((box.min[0] + box.max[0]) * 0.5f,
+                                     (box.min[1] + box.max[1]) * 0.5f,
+                                     (box.min[2] + box.max[2]) * 0.5f);
+        bounds.localRadius = mesh->geometry->getBoundingDiagonal() * 0.5f;
+    }
+    
     Scene::Scene(std::shared_ptr<WindowInterface> window) : window_(window) {
         // 如果window为空，则不创建Context（适用于纯代码模式）
         if (!window_) {
@@ -25,16 +51,117 @@ namespace iengine {
         std::cout << "Scene created with OpenGL context" << std::endl;
     }
     
-    Scene::~Scene() {}
+    Scene::~Scene() {
+        // 模型可能比场景活得长，把它们的状态复制回去
+        for (const auto& component : components_) {
+            detach(*component);
+        }
+    }
     
     void Scene::addComponent(std::shared_ptr<Model> component) {
+        if (updating_) {
+            record([component](Scene& scene) { scene.addComponent(component); });
+            return;
+        }
+        if (!component) {
+            return;
+        }
+        if (component->scene_) {
+            std::cerr << "Scene: component '" << component->name << "' already belongs to a scene" << std::endl;
+            return;
+        }
+        
+        EntityStateComponent state;
+        state.visible = component->visible_ ? 1 : 0;
+        state.resourcesDirty = 1;
+        Entity entity = registry_.create(TransformComponent{component->transform_}, BoundsComponent(),
+                                         RenderableComponent(), state, ModelComponent{component.get()},
+                                         LodComponent{static_cast<uint32_t>(component->currentLod_)});
+        if (component->hasAnimations()) {
+            registry_.add<AnimationComponent>(entity);
+        }
+        component->scene_ = this;
+        component->entity_ = entity;
+        
         components_.push_back(component);
+        dirty_ = true;
     }
     
     void Scene::removeComponent(std::shared_ptr<Model> component) {
+        if (updating_) {
+            record([component](Scene& scene) { scene.removeComponent(component); });
+            return;
+        }
         auto it = std::find(components_.begin(), components_.end(), component);
         if (it != components_.end()) {
+            detach(*component);
             components_.erase(it);
+            dirty_ = true;
+        }
+    }
+    
+    void Scene::detach(Model& model) {
+        if (const auto* transform = registry_.get<TransformComponent>(model.entity_)) {
+            model.transform_ = transform->matrix;
+        }
+        if (const auto* state = registry_.get<EntityStateComponent>(model.entity_)) {
+            model.visible_ = state->visible != 0;
+        }
+        if (const auto* lod = registry_.get<LodComponent>(model.entity_)) {
+            model.currentLod_ = lod->level;
+        }
+        model.dirty_ = true;
+        releaseResources(model.entity_);
+        registry_.destroy(model.entity_);
+        model.scene_ = nullptr;
+        model.entity_ = Entity();
+    }
+    
+    void Scene::enableAnimation(Entity entity) {
+        defer([entity](Scene& scene) {
+            if (scene.registry_.isAlive(entity)) {
+                scene.registry_.add<AnimationComponent>(entity);
+            }
+        });
+    }
+    
+    Entity Scene::createEntity(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Matrix4& transform) {
+        if (updating_) {
+            std::cerr << "Scene: cannot create entities during update, use defer()" << std::endl;
+            return Entity();
+        }
+        
+        BoundsComponent bounds;
+        setLocalBounds(mesh.get(), bounds);
+        RenderableComponent renderable;
+        renderable.mesh = meshes_.acquire(mesh);
+        renderable.material = materials_.acquire(material);
+        Entity entity = registry_.create(TransformComponent{transform}, bounds, renderable, EntityStateComponent(),
+                                         LodComponent());
+        dirty_ = true;
+        return entity;
+    }
+    
+    void Scene::destroyEntity(Entity entity) {
+        if (updating_) {
+            record([entity](Scene& scene) { scene.destroyEntity(entity); });
+            return;
+        }
+        if (registry_.has<ModelComponent>(entity)) {
+            std::cerr << "Scene: entity belongs to a Model, use removeComponent()" << std::endl;
+            return;
+        }
+        releaseResources(entity);
+        if (registry_.destroy(entity)) {
+            dirty_ = true;
+        }
+    }
+    
+    void Scene::releaseResources(Entity entity) {
+        if (auto* renderable = registry_.get<RenderableComponent>(entity)) {
+            meshes_.release(renderable->mesh);
+            materials_.release(renderable->material);
+            *renderable = RenderableComponent();
         }
     }
     
@@ -43,13 +170,23 @@ namespace iengine {
     }
     
     void Scene::addLight(std::shared_ptr<Light> light) {
+        if (updating_) {
+            record([light](Scene& scene) { scene.addLight(light); });
+            return;
+        }
         lights_.push_back(light);
+        dirty_ = true;
     }
     
     void Scene::removeLight(std::shared_ptr<Light> light) {
+        if (updating_) {
+            record([light](Scene& scene) { scene.removeLight(light); });
+            return;
+        }
         auto it = std::find(lights_.begin(), lights_.end(), light);
         if (it != lights_.end()) {
             lights_.erase(it);
+            dirty_ = true;
         }
     }
     
@@ -58,8 +195,192 @@ namespace iengine {
     }
     
     void Scene::update(float deltaTime) {
-        for (auto& component : components_) {
-            component->update(deltaTime);
+        updating_ = true;
+        try {
+            updateAnimations(deltaTime);
+            updateMotion(deltaTime);
+        } catch (...) {
+            // 动画回调抛出的异常由 parallelFor 在全部分段结束后转交到这里；已记录的延迟命令留到下一次同步点执行
+            updating_ = false;
+            throw;
+        }
+        updating_ = false;
+        
+        // 同步点：执行更新期间记录的结构变更
+        applyDeferredCommands();
+        
+        updateBounds();
+    }
+    
+    void Scene::updateAnimations(float deltaTime) {
+        // 只有带动画回调的 Model 需要调用，其余实体不访问 Model 对象
+        JobSystem* jobSystem = getUpdateJobSystem();
+        registry_.parallelForEachChunk<ModelComponent, AnimationComponent>(jobSystem, updateOptions_.minModelsPerChunk,
+            [this, deltaTime](Archetype& archetype, size_t begin, size_t end) {
+                const Entity* entities = archetype.entities();
+                const ModelComponent* models = archetype.column<ModelComponent>();
+                
+                // 工作线程在等待时可能执行其他场景的更新，结束时（包括回调抛出异常时）恢复外层状态
+                struct UpdatingStateGuard {
+                    const Scene* scene = tlsUpdatingScene;
+                    size_t entity = tlsUpdatingEntity;
+                    uint32_t sequence = tlsCommandSequence;
+                    ~UpdatingStateGuard() {
+                        tlsUpdatingScene = scene;
+                        tlsUpdatingEntity = entity;
+                        tlsCommandSequence = sequence;
+                    }
+                } guard;
+                tlsUpdatingScene = this;
+                for (size_t i = begin; i < end; ++i) {
+                    tlsUpdatingEntity = entities[i].index;
+                    tlsCommandSequence = 0;
+                    models[i].model->update(deltaTime);
+                }
+            });
+    }
+    
+    void Scene::updateMotion(float deltaTime) {
+        registry_.parallelEach<TransformComponent, MotionComponent, EntityStateComponent>(
+            getUpdateJobSystem(), updateOptions_.minEntitiesPerChunk,
+            [deltaTime](TransformComponent& transform, const MotionComponent& motion, EntityStateComponent& state) {
+                const Vector3& w = motion.angularVelocity;
+                float angularSpeed = std::sqrt(w.x * w.x + w.y * w.y + w.z * w.z);
+                bool moving = motion.velocity.x != 0.0f || motion.velocity.y != 0.0f || motion.velocity.z != 0.0f;
+                if (angularSpeed <= 0.0f && !moving) {
+                    return;
+                }
+                if (angularSpeed > 0.0f) {
+                    // 右乘：绕实体自身的原点旋转
+                    transform.matrix.multiply(Matrix4::fromRotation(w, angularSpeed * deltaTime));
+                }
+                auto& m = transform.matrix.elements;
+                m[12] += motion.velocity.x * deltaTime;
+                m[13] += motion.velocity.y * deltaTime;
+                m[14] += motion.velocity.z * deltaTime;
+                state.dirty = 1;
+                state.boundsDirty = 1;
+            });
+    }
+    
+    void Scene::updateBounds() {
+        // Model 的网格或材质可能被替换：只有标记过的实体访问 Model 对象，重新获取句柄和局部包围盒
+        registry_.forEachArchetype<ModelComponent, RenderableComponent, BoundsComponent, EntityStateComponent>(
+            [this](Archetype& archetype) {
+                const ModelComponent* models = archetype.column<ModelComponent>();
+                RenderableComponent* renderables = archetype.column<RenderableComponent>();
+                BoundsComponent* bounds = archetype.column<BoundsComponent>();
+                EntityStateComponent* states = archetype.column<EntityStateComponent>();
+                for (size_t i = 0; i < archetype.size(); ++i) {
+                    if (!states[i].resourcesDirty) {
+                        continue;
+                    }
+                    const Model& model = *models[i].model;
+                    SceneResourceHandle mesh = meshes_.acquire(model.mesh);
+                    SceneResourceHandle material = materials_.acquire(model.material);
+                    meshes_.release(renderables[i].mesh);
+                    materials_.release(renderables[i].material);
+                    renderables[i].mesh = mesh;
+                    renderables[i].material = material;
+                    setLocalBounds(model.mesh.get(), bounds[i]);
+                    states[i].resourcesDirty = 0;
+                    states[i].boundsDirty = 1;
+                }
+            });
+        
+        registry_.parallelEach<TransformComponent, BoundsComponent, EntityStateComponent>(
+            getUpdateJobSystem(), updateOptions_.minEntitiesPerChunk,
+            [](const TransformComponent& transform, BoundsComponent& bounds, EntityStateComponent& state) {
+                if (!state.boundsDirty) {
+                    return;
+                }
+                state.boundsDirty = 0;
+                if (bounds.localRadius < 0.0f) {
+                    bounds.worldRadius = -1.0f;
+                    return;
+                }
+                const auto& m = transform.matrix.elements;
+                const Vector3& c = bounds.localCenter;
+                bounds.worldCenter = Vector3(
+                    m[0] * c.x + m[4] * c.y + m[8] * c.z + m[12],
+                    m[1] * c.x + m[5] * c.y + m[9] * c.z + m[13],
+                    m[2] * c.x + m[6] * c.y + m[10] * c.z + m[14]);
+                // 半径乘以最大轴向缩放
+                float scale = std::sqrt(std::max({
+                    m[0] * m[0] + m[1] * m[1] + m[2] * m[2],
+                    m[4] * m[4] + m[5] * m[5] + m[6] * m[6],
+                    m[8] * m[8] + m[9] * m[9] + m[10] * m[10]}));
+                bounds.worldRadius = bounds.localRadius * scale;
+            });
+    }
+    
+    size_t Scene::cull(Camera& camera) {
+        updateBounds();
+        
+        float planes[6][4];
+        camera.getFrustumPlanes(planes);
+        
+        std::atomic<size_t> visible{0};
+        registry_.parallelForEachChunk<BoundsComponent, EntityStateComponent>(
+            getUpdateJobSystem(), updateOptions_.minEntitiesPerChunk,
+            [&planes, &visible](Archetype& archetype, size_t begin, size_t end) {
+                const BoundsComponent* bounds = archetype.column<BoundsComponent>();
+                EntityStateComponent* states = archetype.column<EntityStateComponent>();
+                size_t count = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    const BoundsComponent& b = bounds[i];
+                    bool inside = true;
+                    // 没有几何的实体不剔除
+                    if (b.worldRadius >= 0.0f) {
+                        for (const auto& plane : planes) {
+                            float distance = plane[0] * b.worldCenter.x + plane[1] * b.worldCenter.y +
+                                             plane[2] * b.worldCenter.z + plane[3];
+                            inside = inside && distance >= -b.worldRadius;
+                        }
+                    }
+                    states[i].culled = inside ? 0 : 1;
+                    count += (inside && states[i].visible) ? 1 : 0;
+                }
+                visible.fetch_add(count, std::memory_order_relaxed);
+            });
+        return visible.load();
+    }
+    
+    void Scene::defer(std::function<void(Scene&)> command) {
+        if (updating_) {
+            record(std::move(command));
+        } else {
+            command(*this);
+        }
+    }
+    
+    void Scene::record(std::function<void(Scene&)> command) {
+        DeferredCommand deferred;
+        if (tlsUpdatingScene == this) {
+            deferred.entity = tlsUpdatingEntity;
+            deferred.sequence = tlsCommandSequence++;
+        } else {
+            deferred.entity = SIZE_MAX;
+            deferred.sequence = 0;
+        }
+        deferred.apply = std::move(command);
+        
+        std::lock_guard<std::mutex> lock(deferredMutex_);
+        deferred_.push_back(std::move(deferred));
+    }
+    
+    void Scene::applyDeferredCommands() {
+        std::vector<DeferredCommand> commands;
+        {
+            std::lock_guard<std::mutex> lock(deferredMutex_);
+            commands.swap(deferred_);
+        }
+        // 按串行更新时的发出顺序执行；更新回调之外记录的命令保持记录顺序排在最后
+        std::stable_sort(commands.begin(), commands.end(), [](const DeferredCommand& a, const DeferredCommand& b) {
+            return a.entity != b.entity ? a.entity < b.entity : a.sequence < b.sequence;
+        });
+        for (auto& command : commands) {
+            command.apply(*this);
         }
     }
     
@@ -68,7 +389,68 @@ namespace iengine {
     }
     
     void Scene::setActiveCamera(std::shared_ptr<Camera> camera) {
-        activeCamera_ = camera;
+        if (activeCamera_ != camera) {
+            activeCamera_ = camera;
+            dirty_ = true;
+        }
+    }
+    
+    bool Scene::needsRedraw() const {
+        if (dirty_ || (activeCamera_ && activeCamera_->isDirty()) || hasActiveAnimations()) {
+            return true;
+        }
+        
+        // 只扫描状态列，不访问 Model 对象
+        bool changed = false;
+        registry_.forEachArchetype<EntityStateComponent>([&changed](const Archetype& archetype) {
+            const EntityStateComponent* states = archetype.column<EntityStateComponent>();
+            for (size_t i = 0; i < archetype.size() && !changed; ++i) {
+                changed = states[i].dirty != 0 || states[i].resourcesDirty != 0;
+            }
+        });
+        if (changed) {
+            return true;
+        }
+        
+        // 共享的材质在资源表中只检查一次
+        materials_.forEach([&changed](const std::shared_ptr<Material>& material) {
+            changed = changed || material->isDirty();
+        });
+        if (changed) {
+            return true;
+        }
+        for (const auto& light : lights_) {
+            if (light && light->isDirty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    bool Scene::hasActiveAnimations() const {
+        // 带动画回调的 Model 或有运动状态的实体每帧都可能变化
+        bool animated = false;
+        registry_.forEachArchetype<AnimationComponent>([&animated](const Archetype&) { animated = true; });
+        registry_.forEachArchetype<MotionComponent>([&animated](const Archetype&) { animated = true; });
+        return animated;
+    }
+    
+    void Scene::clearDirty() {
+        dirty_ = false;
+        if (activeCamera_) {
+            activeCamera_->clearDirty();
+        }
+        registry_.each<EntityStateComponent>([](EntityStateComponent& state) {
+            state.dirty = 0;
+        });
+        materials_.forEach([](const std::shared_ptr<Material>& material) {
+            material->clearDirty();
+        });
+        for (const auto& light : lights_) {
+            if (light) {
+                light->clearDirty();
+            }
+        }
     }
     
     std::shared_ptr<Context> Scene::getContext() const {
@@ -76,6 +458,10 @@ namespace iengine {
     }
     
     void Scene::setContextType(RendererType type) {
+        // 纯代码模式没有窗口和上下文，引擎只更新场景、不渲染
+        if (!window_) {
+            return;
+        }
         switch (type) {
             case RendererType::OpenGL:
                 if (!openglContext_) {
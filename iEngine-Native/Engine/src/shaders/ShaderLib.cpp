@@ -6,30 +6,32 @@
 #include "iengine/shaders/glsl/BaseWireframeShader.h"
 
 #include <algorithm>
+#include <mutex>
 #include <sstream>
 
 namespace iengine {
 
     // 静态成员初始化
     std::unordered_map<std::string, std::shared_ptr<ShaderVariants>> ShaderLib::shaders_;
-    std::unordered_map<ShaderVariantKey, std::shared_ptr<ShaderVariants>> ShaderLib::processedShaders_;
+    ShaderVariantCache ShaderLib::processedShaders_;
+    std::shared_mutex ShaderLib::mutex_;
 
     void ShaderLib::registerShader(const std::string& name, std::shared_ptr<ShaderVariants> variants) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         shaders_[name] = variants;
     }
 
     void ShaderLib::unregisterShader(const std::string& name) {
-        shaders_.erase(name);
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            shaders_.erase(name);
+        }
         
         // 清理所有相关变体缓存
-        auto it = processedShaders_.begin();
-        while (it != processedShaders_.end()) {
-            if (it->first.find(name + "__") == 0) {
-                it = processedShaders_.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        const std::string prefix = name + "__";
+        processedShaders_.eraseIf([&prefix](const std::string& key) {
+            return key.compare(0, prefix.size(), prefix) == 0;
+        });
     }
 
     void ShaderLib::clearCache() {
@@ -42,12 +44,15 @@ namespace iengine {
         const ShaderVariantOptions& options
     ) {
         // 获取基础着色器
-        auto shaderIt = shaders_.find(name);
-        if (shaderIt == shaders_.end()) {
-            return nullptr;
+        std::shared_ptr<ShaderVariants> shader;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto shaderIt = shaders_.find(name);
+            if (shaderIt == shaders_.end()) {
+                return nullptr;
+            }
+            shader = shaderIt->second;
         }
-
-        std::shared_ptr<ShaderVariants> shader = shaderIt->second;
         
         // 合并定义
         DefineMap mergedDefines;
@@ -84,47 +89,54 @@ namespace iengine {
         ShaderVariantKey variantKey = makeShaderVariantKey(name, mergedDefines) + "__" + 
             (backend == GraphicsAPI::OpenGL ? "opengl" : "webgpu");
             
-        // 检查缓存
-        auto cachedIt = processedShaders_.find(variantKey);
-        if (cachedIt != processedShaders_.end()) {
-            return cachedIt->second;
-        }
-        
-        // 处理着色器
-        std::shared_ptr<ShaderVariants> result = std::make_shared<ShaderVariants>();
-        
-        if (backend == GraphicsAPI::OpenGL) {
-            if (shader->webgl) {
-                std::shared_ptr<GLSLSource> glsl = std::make_shared<GLSLSource>();
-                glsl->vertCode = shader->webgl->vertCode.empty() ? "" : 
-                    ShaderPreprocessor::preprocessGlsl(shader->webgl->vertCode, backend, "vertex", 
-                                                      std::make_shared<DefineMap>(mergedDefines));
-                glsl->fragCode = shader->webgl->fragCode.empty() ? "" : 
-                    ShaderPreprocessor::preprocessGlsl(shader->webgl->fragCode, backend, "fragment", 
-                                                      std::make_shared<DefineMap>(mergedDefines));
-                glsl->defines = shader->webgl->defines;
-                result->webgl = glsl;
-            }
-        } else if (backend == GraphicsAPI::WebGPU) {
-            if (shader->webgpu) {
-                std::shared_ptr<WGSLSource> wgsl = std::make_shared<WGSLSource>();
-                if (!shader->webgpu->code.empty()) {
-                    wgsl->code = ShaderPreprocessor::preprocessWgsl(shader->webgpu->code, 
-                                                                   std::make_shared<DefineMap>(mergedDefines));
-                } else {
-                    wgsl->code = "";
+        // 未命中时预处理；同一变体的并发请求等待第一个线程的结果
+        return processedShaders_.getOrCreate(variantKey, [&]() {
+            std::shared_ptr<ShaderVariants> result = std::make_shared<ShaderVariants>();
+        
+            if (backend == GraphicsAPI::OpenGL) {
+                if (shader->webgl) {
+                    std::shared_ptr<GLSLSource> glsl = std::make_shared<GLSLSource>();
+                    glsl->vertCode = shader->webgl->vertCode.empty() ? "" : 
+                        ShaderPreprocessor::preprocessGlsl(shader->webgl->vertCode, backend, "vertex", 
+                                                          std::make_shared<DefineMap>(mergedDefines));
+                    glsl->fragCode = shader->webgl->fragCode.empty() ? "" : 
+                        ShaderPreprocessor::preprocessGlsl(shader->webgl->fragCode, backend, "fragment", 
+                                                          std::make_shared<DefineMap>(mergedDefines));
+                    glsl->defines = shader->webgl->defines;
+                    result->webgl = glsl;
+                }
+            } else if (backend == GraphicsAPI::WebGPU) {
+                if (shader->webgpu) {
+                    std::shared_ptr<WGSLSource> wgsl = std::make_shared<WGSLSource>();
+                    if (!shader->webgpu->code.empty()) {
+                        wgsl->code = ShaderPreprocessor::preprocessWgsl(shader->webgpu->code, 
+                                                                       std::make_shared<DefineMap>(mergedDefines));
+                    } else {
+                        wgsl->code = "";
+                    }
+                    wgsl->defines = shader->webgpu->defines;
+                    result->webgpu = wgsl;
                 }
-                wgsl->defines = shader->webgpu->defines;
-                result->webgpu = wgsl;
             }
-        }
         
-        // 缓存结果
-        processedShaders_[variantKey] = result;
-        return result;
+            return result;
+        });
+    }
+
+    void ShaderLib::setCacheBudget(size_t bytes) {
+        processedShaders_.setBudget(bytes);
+    }
+
+    ShaderVariantCacheStats ShaderLib::getCacheStats() {
+        return processedShaders_.getStats();
+    }
+
+    void ShaderLib::printCacheStats() {
+        processedShaders_.printStats();
     }
 
     std::vector<std::string> ShaderLib::getAllShaderNames() {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
         std::vector<std::string> names;
         names.reserve(shaders_.size());
         
@@ -136,13 +148,15 @@ namespace iengine {
     }
 
     void ShaderLib::registerBuiltInShaders() {
+        std::vector<std::pair<std::string, std::shared_ptr<ShaderVariants>>> builtIns;
+        
         // 注册 base_material 着色器
         std::shared_ptr<ShaderVariants> baseMaterial = std::make_shared<ShaderVariants>();
         baseMaterial->webgl = std::make_shared<GLSLSource>();
         baseMaterial->webgl->vertCode = BaseMaterialShader::vertex;
         baseMaterial->webgl->fragCode = BaseMaterialShader::fragment;
         baseMaterial->webgl->defines = std::make_shared<DefineMap>();
-        registerShader("base_material", baseMaterial);
+        builtIns.emplace_back("base_material", baseMaterial);
         
         // 注册 base_wireframe 着色器
         std::shared_ptr<ShaderVariants> baseWireframe = std::make_shared<ShaderVariants>();
@@ -150,7 +164,7 @@ namespace iengine {
         baseWireframe->webgl->vertCode = BaseWireframeShader::vertex;
         baseWireframe->webgl->fragCode = BaseWireframeShader::fragment;
         baseWireframe->webgl->defines = std::make_shared<DefineMap>();
-        registerShader("base_wireframe", baseWireframe);
+        builtIns.emplace_back("base_wireframe", baseWireframe);
         
         // 注册 base_phong 着色器
         std::shared_ptr<ShaderVariants> basePhong = std::make_shared<ShaderVariants>();
@@ -159,7 +173,7 @@ namespace iengine {
         basePhong->webgl->fragCode = BasePhongShader::fragment;
         basePhong->webgl->defines = std::make_shared<DefineMap>();
         basePhong->webgl->defines->defines["HAS_COLOR"] = "true";
-        registerShader("base_phong", basePhong);
+        builtIns.emplace_back("base_phong", basePhong);
         
         // 注册 base_pbr 着色器
         std::shared_ptr<ShaderVariants> basePbr = std::make_shared<ShaderVariants>();
@@ -172,7 +186,12 @@ namespace iengine {
         basePbr->webgl->defines->defines["HAS_NORMAL_MAP"] = "false";
         basePbr->webgl->defines->defines["HAS_AO_MAP"] = "false";
         basePbr->webgl->defines->defines["HAS_EMISSIVE_MAP"] = "false";
-        registerShader("base_pbr", basePbr);
+        builtIns.emplace_back("base_pbr", basePbr);
+        
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& builtIn : builtIns) {
+            shaders_.emplace(std::move(builtIn.first), std::move(builtIn.second));
+        }
     }
 
     ShaderVariantKey ShaderLib::makeShaderVariantKey(const std::string& shaderName, const DefineMap& defines) {
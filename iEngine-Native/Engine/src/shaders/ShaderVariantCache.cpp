@@ -0,0 +1,215 @@
+#include "iengine/shaders/ShaderVariantCache.h"
+#include "iengine/shaders/ShaderLib.h"
+
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace iengine {
+
+    namespace {
+        // 先尝试获取锁，失败时记一次竞争再阻塞等待
+        template <typename Lock>
+        void lockCounted(Lock& lock, std::atomic<uint64_t>& contended) {
+            if (!lock.try_lock()) {
+                contended.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+        }
+    }
+
+    ShaderVariantCache::ShaderVariantCache(size_t budgetBytes)
+        : budget_(budgetBytes) {}
+
+    ShaderVariantCache::Shard& ShaderVariantCache::shardFor(const std::string& key) {
+        return shards_[std::hash<std::string>()(key) % kShardCount];
+    }
+
+    std::shared_ptr<ShaderVariants> ShaderVariantCache::getOrCreate(const std::string& key, const Factory& factory) {
+        Shard& shard = shardFor(key);
+        const uint64_t now = clock_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        // 快速路径：共享锁查找
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+            lockCounted(lock, contended_);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                Entry& entry = *it->second;
+                entry.lastUse.store(now, std::memory_order_relaxed);
+                if (entry.ready) {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return entry.result.get();
+                }
+                Result pending = entry.result;
+                lock.unlock();
+                waits_.fetch_add(1, std::memory_order_relaxed);
+                return pending.get();
+            }
+        }
+
+        // 未命中：独占锁下再查一次，仍然没有时放入未完成的条目
+        std::promise<std::shared_ptr<ShaderVariants>> promise;
+        Entry* inserted = nullptr;
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+            lockCounted(lock, contended_);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                Entry& entry = *it->second;
+                entry.lastUse.store(now, std::memory_order_relaxed);
+                if (entry.ready) {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return entry.result.get();
+                }
+                Result pending = entry.result;
+                lock.unlock();
+                waits_.fetch_add(1, std::memory_order_relaxed);
+                return pending.get();
+            }
+
+            auto entry = std::make_unique<Entry>();
+            entry->result = promise.get_future().share();
+            entry->lastUse.store(now, std::memory_order_relaxed);
+            inserted = entry.get();
+            shard.entries.emplace(key, std::move(entry));
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+
+        // 在锁外预处理，其他键（包括同一分片）的查询不受影响
+        std::shared_ptr<ShaderVariants> result;
+        try {
+            result = factory();
+        } catch (const std::exception& e) {
+            std::cerr << "ShaderVariantCache: 预处理变体 " << key << " 失败: " << e.what() << std::endl;
+            result = nullptr;
+        } catch (...) {
+            std::cerr << "ShaderVariantCache: 预处理变体 " << key << " 失败" << std::endl;
+            result = nullptr;
+        }
+        // 无论成功与否都要完成 promise，否则等待者会得到 broken_promise
+        promise.set_value(result);
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex, std::defer_lock);
+        lockCounted(lock, contended_);
+        auto it = shard.entries.find(key);
+        // 预处理期间条目可能已被 clear/eraseIf 移除，之后其他线程又为同一键放入了自己的条目，
+        // 只处理本线程放入的那一个
+        if (it != shard.entries.end() && it->second.get() == inserted) {
+            if (!result) {
+                // 不缓存失败的结果，等待者已经拿到空指针
+                shard.entries.erase(it);
+            } else {
+                Entry& entry = *it->second;
+                entry.ready = true;
+                entry.bytes = sizeOf(key, *result);
+                shard.bytes += entry.bytes;
+                evict(shard, key);
+            }
+        }
+        return result;
+    }
+
+    void ShaderVariantCache::evict(Shard& shard, const std::string& keep) {
+        // 注意：此函数假设已经获得了分片的独占锁；每个分片分得预算的 1/kShardCount
+        const size_t budget = budget_.load(std::memory_order_relaxed);
+        if (budget == 0) {
+            return;
+        }
+        const size_t shardBudget = budget / kShardCount;
+        while (shard.bytes > shardBudget) {
+            auto victim = shard.entries.end();
+            uint64_t oldest = UINT64_MAX;
+            for (auto it = shard.entries.begin(); it != shard.entries.end(); ++it) {
+                const Entry& entry = *it->second;
+                if (!entry.ready || it->first == keep) {
+                    continue;
+                }
+                uint64_t lastUse = entry.lastUse.load(std::memory_order_relaxed);
+                if (lastUse < oldest) {
+                    oldest = lastUse;
+                    victim = it;
+                }
+            }
+            if (victim == shard.entries.end()) {
+                // 只剩刚插入的条目，超出预算也保留
+                break;
+            }
+            shard.bytes -= victim->second->bytes;
+            shard.entries.erase(victim);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ShaderVariantCache::eraseIf(const std::function<bool(const std::string&)>& predicate) {
+        for (Shard& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (it->second->ready && predicate(it->first)) {
+                    shard.bytes -= it->second->bytes;
+                    it = shard.entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void ShaderVariantCache::clear() {
+        eraseIf([](const std::string&) { return true; });
+    }
+
+    void ShaderVariantCache::setBudget(size_t bytes) {
+        budget_.store(bytes, std::memory_order_relaxed);
+        for (Shard& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            evict(shard, std::string());
+        }
+    }
+
+    ShaderVariantCacheStats ShaderVariantCache::getStats() const {
+        ShaderVariantCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.waits = waits_.load(std::memory_order_relaxed);
+        stats.contended = contended_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        stats.budget = budget_.load(std::memory_order_relaxed);
+        for (const Shard& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            stats.entries += shard.entries.size();
+            stats.bytes += shard.bytes;
+        }
+        return stats;
+    }
+
+    void ShaderVariantCache::resetStats() {
+        hits_ = 0;
+        misses_ = 0;
+        waits_ = 0;
+        contended_ = 0;
+        evictions_ = 0;
+    }
+
+    void ShaderVariantCache::printStats() const {
+        ShaderVariantCacheStats stats = getStats();
+        uint64_t lookups = stats.hits + stats.misses + stats.waits;
+        std::cout << "ShaderVariantCache stats: " << stats.entries << " variants, " << stats.bytes << " / "
+                  << stats.budget << " bytes, " << stats.hits << " hits / " << stats.misses << " misses / "
+                  << stats.waits << " waits (hit rate "
+                  << (lookups > 0 ? 100.0 * (stats.hits + stats.waits) / lookups : 0.0) << "%), "
+                  << stats.contended << " contended locks, " << stats.evictions << " evictions" << std::endl;
+    }
+
+    size_t ShaderVariantCache::sizeOf(const std::string& key, const ShaderVariants& variants) {
+        size_t bytes = key.size() + sizeof(ShaderVariants);
+        if (variants.webgl) {
+            bytes += variants.webgl->vertCode.size() + variants.webgl->fragCode.size();
+        }
+        if (variants.webgpu) {
+            bytes += variants.webgpu->code.size();
+        }
+        return bytes;
+    }
+
+} // namespace iengine
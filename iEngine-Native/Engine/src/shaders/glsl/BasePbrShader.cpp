@@ -67,13 +67,51 @@ void main() {
             varying vec2 vTexCoord;
         #endif
 
-        uniform sampler2D uBaseColorMap;
-        uniform sampler2D uMetallicRoughnessMap;
-        uniform sampler2D uNormalMap;
         uniform float uNormalScale;
-        uniform sampler2D uAoMap;
         uniform float uAoStrength;
-        uniform sampler2D uEmissiveMap;
+
+        #ifdef USE_TEXTURE_ARRAYS
+            // 贴图位于纹理数组中：uXxxSlot = (uv 缩放, uv 偏移)，uXxxLayer = (层号, U/V 方向是否回绕)
+            uniform sampler2DArray uBaseColorMapArray;
+            uniform vec4 uBaseColorMapSlot;
+            uniform vec3 uBaseColorMapLayer;
+            uniform sampler2DArray uMetallicRoughnessMapArray;
+            uniform vec4 uMetallicRoughnessMapSlot;
+            uniform vec3 uMetallicRoughnessMapLayer;
+            uniform sampler2DArray uNormalMapArray;
+            uniform vec4 uNormalMapSlot;
+            uniform vec3 uNormalMapLayer;
+            uniform sampler2DArray uAoMapArray;
+            uniform vec4 uAoMapSlot;
+            uniform vec3 uAoMapLayer;
+            uniform sampler2DArray uEmissiveMapArray;
+            uniform vec4 uEmissiveMapSlot;
+            uniform vec3 uEmissiveMapLayer;
+
+            // 在层内区域中回绕或夹取，导数取自原始 uv，避免回绕处 Mip 选择跳变
+            vec4 sampleArrayMap(sampler2DArray map, vec4 slot, vec3 layer, vec2 uv) {
+                vec2 local = mix(clamp(uv, 0.0, 1.0), fract(uv), layer.yz);
+                return textureGrad(map, vec3(local * slot.xy + slot.zw, layer.x), dFdx(uv) * slot.xy, dFdy(uv) * slot.xy);
+            }
+
+            #define SAMPLE_BASECOLOR(uv) sampleArrayMap(uBaseColorMapArray, uBaseColorMapSlot, uBaseColorMapLayer, uv)
+            #define SAMPLE_METALLICROUGHNESS(uv) sampleArrayMap(uMetallicRoughnessMapArray, uMetallicRoughnessMapSlot, uMetallicRoughnessMapLayer, uv)
+            #define SAMPLE_NORMAL(uv) sampleArrayMap(uNormalMapArray, uNormalMapSlot, uNormalMapLayer, uv)
+            #define SAMPLE_AO(uv) sampleArrayMap(uAoMapArray, uAoMapSlot, uAoMapLayer, uv)
+            #define SAMPLE_EMISSIVE(uv) sampleArrayMap(uEmissiveMapArray, uEmissiveMapSlot, uEmissiveMapLayer, uv)
+        #else
+            uniform sampler2D uBaseColorMap;
+            uniform sampler2D uMetallicRoughnessMap;
+            uniform sampler2D uNormalMap;
+            uniform sampler2D uAoMap;
+            uniform sampler2D uEmissiveMap;
+
+            #define SAMPLE_BASECOLOR(uv) texture2D(uBaseColorMap, uv)
+            #define SAMPLE_METALLICROUGHNESS(uv) texture2D(uMetallicRoughnessMap, uv)
+            #define SAMPLE_NORMAL(uv) texture2D(uNormalMap, uv)
+            #define SAMPLE_AO(uv) texture2D(uAoMap, uv)
+            #define SAMPLE_EMISSIVE(uv) texture2D(uEmissiveMap, uv)
+        #endif
 
         // PBR核心函数
         float DistributionGGX(vec3 N, vec3 H, float roughness) {
@@ -106,12 +144,12 @@ void main() {
         void main() {
             // 采样 baseColor
             vec3 baseColor = uBaseColor;
-            baseColor *= texture2D(uBaseColorMap, vTexCoord).rgb;
+            baseColor *= SAMPLE_BASECOLOR(vTexCoord).rgb;
 
             // 先对贴图（含默认的1X1的uMetallicRoughnessMap贴图）进行采样 metallic/roughness
             // 再和uMetallic/uRoughness进行混合，避免用户设置了uMetallic/uRoughness，而未设置
             // uMetallicRoughnessMap时，用户的uMetallic/uRoughness的设置无法发挥作用。
-            vec4 mrSample = texture2D(uMetallicRoughnessMap, vTexCoord);
+            vec4 mrSample = SAMPLE_METALLICROUGHNESS(vTexCoord);
             float metallic = uMetallic * mrSample.b;
             float roughness = max(0.01, uRoughness * mrSample.g); // 最小粗糙度
 
@@ -125,7 +163,13 @@ void main() {
             // 避免出现：uNormalScale 不为 0 时，却依然使用默认的 1x1 法线贴图，这会导致
             // 用一张没有细节的法线贴图去扰动原本正确的法线，结果导致高光消失或偏移。
             if (uNormalScale > 0.0) {
-                vec3 tangentNormal = texture2D(uNormalMap, vTexCoord).xyz * 2.0 - 1.0;
+            #ifdef NORMALMAP_RG
+                // BC5 只存 xy，按单位长度重建 z
+                vec2 normalXY = SAMPLE_NORMAL(vTexCoord).xy * 2.0 - 1.0;
+                vec3 tangentNormal = vec3(normalXY, sqrt(max(0.0, 1.0 - dot(normalXY, normalXY))));
+            #else
+                vec3 tangentNormal = SAMPLE_NORMAL(vTexCoord).xyz * 2.0 - 1.0;
+            #endif
                 N = normalize(mix(N, tangentNormal, uNormalScale));
             }
 
@@ -135,11 +179,11 @@ void main() {
 
             // 采样 ao
             float ao = 1.0;
-            ao = mix(1.0, texture2D(uAoMap, vTexCoord).r, uAoStrength);
+            ao = mix(1.0, SAMPLE_AO(vTexCoord).r, uAoStrength);
 
             // 采样 emissive
             vec3 emissive = vec3(0.0);
-            emissive = texture2D(uEmissiveMap, vTexCoord).rgb;
+            emissive = SAMPLE_EMISSIVE(vTexCoord).rgb;
 
             float NDF = DistributionGGX(N, H, roughness);
             float G = GeometrySmith(N, V, L, roughness);
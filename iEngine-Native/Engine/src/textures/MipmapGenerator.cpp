@@ -0,0 +1,286 @@
+#include "iengine/textures/MipmapGenerator.h"
+#include "iengine/textures/TextureUtils.h"
+#include "iengine/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace iengine {
+
+    namespace {
+        // 分离滤波的一个维度：每个目标像素对应若干源像素及权重
+        struct FilterTap {
+            int source;
+            float weight;
+        };
+
+        struct FilterTable {
+            std::vector<size_t> begin;  // 每个目标像素在 taps 中的起始位置，长度为 dstSize + 1
+            std::vector<FilterTap> taps;
+        };
+
+        float sinc(float x) {
+            if (std::fabs(x) < 1e-5f) return 1.0f;
+            const float pi = 3.14159265358979f;
+            return std::sin(pi * x) / (pi * x);
+        }
+
+        // 第一类零阶修正贝塞尔函数
+        float besselI0(float x) {
+            float sum = 1.0f;
+            float term = 1.0f;
+            float halfX = x * 0.5f;
+            for (int k = 1; k < 32; ++k) {
+                term *= (halfX / k) * (halfX / k);
+                sum += term;
+                if (term < sum * 1e-8f) break;
+            }
+            return sum;
+        }
+
+        float kaiserWindow(float x, float alpha) {
+            if (std::fabs(x) >= 1.0f) return 0.0f;
+            return besselI0(alpha * std::sqrt(1.0f - x * x)) / besselI0(alpha);
+        }
+
+        int resolveIndex(int index, int size, bool wrap) {
+            if (wrap) {
+                index %= size;
+                return index < 0 ? index + size : index;
+            }
+            return std::min(std::max(index, 0), size - 1);
+        }
+
+        FilterTable buildFilterTable(int srcSize, int dstSize, const MipmapOptions& options, bool wrap) {
+            FilterTable table;
+            table.begin.reserve(dstSize + 1);
+            const float scale = static_cast<float>(srcSize) / dstSize;
+
+            for (int i = 0; i < dstSize; ++i) {
+                table.begin.push_back(table.taps.size());
+                const float start = i * scale;
+                const float end = start + scale;
+                float total = 0.0f;
+
+                if (options.filter == MipFilter::Box || srcSize == dstSize) {
+                    // 源像素与目标像素覆盖区间的重叠长度作为权重
+                    for (int s = static_cast<int>(std::floor(start)); s < static_cast<int>(std::ceil(end)); ++s) {
+                        float overlap = std::min(end, s + 1.0f) - std::max(start, static_cast<float>(s));
+                        if (overlap <= 0.0f) continue;
+                        table.taps.push_back({resolveIndex(s, srcSize, wrap), overlap});
+                        total += overlap;
+                    }
+                } else {
+                    const float center = (start + end) * 0.5f;
+                    const float radius = options.kaiserWidth * scale;
+                    int first = static_cast<int>(std::floor(center - radius));
+                    int last = static_cast<int>(std::ceil(center + radius));
+                    for (int s = first; s <= last; ++s) {
+                        float t = (s + 0.5f - center) / scale;  // 以目标像素为单位的距离
+                        float weight = sinc(t) * kaiserWindow(t / options.kaiserWidth, options.kaiserAlpha);
+                        if (weight == 0.0f) continue;
+                        table.taps.push_back({resolveIndex(s, srcSize, wrap), weight});
+                        total += weight;
+                    }
+                }
+
+                // 归一化，保证平坦区域亮度不变
+                for (size_t k = table.begin.back(); k < table.taps.size(); ++k) {
+                    table.taps[k].weight /= total;
+                }
+            }
+            table.begin.push_back(table.taps.size());
+            return table;
+        }
+
+        float srgbToLinear(float c) {
+            return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+
+        float linearToSrgb(float c) {
+            c = std::min(std::max(c, 0.0f), 1.0f);
+            return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        }
+
+        // 线性值到 sRGB 8 位值的查找表，按 1/65535 的步长量化，暗部误差远小于 1 个色阶
+        const std::vector<uint8_t>& getLinearToSrgbTable() {
+            static const std::vector<uint8_t> table = []() {
+                std::vector<uint8_t> values(65536);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    values[i] = static_cast<uint8_t>(linearToSrgb(i / 65535.0f) * 255.0f + 0.5f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        // 源数据转为浮点工作数据（sRGB 通道转到线性空间）
+        void decodeLevel(const void* data, size_t pixelCount, int channels, TextureFormat format,
+                         bool srgb, std::vector<float>& out) {
+            const size_t count = pixelCount * channels;
+            out.resize(count);
+            if (isFloatTextureFormat(format)) {
+                std::memcpy(out.data(), data, count * sizeof(float));
+                return;
+            }
+
+            // 每个通道一张查找表，Alpha 等非颜色通道保持线性
+            float tables[4][256];
+            for (int c = 0; c < channels; ++c) {
+                for (int i = 0; i < 256; ++i) {
+                    tables[c][i] = (srgb && c < 3) ? srgbToLinear(i / 255.0f) : i / 255.0f;
+                }
+            }
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t p = 0; p < pixelCount; ++p) {
+                for (int c = 0; c < channels; ++c) {
+                    out[p * channels + c] = tables[c][bytes[p * channels + c]];
+                }
+            }
+        }
+
+        void encodeLevel(const std::vector<float>& in, int channels, TextureFormat format, bool srgb, uint8_t* out) {
+            if (isFloatTextureFormat(format)) {
+                std::memcpy(out, in.data(), in.size() * sizeof(float));
+                return;
+            }
+            const std::vector<uint8_t>& srgbTable = getLinearToSrgbTable();
+            const size_t pixelCount = in.size() / channels;
+            for (size_t p = 0; p < pixelCount; ++p) {
+                for (int c = 0; c < channels; ++c) {
+                    float value = std::min(std::max(in[p * channels + c], 0.0f), 1.0f);
+                    out[p * channels + c] = (srgb && c < 3)
+                        ? srgbTable[static_cast<size_t>(value * 65535.0f + 0.5f)]
+                        : static_cast<uint8_t>(value * 255.0f + 0.5f);
+                }
+            }
+        }
+
+        void renormalize(std::vector<float>& level, int channels, bool unsignedEncoding) {
+            if (channels < 3) return;
+            for (size_t i = 0; i + channels <= level.size(); i += channels) {
+                float n[3];
+                for (int c = 0; c < 3; ++c) {
+                    n[c] = unsignedEncoding ? level[i + c] * 2.0f - 1.0f : level[i + c];
+                }
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length < 1e-6f) {
+                    n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f;
+                    length = 1.0f;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    float v = n[c] / length;
+                    level[i + c] = unsignedEncoding ? v * 0.5f + 0.5f : v;
+                }
+            }
+        }
+    }
+
+    int MipmapGenerator::getMipLevelCount(int width, int height) {
+        int levels = 1;
+        int size = std::max(width, height);
+        while (size > 1) {
+            size >>= 1;
+            levels++;
+        }
+        return levels;
+    }
+
+    bool MipmapGenerator::generate(const void* level0, int width, int height, TextureFormat format,
+                                   const MipmapOptions& options,
+                                   std::vector<uint8_t>& outData, std::vector<MipLevel>& outLevels) {
+        outData.clear();
+        outLevels.clear();
+        if (!level0 || width <= 0 || height <= 0) {
+            std::cerr << "MipmapGenerator: invalid source image" << std::endl;
+            return false;
+        }
+
+        const int channels = getTextureFormatChannels(format);
+        const size_t pixelBytes = getTextureFormatDataBytesPerPixel(format);
+        const bool srgb = options.srgb || format == TextureFormat::SRGB8_ALPHA8;
+        const bool floatData = isFloatTextureFormat(format);
+        // 每个线程至少处理约 64K 个浮点乘加
+        const size_t minWork = 64 * 1024;
+
+        // 预先计算各级尺寸和偏移，一次性分配输出缓冲区
+        size_t totalBytes = 0;
+        for (int w = width, h = height; w > 1 || h > 1;) {
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+            MipLevel level;
+            level.width = w;
+            level.height = h;
+            level.offset = totalBytes;
+            level.size = static_cast<size_t>(w) * h * pixelBytes;
+            totalBytes += level.size;
+            outLevels.push_back(level);
+        }
+        outData.resize(totalBytes);
+
+        std::vector<float> source;
+        std::vector<float> temp;
+        std::vector<float> target;
+        decodeLevel(level0, static_cast<size_t>(width) * height, channels, format, srgb, source);
+
+        int srcWidth = width;
+        int srcHeight = height;
+        for (const MipLevel& level : outLevels) {
+            const int dstWidth = level.width;
+            const int dstHeight = level.height;
+            const FilterTable columns = buildFilterTable(srcWidth, dstWidth, options, options.wrapU);
+            const FilterTable rows = buildFilterTable(srcHeight, dstHeight, options, options.wrapV);
+
+            // 水平：srcWidth x srcHeight -> dstWidth x srcHeight
+            temp.assign(static_cast<size_t>(dstWidth) * srcHeight * channels, 0.0f);
+            const size_t rowWork = std::max<size_t>(1, static_cast<size_t>(dstWidth) * channels * 4);
+            parallelFor(options.jobSystem, srcHeight, minWork / rowWork + 1, [&](int begin, int end) {
+                for (int y = begin; y < end; ++y) {
+                    const float* srcRow = source.data() + static_cast<size_t>(y) * srcWidth * channels;
+                    float* dstRow = temp.data() + static_cast<size_t>(y) * dstWidth * channels;
+                    for (int x = 0; x < dstWidth; ++x) {
+                        float* dst = dstRow + static_cast<size_t>(x) * channels;
+                        for (size_t k = columns.begin[x]; k < columns.begin[x + 1]; ++k) {
+                            const float* src = srcRow + static_cast<size_t>(columns.taps[k].source) * channels;
+                            const float weight = columns.taps[k].weight;
+                            for (int c = 0; c < channels; ++c) {
+                                dst[c] += src[c] * weight;
+                            }
+                        }
+                    }
+                }
+            });
+
+            // 垂直：整行乘加 dstWidth x srcHeight -> dstWidth x dstHeight
+            const size_t rowLength = static_cast<size_t>(dstWidth) * channels;
+            target.assign(rowLength * dstHeight, 0.0f);
+            parallelFor(options.jobSystem, dstHeight, minWork / (rowLength * 4) + 1, [&](int begin, int end) {
+                for (int y = begin; y < end; ++y) {
+                    float* dstRow = target.data() + static_cast<size_t>(y) * rowLength;
+                    for (size_t k = rows.begin[y]; k < rows.begin[y + 1]; ++k) {
+                        const float* srcRow = temp.data() + static_cast<size_t>(rows.taps[k].source) * rowLength;
+                        const float weight = rows.taps[k].weight;
+                        for (size_t i = 0; i < rowLength; ++i) {
+                            dstRow[i] += srcRow[i] * weight;
+                        }
+                    }
+                }
+            });
+
+            if (options.normalMap) {
+                renormalize(target, channels, !floatData);
+            }
+
+            encodeLevel(target, channels, format, srgb, outData.data() + level.offset);
+
+            source.swap(target);
+            srcWidth = dstWidth;
+            srcHeight = dstHeight;
+        }
+
+        return true;
+    }
+
+} // namespace iengine
@@ -0,0 +1,234 @@
+#include "iengine/textures/StreamingTexture.h"
+#include "iengine/textures/TextureUtils.h"
+#include "iengine/renderers/Context.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace iengine {
+
+    static TextureOptions makeTextureOptions(const StreamingTextureOptions& options) {
+        TextureOptions textureOptions;
+        textureOptions.name = options.name;
+        textureOptions.wrapS = options.wrapS;
+        textureOptions.wrapT = options.wrapT;
+        textureOptions.minFilter = options.minFilter;
+        textureOptions.magFilter = options.magFilter;
+        textureOptions.format = options.format;
+        textureOptions.autoFormat = false;
+        return textureOptions;
+    }
+
+    StreamingTexture::StreamingTexture(const StreamingTextureOptions& options)
+        : Texture(makeTextureOptions(options)) {
+        TextureFormat format = options.format;
+        if (isCompressedTextureFormat(format)) {
+            std::cerr << "StreamingTexture " << options.name << ": block compressed formats cannot be streamed, using RGBA8"
+                      << std::endl;
+            format = TextureFormat::RGBA8;
+        }
+
+        // 内容只在 GPU 上，释放基类的默认图像数据
+        width_ = std::max(options.width, 1);
+        height_ = std::max(options.height, 1);
+        format_ = format;
+        channels_ = getTextureFormatChannels(format);
+        imageData_.reset();
+        mipData_.clear();
+        mipLevels_.clear();
+
+        pixelBytes_ = getTextureFormatDataBytesPerPixel(format);
+        frameBytes_ = static_cast<size_t>(width_) * height_ * pixelBytes_;
+        slots_.resize(static_cast<size_t>(std::max(options.bufferCount, 2)));
+        for (auto& slot : slots_) {
+            slot.cpuData.resize(frameBytes_);
+            slot.data = slot.cpuData.data();
+        }
+    }
+
+    StreamingTexture::~StreamingTexture() {
+        auto context = context_.lock();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& slot : slots_) {
+            if (!context) break;
+            context->deleteFence(slot.fence);
+            if (slot.buffer) {
+                context->deleteBuffer(slot.buffer);
+            }
+        }
+    }
+
+    uint8_t* StreamingTexture::beginWrite(int x, int y, int width, int height) {
+        if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > width_ || y + height > height_) {
+            std::cerr << "StreamingTexture " << name_ << ": write region out of bounds" << std::endl;
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (writingSlot_ >= 0) {
+            std::cerr << "StreamingTexture " << name_ << ": previous write not finished" << std::endl;
+            return nullptr;
+        }
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            Slot& slot = slots_[i];
+            if (slot.state != SlotState::Free) continue;
+            slot.state = SlotState::Writing;
+            slot.x = x;
+            slot.y = y;
+            slot.width = width;
+            slot.height = height;
+            writingSlot_ = static_cast<int>(i);
+            return slot.data;
+        }
+        // GPU 还在读取全部缓冲区，丢弃本次更新
+        ++stats_.droppedWrites;
+        return nullptr;
+    }
+
+    void StreamingTexture::endWrite(bool commit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (writingSlot_ < 0) return;
+
+        Slot& slot = slots_[writingSlot_];
+        if (commit) {
+            slot.state = SlotState::Ready;
+            slot.sequence = ++sequence_;
+            ++stats_.framesWritten;
+        } else {
+            slot.state = SlotState::Free;
+        }
+        writingSlot_ = -1;
+    }
+
+    bool StreamingTexture::write(const void* data) {
+        return write(data, 0, 0, width_, height_);
+    }
+
+    bool StreamingTexture::write(const void* data, int x, int y, int width, int height) {
+        if (!data) return false;
+        uint8_t* dst = beginWrite(x, y, width, height);
+        if (!dst) return false;
+        std::memcpy(dst, data, static_cast<size_t>(width) * height * pixelBytes_);
+        endWrite(true);
+        return true;
+    }
+
+    bool StreamingTexture::needsUpdate() const {
+        if (needsUpdate_) return true;
+        // 有待上传的更新，或需要回收 GPU 正在读取的缓冲区
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::any_of(slots_.begin(), slots_.end(), [](const Slot& slot) {
+            return slot.state == SlotState::Ready || slot.state == SlotState::InFlight;
+        });
+    }
+
+    void StreamingTexture::useBufferStorage(Slot& slot) {
+        if (slot.mapped && slot.data != slot.mapped) {
+            slot.data = slot.mapped;
+            slot.cpuData.clear();
+            slot.cpuData.shrink_to_fit();
+        }
+    }
+
+    void StreamingTexture::createBuffers(Context& context) {
+        buffersCreated_ = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& slot : slots_) {
+            void* mapped = nullptr;
+            BufferHandle buffer = context.createPixelUploadBuffer(frameBytes_, &mapped);
+            if (!buffer) {
+                // 不支持持久映射：全部缓冲区保持在客户端内存
+                for (auto& created : slots_) {
+                    if (created.buffer) context.deleteBuffer(created.buffer);
+                    created.buffer = BufferHandle{};
+                    created.mapped = nullptr;
+                }
+                std::cout << "StreamingTexture " << name_ << ": persistent pixel buffers unavailable, uploading from client memory"
+                          << std::endl;
+                return;
+            }
+            slot.buffer = buffer;
+            slot.mapped = static_cast<uint8_t*>(mapped);
+            // 正在写入或等待上传的缓冲区在回到空闲后再切换存储
+            if (slot.state == SlotState::Free) {
+                useBufferStorage(slot);
+            }
+        }
+        stats_.persistent = true;
+    }
+
+    void StreamingTexture::upload(std::shared_ptr<Context> context, bool force) {
+        // 1. 创建 GPU 纹理（内容由后续更新写入）
+        if (!gpuTexture_ || force) {
+            if (gpuTexture_) {
+                context->deleteTexture(gpuTexture_);
+            }
+            gpuTexture_ = context->createTexture(width_, height_, nullptr, format_);
+            context_ = context;
+            gpuTextureWidth_ = width_;
+            gpuTextureHeight_ = height_;
+            gpuTextureFormat_ = format_;
+            context->setTextureSampler(gpuTexture_, getSamplerDesc());
+        }
+        if (!buffersCreated_) {
+            createBuffers(*context);
+        }
+
+        // 2. 回收 GPU 已读完的缓冲区，取出按提交顺序排列的待上传更新
+        std::vector<Slot*> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& slot : slots_) {
+                if (slot.state == SlotState::InFlight && context->isFenceSignaled(slot.fence)) {
+                    context->deleteFence(slot.fence);
+                    slot.fence = nullptr;
+                    slot.state = SlotState::Free;
+                    useBufferStorage(slot);
+                } else if (slot.state == SlotState::Ready) {
+                    ready.push_back(&slot);
+                }
+            }
+        }
+        std::sort(ready.begin(), ready.end(), [](const Slot* a, const Slot* b) { return a->sequence < b->sequence; });
+
+        // 3. 上传：Ready 状态的缓冲区生产者不会再访问，无需持锁
+        uint64_t bufferUploads = 0;
+        uint64_t directUploads = 0;
+        uint64_t bytes = 0;
+        for (Slot* slot : ready) {
+            if (slot->buffer && slot->data == slot->mapped) {
+                context->writeTextureRegionFromBuffer(gpuTexture_, slot->x, slot->y, slot->width, slot->height,
+                                                      slot->buffer, 0);
+                slot->fence = context->createFence();
+                ++bufferUploads;
+            } else {
+                context->writeTextureRegion(gpuTexture_, slot->x, slot->y, slot->width, slot->height, slot->data);
+                ++directUploads;
+            }
+            bytes += static_cast<uint64_t>(slot->width) * slot->height * pixelBytes_;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Slot* slot : ready) {
+                // 客户端内存已由驱动拷贝，可立即重用
+                slot->state = slot->fence ? SlotState::InFlight : SlotState::Free;
+                if (slot->state == SlotState::Free) {
+                    useBufferStorage(*slot);
+                }
+            }
+            stats_.framesUploaded += ready.size();
+            stats_.bufferUploads += bufferUploads;
+            stats_.directUploads += directUploads;
+            stats_.bytesUploaded += bytes;
+        }
+        needsUpdate_ = false;
+    }
+
+    StreamingTextureStats StreamingTexture::getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+} // namespace iengine
@@ -1,9 +1,11 @@
 #include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureUtils.h"
 #include "iengine/renderers/Context.h"
 #include <iostream>
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <algorithm>
 
 // STB Image 库用于加载图像（实现已在 def.cpp 中定义）
 #include <stb_image.h>
@@ -11,7 +13,7 @@
 namespace iengine {
 
     // 默认2x2 RGBA 棋盘格数据
-    uint8_t Texture::defaultImageData_[16] = {
+    const uint8_t Texture::defaultImageData_[16] = {
         255, 255, 255, 255,   192, 192, 192, 255,
         192, 192, 192, 255,   255, 255, 255, 255
     };
@@ -21,15 +23,31 @@ namespace iengine {
           width_(DEFAULT_WIDTH),
           height_(DEFAULT_HEIGHT),
           unit_(0),
-          gpuTexture_(nullptr),
+          gpuTexture_(),
           gpuTextureWidth_(0),
           gpuTextureHeight_(0),
+          gpuTextureFormat_(TextureFormat::RGBA8),
           wrapS_(options.wrapS),
           wrapT_(options.wrapT),
           minFilter_(options.minFilter),
           magFilter_(options.magFilter),
           needsUpdate_(true),
-          channels_(4) { // RGBA
+          loadState_(TextureLoadState::Default),
+          sourcePath_(options.sourcePath),
+          lastUsedFrame_(0),
+          droppedMips_(0),
+          format_(TextureFormat::RGBA8),
+          requestedFormat_(options.format),
+          autoFormat_(options.autoFormat),
+          srgb_(options.srgb),
+          mipmapMode_(options.mipmaps),
+          mipFilter_(options.mipFilter),
+          normalMap_(options.normalMap),
+          compress_(options.compress),
+          compressionQuality_(options.compressionQuality),
+          compressionPsnr_(0.0),
+          channels_(4), // RGBA
+          dataVersion_(0) {
         
         // 初始化为默认图像数据
         setImageData(defaultImageData_, DEFAULT_WIDTH, DEFAULT_HEIGHT, 4);
@@ -40,9 +58,13 @@ namespace iengine {
     }
 
     Texture::~Texture() {
-        // 在实际实现中，需要释放GPU纹理资源
-        // 这里简化处理
-        gpuTexture_ = nullptr;
+        // GPU 纹理进入上下文的延迟删除队列；上下文已销毁时纹理已随之释放
+        if (auto context = context_.lock()) {
+            if (gpuTexture_) {
+                context->deleteTexture(gpuTexture_);
+            }
+        }
+        gpuTexture_ = TextureHandle{};
     }
 
     const std::string& Texture::getName() const {
@@ -101,12 +123,93 @@ namespace iengine {
         needsUpdate_ = true;
     }
 
-    void* Texture::getGpuTexture() const {
+    TextureHandle Texture::getGpuTexture() const {
         return gpuTexture_;
     }
 
+    size_t Texture::getGpuByteSize() const {
+        int width = width_;
+        int height = height_;
+        if (droppedMips_ > 0 && droppedMips_ <= static_cast<int>(mipLevels_.size())) {
+            width = mipLevels_[droppedMips_ - 1].width;
+            height = mipLevels_[droppedMips_ - 1].height;
+        }
+        size_t bytes = getTextureLevelSize(format_, width, height);
+        // 完整 Mip 链约为第 0 级的 1/3
+        return usesMipmaps() ? bytes + bytes / 3 : bytes;
+    }
+
+    size_t Texture::getResidentByteSize() const {
+        if (!gpuTexture_) {
+            return 0;
+        }
+        size_t bytes = getTextureLevelSize(gpuTextureFormat_, gpuTextureWidth_, gpuTextureHeight_);
+        return usesMipmaps() ? bytes + bytes / 3 : bytes;
+    }
+
+    bool Texture::setDroppedMips(int count) {
+        count = std::max(count, 0);
+        if (count == droppedMips_) {
+            return true;
+        }
+        if (count > static_cast<int>(mipLevels_.size())) {
+            // 丢弃的级别由 CPU Mip 链代替第 0 级，GPU 生成 Mip 的纹理在这里补全 CPU Mip 链
+            if (!usesMipmaps() || !mipLevels_.empty() || !imageData_ || isCompressedTextureFormat(format_)) {
+                return false;
+            }
+            MipmapOptions options;
+            options.filter = mipFilter_;
+            options.normalMap = normalMap_;
+            options.wrapU = wrapS_ == TextureWrapMode::Repeat;
+            options.wrapV = wrapT_ == TextureWrapMode::Repeat;
+            if (!MipmapGenerator::generate(imageData_.get(), width_, height_, format_, options, mipData_, mipLevels_) ||
+                count > static_cast<int>(mipLevels_.size())) {
+                return false;
+            }
+        }
+        droppedMips_ = count;
+        needsUpdate_ = true;
+        return true;
+    }
+
+    void Texture::evict(bool releaseCpuData) {
+        if (auto context = context_.lock()) {
+            if (gpuTexture_) {
+                context->deleteTexture(gpuTexture_);
+            }
+        }
+        gpuTexture_ = TextureHandle{};
+        gpuTextureWidth_ = 0;
+        gpuTextureHeight_ = 0;
+        needsUpdate_ = true;
+        
+        // 只有能从源文件恢复的数据才释放
+        if (releaseCpuData && !sourcePath_.empty() && loadState_ == TextureLoadState::Ready) {
+            imageData_.reset();
+            mipData_.clear();
+            mipData_.shrink_to_fit();
+            mipLevels_.clear();
+            loadState_ = TextureLoadState::Unloaded;
+        }
+    }
+
+    bool Texture::reloadFromSource() {
+        if (sourcePath_.empty()) {
+            return false;
+        }
+        int droppedMips = droppedMips_;
+        loadFromFile(sourcePath_);
+        // 保持驱逐前丢弃的 Mip 数，避免重新加载后立刻超出预算
+        setDroppedMips(droppedMips);
+        return loadState_ == TextureLoadState::Ready;
+    }
+
+    bool Texture::usesMipmaps() const {
+        return minFilter_ != TextureMinFilter::Nearest && minFilter_ != TextureMinFilter::Linear;
+    }
+
     bool Texture::needsUpdate() const {
-        return needsUpdate_;
+        return needsUpdate_ && loadState_ != TextureLoadState::Loading && loadState_ != TextureLoadState::Unloaded;
     }
 
     void Texture::markUpdated() {
@@ -114,27 +217,56 @@ namespace iengine {
     }
 
     void Texture::upload(std::shared_ptr<Context> context, bool force) {
-        std::cout << "Uploading texture: " << name_ << " (" << width_ << "x" << height_ << ")" << std::endl;
+        if (!imageData_) {
+            // CPU 副本已被驱逐，等待重新加载
+            return;
+        }
+        
+        // 丢弃顶层 Mip 时，以 CPU Mip 链的第 baseLevel 级作为 GPU 纹理的第 0 级
+        int baseLevel = std::min(droppedMips_, static_cast<int>(mipLevels_.size()));
+        int width = baseLevel > 0 ? mipLevels_[baseLevel - 1].width : width_;
+        int height = baseLevel > 0 ? mipLevels_[baseLevel - 1].height : height_;
+        const uint8_t* baseData = baseLevel > 0 ? mipData_.data() + mipLevels_[baseLevel - 1].offset : imageData_.get();
+        
+        std::cout << "Uploading texture: " << name_ << " (" << width << "x" << height << ")" << std::endl;
         
-        // 1. 判断是否需要重新创建GPU纹理
+        // 1. 判断是否需要重新创建GPU纹理（尺寸或格式变化时），创建时同时写入第 0 级
+        bool created = false;
         if (!gpuTexture_ || force || 
-            (gpuTextureWidth_ != width_ || gpuTextureHeight_ != height_)) {
+            (gpuTextureWidth_ != width || gpuTextureHeight_ != height || gpuTextureFormat_ != format_)) {
             
             // 清理旧纹理
             if (gpuTexture_) {
                 context->deleteTexture(gpuTexture_);
-                gpuTexture_ = nullptr;
+                gpuTexture_ = TextureHandle{};
             }
             
             // 创建GPU纹理
-            gpuTexture_ = context->createTexture(width_, height_, imageData_.get());
-            gpuTextureWidth_ = width_;
-            gpuTextureHeight_ = height_;
+            gpuTexture_ = context->createTexture(width, height, baseData, format_);
+            context_ = context;
+            gpuTextureWidth_ = width;
+            gpuTextureHeight_ = height;
+            gpuTextureFormat_ = format_;
+            created = true;
         }
         
-        // 2. 上传数据
-        if (needsUpdate_ && gpuTexture_) {
-            context->writeTexture(gpuTexture_, imageData_.get(), width_, height_);
+        // 2. 上传数据和 Mip 链，应用采样参数
+        if ((needsUpdate_ || created) && gpuTexture_) {
+            if (!created) {
+                context->writeTexture(gpuTexture_, baseData, width, height);
+            }
+            if (usesMipmaps()) {
+                if (!mipLevels_.empty()) {
+                    for (size_t i = baseLevel; i < mipLevels_.size(); ++i) {
+                        const MipLevel& level = mipLevels_[i];
+                        context->writeTextureLevel(gpuTexture_, static_cast<int>(i + 1) - baseLevel, mipData_.data() + level.offset,
+                                                   level.width, level.height);
+                    }
+                } else {
+                    context->generateMipmaps(gpuTexture_);
+                }
+            }
+            context->setTextureSampler(gpuTexture_, getSamplerDesc());
             needsUpdate_ = false;
         }
         
@@ -152,26 +284,143 @@ namespace iengine {
         needsUpdate_ = false;
     }
 
-    void Texture::loadFromFile(const std::string& filePath) {
-        std::cout << "Loading texture from file: " << filePath << std::endl;
-        
-        // 使用 STB Image 加载图像
-        int width, height, channels;
-        
+    bool Texture::decodeImage(const std::string& filePath, DecodedImage& outImage, int desiredChannels) {
         // stbi_set_flip_vertically_on_load(true); // OpenGL 纹理坐标原点在左下角
         
-        unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
+        int sourceChannels = 0;
+        void* data = nullptr;
+        outImage.hdr = stbi_is_hdr(filePath.c_str()) != 0;
+        if (outImage.hdr) {
+            // HDR 图只有单通道或三通道，三通道扩展为 4 通道以使用 RGBA16F
+            if (desiredChannels == 0) {
+                int width, height;
+                stbi_info(filePath.c_str(), &width, &height, &sourceChannels);
+                desiredChannels = sourceChannels == 1 ? 1 : 4;
+            }
+            data = stbi_loadf(filePath.c_str(), &outImage.width, &outImage.height, &sourceChannels, desiredChannels);
+        } else {
+            // 通道转换在解码过程中完成
+            data = stbi_load(filePath.c_str(), &outImage.width, &outImage.height, &sourceChannels, desiredChannels);
+        }
         
         if (!data) {
             std::cerr << "Failed to load texture: " << filePath << std::endl;
             std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
-            
+            return false;
+        }
+        
+        // 直接接管解码器分配的内存
+        outImage.channels = desiredChannels != 0 ? desiredChannels : sourceChannels;
+        outImage.data = ImageBuffer(static_cast<uint8_t*>(data), ImageDataDeleter{stbi_image_free});
+        return true;
+    }
+
+    TextureImportSettings Texture::getImportSettings() const {
+        TextureImportSettings settings;
+        settings.autoFormat = autoFormat_;
+        settings.requestedFormat = requestedFormat_;
+        settings.srgb = srgb_;
+        // 指定格式时按格式通道数解码；sRGB 只有 4 通道格式；其余保持源图通道数
+        settings.decodeChannels = !autoFormat_ ? getTextureFormatChannels(requestedFormat_) : (srgb_ ? 4 : 0);
+        // 压缩格式无法由 GPU 生成 Mip，压缩时总是在 CPU 上生成
+        settings.generateMipmaps = usesMipmaps() && (mipmapMode_ == MipmapMode::Cpu || compress_);
+        settings.mipmap.filter = mipFilter_;
+        settings.mipmap.normalMap = normalMap_;
+        settings.mipmap.wrapU = wrapS_ == TextureWrapMode::Repeat;
+        settings.mipmap.wrapV = wrapT_ == TextureWrapMode::Repeat;
+        settings.compress = compress_;
+        settings.compression.quality = compressionQuality_;
+        return settings;
+    }
+
+    bool Texture::importImage(const std::string& filePath, const TextureImportSettings& settings, DecodedImage& outImage) {
+        if (!decodeImage(filePath, outImage, settings.decodeChannels)) {
+            return false;
+        }
+        
+        outImage.format = chooseTextureFormat(outImage.channels, outImage.hdr, settings.srgb);
+        if (!settings.autoFormat) {
+            // 指定格式与源数据类型（8 位/浮点）不一致时按导入规则选择
+            if (isFloatTextureFormat(settings.requestedFormat) == outImage.hdr &&
+                getTextureFormatChannels(settings.requestedFormat) == outImage.channels) {
+                outImage.format = settings.requestedFormat;
+            } else {
+                std::cerr << "Texture " << filePath << ": requested format does not match source data, using "
+                          << outImage.channels << " channel " << (outImage.hdr ? "float" : "8-bit") << " format" << std::endl;
+            }
+        }
+        
+        if (settings.generateMipmaps) {
+            MipmapGenerator::generate(outImage.data.get(), outImage.width, outImage.height, outImage.format,
+                                      settings.mipmap, outImage.mipData, outImage.mipLevels);
+        }
+        
+        if (settings.compress) {
+            compressImage(filePath, settings, outImage);
+        }
+        return true;
+    }
+
+    void Texture::compressImage(const std::string& filePath, const TextureImportSettings& settings, DecodedImage& image) {
+        TextureFormat target = TextureCompressor::chooseCompressedFormat(
+            image.data.get(), image.width, image.height, image.format, settings.mipmap.normalMap, settings.compression.quality);
+        if (!isCompressedTextureFormat(target)) {
+            std::cerr << "Texture " << filePath << ": format cannot be block compressed, keeping uncompressed data" << std::endl;
+            return;
+        }
+        
+        // 第 0 级
+        ImageBuffer level0(new uint8_t[getTextureLevelDataSize(target, image.width, image.height)]);
+        double psnr = 0.0;
+        if (!TextureCompressor::compress(image.data.get(), image.width, image.height, image.format, target,
+                                         settings.compression, level0.get(), &psnr)) {
+            return;
+        }
+        
+        // 各 Mip 级别逐级压缩，重新计算偏移
+        std::vector<uint8_t> mipData;
+        std::vector<MipLevel> mipLevels = image.mipLevels;
+        size_t offset = 0;
+        for (MipLevel& level : mipLevels) {
+            level.offset = offset;
+            level.size = getTextureLevelDataSize(target, level.width, level.height);
+            offset += level.size;
+        }
+        mipData.resize(offset);
+        for (size_t i = 0; i < mipLevels.size(); ++i) {
+            TextureCompressor::compress(image.mipData.data() + image.mipLevels[i].offset, mipLevels[i].width,
+                                        mipLevels[i].height, image.format, target, settings.compression,
+                                        mipData.data() + mipLevels[i].offset);
+        }
+        
+        std::cout << "Texture " << filePath << " block compressed (format " << static_cast<int>(target)
+                  << "), PSNR " << psnr << " dB" << std::endl;
+        image.data = std::move(level0);
+        image.format = target;
+        image.mipData = std::move(mipData);
+        image.mipLevels = std::move(mipLevels);
+        image.compressionPsnr = psnr;
+    }
+
+    void Texture::setDecodedImage(DecodedImage image) {
+        setImageData(std::move(image.data), image.width, image.height, image.format);
+        compressionPsnr_ = image.compressionPsnr;
+        mipData_ = std::move(image.mipData);
+        mipLevels_ = std::move(image.mipLevels);
+    }
+
+    void Texture::loadFromFile(const std::string& filePath) {
+        std::cout << "Loading texture from file: " << filePath << std::endl;
+        
+        DecodedImage image;
+        if (!importImage(filePath, getImportSettings(), image)) {
             // 加载失败，使用默认棋盘格纹理
             width_ = 256;
             height_ = 256;
             channels_ = 4; // RGBA
+            format_ = TextureFormat::RGBA8;
             size_t dataSize = width_ * height_ * channels_;
-            imageData_ = std::make_unique<uint8_t[]>(dataSize);
+            imageData_ = ImageBuffer(new uint8_t[dataSize]);
             
             // 生成棋盘格图案
             for (int y = 0; y < height_; ++y) {
@@ -186,52 +435,44 @@ namespace iengine {
                 }
             }
             
+            loadState_ = TextureLoadState::Failed;
             needsUpdate_ = true;
             return;
         }
         
         // 加载成功
-        std::cout << "Texture loaded successfully: " << width << "x" << height << " with " << channels << " channels" << std::endl;
-        
-        width_ = width;
-        height_ = height;
-        channels_ = channels;
-        
-        // 如果是 RGB 图像，转换为 RGBA
-        if (channels_ == 3) {
-            std::cout << "Converting RGB to RGBA" << std::endl;
-            size_t rgbaSize = width_ * height_ * 4;
-            imageData_ = std::make_unique<uint8_t[]>(rgbaSize);
-            
-            for (int i = 0; i < width_ * height_; ++i) {
-                imageData_[i * 4 + 0] = data[i * 3 + 0]; // R
-                imageData_[i * 4 + 1] = data[i * 3 + 1]; // G
-                imageData_[i * 4 + 2] = data[i * 3 + 2]; // B
-                imageData_[i * 4 + 3] = 255;             // A
-            }
-            channels_ = 4;
-        } else {
-            // 直接拷贝数据
-            size_t dataSize = width_ * height_ * channels_;
-            imageData_ = std::make_unique<uint8_t[]>(dataSize);
+        std::cout << "Texture loaded successfully: " << image.width << "x" << image.height
+                  << " with " << image.channels << " channels" << std::endl;
+        setDecodedImage(std::move(image));
+        loadState_ = TextureLoadState::Ready;
+    }
+    
+    void Texture::setImageData(const uint8_t* data, int width, int height, int channels) {
+        TextureFormat format = chooseTextureFormat(channels, false, false);
+        size_t dataSize = static_cast<size_t>(width) * height * getTextureFormatDataBytesPerPixel(format);
+        // 尺寸和格式不变时复用已有缓冲区（每帧更新的纹理请使用 StreamingTexture）
+        if (imageData_ && !imageData_.get_deleter().release && width == width_ && height == height_ && format == format_) {
             std::memcpy(imageData_.get(), data, dataSize);
+            setImageData(std::move(imageData_), width, height, format);
+            return;
         }
-        
-        // 释放 STB Image 分配的内存
-        stbi_image_free(data);
-        
-        needsUpdate_ = true;
-        std::cout << "Texture data copied to engine buffer" << std::endl;
+        ImageBuffer copy(new uint8_t[dataSize]);
+        std::memcpy(copy.get(), data, dataSize);
+        setImageData(std::move(copy), width, height, format);
     }
     
-    void Texture::setImageData(const uint8_t* data, int width, int height, int channels) {
+    void Texture::setImageData(ImageBuffer data, int width, int height, TextureFormat format) {
         width_ = width;
         height_ = height;
-        channels_ = channels;
+        format_ = format;
+        channels_ = getTextureFormatChannels(format);
+        imageData_ = std::move(data);
+        ++dataVersion_;
         
-        size_t dataSize = width_ * height_ * channels_;
-        imageData_ = std::make_unique<uint8_t[]>(dataSize);
-        std::memcpy(imageData_.get(), data, dataSize);
+        // 新数据没有对应的 CPU Mip 链，上传时改由 GPU 生成；丢弃的 Mip 由驻留管理重新决定
+        mipData_.clear();
+        mipLevels_.clear();
+        droppedMips_ = 0;
         
         needsUpdate_ = true;
     }
@@ -0,0 +1,402 @@
+#include "iengine/textures/TextureArrayAllocator.h"
+#include "iengine/textures/Texture.h"
+#include "iengine/textures/TextureUtils.h"
+#include "iengine/textures/MipmapGenerator.h"
+#include "iengine/renderers/Context.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace iengine {
+
+    namespace {
+        int alignUp(int value, int alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // 边缘像素的源坐标：回绕或夹取
+        int wrapCoordinate(int value, int size, bool repeat) {
+            if (repeat) {
+                value %= size;
+                return value < 0 ? value + size : value;
+            }
+            return std::min(std::max(value, 0), size - 1);
+        }
+    }
+
+    TextureArrayAllocator::TextureArrayAllocator(const TextureArrayOptions& options)
+        : options_(options) {
+    }
+
+    TextureArrayAllocator::~TextureArrayAllocator() {
+        if (auto context = context_.lock()) {
+            for (auto& pool : pools_) {
+                if (pool.array) {
+                    context->deleteTexture(pool.array);
+                }
+            }
+        }
+    }
+
+    bool TextureArrayAllocator::acquire(const std::shared_ptr<Texture>& texture) {
+        if (!texture) {
+            return false;
+        }
+
+        auto it = entries_.find(texture.get());
+        if (it != entries_.end()) {
+            // 旧纹理销毁后地址可能被新纹理复用
+            if (it->second.texture.lock() == texture) {
+                return true;
+            }
+            release(it->second);
+            entries_.erase(it);
+        }
+
+        Entry entry;
+        entry.texture = texture;
+        if (!allocate(*texture, entry)) {
+            return false;
+        }
+        entries_.emplace(texture.get(), entry);
+        return true;
+    }
+
+    bool TextureArrayAllocator::getSlot(const Texture* texture, TextureArraySlot& outSlot) const {
+        auto it = entries_.find(texture);
+        if (it == entries_.end() || !it->second.written || it->second.texture.lock().get() != texture) {
+            return false;
+        }
+        outSlot = it->second.slot;
+        return true;
+    }
+
+    bool TextureArrayAllocator::fitsAtlas(const Texture& texture) const {
+        const int padded = 2 * options_.atlasPadding;
+        return !isCompressedTextureFormat(texture.format_) &&
+               texture.width_ <= options_.maxAtlasTextureSize && texture.height_ <= options_.maxAtlasTextureSize &&
+               texture.width_ + padded <= options_.atlasSize && texture.height_ + padded <= options_.atlasSize;
+    }
+
+    int TextureArrayAllocator::getPoolLevels(const Texture& texture) const {
+        if (!texture.usesMipmaps()) {
+            return 1;
+        }
+        // 压缩纹理只能使用导入时生成的 CPU Mip 链
+        if (isCompressedTextureFormat(texture.format_)) {
+            return 1 + static_cast<int>(texture.mipLevels_.size());
+        }
+        return MipmapGenerator::getMipLevelCount(texture.width_, texture.height_);
+    }
+
+    bool TextureArrayAllocator::allocate(Texture& texture, Entry& entry) {
+        const int width = texture.width_;
+        const int height = texture.height_;
+        if (width <= 0 || height <= 0 || !texture.imageData_) {
+            return false;
+        }
+
+        entry.textureWidth = width;
+        entry.textureHeight = height;
+        entry.format = texture.format_;
+        entry.written = false;
+        // MirroredRepeat 按 Repeat 处理
+        entry.slot = TextureArraySlot{};
+        entry.slot.repeatU = texture.wrapS_ != TextureWrapMode::ClampToEdge;
+        entry.slot.repeatV = texture.wrapT_ != TextureWrapMode::ClampToEdge;
+
+        if (fitsAtlas(texture)) {
+            const int padding = options_.atlasPadding;
+            entry.width = width + 2 * padding;
+            entry.height = height + 2 * padding;
+
+            size_t poolIndex = pools_.size();
+            for (size_t i = 0; i < pools_.size(); ++i) {
+                Pool& pool = pools_[i];
+                if (pool.atlas && pool.format == texture.format_ &&
+                    allocateAtlasRegion(pool, entry.width, entry.height, entry.layer, entry.x, entry.y)) {
+                    poolIndex = i;
+                    break;
+                }
+            }
+            if (poolIndex == pools_.size()) {
+                Pool pool;
+                pool.width = options_.atlasSize;
+                pool.height = options_.atlasSize;
+                pool.levels = std::max(1, std::min(options_.atlasMipLevels,
+                                                   MipmapGenerator::getMipLevelCount(options_.atlasSize, options_.atlasSize)));
+                pool.format = texture.format_;
+                pool.atlas = true;
+                if (!allocateAtlasRegion(pool, entry.width, entry.height, entry.layer, entry.x, entry.y)) {
+                    return false;
+                }
+                pools_.push_back(std::move(pool));
+            }
+
+            entry.pool = poolIndex;
+            const float size = static_cast<float>(options_.atlasSize);
+            entry.slot.uvScale[0] = width / size;
+            entry.slot.uvScale[1] = height / size;
+            entry.slot.uvOffset[0] = (entry.x + padding) / size;
+            entry.slot.uvOffset[1] = (entry.y + padding) / size;
+        } else {
+            const int levels = getPoolLevels(texture);
+            entry.x = 0;
+            entry.y = 0;
+            entry.width = width;
+            entry.height = height;
+
+            // 优先复用空出的层，其次在未满的数组中追加新层
+            bool found = false;
+            for (size_t i = 0; i < pools_.size() && !found; ++i) {
+                Pool& pool = pools_[i];
+                if (pool.atlas || pool.width != width || pool.height != height ||
+                    pool.format != texture.format_ || pool.levels != levels) {
+                    continue;
+                }
+                for (size_t layer = 0; layer < pool.layers.size(); ++layer) {
+                    if (pool.layers[layer].used == 0) {
+                        entry.pool = i;
+                        entry.layer = static_cast<int>(layer);
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found && static_cast<int>(pool.layers.size()) < options_.maxLayersPerArray) {
+                    pool.layers.emplace_back();
+                    entry.pool = i;
+                    entry.layer = static_cast<int>(pool.layers.size()) - 1;
+                    found = true;
+                }
+            }
+            if (!found) {
+                Pool pool;
+                pool.width = width;
+                pool.height = height;
+                pool.levels = levels;
+                pool.format = texture.format_;
+                pool.layers.emplace_back();
+                pools_.push_back(std::move(pool));
+                entry.pool = pools_.size() - 1;
+                entry.layer = 0;
+            }
+        }
+
+        pools_[entry.pool].layers[entry.layer].used++;
+        return true;
+    }
+
+    bool TextureArrayAllocator::allocateAtlasRegion(Pool& pool, int width, int height, int& outLayer, int& outX, int& outY) {
+        // 区域起点按 2^(级数-1) 对齐，保证每一级 Mip 中的区域都落在整数像素上
+        const int alignment = 1 << (pool.levels - 1);
+        const int alignedWidth = alignUp(width, alignment);
+        const int alignedHeight = alignUp(height, alignment);
+        const int size = options_.atlasSize;
+
+        auto placeInLayer = [&](Layer& layer) -> bool {
+            // 选择能放下且高度最接近的货架，避免矮纹理占用高货架
+            Shelf* best = nullptr;
+            for (auto& shelf : layer.shelves) {
+                if (shelf.height >= alignedHeight && shelf.height <= alignedHeight * 2 &&
+                    shelf.x + alignedWidth <= size && (!best || shelf.height < best->height)) {
+                    best = &shelf;
+                }
+            }
+            if (!best && layer.nextY + alignedHeight <= size) {
+                layer.shelves.push_back(Shelf{layer.nextY, alignedHeight, 0});
+                layer.nextY += alignedHeight;
+                best = &layer.shelves.back();
+            }
+            if (!best) {
+                return false;
+            }
+            outX = best->x;
+            outY = best->y;
+            best->x += alignedWidth;
+            return true;
+        };
+
+        for (size_t i = 0; i < pool.layers.size(); ++i) {
+            if (placeInLayer(pool.layers[i])) {
+                outLayer = static_cast<int>(i);
+                return true;
+            }
+        }
+        if (static_cast<int>(pool.layers.size()) >= options_.maxAtlasLayers) {
+            return false;
+        }
+        pool.layers.emplace_back();
+        outLayer = static_cast<int>(pool.layers.size()) - 1;
+        return placeInLayer(pool.layers.back());
+    }
+
+    void TextureArrayAllocator::release(const Entry& entry) {
+        Layer& layer = pools_[entry.pool].layers[entry.layer];
+        layer.used = std::max(0, layer.used - 1);
+        // 图集区域不单独回收，整层空出后重置货架
+        if (layer.used == 0) {
+            layer.shelves.clear();
+            layer.nextY = 0;
+        }
+    }
+
+    void TextureArrayAllocator::update(const std::shared_ptr<Context>& context) {
+        if (!context) {
+            return;
+        }
+        context_ = context;
+
+        // 1. 回收已销毁纹理的位置；尺寸或格式变化的纹理重新分配
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            Entry& entry = it->second;
+            auto texture = entry.texture.lock();
+            if (!texture) {
+                release(entry);
+                it = entries_.erase(it);
+                continue;
+            }
+            if (texture->width_ != entry.textureWidth || texture->height_ != entry.textureHeight ||
+                texture->format_ != entry.format) {
+                release(entry);
+                Entry fresh;
+                fresh.texture = texture;
+                if (!allocate(*texture, fresh)) {
+                    it = entries_.erase(it);
+                    continue;
+                }
+                entry = fresh;
+            }
+            ++it;
+        }
+
+        // 2. 创建或扩容数组：层数翻倍，扩容后数组中的全部纹理重新写入
+        for (size_t i = 0; i < pools_.size(); ++i) {
+            Pool& pool = pools_[i];
+            const int required = static_cast<int>(pool.layers.size());
+            if (pool.arrayLayers >= required) {
+                continue;
+            }
+            const int maxLayers = pool.atlas ? options_.maxAtlasLayers : options_.maxLayersPerArray;
+            const int layers = std::max(required, std::min(pool.arrayLayers * 2, maxLayers));
+            if (pool.array) {
+                context->deleteTexture(pool.array);
+            }
+            pool.array = context->createTextureArray(pool.width, pool.height, layers, pool.levels, pool.format);
+            pool.arrayLayers = pool.array ? layers : 0;
+            for (auto& pair : entries_) {
+                if (pair.second.pool == i) {
+                    pair.second.written = false;
+                }
+            }
+        }
+
+        // 3. 写入新纹理和内容已变化的纹理
+        size_t writes = 0;
+        for (auto& pair : entries_) {
+            Entry& entry = pair.second;
+            auto texture = entry.texture.lock();
+            if (!texture || (entry.written && entry.writtenVersion == texture->dataVersion_)) {
+                continue;
+            }
+            if (writes >= options_.maxWritesPerFrame) {
+                break;
+            }
+            writeEntry(*context, entry, *texture);
+            ++writes;
+        }
+    }
+
+    void TextureArrayAllocator::writeEntry(Context& context, Entry& entry, Texture& texture) {
+        Pool& pool = pools_[entry.pool];
+        if (!pool.array || !texture.imageData_) {
+            return;
+        }
+
+        const int width = texture.width_;
+        const int height = texture.height_;
+        MipmapOptions mipOptions;
+        mipOptions.filter = texture.mipFilter_;
+        mipOptions.normalMap = texture.normalMap_;
+        mipOptions.jobSystem = jobSystem_;
+
+        if (!pool.atlas) {
+            context.writeTextureArrayRegion(pool.array, 0, entry.layer, 0, 0, width, height, texture.imageData_.get());
+            if (pool.levels > 1) {
+                // 优先使用导入时生成的 Mip 链，没有时在这里生成
+                const std::vector<uint8_t>* mipData = &texture.mipData_;
+                const std::vector<MipLevel>* mipLevels = &texture.mipLevels_;
+                std::vector<uint8_t> generatedData;
+                std::vector<MipLevel> generatedLevels;
+                if (static_cast<int>(texture.mipLevels_.size()) + 1 < pool.levels) {
+                    mipOptions.wrapU = entry.slot.repeatU;
+                    mipOptions.wrapV = entry.slot.repeatV;
+                    MipmapGenerator::generate(texture.imageData_.get(), width, height, texture.format_, mipOptions,
+                                              generatedData, generatedLevels);
+                    mipData = &generatedData;
+                    mipLevels = &generatedLevels;
+                }
+                for (int level = 1; level < pool.levels && level <= static_cast<int>(mipLevels->size()); ++level) {
+                    const MipLevel& mip = (*mipLevels)[level - 1];
+                    context.writeTextureArrayRegion(pool.array, level, entry.layer, 0, 0, mip.width, mip.height,
+                                                    mipData->data() + mip.offset);
+                }
+            }
+        } else {
+            // 在纹理四周复制边缘像素
+            const int padding = options_.atlasPadding;
+            const size_t pixelBytes = getTextureFormatDataBytesPerPixel(texture.format_);
+            std::vector<uint8_t> padded(static_cast<size_t>(entry.width) * entry.height * pixelBytes);
+            for (int y = 0; y < entry.height; ++y) {
+                const int sy = wrapCoordinate(y - padding, height, entry.slot.repeatV);
+                for (int x = 0; x < entry.width; ++x) {
+                    const int sx = wrapCoordinate(x - padding, width, entry.slot.repeatU);
+                    std::memcpy(padded.data() + (static_cast<size_t>(y) * entry.width + x) * pixelBytes,
+                                texture.imageData_.get() + (static_cast<size_t>(sy) * width + sx) * pixelBytes,
+                                pixelBytes);
+                }
+            }
+            context.writeTextureArrayRegion(pool.array, 0, entry.layer, entry.x, entry.y,
+                                            entry.width, entry.height, padded.data());
+
+            if (pool.levels > 1) {
+                // 边缘像素已按寻址方式填好，下采样时不再回绕
+                mipOptions.wrapU = false;
+                mipOptions.wrapV = false;
+                std::vector<uint8_t> mipData;
+                std::vector<MipLevel> mipLevels;
+                MipmapGenerator::generate(padded.data(), entry.width, entry.height, texture.format_, mipOptions,
+                                          mipData, mipLevels);
+                for (int level = 1; level < pool.levels && level <= static_cast<int>(mipLevels.size()); ++level) {
+                    const MipLevel& mip = mipLevels[level - 1];
+                    context.writeTextureArrayRegion(pool.array, level, entry.layer, entry.x >> level, entry.y >> level,
+                                                    mip.width, mip.height, mipData.data() + mip.offset);
+                }
+            }
+        }
+
+        entry.slot.array = pool.array;
+        entry.slot.layer = entry.layer;
+        entry.writtenVersion = texture.dataVersion_;
+        entry.written = true;
+    }
+
+    size_t TextureArrayAllocator::getArrayCount() const {
+        return static_cast<size_t>(std::count_if(pools_.begin(), pools_.end(),
+                                                 [](const Pool& pool) { return pool.array.isValid(); }));
+    }
+
+    void TextureArrayAllocator::printStats() const {
+        std::cout << "TextureArrayAllocator: " << entries_.size() << " textures in " << getArrayCount() << " arrays" << std::endl;
+        for (const auto& pool : pools_) {
+            int used = 0;
+            for (const auto& layer : pool.layers) {
+                used += layer.used;
+            }
+            std::cout << "  " << (pool.atlas ? "atlas " : "layers ") << pool.width << "x" << pool.height
+                      << " format " << static_cast<int>(pool.format) << " levels " << pool.levels
+                      << ": " << pool.layers.size() << "/" << pool.arrayLayers << " layers, " << used << " textures" << std::endl;
+        }
+    }
+
+} // namespace iengine
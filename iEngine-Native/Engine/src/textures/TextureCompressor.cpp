@@ -0,0 +1,686 @@
+#include "iengine/textures/TextureCompressor.h"
+#include "iengine/textures/TextureUtils.h"
+#include "iengine/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace iengine {
+
+    namespace {
+        // 质量预设对应的编码参数
+        struct EncodeParams {
+            int powerIterations;   // 求主成分方向的幂迭代次数
+            int refineIterations;  // 最小二乘端点修正轮数
+            int searchRadius;      // BC4 端点内缩搜索范围
+        };
+
+        EncodeParams getEncodeParams(CompressionQuality quality) {
+            switch (quality) {
+                case CompressionQuality::Fast: return {2, 0, 0};
+                case CompressionQuality::High: return {16, 6, 6};
+                default: return {8, 2, 2};
+            }
+        }
+
+        size_t getBlockBytes(TextureFormat format) {
+            return (format == TextureFormat::BC1 || format == TextureFormat::BC1_SRGB ||
+                    format == TextureFormat::BC4) ? 8 : 16;
+        }
+
+        // 取一个 4x4 块，越界像素复制边缘。raw 为 true 时按原始通道读取（BC4/BC5），
+        // 否则按采样语义补齐为 RGBA（R8: RRR1，RG8: RRRG，与上传时的 swizzle 一致）
+        void fetchBlock(const uint8_t* src, int width, int height, int channels, int bx, int by,
+                        bool raw, uint8_t block[16][4]) {
+            for (int y = 0; y < 4; ++y) {
+                int sy = std::min(by * 4 + y, height - 1);
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(bx * 4 + x, width - 1);
+                    const uint8_t* p = src + (static_cast<size_t>(sy) * width + sx) * channels;
+                    uint8_t* d = block[y * 4 + x];
+                    if (raw) {
+                        d[0] = p[0];
+                        d[1] = channels > 1 ? p[1] : 0;
+                        d[2] = channels > 2 ? p[2] : 0;
+                        d[3] = channels > 3 ? p[3] : 255;
+                    } else if (channels == 1) {
+                        d[0] = d[1] = d[2] = p[0];
+                        d[3] = 255;
+                    } else if (channels == 2) {
+                        d[0] = d[1] = d[2] = p[0];
+                        d[3] = p[1];
+                    } else {
+                        d[0] = p[0];
+                        d[1] = p[1];
+                        d[2] = p[2];
+                        d[3] = channels > 3 ? p[3] : 255;
+                    }
+                }
+            }
+        }
+
+        // 协方差矩阵的主特征向量（幂迭代）
+        void principalAxis(const float points[16][4], int dims, const float mean[4], int iterations, float axis[4]) {
+            float cov[4][4] = {};
+            for (int i = 0; i < 16; ++i) {
+                float d[4];
+                for (int a = 0; a < dims; ++a) d[a] = points[i][a] - mean[a];
+                for (int a = 0; a < dims; ++a) {
+                    for (int b = 0; b < dims; ++b) {
+                        cov[a][b] += d[a] * d[b];
+                    }
+                }
+            }
+
+            // 以方差最大的一列作为初值，收敛更快
+            int column = 0;
+            for (int a = 1; a < dims; ++a) {
+                if (cov[a][a] > cov[column][column]) column = a;
+            }
+            for (int a = 0; a < 4; ++a) axis[a] = a < dims ? cov[a][column] : 0.0f;
+
+            for (int it = 0; it < iterations; ++it) {
+                float next[4] = {};
+                for (int a = 0; a < dims; ++a) {
+                    for (int b = 0; b < dims; ++b) {
+                        next[a] += cov[a][b] * axis[b];
+                    }
+                }
+                float length = 0.0f;
+                for (int a = 0; a < dims; ++a) length += next[a] * next[a];
+                length = std::sqrt(length);
+                if (length < 1e-8f) break;
+                for (int a = 0; a < dims; ++a) axis[a] = next[a] / length;
+            }
+
+            float length = 0.0f;
+            for (int a = 0; a < dims; ++a) length += axis[a] * axis[a];
+            length = std::sqrt(length);
+            for (int a = 0; a < dims; ++a) axis[a] = length > 1e-8f ? axis[a] / length : 0.0f;
+        }
+
+        // 沿主成分方向求初始端点：lo 为投影最小端，hi 为投影最大端
+        void fitEndpoints(const float points[16][4], int dims, int iterations, float lo[4], float hi[4]) {
+            float mean[4] = {};
+            for (int i = 0; i < 16; ++i) {
+                for (int a = 0; a < dims; ++a) mean[a] += points[i][a] / 16.0f;
+            }
+            float axis[4];
+            principalAxis(points, dims, mean, iterations, axis);
+
+            float minT = 0.0f, maxT = 0.0f;
+            for (int i = 0; i < 16; ++i) {
+                float t = 0.0f;
+                for (int a = 0; a < dims; ++a) t += (points[i][a] - mean[a]) * axis[a];
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+            for (int a = 0; a < dims; ++a) {
+                lo[a] = std::min(std::max(mean[a] + axis[a] * minT, 0.0f), 255.0f);
+                hi[a] = std::min(std::max(mean[a] + axis[a] * maxT, 0.0f), 255.0f);
+            }
+        }
+
+        // 给定索引对应的插值权重 w（端点 0 的权重为 1 - w），最小二乘求解两个端点
+        bool solveEndpoints(const float points[16][4], int dims, const float weights[16], float e0[4], float e1[4]) {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (int i = 0; i < 16; ++i) {
+                float b = weights[i];
+                float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < dims; ++c) {
+                    ax[c] += a * points[i][c];
+                    bx[c] += b * points[i][c];
+                }
+            }
+            float det = aa * bb - ab * ab;
+            if (std::fabs(det) < 1e-6f) return false;
+            for (int c = 0; c < dims; ++c) {
+                e0[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / det, 0.0f), 255.0f);
+                e1[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / det, 0.0f), 255.0f);
+            }
+            return true;
+        }
+
+        // ---------------- BC1 颜色块 ----------------
+
+        uint16_t packRgb565(const float c[3]) {
+            int r = std::min(31, std::max(0, static_cast<int>(c[0] * 31.0f / 255.0f + 0.5f)));
+            int g = std::min(63, std::max(0, static_cast<int>(c[1] * 63.0f / 255.0f + 0.5f)));
+            int b = std::min(31, std::max(0, static_cast<int>(c[2] * 31.0f / 255.0f + 0.5f)));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void unpackRgb565(uint16_t v, int out[3]) {
+            int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+            out[0] = (r << 3) | (r >> 2);
+            out[1] = (g << 2) | (g >> 4);
+            out[2] = (b << 3) | (b >> 2);
+        }
+
+        void colorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][3]) {
+            unpackRgb565(c0, palette[0]);
+            unpackRgb565(c1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                if (fourColor) {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+                } else {
+                    palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                    palette[3][c] = 0;
+                }
+            }
+        }
+
+        void encodeColorBlock(const uint8_t block[16][4], const EncodeParams& params, uint8_t* out) {
+            float points[16][4];
+            for (int i = 0; i < 16; ++i) {
+                for (int c = 0; c < 3; ++c) points[i][c] = block[i][c];
+            }
+            float hi[4], lo[4];
+            fitEndpoints(points, 3, params.powerIterations, lo, hi);
+
+            // 端点 0 取投影最大端，保证 c0 >= c1 时使用四色模式
+            static const float indexWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+            uint16_t bestC0 = 0, bestC1 = 0;
+            uint8_t bestIndices[16] = {};
+            float bestError = 1e30f;
+            for (int iteration = 0; iteration <= params.refineIterations; ++iteration) {
+                uint16_t c0 = packRgb565(hi);
+                uint16_t c1 = packRgb565(lo);
+                int palette[4][3];
+                colorPalette(c0, c1, true, palette);
+
+                uint8_t indices[16];
+                float error = 0.0f;
+                for (int i = 0; i < 16; ++i) {
+                    float best = 1e30f;
+                    for (int k = 0; k < 4; ++k) {
+                        float d = 0.0f;
+                        for (int c = 0; c < 3; ++c) {
+                            float diff = points[i][c] - palette[k][c];
+                            d += diff * diff;
+                        }
+                        if (d < best) {
+                            best = d;
+                            indices[i] = static_cast<uint8_t>(k);
+                        }
+                    }
+                    error += best;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    bestC0 = c0;
+                    bestC1 = c1;
+                    std::memcpy(bestIndices, indices, sizeof(indices));
+                }
+                if (iteration == params.refineIterations || error == 0.0f) break;
+
+                float weights[16];
+                for (int i = 0; i < 16; ++i) weights[i] = indexWeights[indices[i]];
+                if (!solveEndpoints(points, 3, weights, hi, lo)) break;
+            }
+
+            // 量化后 c0 < c1 时交换端点，索引 0<->1、2<->3 互换；两端相同时全部使用索引 0
+            if (bestC0 < bestC1) {
+                std::swap(bestC0, bestC1);
+                for (int i = 0; i < 16; ++i) bestIndices[i] ^= 1;
+            } else if (bestC0 == bestC1) {
+                std::memset(bestIndices, 0, sizeof(bestIndices));
+            }
+
+            uint32_t bits = 0;
+            for (int i = 0; i < 16; ++i) bits |= static_cast<uint32_t>(bestIndices[i]) << (2 * i);
+            out[0] = static_cast<uint8_t>(bestC0 & 0xFF);
+            out[1] = static_cast<uint8_t>(bestC0 >> 8);
+            out[2] = static_cast<uint8_t>(bestC1 & 0xFF);
+            out[3] = static_cast<uint8_t>(bestC1 >> 8);
+            for (int b = 0; b < 4; ++b) out[4 + b] = static_cast<uint8_t>(bits >> (8 * b));
+        }
+
+        // BC3 中的颜色块总是按四色模式解码
+        void decodeColorBlock(const uint8_t* in, bool forceFourColor, uint8_t out[16][4]) {
+            uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+            uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+            int palette[4][3];
+            colorPalette(c0, c1, forceFourColor || c0 > c1, palette);
+            uint32_t bits = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+            for (int i = 0; i < 16; ++i) {
+                int k = (bits >> (2 * i)) & 3;
+                for (int c = 0; c < 3; ++c) out[i][c] = static_cast<uint8_t>(palette[k][c]);
+                out[i][3] = 255;
+            }
+        }
+
+        // ---------------- BC4 单通道块 ----------------
+
+        void singleChannelPalette(int a0, int a1, int palette[8]) {
+            palette[0] = a0;
+            palette[1] = a1;
+            if (a0 > a1) {
+                for (int i = 2; i < 8; ++i) palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+            } else {
+                for (int i = 2; i < 6; ++i) palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        void encodeSingleChannelBlock(const uint8_t values[16], const EncodeParams& params, uint8_t* out) {
+            int minValue = 255, maxValue = 0;
+            for (int i = 0; i < 16; ++i) {
+                minValue = std::min(minValue, static_cast<int>(values[i]));
+                maxValue = std::max(maxValue, static_cast<int>(values[i]));
+            }
+
+            int bestA0 = maxValue, bestA1 = minValue;
+            uint8_t bestIndices[16] = {};
+            if (maxValue > minValue) {
+                // 八值模式；端点向内收缩可以让插值点更贴近数据分布
+                int bestError = 1 << 30;
+                for (int d0 = 0; d0 <= params.searchRadius; ++d0) {
+                    for (int d1 = 0; d1 <= params.searchRadius; ++d1) {
+                        int a0 = maxValue - d0;
+                        int a1 = minValue + d1;
+                        if (a0 <= a1) continue;
+                        int palette[8];
+                        singleChannelPalette(a0, a1, palette);
+                        uint8_t indices[16];
+                        int error = 0;
+                        for (int i = 0; i < 16; ++i) {
+                            int best = 1 << 30;
+                            for (int k = 0; k < 8; ++k) {
+                                int diff = values[i] - palette[k];
+                                if (diff * diff < best) {
+                                    best = diff * diff;
+                                    indices[i] = static_cast<uint8_t>(k);
+                                }
+                            }
+                            error += best;
+                        }
+                        if (error < bestError) {
+                            bestError = error;
+                            bestA0 = a0;
+                            bestA1 = a1;
+                            std::memcpy(bestIndices, indices, sizeof(indices));
+                        }
+                    }
+                }
+            }
+
+            out[0] = static_cast<uint8_t>(bestA0);
+            out[1] = static_cast<uint8_t>(bestA1);
+            uint64_t bits = 0;
+            for (int i = 0; i < 16; ++i) bits |= static_cast<uint64_t>(bestIndices[i]) << (3 * i);
+            for (int b = 0; b < 6; ++b) out[2 + b] = static_cast<uint8_t>(bits >> (8 * b));
+        }
+
+        void decodeSingleChannelBlock(const uint8_t* in, uint8_t out[16]) {
+            int palette[8];
+            singleChannelPalette(in[0], in[1], palette);
+            uint64_t bits = 0;
+            for (int b = 0; b < 6; ++b) bits |= static_cast<uint64_t>(in[2 + b]) << (8 * b);
+            for (int i = 0; i < 16; ++i) out[i] = static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]);
+        }
+
+        // ---------------- BC7 模式 6 ----------------
+
+        const int bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        struct BitWriter {
+            uint8_t* data;
+            int position = 0;
+            void write(uint32_t value, int bits) {
+                for (int b = 0; b < bits; ++b, ++position) {
+                    if ((value >> b) & 1) data[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+                }
+            }
+        };
+
+        struct BitReader {
+            const uint8_t* data;
+            int position = 0;
+            uint32_t read(int bits) {
+                uint32_t value = 0;
+                for (int b = 0; b < bits; ++b, ++position) {
+                    value |= static_cast<uint32_t>((data[position >> 3] >> (position & 7)) & 1) << b;
+                }
+                return value;
+            }
+        };
+
+        // 7 位端点 + 共享 P 位，选择量化误差较小的 P 位
+        void quantizeBc7Endpoint(const float e[4], int q[4], int& pbit) {
+            float bestError = 1e30f;
+            for (int p = 0; p < 2; ++p) {
+                int candidate[4];
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c) {
+                    candidate[c] = std::min(127, std::max(0, static_cast<int>((e[c] - p) * 0.5f + 0.5f)));
+                    float diff = static_cast<float>(candidate[c] * 2 + p) - e[c];
+                    error += diff * diff;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    pbit = p;
+                    std::memcpy(q, candidate, sizeof(candidate));
+                }
+            }
+        }
+
+        void encodeBc7Block(const uint8_t block[16][4], const EncodeParams& params, uint8_t* out) {
+            float points[16][4];
+            for (int i = 0; i < 16; ++i) {
+                for (int c = 0; c < 4; ++c) points[i][c] = block[i][c];
+            }
+            float e0[4], e1[4];
+            fitEndpoints(points, 4, params.powerIterations, e0, e1);
+
+            int bestQ0[4] = {}, bestQ1[4] = {}, bestP0 = 0, bestP1 = 0;
+            uint8_t bestIndices[16] = {};
+            float bestError = 1e30f;
+            for (int iteration = 0; iteration <= params.refineIterations; ++iteration) {
+                int q0[4], q1[4], p0 = 0, p1 = 0;
+                quantizeBc7Endpoint(e0, q0, p0);
+                quantizeBc7Endpoint(e1, q1, p1);
+                int palette[16][4];
+                for (int k = 0; k < 16; ++k) {
+                    for (int c = 0; c < 4; ++c) {
+                        int a = q0[c] * 2 + p0;
+                        int b = q1[c] * 2 + p1;
+                        palette[k][c] = ((64 - bc7Weights[k]) * a + bc7Weights[k] * b + 32) >> 6;
+                    }
+                }
+
+                uint8_t indices[16];
+                float error = 0.0f;
+                for (int i = 0; i < 16; ++i) {
+                    float best = 1e30f;
+                    for (int k = 0; k < 16; ++k) {
+                        float d = 0.0f;
+                        for (int c = 0; c < 4; ++c) {
+                            float diff = points[i][c] - palette[k][c];
+                            d += diff * diff;
+                        }
+                        if (d < best) {
+                            best = d;
+                            indices[i] = static_cast<uint8_t>(k);
+                        }
+                    }
+                    error += best;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    std::memcpy(bestQ0, q0, sizeof(q0));
+                    std::memcpy(bestQ1, q1, sizeof(q1));
+                    bestP0 = p0;
+                    bestP1 = p1;
+                    std::memcpy(bestIndices, indices, sizeof(indices));
+                }
+                if (iteration == params.refineIterations || error == 0.0f) break;
+
+                float weights[16];
+                for (int i = 0; i < 16; ++i) weights[i] = bc7Weights[indices[i]] / 64.0f;
+                if (!solveEndpoints(points, 4, weights, e0, e1)) break;
+            }
+
+            // 锚点（第 0 个像素）索引的最高位必须为 0，否则交换端点并翻转索引
+            if (bestIndices[0] & 8) {
+                std::swap(bestQ0, bestQ1);
+                std::swap(bestP0, bestP1);
+                for (int i = 0; i < 16; ++i) bestIndices[i] = static_cast<uint8_t>(15 - bestIndices[i]);
+            }
+
+            std::memset(out, 0, 16);
+            BitWriter writer{out};
+            writer.write(1 << 6, 7);  // 模式 6
+            for (int c = 0; c < 4; ++c) {
+                writer.write(static_cast<uint32_t>(bestQ0[c]), 7);
+                writer.write(static_cast<uint32_t>(bestQ1[c]), 7);
+            }
+            writer.write(static_cast<uint32_t>(bestP0), 1);
+            writer.write(static_cast<uint32_t>(bestP1), 1);
+            writer.write(bestIndices[0], 3);
+            for (int i = 1; i < 16; ++i) writer.write(bestIndices[i], 4);
+        }
+
+        bool decodeBc7Block(const uint8_t* in, uint8_t out[16][4]) {
+            BitReader reader{in};
+            if (reader.read(7) != (1u << 6)) {
+                std::memset(out, 0, 16 * 4);
+                return false;
+            }
+            int q[2][4];
+            for (int c = 0; c < 4; ++c) {
+                q[0][c] = static_cast<int>(reader.read(7));
+                q[1][c] = static_cast<int>(reader.read(7));
+            }
+            int p0 = static_cast<int>(reader.read(1));
+            int p1 = static_cast<int>(reader.read(1));
+            for (int i = 0; i < 16; ++i) {
+                int k = static_cast<int>(reader.read(i == 0 ? 3 : 4));
+                for (int c = 0; c < 4; ++c) {
+                    int a = q[0][c] * 2 + p0;
+                    int b = q[1][c] * 2 + p1;
+                    out[i][c] = static_cast<uint8_t>(((64 - bc7Weights[k]) * a + bc7Weights[k] * b + 32) >> 6);
+                }
+            }
+            return true;
+        }
+
+        // ---------------- 按格式分派 ----------------
+
+        bool isRawChannelFormat(TextureFormat format) {
+            return format == TextureFormat::BC4 || format == TextureFormat::BC5;
+        }
+
+        void encodeBlock(const uint8_t block[16][4], TextureFormat format, const EncodeParams& params, uint8_t* out) {
+            uint8_t values[16];
+            switch (format) {
+                case TextureFormat::BC1:
+                case TextureFormat::BC1_SRGB:
+                    encodeColorBlock(block, params, out);
+                    break;
+                case TextureFormat::BC3:
+                case TextureFormat::BC3_SRGB:
+                    for (int i = 0; i < 16; ++i) values[i] = block[i][3];
+                    encodeSingleChannelBlock(values, params, out);
+                    encodeColorBlock(block, params, out + 8);
+                    break;
+                case TextureFormat::BC4:
+                    for (int i = 0; i < 16; ++i) values[i] = block[i][0];
+                    encodeSingleChannelBlock(values, params, out);
+                    break;
+                case TextureFormat::BC5:
+                    for (int i = 0; i < 16; ++i) values[i] = block[i][0];
+                    encodeSingleChannelBlock(values, params, out);
+                    for (int i = 0; i < 16; ++i) values[i] = block[i][1];
+                    encodeSingleChannelBlock(values, params, out + 8);
+                    break;
+                default:
+                    encodeBc7Block(block, params, out);
+                    break;
+            }
+        }
+
+        // 解码为 RGBA（BC4/BC5 的未使用通道为 0，Alpha 为 255）
+        void decodeBlock(const uint8_t* in, TextureFormat format, uint8_t out[16][4]) {
+            uint8_t values[16];
+            switch (format) {
+                case TextureFormat::BC1:
+                case TextureFormat::BC1_SRGB:
+                    decodeColorBlock(in, false, out);
+                    break;
+                case TextureFormat::BC3:
+                case TextureFormat::BC3_SRGB:
+                    decodeColorBlock(in + 8, true, out);
+                    decodeSingleChannelBlock(in, values);
+                    for (int i = 0; i < 16; ++i) out[i][3] = values[i];
+                    break;
+                case TextureFormat::BC4:
+                case TextureFormat::BC5:
+                    decodeSingleChannelBlock(in, values);
+                    for (int i = 0; i < 16; ++i) {
+                        out[i][0] = values[i];
+                        out[i][1] = 0;
+                        out[i][2] = 0;
+                        out[i][3] = 255;
+                    }
+                    if (format == TextureFormat::BC5) {
+                        decodeSingleChannelBlock(in + 8, values);
+                        for (int i = 0; i < 16; ++i) out[i][1] = values[i];
+                    }
+                    break;
+                default:
+                    decodeBc7Block(in, out);
+                    break;
+            }
+        }
+
+        // PSNR 统计的通道数
+        int getErrorChannels(TextureFormat format) {
+            switch (format) {
+                case TextureFormat::BC4: return 1;
+                case TextureFormat::BC5: return 2;
+                case TextureFormat::BC1:
+                case TextureFormat::BC1_SRGB: return 3;
+                default: return 4;
+            }
+        }
+    }
+
+    bool TextureCompressor::canCompress(TextureFormat source) {
+        return !isFloatTextureFormat(source) && !isCompressedTextureFormat(source);
+    }
+
+    TextureFormat TextureCompressor::chooseCompressedFormat(const void* data, int width, int height, TextureFormat source,
+                                                            bool normalMap, CompressionQuality quality) {
+        if (!data || !canCompress(source)) {
+            return source;
+        }
+
+        const int channels = getTextureFormatChannels(source);
+        const bool srgb = isSrgbTextureFormat(source);
+        if (normalMap && channels >= 2) {
+            return TextureFormat::BC5;
+        }
+        if (channels == 1) {
+            return TextureFormat::BC4;
+        }
+
+        // 灰度+透明度的透明度在第 2 通道，RGBA 在第 4 通道
+        bool opaque = true;
+        if (channels == 2 || channels == 4) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            const size_t pixelCount = static_cast<size_t>(width) * height;
+            for (size_t i = 0; i < pixelCount && opaque; ++i) {
+                opaque = bytes[i * channels + channels - 1] == 255;
+            }
+        }
+
+        if (opaque && quality != CompressionQuality::High) {
+            return srgb ? TextureFormat::BC1_SRGB : TextureFormat::BC1;
+        }
+        return srgb ? TextureFormat::BC7_SRGB : TextureFormat::BC7;
+    }
+
+    TextureFormat TextureCompressor::getDecompressedFormat(TextureFormat compressed) {
+        switch (compressed) {
+            case TextureFormat::BC4: return TextureFormat::R8;
+            case TextureFormat::BC5: return TextureFormat::RG8;
+            case TextureFormat::BC1_SRGB:
+            case TextureFormat::BC3_SRGB:
+            case TextureFormat::BC7_SRGB: return TextureFormat::SRGB8_ALPHA8;
+            case TextureFormat::BC1:
+            case TextureFormat::BC3:
+            case TextureFormat::BC7: return TextureFormat::RGBA8;
+            default: return compressed;
+        }
+    }
+
+    bool TextureCompressor::compress(const void* source, int width, int height, TextureFormat sourceFormat,
+                                     TextureFormat target, const CompressionOptions& options,
+                                     uint8_t* out, double* outPsnr) {
+        if (!source || !out || width <= 0 || height <= 0 ||
+            !canCompress(sourceFormat) || !isCompressedTextureFormat(target)) {
+            std::cerr << "TextureCompressor: unsupported compression request" << std::endl;
+            return false;
+        }
+
+        const uint8_t* src = static_cast<const uint8_t*>(source);
+        const int channels = getTextureFormatChannels(sourceFormat);
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        const size_t blockBytes = getBlockBytes(target);
+        const bool raw = isRawChannelFormat(target);
+        const int errorChannels = getErrorChannels(target);
+        const EncodeParams params = getEncodeParams(options.quality);
+
+        // 每个块行的平方误差，线程间互不共享
+        std::vector<double> rowErrors(blocksY, 0.0);
+        parallelFor(options.jobSystem, blocksY, 4, [&](int begin, int end) {
+            uint8_t block[16][4];
+            uint8_t decoded[16][4];
+            for (int by = begin; by < end; ++by) {
+                double rowError = 0.0;
+                for (int bx = 0; bx < blocksX; ++bx) {
+                    uint8_t* dst = out + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+                    fetchBlock(src, width, height, channels, bx, by, raw, block);
+                    encodeBlock(block, target, params, dst);
+
+                    decodeBlock(dst, target, decoded);
+                    for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+                        for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                            for (int c = 0; c < errorChannels; ++c) {
+                                double diff = static_cast<double>(block[y * 4 + x][c]) - decoded[y * 4 + x][c];
+                                rowError += diff * diff;
+                            }
+                        }
+                    }
+                }
+                rowErrors[by] = rowError;
+            }
+        });
+
+        if (outPsnr) {
+            double totalError = 0.0;
+            for (double error : rowErrors) totalError += error;
+            double mse = totalError / (static_cast<double>(width) * height * errorChannels);
+            *outPsnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+        }
+        return true;
+    }
+
+    bool TextureCompressor::decompress(const void* source, int width, int height, TextureFormat format, uint8_t* out) {
+        if (!source || !out || !isCompressedTextureFormat(format)) {
+            return false;
+        }
+
+        const uint8_t* src = static_cast<const uint8_t*>(source);
+        const int channels = getTextureFormatChannels(getDecompressedFormat(format));
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        const size_t blockBytes = getBlockBytes(format);
+
+        uint8_t decoded[16][4];
+        for (int by = 0; by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                decodeBlock(src + (static_cast<size_t>(by) * blocksX + bx) * blockBytes, format, decoded);
+                for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+                    for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                        uint8_t* dst = out + (static_cast<size_t>(by * 4 + y) * width + bx * 4 + x) * channels;
+                        std::memcpy(dst, decoded[y * 4 + x], channels);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+} // namespace iengine
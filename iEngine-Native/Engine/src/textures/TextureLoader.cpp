@@ -0,0 +1,121 @@
+#include "iengine/textures/TextureLoader.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace iengine {
+
+    TextureLoader::TextureLoader(JobSystem& jobSystem)
+        : jobSystem_(jobSystem) {}
+
+    TextureLoader::~TextureLoader() {
+        // 任务引用了加载器，先等待它们结束，未处理的结果随 Job 一起释放
+        std::vector<JobHandle> decoding;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            decoding.swap(decoding_);
+        }
+        jobSystem_.waitAll(decoding);
+    }
+
+    std::shared_ptr<Texture> TextureLoader::load(const TextureOptions& options, Callback onComplete) {
+        TextureOptions deferred = options;
+        deferred.sourcePath.clear();  // 不在构造函数中同步加载
+        auto texture = std::make_shared<Texture>(deferred);
+        if (!options.sourcePath.empty()) {
+            load(texture, options.sourcePath, std::move(onComplete));
+        }
+        return texture;
+    }
+
+    std::shared_future<bool> TextureLoader::load(const std::shared_ptr<Texture>& texture, const std::string& filePath,
+                                                 Callback onComplete) {
+        auto job = std::make_shared<Job>();
+        job->texture = texture;
+        job->filePath = filePath;
+        job->onComplete = std::move(onComplete);
+        std::shared_future<bool> future = job->promise.get_future().share();
+
+        if (!texture) {
+            job->promise.set_value(false);
+            return future;
+        }
+
+        job->settings = texture->getImportSettings();
+        job->settings.mipmap.jobSystem = &jobSystem_;
+        job->settings.compression.jobSystem = &jobSystem_;
+        texture->loadState_ = TextureLoadState::Loading;
+        texture->sourcePath_ = filePath;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_++;
+        }
+
+        JobHandle handle = jobSystem_.schedule([this, job]() {
+            // 纹理在解码开始前已被释放时不再解码
+            if (!job->texture.expired()) {
+                // 解码失败按加载失败处理，结果仍要交给 processCompleted 以完成 future
+                try {
+                    job->success = Texture::importImage(job->filePath, job->settings, job->image);
+                } catch (const std::exception& e) {
+                    std::cerr << "TextureLoader: failed to decode " << job->filePath << ": " << e.what() << std::endl;
+                    job->success = false;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            completed_.push_back(job);
+        }, "TextureDecode");
+        std::lock_guard<std::mutex> lock(mutex_);
+        decoding_.push_back(std::move(handle));
+        return future;
+    }
+
+    size_t TextureLoader::processCompleted() {
+        std::vector<std::shared_ptr<Job>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs.swap(completed_);
+            pending_ -= jobs.size();
+            decoding_.erase(std::remove_if(decoding_.begin(), decoding_.end(),
+                                           [](const JobHandle& handle) { return handle.isDone(); }),
+                            decoding_.end());
+        }
+
+        for (auto& job : jobs) {
+            auto texture = job->texture.lock();
+            if (texture) {
+                if (job->success) {
+                    std::cout << "Texture loaded asynchronously: " << job->filePath << " ("
+                              << job->image.width << "x" << job->image.height << ")" << std::endl;
+                    texture->setDecodedImage(std::move(job->image));
+                    texture->loadState_ = TextureLoadState::Ready;
+                } else {
+                    texture->loadState_ = TextureLoadState::Failed;
+                }
+            }
+
+            bool success = texture && job->success;
+            job->promise.set_value(success);
+            if (job->onComplete && texture) {
+                job->onComplete(texture, success);
+            }
+        }
+        return jobs.size();
+    }
+
+    size_t TextureLoader::finishAll() {
+        std::vector<JobHandle> decoding;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            decoding = decoding_;
+        }
+        jobSystem_.waitAll(decoding);
+        return processCompleted();
+    }
+
+    size_t TextureLoader::getPendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_;
+    }
+
+} // namespace iengine
@@ -62,4 +62,180 @@ namespace iengine {
         }
     }
 
+    OpenGLTextureFormat getOpenGLTextureFormat(TextureFormat format) {
+        // GL_UNSIGNED_BYTE = 0x1401, GL_FLOAT = 0x1406
+        switch (format) {
+            case TextureFormat::R8:
+                return {0x8229, 0x1903, 0x1401};  // GL_R8, GL_RED
+            case TextureFormat::RG8:
+                return {0x822B, 0x8227, 0x1401};  // GL_RG8, GL_RG
+            case TextureFormat::RGB8:
+                return {0x8051, 0x1907, 0x1401};  // GL_RGB8, GL_RGB
+            case TextureFormat::SRGB8_ALPHA8:
+                return {0x8C43, 0x1908, 0x1401};  // GL_SRGB8_ALPHA8, GL_RGBA
+            case TextureFormat::R16F:
+                return {0x822D, 0x1903, 0x1406};  // GL_R16F, GL_RED
+            case TextureFormat::RGBA16F:
+                return {0x881A, 0x1908, 0x1406};  // GL_RGBA16F, GL_RGBA
+            case TextureFormat::RGBA32F:
+                return {0x8814, 0x1908, 0x1406};  // GL_RGBA32F, GL_RGBA
+            // 压缩格式只有内部格式
+            case TextureFormat::BC1:
+                return {0x83F0, 0, 0};  // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            case TextureFormat::BC1_SRGB:
+                return {0x8C4C, 0, 0};  // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+            case TextureFormat::BC3:
+                return {0x83F3, 0, 0};  // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            case TextureFormat::BC3_SRGB:
+                return {0x8C4F, 0, 0};  // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+            case TextureFormat::BC4:
+                return {0x8DBB, 0, 0};  // GL_COMPRESSED_RED_RGTC1
+            case TextureFormat::BC5:
+                return {0x8DBD, 0, 0};  // GL_COMPRESSED_RG_RGTC2
+            case TextureFormat::BC7:
+                return {0x8E8C, 0, 0};  // GL_COMPRESSED_RGBA_BPTC_UNORM
+            case TextureFormat::BC7_SRGB:
+                return {0x8E8D, 0, 0};  // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+            // GL_DEPTH_COMPONENT = 0x1902, GL_UNSIGNED_INT = 0x1405
+            case TextureFormat::DEPTH24:
+                return {0x81A6, 0x1902, 0x1405};  // GL_DEPTH_COMPONENT24
+            case TextureFormat::DEPTH24_STENCIL8:
+                return {0x88F0, 0x84F9, 0x84FA};  // GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8
+            case TextureFormat::DEPTH32F:
+                return {0x8CAC, 0x1902, 0x1406};  // GL_DEPTH_COMPONENT32F
+            case TextureFormat::RGBA8:
+            default:
+                return {0x8058, 0x1908, 0x1401};  // GL_RGBA8, GL_RGBA
+        }
+    }
+
+    int getTextureFormatChannels(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::R8:
+            case TextureFormat::R16F:
+            case TextureFormat::BC4:
+            case TextureFormat::DEPTH24:
+            case TextureFormat::DEPTH24_STENCIL8:
+            case TextureFormat::DEPTH32F:
+                return 1;
+            case TextureFormat::RG8:
+            case TextureFormat::BC5:
+                return 2;
+            case TextureFormat::RGB8:
+            case TextureFormat::BC1:
+            case TextureFormat::BC1_SRGB:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+
+    bool isFloatTextureFormat(TextureFormat format) {
+        return format == TextureFormat::R16F ||
+               format == TextureFormat::RGBA16F ||
+               format == TextureFormat::RGBA32F;
+    }
+
+    bool isCompressedTextureFormat(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::BC1:
+            case TextureFormat::BC1_SRGB:
+            case TextureFormat::BC3:
+            case TextureFormat::BC3_SRGB:
+            case TextureFormat::BC4:
+            case TextureFormat::BC5:
+            case TextureFormat::BC7:
+            case TextureFormat::BC7_SRGB:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool isDepthTextureFormat(TextureFormat format) {
+        return format == TextureFormat::DEPTH24 ||
+               format == TextureFormat::DEPTH24_STENCIL8 ||
+               format == TextureFormat::DEPTH32F;
+    }
+
+    bool isSrgbTextureFormat(TextureFormat format) {
+        return format == TextureFormat::SRGB8_ALPHA8 ||
+               format == TextureFormat::BC1_SRGB ||
+               format == TextureFormat::BC3_SRGB ||
+               format == TextureFormat::BC7_SRGB;
+    }
+
+    size_t getTextureFormatBytesPerPixel(TextureFormat format) {
+        if (isCompressedTextureFormat(format)) {
+            return 0;
+        }
+        switch (format) {
+            case TextureFormat::RGB8:
+                return 4;  // 多数驱动把 RGB8 补齐为 4 字节存储，按实际占用统计
+            case TextureFormat::R16F:
+                return 2;
+            case TextureFormat::RGBA16F:
+                return 8;
+            case TextureFormat::RGBA32F:
+                return 16;
+            case TextureFormat::DEPTH24:
+            case TextureFormat::DEPTH24_STENCIL8:
+            case TextureFormat::DEPTH32F:
+                return 4;
+            default:
+                return static_cast<size_t>(getTextureFormatChannels(format));
+        }
+    }
+
+    size_t getTextureFormatDataBytesPerPixel(TextureFormat format) {
+        if (isCompressedTextureFormat(format)) {
+            return 0;
+        }
+        if (isDepthTextureFormat(format)) {
+            return 4;
+        }
+        size_t channels = static_cast<size_t>(getTextureFormatChannels(format));
+        return isFloatTextureFormat(format) ? channels * sizeof(float) : channels;
+    }
+
+    // 压缩格式每个 4x4 块的字节数
+    static size_t getCompressedBlockBytes(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::BC1:
+            case TextureFormat::BC1_SRGB:
+            case TextureFormat::BC4:
+                return 8;
+            default:
+                return 16;
+        }
+    }
+
+    size_t getTextureLevelSize(TextureFormat format, int width, int height) {
+        if (isCompressedTextureFormat(format)) {
+            return getTextureLevelDataSize(format, width, height);
+        }
+        return static_cast<size_t>(width) * height * getTextureFormatBytesPerPixel(format);
+    }
+
+    size_t getTextureLevelDataSize(TextureFormat format, int width, int height) {
+        if (isCompressedTextureFormat(format)) {
+            size_t blocksX = static_cast<size_t>((width + 3) / 4);
+            size_t blocksY = static_cast<size_t>((height + 3) / 4);
+            return blocksX * blocksY * getCompressedBlockBytes(format);
+        }
+        return static_cast<size_t>(width) * height * getTextureFormatDataBytesPerPixel(format);
+    }
+
+    TextureFormat chooseTextureFormat(int channels, bool hdr, bool srgb) {
+        if (hdr) {
+            return channels == 1 ? TextureFormat::R16F : TextureFormat::RGBA16F;
+        }
+        switch (channels) {
+            case 1: return TextureFormat::R8;
+            case 2: return TextureFormat::RG8;
+            case 3: return TextureFormat::RGB8;
+            default: return srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8;
+        }
+    }
+
 } // namespace iengine
\ No newline at end of file
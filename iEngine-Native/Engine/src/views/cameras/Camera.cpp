@@ -1,5 +1,8 @@
 #include "iengine/views/cameras/Camera.h"
 
+#include <cmath>
+#include <limits>
+
 namespace iengine {
     Camera::Camera() {
         updateViewMatrix();
@@ -8,31 +11,37 @@ namespace iengine {
     void Camera::setPosition(float x, float y, float z) {
         position_.set(x, y, z);
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::setPosition(const Vector3& position) {
         position_ = position;
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::setTarget(float x, float y, float z) {
         target_.set(x, y, z);
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::setTarget(const Vector3& target) {
         target_ = target;
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::setUp(float x, float y, float z) {
         up_.set(x, y, z);
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::setUp(const Vector3& up) {
         up_ = up;
         viewMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void Camera::updateViewMatrix() {
@@ -52,6 +61,61 @@ namespace iengine {
         return viewMatrix_;
     }
     
+    float Camera::getProjectedSize(const Vector3& center, float worldSize, float viewportHeight) {
+        const auto& view = getViewMatrix();
+        const auto& projection = getProjectionMatrix().elements;
+        
+        // 视图空间深度（相机看向 -Z）
+        float viewZ = view.elements[2] * center.x + view.elements[6] * center.y + view.elements[10] * center.z + view.elements[14];
+        
+        // 透视投影 w = -viewZ，正交投影 w = 1，统一用投影矩阵的第4行计算
+        float w = projection[11] * viewZ + projection[15];
+        if (w <= 1e-6f) {
+            // 位于相机平面或身后，视为无限大，保证选择最精细的级别
+            return std::numeric_limits<float>::max();
+        }
+        
+        return worldSize * projection[5] / w * viewportHeight * 0.5f;
+    }
+    
+    bool Camera::intersectsSphere(const Vector3& center, float radius) {
+        float planes[6][4];
+        getFrustumPlanes(planes);
+        for (const auto& plane : planes) {
+            if (plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3] < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void Camera::getFrustumPlanes(float planes[6][4]) {
+        // 从视图投影矩阵提取六个裁剪平面（列主序，第 i 行为 m[i], m[4+i], m[8+i], m[12+i]）
+        Matrix4 viewProjection = getViewProjectionMatrix();
+        const auto& m = viewProjection.elements;
+        auto row = [&](int i, int c) { return m[c * 4 + i]; };
+        
+        int index = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            for (float sign : {1.0f, -1.0f}) {
+                float* plane = planes[index++];
+                for (int c = 0; c < 4; ++c) {
+                    plane[c] = row(3, c) + sign * row(axis, c);
+                }
+                float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+                if (length <= 0.0f) {
+                    // 退化的平面不剔除任何东西
+                    plane[0] = plane[1] = plane[2] = 0.0f;
+                    plane[3] = 1.0f;
+                    continue;
+                }
+                for (int c = 0; c < 4; ++c) {
+                    plane[c] /= length;
+                }
+            }
+        }
+    }
+    
     Matrix4 Camera::getViewProjectionMatrix() {
         updateViewMatrix();
         updateProjectionMatrix();
@@ -38,31 +38,37 @@ namespace iengine {
     void OrthographicCamera::setLeft(float left) {
         left_ = left;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::setRight(float right) {
         right_ = right;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::setBottom(float bottom) {
         bottom_ = bottom;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::setTop(float top) {
         top_ = top;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::setNear(float near) {
         near_ = near;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::setFar(float far) {
         far_ = far;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
 
     void OrthographicCamera::updateProjectionMatrix() {
@@ -76,4 +82,13 @@ namespace iengine {
         projectionMatrixDirty_ = false;
     }
 
+    const Matrix4& OrthographicCamera::getProjectionMatrix() {
+        updateProjectionMatrix();
+        return projectionMatrix_;
+    }
+
+    std::shared_ptr<Camera> OrthographicCamera::clone() const {
+        return std::make_shared<OrthographicCamera>(*this);
+    }
+
 } // namespace iengine
\ No newline at end of file
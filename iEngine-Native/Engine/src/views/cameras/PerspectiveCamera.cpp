@@ -18,21 +18,25 @@ namespace iengine {
     void PerspectiveCamera::setFov(float fov) {
         this->fov = fov;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void PerspectiveCamera::setAspect(float aspect) {
         this->aspect = aspect;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void PerspectiveCamera::setNear(float near) {
         this->near = near;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void PerspectiveCamera::setFar(float far) {
         this->far = far;
         projectionMatrixDirty_ = true;
+        dirty_ = true;
     }
     
     void PerspectiveCamera::updateProjectionMatrix() {
@@ -52,4 +56,8 @@ namespace iengine {
         updateProjectionMatrix();
         return projectionMatrix_;
     }
+    
+    std::shared_ptr<Camera> PerspectiveCamera::clone() const {
+        return std::make_shared<PerspectiveCamera>(*this);
+    }
 }
\ No newline at end of file
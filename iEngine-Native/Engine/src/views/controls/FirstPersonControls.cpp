@@ -73,14 +73,10 @@ namespace iengine {
                 }
                 break;
             case WindowEventType::MouseMove:
-                if (isDragging_) {
-                    std::cout << "FirstPersonControls: 鼠标拖拽中 - 位置:(" << event.data.mouseMove.x << ", " << event.data.mouseMove.y << ")" << std::endl;
-                }
                 onMouseMove(static_cast<float>(event.data.mouseMove.x), 
                            static_cast<float>(event.data.mouseMove.y));
                 break;
             case WindowEventType::MouseScroll: {
-                std::cout << "FirstPersonControls: 收到滚轮事件 - 偏移:" << event.data.mouseScroll.yoffset << std::endl;
                 // 防御性判断：限制滚轮值范围以防止异常值
                 float wheelDelta = static_cast<float>(event.data.mouseScroll.yoffset);
                 if (std::abs(wheelDelta) > 10.0f) {
@@ -115,10 +111,9 @@ namespace iengine {
         lastX_ = x;
         lastY_ = y;
         
-        yaw_ -= dx * lookSpeed_;
-        pitch_ -= dy * lookSpeed_;
-        pitch_ = std::max(-static_cast<float>(M_PI) / 2, std::min(static_cast<float>(M_PI) / 2, pitch_));
-        updateCamera();
+        // 只累积，update() 中统一应用
+        pendingYaw_ -= dx * lookSpeed_;
+        pendingPitch_ -= dy * lookSpeed_;
     }
     
     void FirstPersonControls::onMouseUp() {
@@ -132,21 +127,9 @@ namespace iengine {
             return;
         }
         
-        // 用于前后移动（参考TS版本）
-        // 计算前方向
-        const float forwardX = std::sin(yaw_);
-        const float forwardZ = std::cos(yaw_);
-        
-        // 限制移动速度
+        // 用于前后移动（参考TS版本），限制移动速度
         float moveAmount = delta * 0.01f;
-        moveAmount = std::max(-1.0f, std::min(1.0f, moveAmount));
-        
-        // 获取当前相机位置并移动（直接使用setPosition方法）
-        // 需要先获取当前位置，但由于position_是protected，我们维护本地位置状态
-        currentPosition_.x += forwardX * moveAmount;
-        currentPosition_.z += forwardZ * moveAmount;
-        camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
-        updateCamera();
+        pendingForward_ += std::max(-1.0f, std::min(1.0f, moveAmount));
     }
     
     void FirstPersonControls::onKeyDown(int key, int action) {
@@ -155,12 +138,7 @@ namespace iengine {
             return;
         }
         
-        // 简单的WASD移动（参考TS版本）
-        const float forwardX = std::sin(yaw_);
-        const float forwardZ = std::cos(yaw_);
-        const float rightX = std::cos(yaw_);
-        const float rightZ = -std::sin(yaw_);
-        
+        // 简单的WASD移动（参考TS版本），沿 update() 时的朝向移动
         // GLFW键码对应（参考GLFW定义）
         const int GLFW_KEY_W = 87;
         const int GLFW_KEY_S = 83;
@@ -169,28 +147,46 @@ namespace iengine {
         
         if (key == GLFW_KEY_W) {
             std::cout << "FirstPersonControls: W键 - 向前移动" << std::endl;
-            currentPosition_.x += forwardX * moveSpeed_;
-            currentPosition_.z += forwardZ * moveSpeed_;
-            camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
+            pendingForward_ += moveSpeed_;
         }
         if (key == GLFW_KEY_S) {
             std::cout << "FirstPersonControls: S键 - 向后移动" << std::endl;
-            currentPosition_.x -= forwardX * moveSpeed_;
-            currentPosition_.z -= forwardZ * moveSpeed_;
-            camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
+            pendingForward_ -= moveSpeed_;
         }
         if (key == GLFW_KEY_A) {
             std::cout << "FirstPersonControls: A键 - 向左移动" << std::endl;
-            currentPosition_.x -= rightX * moveSpeed_;
-            currentPosition_.z -= rightZ * moveSpeed_;
-            camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
+            pendingRight_ -= moveSpeed_;
         }
         if (key == GLFW_KEY_D) {
             std::cout << "FirstPersonControls: D键 - 向右移动" << std::endl;
-            currentPosition_.x += rightX * moveSpeed_;
-            currentPosition_.z += rightZ * moveSpeed_;
-            camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
+            pendingRight_ += moveSpeed_;
         }
+    }
+    
+    void FirstPersonControls::update() {
+        if (pendingYaw_ == 0.0f && pendingPitch_ == 0.0f && pendingForward_ == 0.0f && pendingRight_ == 0.0f) {
+            return;
+        }
+        
+        yaw_ += pendingYaw_;
+        pitch_ += pendingPitch_;
+        pitch_ = std::max(-static_cast<float>(M_PI) / 2, std::min(static_cast<float>(M_PI) / 2, pitch_));
+        
+        // 获取当前相机位置并移动（直接使用setPosition方法）
+        // 需要先获取当前位置，但由于position_是protected，我们维护本地位置状态
+        const float forwardX = std::sin(yaw_);
+        const float forwardZ = std::cos(yaw_);
+        const float rightX = std::cos(yaw_);
+        const float rightZ = -std::sin(yaw_);
+        currentPosition_.x += forwardX * pendingForward_ + rightX * pendingRight_;
+        currentPosition_.z += forwardZ * pendingForward_ + rightZ * pendingRight_;
+        
+        pendingYaw_ = 0.0f;
+        pendingPitch_ = 0.0f;
+        pendingForward_ = 0.0f;
+        pendingRight_ = 0.0f;
+        
+        camera_->setPosition(currentPosition_.x, currentPosition_.y, currentPosition_.z);
         updateCamera();
     }
     
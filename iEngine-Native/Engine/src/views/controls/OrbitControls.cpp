@@ -70,14 +70,10 @@ namespace iengine {
                 }
                 break;
             case WindowEventType::MouseMove:
-                if (isDragging_) {
-                    std::cout << "OrbitControls: 鼠标拖拽中 - 位置:(" << event.data.mouseMove.x << ", " << event.data.mouseMove.y << ")" << std::endl;
-                }
                 onMouseMove(static_cast<float>(event.data.mouseMove.x), 
                            static_cast<float>(event.data.mouseMove.y));
                 break;
             case WindowEventType::MouseScroll: {
-                std::cout << "OrbitControls: 收到滚轮事件 - 偏移:" << event.data.mouseScroll.yoffset << std::endl;
                 // 防御性判断：限制滚轮值范围以防止异常值
                 float wheelDelta = static_cast<float>(event.data.mouseScroll.yoffset);
                 if (std::abs(wheelDelta) > 10.0f) {
@@ -106,10 +102,9 @@ namespace iengine {
         lastX_ = x;
         lastY_ = y;
         
-        theta_ -= dx * 0.01f;
-        phi_ -= dy * 0.01f;
-        phi_ = std::max(0.01f, std::min(static_cast<float>(M_PI) - 0.01f, phi_));
-        updateCamera();
+        // 只累积，update() 中统一应用
+        pendingTheta_ -= dx * 0.01f;
+        pendingPhi_ -= dy * 0.01f;
     }
     
     void OrbitControls::onMouseUp() {
@@ -117,19 +112,37 @@ namespace iengine {
     }
     
     void OrbitControls::onMouseWheel(float delta) {
-        // 防御性判断：如果值过小则忽略，防止微小抖动
-        if (std::abs(delta) < 0.001f) {
-            return;
-        }
+        pendingZoom_ += delta * 0.01f;
+    }
+    
+    void OrbitControls::update() {
+        bool changed = false;
         
-        float oldRadius = radius_;
-        radius_ += delta * 0.01f;
+        if (pendingTheta_ != 0.0f || pendingPhi_ != 0.0f) {
+            theta_ += pendingTheta_;
+            phi_ += pendingPhi_;
+            phi_ = std::max(0.01f, std::min(static_cast<float>(M_PI) - 0.01f, phi_));
+            pendingTheta_ = 0.0f;
+            pendingPhi_ = 0.0f;
+            changed = true;
+        }
         
-        // 限制缩放范围：最小1.0，最大100.0
-        radius_ = std::max(1.0f, std::min(100.0f, radius_));
+        // 防御性判断：如果值过小则忽略，防止微小抖动
+        if (std::abs(pendingZoom_) >= 0.00001f) {
+            float oldRadius = radius_;
+            radius_ += pendingZoom_;
+            
+            // 限制缩放范围：最小1.0，最大100.0
+            radius_ = std::max(1.0f, std::min(100.0f, radius_));
+            
+            // 只有当半径真正改变时才更新相机
+            if (std::abs(radius_ - oldRadius) > 0.001f) {
+                changed = true;
+            }
+        }
+        pendingZoom_ = 0.0f;
         
-        // 只有当半径真正改变时才更新相机
-        if (std::abs(radius_ - oldRadius) > 0.001f) {
+        if (changed) {
             updateCamera();
         }
     }
@@ -4,6 +4,41 @@
 
 namespace iengine {
 
+    WindowEventQueue::WindowEventQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    bool WindowEventQueue::push(const WindowEvent& event) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= buffer_.size()) {
+            return false;
+        }
+        buffer_[tail & mask_] = event;
+        // release：消费者看到新的 tail 时事件内容已经写好
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool WindowEventQueue::pop(WindowEvent& event) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        event = buffer_[head & mask_];
+        // release：生产者看到新的 head 时这个位置已经读完，可以覆盖
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool WindowEventQueue::empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
     void WindowEventDispatcher::addEventListener(std::weak_ptr<WindowEventListener> listener) {
         std::lock_guard<std::mutex> lock(listenersMutex_);
         
@@ -20,8 +55,10 @@ namespace iengine {
             }
         }
 
+        cleanupExpiredListeners();
         listeners_.push_back(listener);
         sortListenersByPriority();
+        rebuildSnapshot();
         
         std::cout << "WindowEventDispatcher: 添加事件监听器，当前监听器数量: " << listeners_.size() << std::endl;
     }
@@ -42,6 +79,7 @@ namespace iengine {
                 }),
             listeners_.end()
         );
+        rebuildSnapshot();
         
         std::cout << "WindowEventDispatcher: 移除事件监听器，当前监听器数量: " << listeners_.size() << std::endl;
     }
@@ -49,33 +87,128 @@ namespace iengine {
     void WindowEventDispatcher::clearEventListeners() {
         std::lock_guard<std::mutex> lock(listenersMutex_);
         listeners_.clear();
+        rebuildSnapshot();
         std::cout << "WindowEventDispatcher: 清除所有事件监听器" << std::endl;
     }
 
     bool WindowEventDispatcher::dispatchEvent(const WindowEvent& event) {
-        std::lock_guard<std::mutex> lock(listenersMutex_);
-        
-        // 清理过期的监听器
-        cleanupExpiredListeners();
-        
-        bool handled = false;
+        // 不使用 active_，立即分发可能发生在排队事件的分发过程中（监听器回调里）
+        std::vector<std::shared_ptr<WindowEventListener>> listeners;
+        lockListeners(listeners);
         
+        bool handled = dispatchTo(listeners, event);
+        for (const auto& listener : listeners) {
+            listener->onEventsDispatched();
+        }
+        return handled;
+    }
+
+    bool WindowEventDispatcher::queueEvent(const WindowEvent& event) {
+        if (!queue_.push(event)) {
+            overflowed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queued_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t WindowEventDispatcher::dispatchQueuedEvents() {
+        batch_.clear();
+        WindowEvent event;
+        while (queue_.pop(event)) {
+            if (coalesceEvents_ && !batch_.empty() && batch_.back().type == event.type) {
+                if (event.type == WindowEventType::MouseMove) {
+                    // 只有最后的位置有意义，控制器按与上一位置的差值计算
+                    batch_.back().data.mouseMove = event.data.mouseMove;
+                    ++coalesced_;
+                    continue;
+                }
+                if (event.type == WindowEventType::MouseScroll) {
+                    batch_.back().data.mouseScroll.xoffset += event.data.mouseScroll.xoffset;
+                    batch_.back().data.mouseScroll.yoffset += event.data.mouseScroll.yoffset;
+                    ++coalesced_;
+                    continue;
+                }
+            }
+            batch_.push_back(event);
+        }
+        if (batch_.empty()) {
+            return 0;
+        }
+
+        // 每批只锁定一次监听器；回调中增删监听器后重新取快照
+        uint64_t version = listenersVersion_.load(std::memory_order_acquire);
+        lockListeners(active_);
+        for (const auto& queued : batch_) {
+            if (listenersVersion_.load(std::memory_order_acquire) != version) {
+                version = listenersVersion_.load(std::memory_order_acquire);
+                // 被移除的监听器可能已经累积了本批的增量，保留下来到批末通知
+                received_.insert(received_.end(), active_.begin(), active_.end());
+                lockListeners(active_);
+            }
+            dispatchTo(active_, queued);
+        }
+        received_.insert(received_.end(), active_.begin(), active_.end());
+        // 同一监听器可能出现在多个快照中，只通知一次
+        for (size_t i = 0; i < received_.size(); ++i) {
+            const auto& listener = received_[i];
+            if (std::find(received_.begin(), received_.begin() + i, listener) == received_.begin() + i) {
+                listener->onEventsDispatched();
+            }
+        }
+        // 不延长监听器的生命周期
+        received_.clear();
+        active_.clear();
+
+        dispatched_ += batch_.size();
+        return batch_.size();
+    }
+
+    WindowEventQueueStats WindowEventDispatcher::getQueueStats() const {
+        WindowEventQueueStats stats;
+        stats.queued = queued_.load(std::memory_order_relaxed);
+        stats.overflowed = overflowed_.load(std::memory_order_relaxed);
+        stats.dispatched = dispatched_;
+        stats.coalesced = coalesced_;
+        return stats;
+    }
+
+    void WindowEventDispatcher::lockListeners(std::vector<std::shared_ptr<WindowEventListener>>& listeners) {
+        // 分发中发现过期的监听器时才在锁内清理一次
+        if (hasExpiredListeners_.exchange(false, std::memory_order_acq_rel)) {
+            std::lock_guard<std::mutex> lock(listenersMutex_);
+            cleanupExpiredListeners();
+            rebuildSnapshot();
+        }
+
+        listeners.clear();
+        auto snapshot = std::atomic_load(&snapshot_);
+        if (!snapshot) {
+            return;
+        }
+        listeners.reserve(snapshot->size());
+        for (const auto& weakListener : *snapshot) {
+            if (auto listener = weakListener.lock()) {
+                listeners.push_back(std::move(listener));
+            } else {
+                hasExpiredListeners_.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    bool WindowEventDispatcher::dispatchTo(const std::vector<std::shared_ptr<WindowEventListener>>& listeners,
+                                           const WindowEvent& event) {
         // 按优先级分发事件
-        for (const auto& weakListener : listeners_) {
-            auto listener = weakListener.lock();
-            if (listener) {
-                try {
-                    if (listener->onWindowEvent(event)) {
-                        handled = true;
-                        break; // 事件被处理，停止传播
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "WindowEventDispatcher: 监听器处理事件时发生异常: " << e.what() << std::endl;
+        for (const auto& listener : listeners) {
+            try {
+                if (listener->onWindowEvent(event)) {
+                    return true; // 事件被处理，停止传播
                 }
+            } catch (const std::exception& e) {
+                std::cerr << "WindowEventDispatcher: 监听器处理事件时发生异常: " << e.what() << std::endl;
             }
         }
-        
-        return handled;
+        return false;
     }
 
     size_t WindowEventDispatcher::getListenerCount() const {
@@ -94,6 +227,12 @@ namespace iengine {
         );
     }
 
+    void WindowEventDispatcher::rebuildSnapshot() {
+        // 注意：此函数假设已经获得了锁
+        std::atomic_store(&snapshot_, std::shared_ptr<const ListenerList>(std::make_shared<ListenerList>(listeners_)));
+        listenersVersion_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
     void WindowEventDispatcher::sortListenersByPriority() {
         // 注意：此函数假设已经获得了锁
         std::sort(listeners_.begin(), listeners_.end(),
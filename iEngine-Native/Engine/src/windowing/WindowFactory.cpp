@@ -5,16 +5,28 @@ namespace iengine {
     
     // 静态成员初始化
     std::map<WindowType, WindowCreatorFunction> WindowFactory::creators_;
+    std::mutex WindowFactory::mutex_;
     
     void WindowFactory::registerWindowCreator(WindowType type, WindowCreatorFunction creator) {
-        creators_[type] = creator;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            creators_[type] = creator;
+        }
         std::cout << "WindowFactory: Registered window creator for type " << static_cast<int>(type) << std::endl;
     }
     
     std::unique_ptr<WindowInterface> WindowFactory::createWindow(WindowType type) {
-        auto it = creators_.find(type);
-        if (it != creators_.end()) {
-            return it->second();
+        // 在锁外创建窗口，创建函数可以再调用工厂
+        WindowCreatorFunction creator;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = creators_.find(type);
+            if (it != creators_.end()) {
+                creator = it->second;
+            }
+        }
+        if (creator) {
+            return creator();
         }
         
         std::cerr << "WindowFactory: No creator registered for window type " << static_cast<int>(type) << std::endl;
@@ -22,10 +34,12 @@ namespace iengine {
     }
     
     bool WindowFactory::isWindowTypeAvailable(WindowType type) {
+        std::lock_guard<std::mutex> lock(mutex_);
         return creators_.find(type) != creators_.end();
     }
     
     std::vector<WindowType> WindowFactory::getAvailableWindowTypes() {
+        std::lock_guard<std::mutex> lock(mutex_);
         std::vector<WindowType> types;
         for (const auto& pair : creators_) {
             types.push_back(pair.first);
@@ -34,7 +48,10 @@ namespace iengine {
     }
     
     void WindowFactory::clearCreators() {
-        creators_.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            creators_.clear();
+        }
         std::cout << "WindowFactory: Cleared all window creators" << std::endl;
     }
     
@@ -1,5 +1,12 @@
 #include <iengine/iengine.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -48,6 +55,185 @@ void demonstrateEngineCore() {
     }
 }
 
+// 运行一个离屏引擎：并行更新场景并查询着色器变体，返回耗时（秒）
+double runHeadlessEngine(int index, int frames, int models) {
+    iengine::EngineOptions options;
+    options.renderer = iengine::RendererType::OpenGL;
+    options.multipleInstances = true;
+    options.jobWorkerThreads = 2;
+    iengine::Engine engine(options);
+
+    auto scene = std::make_shared<iengine::Scene>(nullptr);
+    iengine::SceneUpdateOptions updateOptions;
+    updateOptions.parallel = true;
+    updateOptions.minModelsPerChunk = 64;
+    scene->setUpdateOptions(updateOptions);
+    scene->setActiveCamera(std::make_shared<iengine::PerspectiveCamera>(60.0f, 1.0f, 0.1f, 100.0f));
+
+    // 动画回调只修改自己的模型和计数器
+    std::vector<std::shared_ptr<int>> counters;
+    for (int i = 0; i < models; ++i) {
+        auto counter = std::make_shared<int>(0);
+        counters.push_back(counter);
+        auto model = std::make_shared<iengine::Model>("model_" + std::to_string(i), nullptr, nullptr);
+        model->addAnimation([counter](iengine::Model& self, float deltaTime) {
+            ++*counter;
+            self.setPosition(deltaTime, 0.0f, 0.0f);
+        });
+        scene->addComponent(model);
+    }
+
+    engine.addScene("main", scene);
+    engine.start();
+
+    const char* defineNames[] = { "HAS_BASECOLOR_MAP", "HAS_NORMAL_MAP", "HAS_AO_MAP", "HAS_EMISSIVE_MAP" };
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        engine.tick();
+
+        // 所有引擎共享着色器变体缓存，不同线程同时查询相同和不同的变体
+        iengine::ShaderVariantOptions variantOptions;
+        variantOptions.defines = std::make_shared<iengine::DefineMap>();
+        variantOptions.defines->defines[defineNames[(frame + index) % 4]] = "true";
+        if (!iengine::ShaderLib::getVariant("base_pbr", iengine::GraphicsAPI::OpenGL, variantOptions)) {
+            throw std::runtime_error("base_pbr variant missing");
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    engine.stop();
+
+    for (const auto& counter : counters) {
+        if (*counter != frames) {
+            throw std::runtime_error("engine " + std::to_string(index) + ": animation ran " +
+                                     std::to_string(*counter) + " times, expected " + std::to_string(frames));
+        }
+    }
+    return seconds;
+}
+
+// 多个离屏引擎在各自线程上并行运行，检查结果正确并输出扩展性；使用 IENGINE_ENABLE_TSAN 构建时检查数据竞争
+void demonstrateMultipleEngines() {
+    std::cout << "=== 多引擎并行测试 ===" << std::endl;
+
+    const int frames = 200;
+    const int models = 512;
+    const int engineCount = static_cast<int>(std::max(2u, std::min(8u, std::thread::hardware_concurrency() / 2)));
+
+    double single = runHeadlessEngine(0, frames, models);
+
+    std::vector<std::thread> threads;
+    std::vector<double> seconds(engineCount, 0.0);
+    std::atomic<int> failures{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < engineCount; ++i) {
+        threads.emplace_back([i, frames, models, &seconds, &failures]() {
+            try {
+                seconds[i] = runHeadlessEngine(i, frames, models);
+            } catch (const std::exception& e) {
+                std::cerr << "引擎 " << i << " 失败: " << e.what() << std::endl;
+                ++failures;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (failures > 0) {
+        throw std::runtime_error("多引擎并行测试失败");
+    }
+    std::cout << engineCount << " 个引擎并行 " << frames << " 帧: " << parallel << " s，单个引擎 " << single
+              << " s，加速比 " << (single * engineCount / parallel) << std::endl;
+}
+
+// 场景实体存储：一百万个实体（一半带运动状态）的按列更新和剔除耗时
+void demonstrateEntityStorage() {
+    std::cout << "=== 实体存储测试 ===" << std::endl;
+
+    const size_t entityCount = 1000000;
+    iengine::JobSystem jobSystem;
+    auto scene = std::make_shared<iengine::Scene>(nullptr);
+    iengine::SceneUpdateOptions updateOptions;
+    updateOptions.parallel = true;
+    scene->setUpdateOptions(updateOptions);
+    scene->setJobSystem(&jobSystem);
+
+    auto camera = std::make_shared<iengine::PerspectiveCamera>(60.0f, 1.0f, 0.1f, 100.0f);
+    camera->setPosition(0.0f, 0.0f, 50.0f);
+    scene->setActiveCamera(camera);
+
+    // 所有实体共享一个网格和材质，实体中只保存句柄
+    auto mesh = std::make_shared<iengine::Mesh>(std::make_shared<iengine::Cube>(1.0f),
+                                                std::make_shared<iengine::Primitive>(iengine::PrimitiveType::TRIANGLES));
+    iengine::BaseMaterialParams materialParams;
+    materialParams.shaderName = "base_material";
+    auto material = std::make_shared<iengine::BaseMaterial>(materialParams);
+
+    auto& registry = scene->getRegistry();
+    for (size_t i = 0; i < entityCount; ++i) {
+        iengine::Vector3 position(static_cast<float>(i % 1000) - 500.0f, static_cast<float>(i / 1000) - 500.0f, 0.0f);
+        iengine::Entity entity = scene->createEntity(mesh, material, iengine::Matrix4::fromTranslation(position));
+        if (i % 2 == 0) {
+            registry.add<iengine::MotionComponent>(entity, iengine::MotionComponent{
+                iengine::Vector3(0.5f, 0.0f, 0.0f), iengine::Vector3(0.0f, 1.0f, 0.0f) });
+        }
+    }
+    std::cout << entityCount << " 个实体，" << registry.getArchetypeCount() << " 个原型" << std::endl;
+
+    const int frames = 10;
+    double updateMs = 0.0;
+    double cullMs = 0.0;
+    size_t visible = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        scene->update(1.0f / 60.0f);
+        auto updated = std::chrono::steady_clock::now();
+        visible = scene->cull(*camera);
+        auto culled = std::chrono::steady_clock::now();
+        updateMs += std::chrono::duration<double, std::milli>(updated - start).count();
+        cullMs += std::chrono::duration<double, std::milli>(culled - updated).count();
+    }
+    if (visible == 0 || visible >= entityCount) {
+        throw std::runtime_error("unexpected visible entity count " + std::to_string(visible));
+    }
+    std::cout << "每帧更新 " << updateMs / frames << " ms，剔除 " << cullMs / frames << " ms，可见 " << visible
+              << " 个实体" << std::endl;
+}
+
+// 缓冲区区间分配器：释放与空闲块重叠的区间时应被拒绝且不改变空闲列表
+void demonstrateBufferRangeAllocator() {
+    std::cout << "=== 缓冲区区间分配器测试 ===" << std::endl;
+
+    const size_t capacity = 400;
+    iengine::BufferRangeAllocator allocator(capacity);
+    size_t a = allocator.allocate(100);
+    size_t b = allocator.allocate(100);
+    size_t c = allocator.allocate(100);
+    size_t d = allocator.allocate(100);
+    if (a != 0 || b != 100 || c != 200 || d != 300) {
+        throw std::runtime_error("unexpected allocation offsets");
+    }
+
+    // [0, 100) 和 [200, 300) 空闲，[100, 200) 仍被占用
+    allocator.free(a, 100);
+    allocator.free(c, 100);
+    // 错误释放 [50, 200)：紧邻后一个空闲块，但与前一个空闲块重叠
+    allocator.free(50, 150);
+    if (allocator.getFree() != 200 || allocator.getFreeBlockCount() != 2) {
+        throw std::runtime_error("overlapping free changed the free list: " + std::to_string(allocator.getFree()) +
+                                 " free in " + std::to_string(allocator.getFreeBlockCount()) + " blocks");
+    }
+
+    // 正常释放后合并为一个完整的空闲块
+    allocator.free(b, 100);
+    allocator.free(d, 100);
+    if (allocator.getFree() != capacity || allocator.getFreeBlockCount() != 1 || allocator.allocate(capacity) != 0) {
+        throw std::runtime_error("free blocks were not coalesced");
+    }
+    std::cout << "重叠释放被拒绝，空闲块合并正确" << std::endl;
+}
+
 // 独立的引擎核心测试程序的main函数
 int main() {
     // 首先设置控制台编码
@@ -58,6 +244,9 @@ int main() {
         
         // 运行引擎核心测试
         demonstrateEngineCore();
+        demonstrateMultipleEngines();
+        demonstrateEntityStorage();
+        demonstrateBufferRangeAllocator();
         
         std::cout << "所有测试通过！" << std::endl;
         return 0;
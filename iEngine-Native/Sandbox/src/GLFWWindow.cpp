@@ -61,7 +61,7 @@ namespace sandbox {
                 event.type = iengine::WindowEventType::MouseScroll;
                 event.data.mouseScroll.xoffset = xoffset;
                 event.data.mouseScroll.yoffset = yoffset;
-                self->eventDispatcher_->dispatchEvent(event);
+                self->postEvent(event);
                 
                 // 【旧版本已弃用】通过回调函数分发事件（会导致双重处理）
                 // if (self->eventCallback_) {
@@ -109,10 +109,27 @@ namespace sandbox {
         return *eventDispatcher_;
     }
 
+    void GLFWWindow::postEvent(const iengine::WindowEvent& event) {
+        // 事件回调和引擎的 tick() 都在主线程，队列满（长时间没有 tick）时先分发队列中较早的事件，
+        // 再直接分发本事件，保持事件顺序（例如按键释放不会先于之前的按下和移动被处理）
+        if (!eventDispatcher_->queueEvent(event)) {
+            eventDispatcher_->dispatchQueuedEvents();
+            eventDispatcher_->dispatchEvent(event);
+        }
+    }
+
     void GLFWWindow::pollEvents() {
         glfwPollEvents();
     }
 
+    void GLFWWindow::waitEvents(double timeout) {
+        glfwWaitEventsTimeout(timeout);
+    }
+
+    void GLFWWindow::doneContextCurrent() {
+        glfwMakeContextCurrent(nullptr);
+    }
+
     void GLFWWindow::swapBuffers() {
         if (window_) {
             glfwSwapBuffers(window_);
@@ -162,7 +179,7 @@ namespace sandbox {
             }
             
             event.data.key.mods = mods;
-            self->eventDispatcher_->dispatchEvent(event);
+            self->postEvent(event);
             
             // 【旧版本已弃用】通过回调函数分发（会导致双重处理）
             // if (self->eventCallback_) {
@@ -200,7 +217,7 @@ namespace sandbox {
             event.data.mouseButton.x = x;
             event.data.mouseButton.y = y;
                 
-            self->eventDispatcher_->dispatchEvent(event);
+            self->postEvent(event);
             
             // 【旧版本已弃用】通过回调函数分发（会导致双重处理）
             // if (self->eventCallback_) {
@@ -217,7 +234,7 @@ namespace sandbox {
             event.type = iengine::WindowEventType::MouseMove;
             event.data.mouseMove.x = xpos;
             event.data.mouseMove.y = ypos;
-            self->eventDispatcher_->dispatchEvent(event);
+            self->postEvent(event);
             
             // 【旧版本已弃用】通过回调函数分发（会导致双重处理）
             // if (self->eventCallback_) {
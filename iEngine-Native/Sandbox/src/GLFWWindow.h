@@ -33,6 +33,8 @@ namespace sandbox {
         bool shouldClose() const override;
         std::shared_ptr<iengine::Context> getContext() const override;
         void makeContextCurrent() override;
+        void doneContextCurrent() override;
+        void swapBuffers() override;
         void setEventCallback(const iengine::WindowEventCallback& callback) override;
         
         // 观察者模式事件接口实现
@@ -42,7 +44,8 @@ namespace sandbox {
         // GLFW特有的方法
         GLFWwindow* getGLFWHandle() const { return window_; }
         void pollEvents();
-        void swapBuffers();
+        // 阻塞直到有事件到达或超时（秒），按需渲染时场景静止期间代替 pollEvents
+        void waitEvents(double timeout);
 
     private:
         GLFWwindow* window_;
@@ -55,6 +58,9 @@ namespace sandbox {
         static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
         static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
         static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
+        
+        // 输入事件放入分发器的队列，由引擎每帧合并分发
+        void postEvent(const iengine::WindowEvent& event);
     };
 
 } // namespace sandbox
@@ -93,6 +93,8 @@ namespace sandbox {
             try {
                 iengine::EngineOptions options;
                 options.renderer = iengine::RendererType::OpenGL;
+                // 场景静止时不重绘，主循环等待事件
+                options.onDemandRendering = true;
                 engine_ = std::make_shared<iengine::Engine>(options);
                 
                 std::cout << "iEngine初始化成功" << std::endl;
@@ -131,8 +133,12 @@ namespace sandbox {
             auto lastTime = glfwGetTime();
             
             while (!window_->shouldClose()) {
-                // 处理事件
-                window_->pollEvents();
+                // 处理事件：没有需要重绘的内容时阻塞等待，超时用于处理工作线程中的加载等无事件的变化
+                if (engine_ && !engine_->needsRedraw()) {
+                    window_->waitEvents(0.1);
+                } else {
+                    window_->pollEvents();
+                }
                 
                 // 检查是否需要切换控制器（在事件处理完成后，避免死锁）
                 if (shouldSwitchController_.load()) {
@@ -140,8 +146,10 @@ namespace sandbox {
                     switchControllerMode();
                 }
                 
-                // 渲染
-                render();
+                // 渲染，本帧没有渲染时不交换缓冲区
+                if (!render()) {
+                    continue;
+                }
                 
                 // 交换缓冲区
                 window_->swapBuffers();
@@ -332,7 +340,8 @@ namespace sandbox {
             }
         }
         
-        void render() {
+        // 返回是否渲染了新的一帧
+        bool render() {
             // 确保OpenGL上下文是当前的
             window_->makeContextCurrent();
             
@@ -341,7 +350,7 @@ namespace sandbox {
                 try {
                     // 调用引擎渲染
                     //engine_->render();
-                    engine_->tick();
+                    return engine_->tick();
                 } catch (const std::exception& e) {
                     std::cerr << "Engine render error: " << e.what() << std::endl;
                     // 如果引擎渲染失败，使用备用渲染
@@ -350,6 +359,7 @@ namespace sandbox {
             } else {
                 fallbackRender();
             }
+            return true;
         }
         
         void fallbackRender() {
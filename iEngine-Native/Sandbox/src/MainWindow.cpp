@@ -240,6 +240,8 @@ namespace sandbox {
 
             // 将场景添加到引擎
             engine_.addScene("main", scene_);
+            // 场景静止时渲染定时器不触发重绘
+            engine_.setOnDemandRendering(true);
             std::cout << "场景创建成功，包含 " << scene_->getComponents().size() << " 个组件" << std::endl;
 
             // 注册内置着色器
@@ -35,7 +35,10 @@ namespace sandbox {
         
         // 设置连续渲染定时器（60FPS）
         connect(renderTimer_, &QTimer::timeout, this, [this]() {
-            this->update(); // 触发 paintGL
+            // 按需渲染时场景没有变化就不触发 paintGL
+            if (engine_.needsRedraw()) {
+                this->update(); // 触发 paintGL
+            }
         });
         renderTimer_->setInterval(16); // 约60FPS (1000ms/60 ≈ 16ms)
         renderTimer_->setTimerType(Qt::PreciseTimer); // 使用精确定时器提高帧率稳定性
@@ -194,6 +197,8 @@ namespace sandbox {
         if (engine_.isReady() && initialized_) {
             try {
                 //engine_->render();
+                // paintGL 之前已清屏，Qt 也会在之后呈现，因此这里总要渲染
+                engine_.requestRedraw();
                 engine_.tick();
             } catch (const std::exception& e) {
                 std::cerr << "Qt窗口Engine渲染失败: " << e.what() << std::endl;
@@ -208,6 +213,14 @@ namespace sandbox {
         }
     }
 
+    void QtWindow::postEvent(const iengine::WindowEvent& event) {
+        // Qt 事件和 paintGL 都在 GUI 线程，队列满时先分发队列中较早的事件，再直接分发本事件以保持顺序
+        if (!eventDispatcher_->queueEvent(event)) {
+            eventDispatcher_->dispatchQueuedEvents();
+            eventDispatcher_->dispatchEvent(event);
+        }
+    }
+
     // Qt输入事件处理
     void QtWindow::mousePressEvent(QMouseEvent* event) {
         iengine::WindowEvent windowEvent;
@@ -217,16 +230,12 @@ namespace sandbox {
         windowEvent.data.mouseButton.x = event->x();
         windowEvent.data.mouseButton.y = event->y();
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::mousePressEvent(event);
-        }
     }
 
     void QtWindow::mouseReleaseEvent(QMouseEvent* event) {
@@ -237,16 +246,12 @@ namespace sandbox {
         windowEvent.data.mouseButton.x = event->x();
         windowEvent.data.mouseButton.y = event->y();
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::mouseReleaseEvent(event);
-        }
     }
 
     void QtWindow::mouseMoveEvent(QMouseEvent* event) {
@@ -255,16 +260,12 @@ namespace sandbox {
         windowEvent.data.mouseMove.x = event->x();
         windowEvent.data.mouseMove.y = event->y();
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘（鼠标移动很关键）
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::mouseMoveEvent(event);
-        }
     }
 
     void QtWindow::wheelEvent(QWheelEvent* event) {
@@ -273,16 +274,12 @@ namespace sandbox {
         windowEvent.data.mouseScroll.xoffset = event->angleDelta().x() / 120.0;
         windowEvent.data.mouseScroll.yoffset = event->angleDelta().y() / 120.0;
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘（滚轮缩放很关键）
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::wheelEvent(event);
-        }
     }
 
     void QtWindow::keyPressEvent(QKeyEvent* event) {
@@ -292,16 +289,12 @@ namespace sandbox {
         windowEvent.data.key.action = iengine::KeyAction::Press;
         windowEvent.data.key.mods = 0;
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘（按键切换控制器等）
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::keyPressEvent(event);
-        }
     }
 
     void QtWindow::keyReleaseEvent(QKeyEvent* event) {
@@ -311,16 +304,12 @@ namespace sandbox {
         windowEvent.data.key.action = iengine::KeyAction::Release;
         windowEvent.data.key.mods = 0;
         
-        bool eventHandled = eventDispatcher_->dispatchEvent(windowEvent);
+        postEvent(windowEvent);
         
-        // 在事件驱动模式下，如果事件被处理了，就触发重绘
-        if (eventHandled && !renderTimer_->isActive()) {
+        // 事件驱动模式下触发重绘，排队的事件在 paintGL 中分发；定时器模式下由定时器检查 needsRedraw
+        if (!renderTimer_->isActive()) {
             update(); // 事件驱动模式下的智能重绘
         }
-        
-        if (!eventHandled) {
-            QOpenGLWidget::keyReleaseEvent(event);
-        }
     }
     
     // Qt事件转换辅助函数
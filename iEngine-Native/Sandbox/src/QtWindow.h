@@ -64,6 +64,8 @@ namespace sandbox {
         iengine::MouseButton qtButtonToEngineButton(Qt::MouseButton button);
         iengine::KeyAction qtActionToEngineAction(bool pressed);
         int qtKeyToEngineKey(int qtKey);
+        // 输入事件放入分发器的队列，在下一次 paintGL 的 tick() 中合并分发
+        void postEvent(const iengine::WindowEvent& event);
 
     private:
         iengine::Engine& engine_;   // ← 引用，不拥有所有权